@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBatchFunctor_h
+#define itkBatchFunctor_h
+
+#include "itkImage.h"
+#include "itkIndexRange.h"
+
+#include <type_traits>
+#include <utility>
+
+/** \file itkBatchFunctor.h
+ * \brief Batch overloads of the functors of the pixel-wise filters.
+ *
+ * Next to its operator() for a pixel, a functor of UnaryFunctorImageFilter
+ * or UnaryGeneratorImageFilter may provide the batch overload
+     \code
+     void operator()(const TInput * input, TOutput * output, SizeValueType numberOfPixels) const;
+     \endcode
+ * and a functor of BinaryGeneratorImageFilter may provide the batch overloads
+     \code
+     void operator()(const TInput1 * input1, const TInput2 * input2, TOutput * output, SizeValueType n) const;
+     void operator()(const TInput1 * input1, const TInput2 & constant2, TOutput * output, SizeValueType n) const;
+     void operator()(const TInput1 & constant1, const TInput2 * input2, TOutput * output, SizeValueType n) const;
+     \endcode
+ * When the input and output images are Image objects, the filters then pass
+ * the functor the pixels of each line of the region along the first
+ * dimension, which are contiguous in the buffers, so that the functor may
+ * process them with explicit SIMD instructions, or with a loop over the
+ * arrays that the compiler vectorizes. The batch overloads must compute the
+ * same values as operator() for each pixel. The output array may be an input
+ * array, when the filter runs in place.
+ *
+ * ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION and
+ * ITK_BINARY_BATCH_OPERATOR_MEMBER_FUNCTION define the batch overloads as
+ * such loops over the operator() for a pixel.
+ *
+ * \ingroup ITKCommon
+ */
+
+// Defines the batch overload of a unary functor, which applies its operator()
+// to each element of the input array. The loop calls a local copy of the
+// functor, whose data members the output array cannot alias, so that the
+// compiler may keep them in registers and vectorize the loop.
+#define ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput, TOutput)                                    \
+  void operator()(const TInput * input, TOutput * output, ::itk::SizeValueType numberOfPixels) const \
+  {                                                                                                  \
+    const auto functor = *this;                                                                      \
+    for (::itk::SizeValueType i = 0; i < numberOfPixels; ++i)                                        \
+    {                                                                                                \
+      output[i] = functor(input[i]);                                                                 \
+    }                                                                                                \
+  }                                                                                                  \
+  ITK_MACROEND_NOOP_STATEMENT
+
+// Defines the batch overloads of a binary functor, which apply its operator()
+// to the elements of the input arrays, or to the elements of an input array
+// and a constant.
+#define ITK_BINARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput1, TInput2, TOutput) \
+  void operator()(const TInput1 *      input1,                               \
+                  const TInput2 *      input2,                               \
+                  TOutput *            output,                               \
+                  ::itk::SizeValueType numberOfPixels) const                 \
+  {                                                                          \
+    const auto functor = *this;                                              \
+    for (::itk::SizeValueType i = 0; i < numberOfPixels; ++i)                \
+    {                                                                        \
+      output[i] = functor(input1[i], input2[i]);                             \
+    }                                                                        \
+  }                                                                          \
+  void operator()(const TInput1 *      input1,                               \
+                  const TInput2 &      constant2,                            \
+                  TOutput *            output,                               \
+                  ::itk::SizeValueType numberOfPixels) const                 \
+  {                                                                          \
+    const auto    functor = *this;                                           \
+    const TInput2 value2 = constant2;                                        \
+    for (::itk::SizeValueType i = 0; i < numberOfPixels; ++i)                \
+    {                                                                        \
+      output[i] = functor(input1[i], value2);                                \
+    }                                                                        \
+  }                                                                          \
+  void operator()(const TInput1 &      constant1,                            \
+                  const TInput2 *      input2,                               \
+                  TOutput *            output,                               \
+                  ::itk::SizeValueType numberOfPixels) const                 \
+  {                                                                          \
+    const auto    functor = *this;                                           \
+    const TInput1 value1 = constant1;                                        \
+    for (::itk::SizeValueType i = 0; i < numberOfPixels; ++i)                \
+    {                                                                        \
+      output[i] = functor(value1, input2[i]);                                \
+    }                                                                        \
+  }                                                                          \
+  ITK_MACROEND_NOOP_STATEMENT
+
+namespace itk
+{
+namespace Functor
+{
+/** Tells whether the functor has the batch overload of a unary functor. */
+template <typename TFunctor, typename TInput, typename TOutput, typename = void>
+struct HasUnaryBatchOperator : std::false_type
+{};
+
+template <typename TFunctor, typename TInput, typename TOutput>
+struct HasUnaryBatchOperator<TFunctor,
+                             TInput,
+                             TOutput,
+                             std::void_t<decltype(std::declval<const TFunctor &>()(
+                               std::declval<const TInput *>(), std::declval<TOutput *>(), SizeValueType{}))>>
+  : std::true_type
+{};
+
+/** Tells whether the functor has the batch overloads of a binary functor. */
+template <typename TFunctor, typename TInput1, typename TInput2, typename TOutput, typename = void>
+struct HasBinaryBatchOperator : std::false_type
+{};
+
+template <typename TFunctor, typename TInput1, typename TInput2, typename TOutput>
+struct HasBinaryBatchOperator<
+  TFunctor,
+  TInput1,
+  TInput2,
+  TOutput,
+  std::void_t<decltype(std::declval<const TFunctor &>()(std::declval<const TInput1 *>(),
+                                                        std::declval<const TInput2 *>(),
+                                                        std::declval<TOutput *>(),
+                                                        SizeValueType{})),
+              decltype(std::declval<const TFunctor &>()(std::declval<const TInput1 *>(),
+                                                        std::declval<const TInput2 &>(),
+                                                        std::declval<TOutput *>(),
+                                                        SizeValueType{})),
+              decltype(std::declval<const TFunctor &>()(std::declval<const TInput1 &>(),
+                                                        std::declval<const TInput2 *>(),
+                                                        std::declval<TOutput *>(),
+                                                        SizeValueType{}))>> : std::true_type
+{};
+} // namespace Functor
+
+/** \class ImageScanlineBatch
+ * \brief Walks the lines of a region of Image objects along the first
+ * dimension, whose pixels are contiguous in the buffers, for the batch
+ * overloads of the functors.
+ *
+ * \sa itkBatchFunctor.h
+ * \ingroup ITKCommon
+ */
+struct ImageScanlineBatch
+{
+  /** Whether the pixels of the images are the elements of their buffers. */
+  template <typename... TImages>
+  static constexpr bool IsSupported =
+    (std::is_same_v<std::remove_const_t<TImages>, Image<typename TImages::PixelType, TImages::ImageDimension>> && ...);
+
+  /** Call function(lineLength, outputLine, inputLines...) for each line of
+   * the region of the images, where outputLine and inputLines point to the
+   * first pixel of the line in the output image and in the input images. */
+  template <typename TFunction, typename TOutputImage, typename... TInputImages>
+  static void
+  ForEachScanline(const typename TOutputImage::RegionType & region,
+                  TFunction &&                              function,
+                  TOutputImage &                            outputImage,
+                  const TInputImages &... inputImages)
+  {
+    static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+    const SizeValueType lineLength = region.GetSize(0);
+    if (region.GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+    typename TOutputImage::RegionType lineStartRegion = region;
+    lineStartRegion.SetSize(0, 1);
+
+    for (const auto & index : ImageRegionIndexRange<ImageDimension>(lineStartRegion))
+    {
+      function(lineLength,
+               outputImage.GetBufferPointer() + outputImage.ComputeOffset(index),
+               (inputImages.GetBufferPointer() + inputImages.ComputeOffset(index))...);
+    }
+  }
+};
+} // end namespace itk
+
+#endif
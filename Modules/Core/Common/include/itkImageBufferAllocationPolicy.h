@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocationPolicy_h
+#define itkImageBufferAllocationPolicy_h
+
+#include "itkSingletonMacro.h"
+#include "ITKCommonExport.h"
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+namespace itk
+{
+/** \class ImageBufferAllocationPolicy
+ * \brief How an ImportImageContainer allocates the buffers that it manages.
+ *
+ * By default, a buffer is allocated with new[]. Its pages are then mapped to
+ * the memory of the NUMA node of the thread that first writes them, which is
+ * the thread that allocates the image when its pixels are initialized, and
+ * the filters that process the image from every node fetch their pixels
+ * from that node.
+ *
+ * The policy may instead:
+ * - align the buffer on a given number of bytes, for instance on cache lines
+ *   or on the width of SIMD registers;
+ * - request transparent huge pages for the buffer, on Linux, which reduces
+ *   the TLB misses of large images;
+ * - initialize the buffer with the work units of a multi-threader, each one
+ *   writing the contiguous part of the buffer that the default
+ *   ImageRegionSplitterSlowDimension gives it when an image is split along
+ *   its slowest dimension, so that the pages are mapped near the threads
+ *   that will process them. The pixels are then value-initialized;
+ * - recycle the buffers through the process-wide ImageBufferPool.
+ *
+ * The policy of a container is copied from GetGlobalDefault() when the
+ * container is created, and an Image keeps the policy of its pixel
+ * container when it is initialized.
+ *
+ * \sa ImportImageContainer
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocationPolicy
+{
+public:
+  /** Alignment of the buffers in bytes, a power of two, or 0 to allocate
+   * them with new[]. */
+  size_t Alignment{ 0 };
+
+  /** Whether transparent huge pages are requested for the buffers of at
+   * least HugePageSize bytes, which are then aligned on huge pages. */
+  bool UseHugePages{ false };
+
+  /** Whether the buffers are initialized by the work units of a
+   * multi-threader. */
+  bool UseParallelFirstTouch{ false };
+
+  /** Whether the buffers are acquired from, and released to, the
+   * ImageBufferPool. */
+  bool UsePool{ false };
+
+  /** Size of the transparent huge pages. */
+  static constexpr size_t HugePageSize = size_t{ 2 } << 20;
+
+  bool
+  operator==(const ImageBufferAllocationPolicy & other) const
+  {
+    return Alignment == other.Alignment && UseHugePages == other.UseHugePages &&
+           UseParallelFirstTouch == other.UseParallelFirstTouch && UsePool == other.UsePool;
+  }
+
+  bool
+  operator!=(const ImageBufferAllocationPolicy & other) const
+  {
+    return !(*this == other);
+  }
+
+  /** Whether the buffers are allocated with new[], rather than with
+   * AllocateBuffer(). */
+  bool
+  IsDefault() const
+  {
+    return Alignment == 0 && !UseHugePages && !UseParallelFirstTouch && !UsePool;
+  }
+
+  /** Set/Get the policy of the containers created from now on. */
+  static void
+  SetGlobalDefault(const ImageBufferAllocationPolicy & policy);
+  static ImageBufferAllocationPolicy
+  GetGlobalDefault();
+
+  /** Alignment of a buffer of numberOfBytes whose elements are aligned on
+   * elementAlignment bytes. */
+  size_t
+  GetBufferAlignment(size_t numberOfBytes, size_t elementAlignment) const;
+
+  /** Allocate a buffer of numberOfBytes, aligned on alignment bytes, or
+   * acquire it from the pool, and request huge pages for it, or return
+   * nullptr. The buffer must be released by DeallocateBuffer(), with the
+   * same alignment, and with fromPool set to UsePool. */
+  void *
+  AllocateBuffer(size_t numberOfBytes, size_t alignment) const;
+
+  /** Deallocate a buffer returned by AllocateBuffer(), or return it to the
+   * pool if it was acquired from the pool. */
+  static void
+  DeallocateBuffer(void * buffer, size_t alignment, bool fromPool);
+
+  /** Minimum number of bytes of the buffers that are initialized in
+   * parallel. The smaller ones are initialized by the calling thread. */
+  static constexpr size_t MinimumParallelFirstTouchSize = HugePageSize;
+
+  /** Call function(begin, end) for the contiguous parts of [0, size) of the
+   * work units of a multi-threader, or once for the whole range if the
+   * buffer of size elements of elementSize bytes is not initialized in
+   * parallel: when UseParallelFirstTouch is off, when the buffer is smaller
+   * than MinimumParallelFirstTouchSize, or when the calling thread is
+   * already a thread of the ThreadPool, on which a nested multi-threader
+   * would only wait for the other threads of the pool. */
+  void
+  ParallelizeBuffer(size_t size, size_t elementSize, const std::function<void(size_t, size_t)> & function) const;
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocationPolicy, GlobalDefault);
+
+  static ImageBufferAllocationPolicy * m_GlobalDefault;
+};
+
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const ImageBufferAllocationPolicy & policy);
+} // end namespace itk
+
+#endif
@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferPool_h
+#define itkImageBufferPool_h
+
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+#include "ITKCommonExport.h"
+#include <cstddef>
+#include <ostream>
+
+namespace itk
+{
+/** \class ImageBufferPool
+ * \brief Process-wide pool of the image buffers released by the
+ * ImportImageContainer objects whose allocation policy uses it.
+ *
+ * When a pipeline is updated repeatedly, the intermediate images whose
+ * producer has its ReleaseDataFlag set, and the outputs of the filters whose
+ * ReleaseDataBeforeUpdateFlag is set, release their buffers, and the next
+ * update allocates them again, paying for the allocation and for the page
+ * faults of the new buffers. With ImageBufferAllocationPolicy::UsePool, the
+ * released buffers are kept by the pool instead, and handed over to the next
+ * containers that allocate buffers of the same size class and alignment.
+ *
+ * The size of the buffers is rounded up to a size class, so that a buffer
+ * may be reused for sizes that differ by less than an eighth. The pool holds
+ * at most MaximumNumberOfBytes: when a released buffer exceeds it, the buffers
+ * released the longest time ago are deallocated.
+ *
+ * \sa ImageBufferAllocationPolicy
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferPool
+{
+public:
+  /** Statistics of the pool since it was created or its statistics were
+   * reset. */
+  struct Statistics
+  {
+    /** Number of buffers acquired from the pool, and allocated for it. */
+    SizeValueType NumberOfHits{ 0 };
+    SizeValueType NumberOfMisses{ 0 };
+    /** Number of buffers released to the pool that it deallocated to stay
+     * within its maximum number of bytes. */
+    SizeValueType NumberOfTrimmedBuffers{ 0 };
+    /** Number of buffers, and of bytes, currently held by the pool. */
+    SizeValueType NumberOfBuffersHeld{ 0 };
+    size_t        NumberOfBytesHeld{ 0 };
+  };
+
+  /** Set/Get the maximum number of bytes of the buffers held by the pool.
+   * It is 1 GiB by default. */
+  static void
+  SetMaximumNumberOfBytes(size_t numberOfBytes);
+  static size_t
+  GetMaximumNumberOfBytes();
+
+  /** Size class of a buffer of numberOfBytes. */
+  static size_t
+  GetSizeClass(size_t numberOfBytes);
+
+  /** Return a buffer of at least numberOfBytes, aligned on alignment bytes,
+   * held by the pool or newly allocated, or nullptr if it cannot be
+   * allocated. */
+  static void *
+  Acquire(size_t numberOfBytes, size_t alignment);
+
+  /** Take back a buffer returned by Acquire(), and return true, or return
+   * false if the buffer was not acquired from the pool. */
+  static bool
+  Release(void * buffer, size_t alignment);
+
+  /** Deallocate the buffers held by the pool. */
+  static void
+  Clear();
+
+  static Statistics
+  GetStatistics();
+  static void
+  ResetStatistics();
+
+private:
+  struct PoolGlobals;
+
+  itkGetGlobalDeclarationMacro(PoolGlobals, PoolGlobals);
+
+  static PoolGlobals * m_PoolGlobals;
+};
+
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const ImageBufferPool::Statistics & statistics);
+} // end namespace itk
+
+#endif
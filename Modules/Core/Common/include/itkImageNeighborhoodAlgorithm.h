@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageNeighborhoodAlgorithm_h
+#define itkImageNeighborhoodAlgorithm_h
+
+#include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNeighborhoodAlgorithm.h"
+#include "itkShapedImageNeighborhoodRange.h"
+#include "itkTotalProgressReporter.h"
+#include "itkZeroFluxNeumannImageNeighborhoodPixelAccessPolicy.h"
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+
+/** \class ImageNeighborhoodAlgorithm
+ *  \brief A container of static functions which compute the pixels of an
+ *  output image from the neighborhoods of the pixels of an input image.
+ *
+ *  Transform() splits the region to compute into the region where the
+ *  neighborhoods lie in the buffered region of the input image, and the
+ *  boundary faces around it, as computed by
+ *  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator, so that filters do
+ *  not have to. In the non-boundary region of an Image, the neighbor pixels
+ *  are read, without bounds checks, at offsets from the center pixel in the
+ *  buffer that are computed once, and the output pixels are written through
+ *  a pointer. In the boundary faces, the neighbor pixels are read with the
+ *  boundary pixel access policy, for instance
+ *  ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy or
+ *  ConstantBoundaryImageNeighborhoodPixelAccessPolicy.
+ *
+ *  The kernel is called with the neighborhood of each pixel, and returns the
+ *  value of the output pixel. The neighborhood is a range of the values of
+ *  the neighbor pixels, in the order of the offsets, which supports size(),
+ *  operator[] and range-based for loops. Its type differs between the
+ *  non-boundary region and the boundary faces, so that the kernel is
+ *  typically a generic lambda:
+     \code
+     ImageNeighborhoodAlgorithm::Transform(*input, *output, region, offsets, [](const auto & neighborhood) {
+       double sum = 0.0;
+       for (const InputPixelType pixel : neighborhood)
+       {
+         sum += pixel;
+       }
+       return static_cast<OutputPixelType>(sum / neighborhood.size());
+     });
+     \endcode
+ *
+ *  \sa ShapedImageNeighborhoodRange
+ *  \ingroup ITKCommon
+ */
+struct ImageNeighborhoodAlgorithm
+{
+  /** \class BufferedNeighborhood
+   * The neighborhood of a pixel of the non-boundary region of an Image,
+   * whose neighbor pixels are read at offsets from the center pixel in the
+   * buffer.
+   * \ingroup ITKCommon
+   */
+  template <typename TPixel>
+  class BufferedNeighborhood
+  {
+  public:
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = TPixel;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const TPixel *;
+      using reference = const TPixel &;
+
+      const_iterator(const TPixel * center, const OffsetValueType * offset)
+        : m_Center(center)
+        , m_Offset(offset)
+      {}
+
+      reference
+      operator*() const
+      {
+        return m_Center[*m_Offset];
+      }
+
+      const_iterator &
+      operator++()
+      {
+        ++m_Offset;
+        return *this;
+      }
+
+      const_iterator
+      operator++(int)
+      {
+        const_iterator result = *this;
+        ++m_Offset;
+        return result;
+      }
+
+      bool
+      operator==(const const_iterator & other) const
+      {
+        return m_Offset == other.m_Offset;
+      }
+
+      bool
+      operator!=(const const_iterator & other) const
+      {
+        return m_Offset != other.m_Offset;
+      }
+
+    private:
+      const TPixel *          m_Center;
+      const OffsetValueType * m_Offset;
+    };
+    using iterator = const_iterator;
+
+    BufferedNeighborhood(const TPixel * center, const OffsetValueType * offsets, size_t size)
+      : m_Center(center)
+      , m_Offsets(offsets)
+      , m_Size(size)
+    {}
+
+    size_t
+    size() const
+    {
+      return m_Size;
+    }
+
+    const TPixel & operator[](size_t n) const { return m_Center[m_Offsets[n]]; }
+
+    const_iterator
+    begin() const
+    {
+      return const_iterator(m_Center, m_Offsets);
+    }
+
+    const_iterator
+    end() const
+    {
+      return const_iterator(m_Center, m_Offsets + m_Size);
+    }
+
+  private:
+    const TPixel *          m_Center;
+    const OffsetValueType * m_Offsets;
+    size_t                  m_Size;
+  };
+
+  /** The parameter of a pixel access policy, for instance the constant of
+   * ConstantBoundaryImageNeighborhoodPixelAccessPolicy, or
+   * EmptyPixelAccessParameter if the policy has no parameter. */
+  struct EmptyPixelAccessParameter
+  {};
+
+  template <typename TPixelAccessPolicy, typename = void>
+  struct PixelAccessParameter
+  {
+    using Type = EmptyPixelAccessParameter;
+  };
+
+  template <typename TPixelAccessPolicy>
+  struct PixelAccessParameter<TPixelAccessPolicy, std::void_t<typename TPixelAccessPolicy::PixelAccessParameterType>>
+  {
+    using Type = typename TPixelAccessPolicy::PixelAccessParameterType;
+  };
+
+  /** Assign kernel(neighborhood) to each pixel of the region of the output
+   * image, where neighborhood is the neighborhood of the pixel of the input
+   * image with the same index, whose shape is given by the offsets. If
+   * progress is not nullptr, it is notified of the computed pixels. */
+  template <template <typename> class TBoundaryPixelAccessPolicy = ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy,
+            typename TInputImage,
+            typename TOutputImage,
+            typename TKernel>
+  static void
+  Transform(const TInputImage &                                                    inputImage,
+            TOutputImage &                                                         outputImage,
+            const typename TOutputImage::RegionType &                              region,
+            const std::vector<Offset<TInputImage::ImageDimension>> &               offsets,
+            TKernel &&                                                             kernel,
+            TotalProgressReporter *                                                progress = nullptr,
+            const typename PixelAccessParameter<TBoundaryPixelAccessPolicy<TInputImage>>::Type & boundaryParameter = {});
+
+  /** Like Transform(), but splits the region with the multi-threader, and
+   * computes the parts of the region in parallel, each one with a copy of the
+   * kernel. */
+  template <template <typename> class TBoundaryPixelAccessPolicy = ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy,
+            typename TInputImage,
+            typename TOutputImage,
+            typename TKernel>
+  static void
+  ParallelTransform(MultiThreaderBase *                                                    multiThreader,
+                    const TInputImage &                                                    inputImage,
+                    TOutputImage &                                                         outputImage,
+                    const typename TOutputImage::RegionType &                              region,
+                    const std::vector<Offset<TInputImage::ImageDimension>> &               offsets,
+                    const TKernel &                                                        kernel,
+                    ProcessObject *                                                        filter = nullptr,
+                    const typename PixelAccessParameter<TBoundaryPixelAccessPolicy<TInputImage>>::Type & boundaryParameter = {});
+
+private:
+  /** Whether the pixels of the image are the elements of its buffer. */
+  template <typename TImage>
+  static constexpr bool IsBufferedImage =
+    std::is_same_v<std::remove_const_t<TImage>, Image<typename TImage::PixelType, TImage::ImageDimension>>;
+
+  template <typename TPixelAccessPolicy,
+            typename TInputImage,
+            typename TOutputImage,
+            typename TKernel,
+            typename TParameter>
+  static void
+  TransformSubregion(const TInputImage &                                      inputImage,
+                     TOutputImage &                                           outputImage,
+                     const typename TOutputImage::RegionType &                subregion,
+                     const std::vector<Offset<TInputImage::ImageDimension>> & offsets,
+                     TKernel &                                                kernel,
+                     TotalProgressReporter *                                  progress,
+                     const TParameter &                                       parameter);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageNeighborhoodAlgorithm.hxx"
+#endif
+
+#endif
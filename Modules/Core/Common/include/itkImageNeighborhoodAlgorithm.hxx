@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageNeighborhoodAlgorithm_hxx
+#define itkImageNeighborhoodAlgorithm_hxx
+
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace itk
+{
+
+template <template <typename> class TBoundaryPixelAccessPolicy,
+          typename TInputImage,
+          typename TOutputImage,
+          typename TKernel>
+void
+ImageNeighborhoodAlgorithm::Transform(
+  const TInputImage &                                                    inputImage,
+  TOutputImage &                                                         outputImage,
+  const typename TOutputImage::RegionType &                              region,
+  const std::vector<Offset<TInputImage::ImageDimension>> &               offsets,
+  TKernel &&                                                             kernel,
+  TotalProgressReporter *                                                progress,
+  const typename PixelAccessParameter<TBoundaryPixelAccessPolicy<TInputImage>>::Type & boundaryParameter)
+{
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+  using FacesCalculatorType = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>;
+  using RegionType = typename FacesCalculatorType::RegionType;
+
+  // The radius of the smallest rectangular neighborhood that contains the offsets.
+  typename FacesCalculatorType::RadiusType radius{};
+  for (const auto & offset : offsets)
+  {
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      radius[i] = std::max(radius[i], static_cast<SizeValueType>(std::abs(offset[i])));
+    }
+  }
+
+  const auto       calculatorResult = FacesCalculatorType::Compute(inputImage, region, radius);
+  const RegionType nonBoundaryRegion = calculatorResult.GetNonBoundaryRegion();
+
+  if (nonBoundaryRegion.GetNumberOfPixels() > 0)
+  {
+    if constexpr (IsBufferedImage<TInputImage> && IsBufferedImage<TOutputImage>)
+    {
+      using InputPixelType = typename TInputImage::PixelType;
+      using OutputPixelType = typename TOutputImage::PixelType;
+
+      // The offsets of the neighbor pixels from the center pixel in the buffer.
+      const auto &                 offsetTable = inputImage.GetOffsetTable();
+      std::vector<OffsetValueType> bufferOffsets;
+      bufferOffsets.reserve(offsets.size());
+      for (const auto & offset : offsets)
+      {
+        OffsetValueType bufferOffset = offset[0];
+        for (unsigned int i = 1; i < ImageDimension; ++i)
+        {
+          bufferOffset += offset[i] * offsetTable[i];
+        }
+        bufferOffsets.push_back(bufferOffset);
+      }
+
+      // Process the non-boundary region line by line, along the first
+      // dimension, where both the input and output pixels are contiguous.
+      const InputPixelType * const inputBuffer = inputImage.GetBufferPointer();
+      OutputPixelType * const      outputBuffer = outputImage.GetBufferPointer();
+      const SizeValueType          lineLength = nonBoundaryRegion.GetSize(0);
+      RegionType                   lineStartRegion = nonBoundaryRegion;
+      lineStartRegion.SetSize(0, 1);
+
+      for (const auto & index : ImageRegionIndexRange<ImageDimension>(lineStartRegion))
+      {
+        const InputPixelType * center = inputBuffer + inputImage.ComputeOffset(index);
+        OutputPixelType *      outputPixel = outputBuffer + outputImage.ComputeOffset(index);
+        for (SizeValueType n = 0; n < lineLength; ++n, ++center, ++outputPixel)
+        {
+          *outputPixel =
+            kernel(BufferedNeighborhood<InputPixelType>(center, bufferOffsets.data(), bufferOffsets.size()));
+        }
+        if (progress)
+        {
+          progress->Completed(lineLength);
+        }
+      }
+    }
+    else
+    {
+      TransformSubregion<BufferedImageNeighborhoodPixelAccessPolicy<TInputImage>>(
+        inputImage, outputImage, nonBoundaryRegion, offsets, kernel, progress, EmptyPixelAccessParameter{});
+    }
+  }
+
+  for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
+  {
+    TransformSubregion<TBoundaryPixelAccessPolicy<TInputImage>>(
+      inputImage, outputImage, boundaryFace, offsets, kernel, progress, boundaryParameter);
+  }
+}
+
+
+template <template <typename> class TBoundaryPixelAccessPolicy,
+          typename TInputImage,
+          typename TOutputImage,
+          typename TKernel>
+void
+ImageNeighborhoodAlgorithm::ParallelTransform(
+  MultiThreaderBase *                                                    multiThreader,
+  const TInputImage &                                                    inputImage,
+  TOutputImage &                                                         outputImage,
+  const typename TOutputImage::RegionType &                              region,
+  const std::vector<Offset<TInputImage::ImageDimension>> &               offsets,
+  const TKernel &                                                        kernel,
+  ProcessObject *                                                        filter,
+  const typename PixelAccessParameter<TBoundaryPixelAccessPolicy<TInputImage>>::Type & boundaryParameter)
+{
+  multiThreader->template ParallelizeImageRegion<TOutputImage::ImageDimension>(
+    region,
+    [&](const typename TOutputImage::RegionType & piece) {
+      TKernel               pieceKernel(kernel);
+      TotalProgressReporter progress(filter, region.GetNumberOfPixels());
+      Transform<TBoundaryPixelAccessPolicy>(
+        inputImage, outputImage, piece, offsets, pieceKernel, &progress, boundaryParameter);
+    },
+    nullptr);
+}
+
+
+template <typename TPixelAccessPolicy,
+          typename TInputImage,
+          typename TOutputImage,
+          typename TKernel,
+          typename TParameter>
+void
+ImageNeighborhoodAlgorithm::TransformSubregion(const TInputImage &                                      inputImage,
+                                               TOutputImage &                                           outputImage,
+                                               const typename TOutputImage::RegionType &                subregion,
+                                               const std::vector<Offset<TInputImage::ImageDimension>> & offsets,
+                                               TKernel &                                                kernel,
+                                               TotalProgressReporter *                                  progress,
+                                               const TParameter &                                       parameter)
+{
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using RangeType = ShapedImageNeighborhoodRange<const TInputImage, TPixelAccessPolicy>;
+
+  auto neighborhoodRange = [&] {
+    if constexpr (std::is_same_v<TParameter, EmptyPixelAccessParameter>)
+    {
+      return RangeType(inputImage, Index<ImageDimension>(), offsets);
+    }
+    else
+    {
+      return RangeType(inputImage, Index<ImageDimension>(), offsets, parameter);
+    }
+  }();
+  auto outputIterator = ImageRegionRange<TOutputImage>(outputImage, subregion).begin();
+
+  for (const auto & index : ImageRegionIndexRange<ImageDimension>(subregion))
+  {
+    neighborhoodRange.SetLocation(index);
+    *outputIterator = kernel(neighborhoodRange);
+    ++outputIterator;
+    if (progress)
+    {
+      progress->CompletedPixel();
+    }
+  }
+}
+} // end namespace itk
+
+#endif
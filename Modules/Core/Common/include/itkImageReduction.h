@@ -0,0 +1,260 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageReduction_h
+#define itkImageReduction_h
+
+#include "itkBatchFunctor.h"
+#include "itkImageScanlineIterator.h"
+#include "itkReductionAccumulators.h"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageReduction
+ * \brief Passes the lines of a region of images to a function or to an
+ * accumulator of the Reduction namespace.
+ *
+ * The pixels of a line of an Image are passed directly from its buffer. The
+ * pixels of a line of other images, for instance image adaptors, are first
+ * copied to a buffer.
+ *
+ * \sa itkReductionAccumulators.h ImageReductionPartials
+ * \ingroup ITKCommon
+ */
+struct ImageReduction
+{
+  /** Call function(lineIndex, lineLength, lines...) for each line of the
+   * region along the first dimension, where lineIndex is the index of the
+   * first pixel of the line and lines point to the pixels of the line in each
+   * image. */
+  template <typename TFunction, typename TImage, typename... TImages>
+  static void
+  ForEachLine(const typename TImage::RegionType & region,
+              TFunction &&                        function,
+              const TImage &                      image,
+              const TImages &... images)
+  {
+    if (region.GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+    const SizeValueType lineLength = region.GetSize(0);
+
+    typename TImage::RegionType lineStartRegion = region;
+    lineStartRegion.SetSize(0, 1);
+
+    LineReader<TImage>                 lineReader(image, region);
+    std::tuple<LineReader<TImages>...> lineReaders(LineReader<TImages>(images, region)...);
+    for (const auto & index : ImageRegionIndexRange<TImage::ImageDimension>(lineStartRegion))
+    {
+      std::apply(
+        [&](auto &... readers) { function(index, lineLength, lineReader.Read(index), readers.Read(index)...); },
+        lineReaders);
+    }
+  }
+
+  /** Add the pixels of the region of the image to the accumulator. */
+  template <typename TImage, typename TAccumulator>
+  static void
+  Accumulate(const TImage & image, const typename TImage::RegionType & region, TAccumulator & accumulator)
+  {
+    ForEachLine(
+      region,
+      [&accumulator](const auto &, const SizeValueType lineLength, const auto * line) {
+        accumulator.AddPixels(line, lineLength);
+      },
+      image);
+  }
+
+private:
+  /** Reads the lines of a region of an image, in the order of
+   * ImageRegionIndexRange. */
+  template <typename TImage, bool VIsImage = ImageScanlineBatch::IsSupported<TImage>>
+  class LineReader
+  {
+  public:
+    using PixelType = typename TImage::PixelType;
+
+    LineReader(const TImage & image, const typename TImage::RegionType &)
+      : m_Image(image)
+      , m_Buffer(image.GetBufferPointer())
+    {}
+
+    const PixelType *
+    Read(const typename TImage::IndexType & index)
+    {
+      return m_Buffer + m_Image.ComputeOffset(index);
+    }
+
+  private:
+    const TImage &          m_Image;
+    const PixelType * const m_Buffer;
+  };
+
+  /** Copies the pixels of each line to a buffer, for the images whose pixels
+   * are not the elements of a buffer. */
+  template <typename TImage>
+  class LineReader<TImage, false>
+  {
+  public:
+    using PixelType = typename TImage::PixelType;
+
+    LineReader(const TImage & image, const typename TImage::RegionType & region)
+      : m_Iterator(&image, region)
+      , m_Line(region.GetSize(0))
+    {}
+
+    const PixelType *
+    Read(const typename TImage::IndexType &)
+    {
+      for (auto & pixel : m_Line)
+      {
+        pixel = m_Iterator.Get();
+        ++m_Iterator;
+      }
+      m_Iterator.NextLine();
+      return m_Line.data();
+    }
+
+  private:
+    ImageScanlineConstIterator<TImage> m_Iterator;
+    std::vector<PixelType>             m_Line;
+  };
+};
+
+
+/** \class ImageReductionPartials
+ * \brief Collects the partial reductions of the regions of an image that the
+ * threads compute, and merges them in an order that does not depend on the
+ * threads.
+ *
+ * Add() may be called concurrently by the threads. MergePiece() sorts the
+ * partial reductions by the index of their regions, the last dimension first,
+ * and merges them pairwise in a tree, so that a floating point reduction
+ * gives the same result when the image is split in the same regions. A
+ * streaming filter calls it at the end of each piece, so that only the
+ * partial reductions of one piece are kept at a time, and the result of the
+ * piece is merged after those of the previous pieces. MergeInto() merges the
+ * last piece and returns the result of all the pieces.
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TPartial, unsigned int VDimension>
+class ImageReductionPartials
+{
+public:
+  using PartialType = TPartial;
+  using RegionType = ImageRegion<VDimension>;
+
+  /** Add the partial reduction of the region. */
+  void
+  Add(const RegionType & region, TPartial partial)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    m_Partials.emplace_back(region.GetIndex(), std::move(partial));
+  }
+
+  /** Merge the partial reductions added since the previous piece, with
+   * mergeFunction(partial, otherPartial), into the result of the previous
+   * pieces, and remove them. */
+  template <typename TMergeFunction>
+  void
+  MergePiece(TMergeFunction && mergeFunction)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+
+    std::sort(m_Partials.begin(), m_Partials.end(), [](const auto & a, const auto & b) {
+      return std::lexicographical_compare(a.first.rbegin(), a.first.rend(), b.first.rbegin(), b.first.rend());
+    });
+
+    const size_t numberOfPartials = m_Partials.size();
+    for (size_t step = 1; step < numberOfPartials; step *= 2)
+    {
+      for (size_t i = 0; i + step < numberOfPartials; i += 2 * step)
+      {
+        mergeFunction(m_Partials[i].second, m_Partials[i + step].second);
+      }
+    }
+    if (numberOfPartials > 0)
+    {
+      if (m_PiecesResult)
+      {
+        mergeFunction(*m_PiecesResult, m_Partials.front().second);
+      }
+      else
+      {
+        m_PiecesResult.emplace(std::move(m_Partials.front().second));
+      }
+    }
+    m_Partials.clear();
+  }
+
+  /** Merge the partial reductions of the pieces into the result, with
+   * mergeFunction(partial, otherPartial), and remove them. */
+  template <typename TMergeFunction>
+  void
+  MergeInto(TPartial & result, TMergeFunction && mergeFunction)
+  {
+    MergePiece(mergeFunction);
+
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_PiecesResult)
+    {
+      mergeFunction(result, *m_PiecesResult);
+      m_PiecesResult.reset();
+    }
+  }
+
+  /** Merge the partial reductions of the piece with their Merge member
+   * function. */
+  void
+  MergePiece()
+  {
+    MergePiece([](TPartial & partial, const TPartial & otherPartial) { partial.Merge(otherPartial); });
+  }
+
+  /** Merge the partial reductions of the pieces into the result with their
+   * Merge member function, and remove them. */
+  void
+  MergeInto(TPartial & result)
+  {
+    MergeInto(result, [](TPartial & partial, const TPartial & otherPartial) { partial.Merge(otherPartial); });
+  }
+
+  void
+  Clear()
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    m_Partials.clear();
+    m_PiecesResult.reset();
+  }
+
+private:
+  std::vector<std::pair<Index<VDimension>, TPartial>> m_Partials{};
+  std::optional<TPartial>                             m_PiecesResult{};
+  std::mutex                                          m_Mutex{};
+};
+} // end namespace itk
+
+#endif
@@ -280,6 +280,7 @@ ImageSource<TOutputImage>::ThreaderCallback(void * arg)
 
   if (workUnitID < total)
   {
+    const PipelineProfiler::ScopedInterval profilerInterval("WorkUnit", str->Filter->GetNameOfClass(), str->Filter);
     str->Filter->ThreadedGenerateData(splitRegion, workUnitID);
   }
   // else don't use this thread. Threads were not split conveniently.
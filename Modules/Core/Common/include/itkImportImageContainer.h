@@ -18,8 +18,10 @@
 #ifndef itkImportImageContainer_h
 #define itkImportImageContainer_h
 
+#include "itkImageBufferAllocationPolicy.h"
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkPipelineProfiler.h"
 #include <utility>
 
 namespace itk
@@ -34,6 +36,9 @@ namespace itk
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
+ * The buffers that the container allocates itself are allocated according
+ * to its ImageBufferAllocationPolicy.
+ *
  * \tparam TElement The element type stored in the container.
  *
  * \ingroup ImageObjects
@@ -151,6 +156,13 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get the policy with which the container allocates the buffers that
+   * it manages. It applies to the buffers allocated from then on, and its
+   * default is ImageBufferAllocationPolicy::GetGlobalDefault().
+   * \sa ImageBufferAllocationPolicy */
+  itkSetMacro(AllocationPolicy, ImageBufferAllocationPolicy);
+  itkGetConstReferenceMacro(AllocationPolicy, ImageBufferAllocationPolicy);
+
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -163,7 +175,8 @@ protected:
 
   /**
    * Allocates elements of the array.  If UseValueInitialization is true, then
-   * POD types will be zero-initialized.
+   * POD types will be zero-initialized. The array is allocated according to
+   * the allocation policy.
    */
   virtual TElement *
   AllocateElements(ElementIdentifier size, bool UseValueInitialization = false) const;
@@ -198,10 +211,31 @@ protected:
   }
 
 private:
+  /** How a managed buffer was allocated: with new[] if its alignment is 0,
+   * or by the allocation policy otherwise. */
+  struct BufferAllocation
+  {
+    size_t Alignment{ 0 };
+    bool   FromPool{ false };
+  };
+
+  /** Return how the buffer returned by AllocateElements() was allocated, and
+   * forget the allocation recorded by AllocateElements(). */
+  BufferAllocation
+  TakeBufferAllocation(const TElement * buffer) const;
+
   TElement *         m_ImportPointer{};
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  ImageBufferAllocationPolicy m_AllocationPolicy{ ImageBufferAllocationPolicy::GetGlobalDefault() };
+
+  BufferAllocation m_BufferAllocation{};
+
+  // Last buffer allocated by the policy in AllocateElements(), and how.
+  mutable const TElement * m_PolicyBuffer{};
+  mutable BufferAllocation m_PolicyBufferAllocation{};
 };
 } // end namespace itk
 
@@ -29,6 +29,8 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <limits>
+#include <memory> // For uninitialized_value_construct and destroy_n.
 
 namespace itk
 {
@@ -60,6 +62,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocation = this->TakeBufferAllocation(temp);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -74,6 +77,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   else
   {
     m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    m_BufferAllocation = this->TakeBufferAllocation(m_ImportPointer);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -100,6 +104,7 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_BufferAllocation = this->TakeBufferAllocation(temp);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -157,20 +162,60 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
 {
   TElement * data;
 
-  try
+  if (m_AllocationPolicy.IsDefault())
   {
-    if (UseValueInitialization)
+    try
     {
-      data = new TElement[size]();
+      if (UseValueInitialization)
+      {
+        data = new TElement[size]();
+      }
+      else
+      {
+        data = new TElement[size];
+      }
     }
-    else
+    catch (...)
     {
-      data = new TElement[size];
+      data = nullptr;
     }
   }
-  catch (...)
+  else
   {
+    const size_t alignment =
+      m_AllocationPolicy.GetBufferAlignment(static_cast<size_t>(size) * sizeof(TElement), alignof(TElement));
+    const bool fromPool = m_AllocationPolicy.UsePool;
     data = nullptr;
+    if (static_cast<size_t>(size) <= std::numeric_limits<size_t>::max() / sizeof(TElement))
+    {
+      data = static_cast<TElement *>(m_AllocationPolicy.AllocateBuffer(size * sizeof(TElement), alignment));
+    }
+    if (data)
+    {
+      try
+      {
+        // The pages are first touched where the elements are constructed.
+        if (UseValueInitialization || m_AllocationPolicy.UseParallelFirstTouch)
+        {
+          m_AllocationPolicy.ParallelizeBuffer(size, sizeof(TElement), [data](size_t begin, size_t end) {
+            std::uninitialized_value_construct(data + begin, data + end);
+          });
+        }
+        else
+        {
+          std::uninitialized_default_construct_n(data, size);
+        }
+      }
+      catch (...)
+      {
+        ImageBufferAllocationPolicy::DeallocateBuffer(data, alignment, fromPool);
+        throw;
+      }
+      // Recorded here rather than from the policy after the allocation, since
+      // an override of AllocateElements() may allocate the buffer otherwise.
+      m_PolicyBuffer = data;
+      m_PolicyBufferAllocation = { alignment, fromPool };
+    }
   }
   if (!data)
   {
@@ -178,6 +223,8 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
     // of memory.  Do not use the exception macro.
     throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
   }
+  PipelineProfiler::RecordValue(
+    "Allocation", this->GetNameOfClass(), this, static_cast<int64_t>(size * sizeof(TElement)));
   return data;
 }
 
@@ -188,13 +235,35 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_BufferAllocation.Alignment == 0)
+    {
+      delete[] m_ImportPointer;
+    }
+    else if (m_ImportPointer)
+    {
+      std::destroy_n(m_ImportPointer, m_Capacity);
+      ImageBufferAllocationPolicy::DeallocateBuffer(
+        m_ImportPointer, m_BufferAllocation.Alignment, m_BufferAllocation.FromPool);
+    }
   }
   m_ImportPointer = nullptr;
+  m_BufferAllocation = {};
   m_Capacity = 0;
   m_Size = 0;
 }
 
+template <typename TElementIdentifier, typename TElement>
+auto
+ImportImageContainer<TElementIdentifier, TElement>::TakeBufferAllocation(const TElement * buffer) const
+  -> BufferAllocation
+{
+  // A buffer that the policy did not allocate was allocated with new[].
+  const BufferAllocation allocation = buffer == m_PolicyBuffer ? m_PolicyBufferAllocation : BufferAllocation{};
+  m_PolicyBuffer = nullptr;
+  m_PolicyBufferAllocation = {};
+  return allocation;
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os, Indent indent) const
@@ -205,6 +274,7 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  os << indent << "AllocationPolicy: " << m_AllocationPolicy << std::endl;
 }
 } // end namespace itk
 
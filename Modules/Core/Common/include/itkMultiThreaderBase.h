@@ -35,6 +35,7 @@
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
 #include "itkSingletonMacro.h"
+#include "itkPipelineProfiler.h"
 #include <atomic>
 #include <functional>
 #include <thread>
@@ -342,11 +343,13 @@ ITK_GCC_PRAGMA_DIAG_POP()
   ITK_TEMPLATE_EXPORT void
   ParallelizeImageRegion(const ImageRegion<VDimension> & requestedRegion, TFunction funcP, ProcessObject * filter)
   {
+    const char * const workUnitName = GetWorkUnitName(filter);
     this->ParallelizeImageRegion(
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+      [&funcP, workUnitName, filter](const IndexValueType index[], const SizeValueType size[]) {
+        const PipelineProfiler::ScopedInterval profilerInterval("WorkUnit", workUnitName, filter);
         ImageRegion<VDimension> region;
         for (unsigned int d = 0; d < VDimension; ++d)
         {
@@ -390,11 +393,14 @@ ITK_GCC_PRAGMA_DIAG_POP()
         }
       }
 
+      const char * const workUnitName = GetWorkUnitName(filter);
       this->ParallelizeImageRegion(
         SplitDimension,
         splitIndex.m_InternalArray,
         splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
+        [restrictedDirection, &requestedRegion, &funcP, workUnitName, filter](const IndexValueType index[],
+                                                                              const SizeValueType  size[]) {
+          const PipelineProfiler::ScopedInterval profilerInterval("WorkUnit", workUnitName, filter);
           ImageRegion<VDimension> restrictedRequestedRegion;
           restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
           restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
@@ -428,6 +434,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Name of the work units of the filter in the events of the
+   * PipelineProfiler. */
+  static const char *
+  GetWorkUnitName(const ProcessObject * filter);
+
   struct ArrayCallback
   {
     ArrayThreadingFunctorType functor;
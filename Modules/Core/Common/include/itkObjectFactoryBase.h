@@ -81,6 +81,15 @@ public:
   static LightObject::Pointer
   CreateInstance(const char * itkclassname);
 
+  /** Create and return an instance of the named itk object, overridden by
+   * the class named overrideWithName. The loaded factories are asked in the
+   * same order as by CreateInstance, with CreateObject(itkclassname,
+   * overrideWithName), and nullptr is returned when none of them has an
+   * enabled override by that class. Unlike the object returned by
+   * CreateInstance, the object has a reference count of 1. */
+  static LightObject::Pointer
+  CreateInstance(const char * itkclassname, const char * overrideWithName);
+
   /** Create and return all possible instances of the named itk object.
    * Each loaded ObjectFactoryBase will be asked in the order
    * the factory was in the ITK_AUTOLOAD_PATH.  All created objects
@@ -242,10 +251,23 @@ protected:
 
   /** This method is provided by sub-classes of ObjectFactoryBase.
    * It should create the named itk object or return 0 if that object
-   * is not supported by the factory implementation. */
+   * is not supported by the factory implementation. The default
+   * implementation creates the object of the first enabled override
+   * registered with RegisterOverride(), which it caches by class name until
+   * the overrides of the factory change. */
   virtual LightObject::Pointer
   CreateObject(const char * itkclassname);
 
+  /** Create the named itk object with the override by the class named
+   * overrideWithName, or return nullptr if this factory does not have such
+   * an enabled override. Called by CreateInstance(itkclassname,
+   * overrideWithName). The default implementation creates the object of the
+   * enabled override registered with RegisterOverride(). A factory which
+   * overrides CreateObject(itkclassname) to create objects that are not
+   * registered should override this method as well. */
+  virtual LightObject::Pointer
+  CreateObject(const char * itkclassname, const char * overrideWithName);
+
   /** This method creates all the objects with the class override of
    * itkclass name, which are provide by this object
    */
@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineProfiler_h
+#define itkPipelineProfiler_h
+
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+#include "ITKCommonExport.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class PipelineProfiler
+ * \brief Process-wide recorder of the execution of the pipelines, which
+ * exports it as a trace.
+ *
+ * When the profiler is enabled, it records
+ *   - the time of the GenerateData() of each filter that ProcessObject
+ *     executes, in the category "GenerateData",
+ *   - the time of each streamed piece of a StreamingProcessObject or of a
+ *     StreamingImageFilter, in the category "StreamedGenerateData", and their
+ *     number of pieces, in the category "StreamDivisions",
+ *   - the time of each work unit of MultiThreaderBase::ParallelizeImageRegion(),
+ *     MultiThreaderBase::ParallelizeArray() and of the threaded
+ *     ThreadedGenerateData() of ImageSource, in the category "WorkUnit", which
+ *     exposes the imbalance between the work units,
+ *   - the number of bytes of each buffer that an ImportImageContainer
+ *     allocates, in the category "Allocation".
+ *
+ * The events are recorded by each thread in a ring buffer of its own, without
+ * locks: when a ring buffer is full, the oldest events of the thread are
+ * overwritten. The ring buffer of a thread that exits is reused by the next
+ * thread that records an event, so that the profiler holds no more ring
+ * buffers than threads recording events at the same time.
+ * WriteChromeTrace() exports the events in the Trace Event format of Chrome,
+ * which chrome://tracing and https://ui.perfetto.dev display as a timeline of
+ * the threads, where the work units of a filter are nested within its
+ * GenerateData().
+ *
+ * The profiler is disabled by default, and then costs a test per recorded
+ * event. It is enabled by SetEnabled(), or when the environment variable
+ * ITK_PIPELINE_PROFILE names a file, to which the trace is then written at
+ * exit, so that a pipeline may be profiled without recompiling it.
+ *
+ * The events should be retrieved or exported when no pipeline executes.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineProfiler
+{
+public:
+  /** Time in nanoseconds since the creation of the profiler. */
+  using TimeType = int64_t;
+
+  /** A recorded event: an interval of time, or a value at a time. The name,
+   * usually the name of the class of the object, and the category must be
+   * string literals. */
+  struct Event
+  {
+    const char * Category{ nullptr };
+    const char * Name{ nullptr };
+    const void * Object{ nullptr };
+    TimeType     StartTime{ 0 };
+    TimeType     Duration{ 0 };
+    int64_t      Value{ 0 };
+    bool         IsInterval{ true };
+    /** Index of the ring buffer of the thread which recorded the event, in
+     * the order in which the buffers were created. The buffer of a thread
+     * that exits is reused by the next thread that records an event, so the
+     * threads that do not overlap in time may share an index. */
+    unsigned int ThreadIndex{ 0 };
+  };
+
+  /** Records the interval of time of its lifetime, when the profiler is
+   * enabled. */
+  class ScopedInterval
+  {
+  public:
+    ScopedInterval(const char * category, const char * name, const void * object = nullptr)
+      : m_Category(category)
+      , m_Name(name)
+      , m_Object(object)
+      , m_StartTime(PipelineProfiler::GetEnabled() ? PipelineProfiler::GetTime() : -1)
+    {}
+
+    ~ScopedInterval()
+    {
+      if (m_StartTime >= 0)
+      {
+        PipelineProfiler::RecordInterval(m_Category, m_Name, m_Object, m_StartTime, PipelineProfiler::GetTime());
+      }
+    }
+
+    ScopedInterval(const ScopedInterval &) = delete;
+    ScopedInterval &
+    operator=(const ScopedInterval &) = delete;
+
+  private:
+    const char * const m_Category;
+    const char * const m_Name;
+    const void * const m_Object;
+    const TimeType     m_StartTime;
+  };
+
+  /** Set/Get whether the profiler records events. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** Set/Get the number of events of the ring buffer of a thread, 16384 by
+   * default. It applies to the ring buffers created from now on. */
+  static void
+  SetThreadBufferCapacity(size_t numberOfEvents);
+  static size_t
+  GetThreadBufferCapacity();
+
+  static TimeType
+  GetTime();
+
+  /** Record an interval of time, or a value, in the ring buffer of the
+   * calling thread, if the profiler is enabled. */
+  static void
+  RecordInterval(const char * category, const char * name, const void * object, TimeType startTime, TimeType endTime);
+  static void
+  RecordValue(const char * category, const char * name, const void * object, int64_t value);
+
+  /** The events in the ring buffers, in the order of their start time. */
+  static std::vector<Event>
+  GetEvents();
+
+  /** Remove the events from the ring buffers. */
+  static void
+  Clear();
+
+  /** Write the events in the JSON Trace Event format of Chrome. */
+  static void
+  WriteChromeTrace(std::ostream & os);
+  static void
+  WriteChromeTrace(const std::string & fileName);
+
+private:
+  struct ProfilerGlobals;
+
+  itkGetGlobalDeclarationMacro(ProfilerGlobals, ProfilerGlobals);
+
+  static ProfilerGlobals * m_ProfilerGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -122,7 +122,9 @@ class MultiThreaderBase;
  * pipeline update.  For a ProcessObject, the ReleaseDataFlag defaults
  * to false and the ReleaseDataBeforeUpdateFlag defaults to true.
  * Some subclasses of ProcessObject, for example ImageSource, use a
- * default setting of false for the ReleaseDataBeforeUpdateFlag.
+ * default setting of false for the ReleaseDataBeforeUpdateFlag. The image
+ * buffers released by either flag may be recycled by the next update
+ * through the ImageBufferPool (see ImageBufferAllocationPolicy::UsePool).
  *
  * Subclasses of ProcessObject may override 4 of the methods of this class
  * to control how a given filter may interact with the pipeline (dataflow).
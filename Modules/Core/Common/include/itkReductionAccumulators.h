@@ -0,0 +1,463 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkReductionAccumulators_h
+#define itkReductionAccumulators_h
+
+#include "itkCompensatedSummation.h"
+#include "itkMacro.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace itk
+{
+/** \file itkReductionAccumulators.h
+ * \brief Accumulators of reductions of the pixels of images.
+ *
+ * An accumulator of the Reduction namespace has the member functions
+     \code
+     void AddPixels(const PixelType * pixels, SizeValueType numberOfPixels);
+     void Merge(const Self & other);
+     \endcode
+ * AddPixels() adds an array of pixels, typically a line of an image, to the
+ * reduction, and Merge() adds the pixels of another accumulator, typically
+ * the partial reduction of another thread. The accumulators are composed with
+ * CompositeAccumulator, so that several reductions are computed in a single
+ * pass over the pixels. ImageReduction passes the lines of a region of an
+ * image to an accumulator.
+ *
+ * \sa ImageReduction
+ * \ingroup ITKCommon
+ */
+namespace Reduction
+{
+/** The number of independent partial results that ReduceArray() computes
+ * within an array, which the compiler may keep in the lanes of SIMD
+ * registers. */
+constexpr unsigned int NumberOfLanes = 8;
+
+/** Reduce an array of pixels to a value. The value is the combination of
+ * NumberOfLanes partial values, computed from interleaved elements of the
+ * array, starting from the initial value. */
+template <typename TValue, typename TPixel, typename TOperation, typename TCombination>
+TValue
+ReduceArray(const TPixel *       pixels,
+            const SizeValueType  numberOfPixels,
+            const TValue &       initialValue,
+            const TOperation &   operation,
+            const TCombination & combination)
+{
+  if (numberOfPixels < NumberOfLanes)
+  {
+    TValue value = initialValue;
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      value = operation(value, pixels[i]);
+    }
+    return value;
+  }
+
+  TValue lanes[NumberOfLanes];
+  std::fill_n(lanes, NumberOfLanes, initialValue);
+
+  SizeValueType i = 0;
+  for (; i + NumberOfLanes <= numberOfPixels; i += NumberOfLanes)
+  {
+    for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+    {
+      lanes[lane] = operation(lanes[lane], pixels[i + lane]);
+    }
+  }
+  for (unsigned int lane = 0; i < numberOfPixels; ++i, ++lane)
+  {
+    lanes[lane] = operation(lanes[lane], pixels[i]);
+  }
+
+  for (unsigned int width = NumberOfLanes / 2; width > 0; width /= 2)
+  {
+    for (unsigned int lane = 0; lane < width; ++lane)
+    {
+      lanes[lane] = combination(lanes[lane], lanes[lane + width]);
+    }
+  }
+  return lanes[0];
+}
+
+
+/** \class MinimumAccumulator
+ * \brief Accumulates the minimum of the pixels.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel>
+class MinimumAccumulator
+{
+public:
+  using PixelType = TPixel;
+
+  void
+  AddPixels(const TPixel * pixels, const SizeValueType numberOfPixels)
+  {
+    const auto minimum = [](const TPixel & a, const TPixel & b) { return std::min(a, b); };
+    m_Minimum = ReduceArray(pixels, numberOfPixels, m_Minimum, minimum, minimum);
+  }
+
+  void
+  Merge(const MinimumAccumulator & other)
+  {
+    m_Minimum = std::min(m_Minimum, other.m_Minimum);
+  }
+
+  /** The minimum of the pixels, or NumericTraits::max() if there are none. */
+  const TPixel &
+  GetMinimum() const
+  {
+    return m_Minimum;
+  }
+
+private:
+  TPixel m_Minimum{ NumericTraits<TPixel>::max() };
+};
+
+
+/** \class MaximumAccumulator
+ * \brief Accumulates the maximum of the pixels.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel>
+class MaximumAccumulator
+{
+public:
+  using PixelType = TPixel;
+
+  void
+  AddPixels(const TPixel * pixels, const SizeValueType numberOfPixels)
+  {
+    const auto maximum = [](const TPixel & a, const TPixel & b) { return std::max(a, b); };
+    m_Maximum = ReduceArray(pixels, numberOfPixels, m_Maximum, maximum, maximum);
+  }
+
+  void
+  Merge(const MaximumAccumulator & other)
+  {
+    m_Maximum = std::max(m_Maximum, other.m_Maximum);
+  }
+
+  /** The maximum of the pixels, or NumericTraits::NonpositiveMin() if there
+   * are none. */
+  const TPixel &
+  GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+private:
+  TPixel m_Maximum{ NumericTraits<TPixel>::NonpositiveMin() };
+};
+
+
+/** \class SumAccumulator
+ * \brief Accumulates the sum of the pixels, as TSum values.
+ *
+ * The sums of the arrays of pixels are added with a CompensatedSummation.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, typename TSum = typename NumericTraits<TPixel>::RealType>
+class SumAccumulator
+{
+public:
+  using PixelType = TPixel;
+  using SumType = TSum;
+
+  void
+  AddPixels(const TPixel * pixels, const SizeValueType numberOfPixels)
+  {
+    m_Sum += ReduceArray(
+      pixels,
+      numberOfPixels,
+      TSum{},
+      [](const TSum & sum, const TPixel & pixel) { return sum + static_cast<TSum>(pixel); },
+      [](const TSum & a, const TSum & b) { return a + b; });
+  }
+
+  void
+  Merge(const SumAccumulator & other)
+  {
+    m_Sum += other.m_Sum;
+  }
+
+  TSum
+  GetSum() const
+  {
+    return m_Sum.GetSum();
+  }
+
+private:
+  CompensatedSummation<TSum> m_Sum{};
+};
+
+
+/** \class SumOfSquaresAccumulator
+ * \brief Accumulates the sum of the squares of the pixels, as TSum values.
+ *
+ * The sums of the arrays of pixels are added with a CompensatedSummation.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, typename TSum = typename NumericTraits<TPixel>::RealType>
+class SumOfSquaresAccumulator
+{
+public:
+  using PixelType = TPixel;
+  using SumType = TSum;
+
+  void
+  AddPixels(const TPixel * pixels, const SizeValueType numberOfPixels)
+  {
+    m_SumOfSquares += ReduceArray(
+      pixels,
+      numberOfPixels,
+      TSum{},
+      [](const TSum & sum, const TPixel & pixel) {
+        const auto value = static_cast<TSum>(pixel);
+        return sum + value * value;
+      },
+      [](const TSum & a, const TSum & b) { return a + b; });
+  }
+
+  void
+  Merge(const SumOfSquaresAccumulator & other)
+  {
+    m_SumOfSquares += other.m_SumOfSquares;
+  }
+
+  TSum
+  GetSumOfSquares() const
+  {
+    return m_SumOfSquares.GetSum();
+  }
+
+private:
+  CompensatedSummation<TSum> m_SumOfSquares{};
+};
+
+
+/** \class CountAccumulator
+ * \brief Accumulates the number of pixels.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel>
+class CountAccumulator
+{
+public:
+  using PixelType = TPixel;
+
+  void
+  AddPixels(const TPixel *, const SizeValueType numberOfPixels)
+  {
+    m_Count += numberOfPixels;
+  }
+
+  void
+  Merge(const CountAccumulator & other)
+  {
+    m_Count += other.m_Count;
+  }
+
+  SizeValueType
+  GetCount() const
+  {
+    return m_Count;
+  }
+
+private:
+  SizeValueType m_Count{};
+};
+
+
+/** \class HistogramAccumulator
+ * \brief Accumulates the histogram of the pixels, in bins of equal width
+ * between a lower and an upper bound.
+ *
+ * A pixel value v is counted in the bin floor((v - lowerBound) / width), and
+ * the upper bound in the last bin. The pixels outside of the bounds are not
+ * counted. Merge() expects the other accumulator to have the same bins.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel>
+class HistogramAccumulator
+{
+public:
+  using PixelType = TPixel;
+  using FrequencyContainerType = std::vector<SizeValueType>;
+
+  HistogramAccumulator() = default;
+
+  HistogramAccumulator(const SizeValueType numberOfBins, const double lowerBound, const double upperBound)
+    : m_Frequencies(numberOfBins)
+    , m_LowerBound(lowerBound)
+    , m_UpperBound(upperBound)
+    , m_Scale(static_cast<double>(numberOfBins) / (upperBound - lowerBound))
+  {
+    if (numberOfBins == 0 || !(lowerBound < upperBound))
+    {
+      itkGenericExceptionMacro("The histogram needs at least one bin and a lower bound less than the upper bound.");
+    }
+  }
+
+  void
+  AddPixels(const TPixel * pixels, const SizeValueType numberOfPixels)
+  {
+    const SizeValueType lastBin = m_Frequencies.size() - 1;
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      const auto value = static_cast<double>(pixels[i]);
+      if (value >= m_LowerBound && value <= m_UpperBound)
+      {
+        ++m_Frequencies[std::min(static_cast<SizeValueType>((value - m_LowerBound) * m_Scale), lastBin)];
+      }
+    }
+  }
+
+  void
+  Merge(const HistogramAccumulator & other)
+  {
+    for (SizeValueType bin = 0; bin < m_Frequencies.size(); ++bin)
+    {
+      m_Frequencies[bin] += other.m_Frequencies[bin];
+    }
+  }
+
+  const FrequencyContainerType &
+  GetFrequencies() const
+  {
+    return m_Frequencies;
+  }
+
+  double
+  GetLowerBound() const
+  {
+    return m_LowerBound;
+  }
+
+  double
+  GetUpperBound() const
+  {
+    return m_UpperBound;
+  }
+
+private:
+  FrequencyContainerType m_Frequencies{};
+  double                 m_LowerBound{};
+  double                 m_UpperBound{};
+  double                 m_Scale{};
+};
+
+
+/** \class CompositeAccumulator
+ * \brief Accumulates several reductions of the same pixels.
+ *
+ * The composite accumulator derives from its accumulators, so that their
+ * results are available as its member functions, for instance GetMinimum()
+ * and GetSum() of
+     \code
+     Reduction::CompositeAccumulator<Reduction::MinimumAccumulator<float>, Reduction::SumAccumulator<float>>
+     \endcode
+ * AddPixels() passes the pixels to the accumulators in blocks, which remain
+ * in the cache between the accumulators.
+ * \ingroup ITKCommon
+ */
+template <typename... TAccumulators>
+class CompositeAccumulator : public TAccumulators...
+{
+public:
+  /** The number of pixels passed to the accumulators at once. */
+  static constexpr SizeValueType BlockSize = 2048;
+
+  CompositeAccumulator() = default;
+
+  explicit CompositeAccumulator(const TAccumulators &... accumulators)
+    : TAccumulators(accumulators)...
+  {}
+
+  template <typename TPixel>
+  void
+  AddPixels(const TPixel * pixels, const SizeValueType numberOfPixels)
+  {
+    for (SizeValueType offset = 0; offset < numberOfPixels; offset += BlockSize)
+    {
+      const SizeValueType blockSize = std::min(BlockSize, numberOfPixels - offset);
+      (TAccumulators::AddPixels(pixels + offset, blockSize), ...);
+    }
+  }
+
+  void
+  Merge(const CompositeAccumulator & other)
+  {
+    (TAccumulators::Merge(static_cast<const TAccumulators &>(other)), ...);
+  }
+};
+
+
+/** \class StatisticsAccumulator
+ * \brief Accumulates the minimum, maximum, sum, sum of squares and number of
+ * the pixels, and computes their mean, variance and standard deviation.
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, typename TReal = typename NumericTraits<TPixel>::RealType>
+class StatisticsAccumulator
+  : public CompositeAccumulator<MinimumAccumulator<TPixel>,
+                                MaximumAccumulator<TPixel>,
+                                SumAccumulator<TPixel, TReal>,
+                                SumOfSquaresAccumulator<TPixel, TReal>,
+                                CountAccumulator<TPixel>>
+{
+public:
+  using RealType = TReal;
+
+  void
+  Merge(const StatisticsAccumulator & other)
+  {
+    StatisticsAccumulator::CompositeAccumulator::Merge(other);
+  }
+
+  TReal
+  GetMean() const
+  {
+    return this->GetSum() / static_cast<TReal>(this->GetCount());
+  }
+
+  /** The unbiased estimate of the variance. */
+  TReal
+  GetVariance() const
+  {
+    const TReal sum = this->GetSum();
+    const auto  count = static_cast<TReal>(this->GetCount());
+    return (this->GetSumOfSquares() - sum * sum / count) / (count - 1);
+  }
+
+  TReal
+  GetSigma() const
+  {
+    return std::sqrt(this->GetVariance());
+  }
+};
+} // end namespace Reduction
+} // end namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 #include "itkCommand.h"
 #include "itkImageAlgorithm.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include "itkPipelineProfiler.h"
 
 namespace itk
 {
@@ -160,6 +161,7 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
   {
     numDivisions = numDivisionsFromSplitter;
   }
+  PipelineProfiler::RecordValue("StreamDivisions", this->GetNameOfClass(), this, numDivisions);
 
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
@@ -168,6 +170,8 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
   unsigned int piece = 0;
   for (; piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
   {
+    const PipelineProfiler::ScopedInterval profilerInterval("StreamedGenerateData", this->GetNameOfClass(), this);
+
     InputImageRegionType streamRegion = outputRegion;
     m_RegionSplitter->GetSplit(piece, numDivisions, streamRegion);
 
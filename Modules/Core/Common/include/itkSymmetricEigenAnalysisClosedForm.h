@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysisClosedForm_h
+#define itkSymmetricEigenAnalysisClosedForm_h
+
+#include "itkSymmetricEigenAnalysis.h"
+#include "itkIntTypes.h"
+#include "itkMath.h"
+
+namespace itk
+{
+/** \class SymmetricEigenAnalysisClosedForm
+ * \brief Closed-form eigen analysis of 2x2 and 3x3 symmetric matrices.
+ *
+ * This class is a drop-in alternative to SymmetricEigenAnalysisFixedDimension
+ * for matrices of dimension 2 or 3, which are the pixels of Hessian and
+ * diffusion tensor images. Instead of iterating, the eigen values are
+ * computed with the quadratic formula in 2D, and with the trigonometric
+ * solution of the characteristic polynomial of the shifted and scaled matrix
+ * in 3D. The eigen vectors are then computed from the eigen values, starting
+ * from the most isolated eigen value, which is robust for repeated eigen
+ * values. The trigonometric solution loses accuracy when two eigen values of
+ * a 3x3 matrix are nearly repeated, so such matrices are analyzed with the
+ * iterative solver of SymmetricEigenAnalysisFixedDimension instead, and the
+ * results are as accurate as those of the iterative solver for any matrix.
+ *
+ * Besides the methods that analyze one matrix, the class provides methods
+ * that analyze an array of matrices. The eigen values of an array are
+ * computed by blocks of BlockSize matrices, which are stored one component
+ * after the other and processed with branch-free arithmetic, so that the
+ * compiler may process the matrices of a block in the lanes of SIMD
+ * registers.
+ *
+ * A is any type that provides the (row, col) operator and contains the
+ * symmetric matrix. Only the upper triangle of the matrix is accessed. The
+ * computations are done in double precision. The eigen values are ordered as
+ * set by SetOrderEigenValues() and SetOrderEigenMagnitudes(); without ordering
+ * they are returned in ascending order, as by
+ * SymmetricEigenAnalysisFixedDimension. Each row of the eigen vector matrix is
+ * an eigen vector.
+ *
+ * \sa SymmetricEigenAnalysisFixedDimension
+ * \ingroup ITKCommon
+ */
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix = TMatrix>
+class ITK_TEMPLATE_EXPORT SymmetricEigenAnalysisClosedForm
+{
+public:
+  static_assert(VDimension == 2 || VDimension == 3, "SymmetricEigenAnalysisClosedForm only supports 2D and 3D.");
+
+  using MatrixType = TMatrix;
+  using EigenMatrixType = TEigenMatrix;
+  using VectorType = TVector;
+
+  /** Number of matrices whose eigen values are computed together. */
+  static constexpr unsigned int BlockSize = 8;
+
+  /** Compute the eigen values of A. */
+  unsigned int
+  ComputeEigenValues(const TMatrix & A, TVector & EigenValues) const
+  {
+    this->ComputeEigenValues(&A, &EigenValues, 1);
+    return 1;
+  }
+
+  /** Compute the eigen values of the numberOfMatrices matrices of the
+   * matrices array. */
+  void
+  ComputeEigenValues(const TMatrix * matrices, TVector * eigenValues, SizeValueType numberOfMatrices) const;
+
+  /** Compute the eigen values and eigen vectors of A. */
+  unsigned int
+  ComputeEigenValuesAndVectors(const TMatrix & A, TVector & EigenValues, TEigenMatrix & EigenVectors) const
+  {
+    this->ComputeEigenValuesAndVectors(&A, &EigenValues, &EigenVectors, 1);
+    return 1;
+  }
+
+  /** Compute the eigen values and eigen vectors of the numberOfMatrices
+   * matrices of the matrices array. */
+  void
+  ComputeEigenValuesAndVectors(const TMatrix * matrices,
+                               TVector *       eigenValues,
+                               TEigenMatrix *  eigenVectors,
+                               SizeValueType   numberOfMatrices) const;
+
+  void
+  SetOrderEigenValues(const bool b)
+  {
+    m_OrderEigenValues = b ? EigenValueOrderEnum::OrderByValue : EigenValueOrderEnum::DoNotOrder;
+  }
+  bool
+  GetOrderEigenValues() const
+  {
+    return (m_OrderEigenValues == EigenValueOrderEnum::OrderByValue);
+  }
+  void
+  SetOrderEigenMagnitudes(const bool b)
+  {
+    m_OrderEigenValues = b ? EigenValueOrderEnum::OrderByMagnitude : EigenValueOrderEnum::DoNotOrder;
+  }
+  bool
+  GetOrderEigenMagnitudes() const
+  {
+    return (m_OrderEigenValues == EigenValueOrderEnum::OrderByMagnitude);
+  }
+  constexpr unsigned int
+  GetOrder() const
+  {
+    return VDimension;
+  }
+  constexpr unsigned int
+  GetDimension() const
+  {
+    return VDimension;
+  }
+
+private:
+  /** Components of the upper triangle of a matrix, row by row. */
+  static constexpr unsigned int NumberOfComponents = VDimension * (VDimension + 1) / 2;
+
+  /** Eigen values of a matrix given by its upper triangle, in ascending
+   * order. Returns false when the eigen values are nearly repeated, and were
+   * computed by the iterative solver. */
+  static bool
+  ComputeAscendingEigenValues(const double * upperTriangle, double * eigenValues);
+
+  /** Eigen values in ascending order and, unless eigenVectors is null, eigen
+   * vectors of a matrix given by its upper triangle, computed by the
+   * iterative solver. */
+  static void
+  ComputeIterativeEigenAnalysis(const double * upperTriangle, double * eigenValues, double (*eigenVectors)[VDimension]);
+
+  /** Eigen vectors of a matrix given by its upper triangle, for its eigen
+   * values in ascending order. */
+  static void
+  ComputeEigenVectors(const double * upperTriangle, const double * eigenValues, double eigenVectors[][VDimension]);
+
+  /** Order the ascending eigen values of a matrix as requested, and return the
+   * permutation applied to them. */
+  void
+  OrderEigenValues(double * eigenValues, unsigned int * permutation) const;
+
+  EigenValueOrderEnum m_OrderEigenValues{ EigenValueOrderEnum::OrderByValue };
+};
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+std::ostream &
+operator<<(std::ostream & os, const SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix> & s)
+{
+  os << "[ClassType: SymmetricEigenAnalysisClosedForm]" << std::endl;
+  os << "  Dimension : " << s.GetDimension() << std::endl;
+  os << "  Order : " << s.GetOrder() << std::endl;
+  os << "  OrderEigenValues: " << s.GetOrderEigenValues() << std::endl;
+  os << "  OrderEigenMagnitudes: " << s.GetOrderEigenMagnitudes() << std::endl;
+  return os;
+}
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSymmetricEigenAnalysisClosedForm.hxx"
+#endif
+
+#endif
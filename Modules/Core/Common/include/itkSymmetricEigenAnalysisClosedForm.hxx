@@ -0,0 +1,513 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysisClosedForm_hxx
+#define itkSymmetricEigenAnalysisClosedForm_hxx
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace itk
+{
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+void
+SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix>::ComputeEigenValues(
+  const TMatrix * matrices,
+  TVector *       eigenValues,
+  SizeValueType   numberOfMatrices) const
+{
+  using EigenValueType = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<TVector &>()[0])>>;
+
+  // The components and the eigen values of the matrices of a block are stored
+  // one after the other, the last block being padded with zero matrices.
+  double components[NumberOfComponents][BlockSize];
+  double values[VDimension][BlockSize];
+
+  for (SizeValueType first = 0; first < numberOfMatrices; first += BlockSize)
+  {
+    const auto count = static_cast<unsigned int>(std::min<SizeValueType>(BlockSize, numberOfMatrices - first));
+
+    for (unsigned int lane = 0; lane < BlockSize; ++lane)
+    {
+      unsigned int component = 0;
+      for (unsigned int row = 0; row < VDimension; ++row)
+      {
+        for (unsigned int col = row; col < VDimension; ++col)
+        {
+          components[component++][lane] = lane < count ? static_cast<double>(matrices[first + lane](row, col)) : 0.0;
+        }
+      }
+    }
+
+    for (unsigned int lane = 0; lane < BlockSize; ++lane)
+    {
+      double upperTriangle[NumberOfComponents];
+      for (unsigned int component = 0; component < NumberOfComponents; ++component)
+      {
+        upperTriangle[component] = components[component][lane];
+      }
+      double laneValues[VDimension];
+      ComputeAscendingEigenValues(upperTriangle, laneValues);
+
+      if (m_OrderEigenValues == EigenValueOrderEnum::OrderByMagnitude)
+      {
+        // Sorting network on the magnitudes, which keeps the ascending order
+        // of eigen values of equal magnitude.
+        const auto compareAndSwap = [&laneValues](unsigned int i, unsigned int j) {
+          const bool   swap = std::abs(laneValues[j]) < std::abs(laneValues[i]);
+          const double smaller = swap ? laneValues[j] : laneValues[i];
+          const double larger = swap ? laneValues[i] : laneValues[j];
+          laneValues[i] = smaller;
+          laneValues[j] = larger;
+        };
+        compareAndSwap(0, 1);
+        if constexpr (VDimension == 3)
+        {
+          compareAndSwap(1, 2);
+          compareAndSwap(0, 1);
+        }
+      }
+
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        values[i][lane] = laneValues[i];
+      }
+    }
+
+    for (unsigned int lane = 0; lane < count; ++lane)
+    {
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        eigenValues[first + lane][i] = static_cast<EigenValueType>(values[i][lane]);
+      }
+    }
+  }
+}
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+void
+SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix>::ComputeEigenValuesAndVectors(
+  const TMatrix * matrices,
+  TVector *       eigenValues,
+  TEigenMatrix *  eigenVectors,
+  SizeValueType   numberOfMatrices) const
+{
+  using EigenValueType = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<TVector &>()[0])>>;
+  using EigenVectorComponentType =
+    std::remove_cv_t<std::remove_reference_t<decltype(std::declval<TEigenMatrix &>()[0][0])>>;
+
+  for (SizeValueType n = 0; n < numberOfMatrices; ++n)
+  {
+    double       upperTriangle[NumberOfComponents];
+    unsigned int component = 0;
+    for (unsigned int row = 0; row < VDimension; ++row)
+    {
+      for (unsigned int col = row; col < VDimension; ++col)
+      {
+        upperTriangle[component++] = static_cast<double>(matrices[n](row, col));
+      }
+    }
+
+    double values[VDimension];
+    double vectors[VDimension][VDimension];
+    if (ComputeAscendingEigenValues(upperTriangle, values))
+    {
+      ComputeEigenVectors(upperTriangle, values, vectors);
+    }
+    else
+    {
+      ComputeIterativeEigenAnalysis(upperTriangle, values, vectors);
+    }
+
+    unsigned int permutation[VDimension];
+    this->OrderEigenValues(values, permutation);
+
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      eigenValues[n][i] = static_cast<EigenValueType>(values[i]);
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        eigenVectors[n][i][j] = static_cast<EigenVectorComponentType>(vectors[permutation[i]][j]);
+      }
+    }
+  }
+}
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+bool
+SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix>::ComputeAscendingEigenValues(
+  const double * upperTriangle,
+  double *       eigenValues)
+{
+  // Scale the matrix by its largest component, to avoid overflow and
+  // underflow in the squares below.
+  double norm = 0.0;
+  for (unsigned int component = 0; component < NumberOfComponents; ++component)
+  {
+    norm = std::max(norm, std::abs(upperTriangle[component]));
+  }
+  const double inverseNorm = norm > 0.0 ? 1.0 / norm : 0.0;
+
+  if constexpr (VDimension == 2)
+  {
+    const double a00 = upperTriangle[0] * inverseNorm;
+    const double a01 = upperTriangle[1] * inverseNorm;
+    const double a11 = upperTriangle[2] * inverseNorm;
+
+    const double mean = 0.5 * (a00 + a11);
+    const double halfDifference = 0.5 * (a00 - a11);
+    const double radius = std::sqrt(halfDifference * halfDifference + a01 * a01);
+
+    eigenValues[0] = (mean - radius) * norm;
+    eigenValues[1] = (mean + radius) * norm;
+    return true;
+  }
+  else
+  {
+    const double a00 = upperTriangle[0] * inverseNorm;
+    const double a01 = upperTriangle[1] * inverseNorm;
+    const double a02 = upperTriangle[2] * inverseNorm;
+    const double a11 = upperTriangle[3] * inverseNorm;
+    const double a12 = upperTriangle[4] * inverseNorm;
+    const double a22 = upperTriangle[5] * inverseNorm;
+
+    // The eigen values of A are shift + 2 * scale * cos(angle + 2 k pi / 3),
+    // where B = (A - shift I) / scale has unit norm and half determinant
+    // cos(3 angle).
+    const double shift = (a00 + a11 + a22) / 3.0;
+    const double b00 = a00 - shift;
+    const double b11 = a11 - shift;
+    const double b22 = a22 - shift;
+    const double offDiagonal = a01 * a01 + a02 * a02 + a12 * a12;
+    const double scale = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * offDiagonal) / 6.0);
+    const double inverseScale = scale > 0.0 ? 1.0 / scale : 0.0;
+
+    const double c00 = b00 * inverseScale;
+    const double c01 = a01 * inverseScale;
+    const double c02 = a02 * inverseScale;
+    const double c11 = b11 * inverseScale;
+    const double c12 = a12 * inverseScale;
+    const double c22 = b22 * inverseScale;
+    const double halfDeterminant =
+      0.5 * (c00 * (c11 * c22 - c12 * c12) - c01 * (c01 * c22 - c12 * c02) + c02 * (c01 * c12 - c11 * c02));
+
+    // When two eigen values are nearly repeated, the half determinant is close
+    // to -1 or 1, where the rounding error of the arc cosine grows as the
+    // inverse of the square root of the distance: 1e-6 bounds it to about a
+    // thousand times the machine precision.
+    if (1.0 - std::abs(halfDeterminant) < 1e-6)
+    {
+      ComputeIterativeEigenAnalysis(upperTriangle, eigenValues, nullptr);
+      return false;
+    }
+
+    const double angle = std::acos(std::clamp(halfDeterminant, -1.0, 1.0)) / 3.0;
+    const double largest = shift + 2.0 * scale * std::cos(angle);
+    const double smallest = shift + 2.0 * scale * std::cos(angle + 2.0 * Math::pi / 3.0);
+    const double middle = std::clamp(3.0 * shift - largest - smallest, smallest, largest);
+
+    eigenValues[0] = smallest * norm;
+    eigenValues[1] = middle * norm;
+    eigenValues[2] = largest * norm;
+    return true;
+  }
+}
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+void
+SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix>::ComputeIterativeEigenAnalysis(
+  const double * upperTriangle,
+  double *       eigenValues,
+  double (*eigenVectors)[VDimension])
+{
+  using IterativeMatrixType = Matrix<double, VDimension, VDimension>;
+  using IterativeVectorType = FixedArray<double, VDimension>;
+
+  IterativeMatrixType matrix;
+  unsigned int        component = 0;
+  for (unsigned int row = 0; row < VDimension; ++row)
+  {
+    for (unsigned int col = row; col < VDimension; ++col)
+    {
+      matrix(row, col) = upperTriangle[component];
+      matrix(col, row) = upperTriangle[component];
+      ++component;
+    }
+  }
+
+  const SymmetricEigenAnalysisFixedDimension<VDimension, IterativeMatrixType, IterativeVectorType, IterativeMatrixType>
+                      iterativeEigenSystem;
+  IterativeVectorType values;
+  if (eigenVectors)
+  {
+    IterativeMatrixType vectors;
+    iterativeEigenSystem.ComputeEigenValuesAndVectors(matrix, values, vectors);
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        eigenVectors[i][j] = vectors[i][j];
+      }
+    }
+  }
+  else
+  {
+    iterativeEigenSystem.ComputeEigenValues(matrix, values);
+  }
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    eigenValues[i] = values[i];
+  }
+}
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+void
+SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix>::ComputeEigenVectors(
+  const double * upperTriangle,
+  const double * eigenValues,
+  double         eigenVectors[][VDimension])
+{
+  double norm = 0.0;
+  for (unsigned int component = 0; component < NumberOfComponents; ++component)
+  {
+    norm = std::max(norm, std::abs(upperTriangle[component]));
+  }
+  const double inverseNorm = norm > 0.0 ? 1.0 / norm : 0.0;
+
+  if constexpr (VDimension == 2)
+  {
+    const double a00 = upperTriangle[0] * inverseNorm;
+    const double a01 = upperTriangle[1] * inverseNorm;
+    const double a11 = upperTriangle[2] * inverseNorm;
+    const double largest = eigenValues[1] * inverseNorm;
+
+    // The eigen vector of the largest eigen value is orthogonal to both rows
+    // of A - largest I; use the row of larger norm.
+    const double x0 = a01;
+    const double y0 = largest - a00;
+    const double x1 = largest - a11;
+    const double y1 = a01;
+    const double squaredNorm0 = x0 * x0 + y0 * y0;
+    const double squaredNorm1 = x1 * x1 + y1 * y1;
+    double       x = 1.0;
+    double       y = 0.0;
+    if (squaredNorm0 >= squaredNorm1 && squaredNorm0 > 0.0)
+    {
+      x = x0 / std::sqrt(squaredNorm0);
+      y = y0 / std::sqrt(squaredNorm0);
+    }
+    else if (squaredNorm1 > 0.0)
+    {
+      x = x1 / std::sqrt(squaredNorm1);
+      y = y1 / std::sqrt(squaredNorm1);
+    }
+    eigenVectors[0][0] = -y;
+    eigenVectors[0][1] = x;
+    eigenVectors[1][0] = x;
+    eigenVectors[1][1] = y;
+  }
+  else
+  {
+    const double a[3][3] = { { upperTriangle[0] * inverseNorm,
+                               upperTriangle[1] * inverseNorm,
+                               upperTriangle[2] * inverseNorm },
+                             { upperTriangle[1] * inverseNorm,
+                               upperTriangle[3] * inverseNorm,
+                               upperTriangle[4] * inverseNorm },
+                             { upperTriangle[2] * inverseNorm,
+                               upperTriangle[4] * inverseNorm,
+                               upperTriangle[5] * inverseNorm } };
+    const double values[3] = { eigenValues[0] * inverseNorm,
+                               eigenValues[1] * inverseNorm,
+                               eigenValues[2] * inverseNorm };
+
+    const auto cross = [](const double * u, const double * v, double * w) {
+      w[0] = u[1] * v[2] - u[2] * v[1];
+      w[1] = u[2] * v[0] - u[0] * v[2];
+      w[2] = u[0] * v[1] - u[1] * v[0];
+    };
+
+    // Eigen vector of an eigen value of multiplicity one: the largest cross
+    // product of two rows of A - value I.
+    const auto computeIsolatedEigenVector = [&a, &cross](double value, double * vector) {
+      const double rows[3][3] = { { a[0][0] - value, a[0][1], a[0][2] },
+                                  { a[1][0], a[1][1] - value, a[1][2] },
+                                  { a[2][0], a[2][1], a[2][2] - value } };
+      double       products[3][3];
+      cross(rows[0], rows[1], products[0]);
+      cross(rows[0], rows[2], products[1]);
+      cross(rows[1], rows[2], products[2]);
+      unsigned int largest = 0;
+      double       largestSquaredNorm = 0.0;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        const double squaredNorm =
+          products[i][0] * products[i][0] + products[i][1] * products[i][1] + products[i][2] * products[i][2];
+        if (squaredNorm > largestSquaredNorm)
+        {
+          largest = i;
+          largestSquaredNorm = squaredNorm;
+        }
+      }
+      if (largestSquaredNorm > 0.0)
+      {
+        const double inverseLength = 1.0 / std::sqrt(largestSquaredNorm);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          vector[i] = products[largest][i] * inverseLength;
+        }
+      }
+      else
+      {
+        // A is a multiple of the identity.
+        vector[0] = 1.0;
+        vector[1] = 0.0;
+        vector[2] = 0.0;
+      }
+    };
+
+    // Eigen vector of another eigen value, orthogonal to the given unit eigen
+    // vector: an eigen vector of the 2x2 restriction of A to the plane
+    // orthogonal to it.
+    const auto computeOrthogonalEigenVector = [&a, &cross](const double * w, double value, double * vector) {
+      double u[3];
+      if (std::abs(w[0]) > std::abs(w[1]))
+      {
+        const double inverseLength = 1.0 / std::sqrt(w[0] * w[0] + w[2] * w[2]);
+        u[0] = -w[2] * inverseLength;
+        u[1] = 0.0;
+        u[2] = w[0] * inverseLength;
+      }
+      else
+      {
+        const double inverseLength = 1.0 / std::sqrt(w[1] * w[1] + w[2] * w[2]);
+        u[0] = 0.0;
+        u[1] = w[2] * inverseLength;
+        u[2] = -w[1] * inverseLength;
+      }
+      double v[3];
+      cross(w, u, v);
+
+      double au[3];
+      double av[3];
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        au[i] = a[i][0] * u[0] + a[i][1] * u[1] + a[i][2] * u[2];
+        av[i] = a[i][0] * v[0] + a[i][1] * v[1] + a[i][2] * v[2];
+      }
+      double m00 = u[0] * au[0] + u[1] * au[1] + u[2] * au[2] - value;
+      double m01 = u[0] * av[0] + u[1] * av[1] + u[2] * av[2];
+      double m11 = v[0] * av[0] + v[1] * av[1] + v[2] * av[2] - value;
+
+      // The eigen vector is x u + y v, with (x, y) orthogonal to the row of
+      // larger norm of [m00 m01; m01 m11].
+      double x = 1.0;
+      double y = 0.0;
+      if (std::abs(m00) >= std::abs(m11))
+      {
+        if (std::max(std::abs(m00), std::abs(m01)) > 0.0)
+        {
+          if (std::abs(m00) >= std::abs(m01))
+          {
+            m01 /= m00;
+            m00 = 1.0 / std::sqrt(1.0 + m01 * m01);
+            m01 *= m00;
+          }
+          else
+          {
+            m00 /= m01;
+            m01 = 1.0 / std::sqrt(1.0 + m00 * m00);
+            m00 *= m01;
+          }
+          x = m01;
+          y = -m00;
+        }
+      }
+      else
+      {
+        if (std::max(std::abs(m11), std::abs(m01)) > 0.0)
+        {
+          if (std::abs(m11) >= std::abs(m01))
+          {
+            m01 /= m11;
+            m11 = 1.0 / std::sqrt(1.0 + m01 * m01);
+            m01 *= m11;
+          }
+          else
+          {
+            m11 /= m01;
+            m01 = 1.0 / std::sqrt(1.0 + m11 * m11);
+            m11 *= m01;
+          }
+          x = m11;
+          y = -m01;
+        }
+      }
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        vector[i] = x * u[i] + y * v[i];
+      }
+    };
+
+    // Start from the eigen value farthest from the middle one.
+    if (values[2] - values[1] >= values[1] - values[0])
+    {
+      computeIsolatedEigenVector(values[2], eigenVectors[2]);
+      computeOrthogonalEigenVector(eigenVectors[2], values[1], eigenVectors[1]);
+      cross(eigenVectors[1], eigenVectors[2], eigenVectors[0]);
+    }
+    else
+    {
+      computeIsolatedEigenVector(values[0], eigenVectors[0]);
+      computeOrthogonalEigenVector(eigenVectors[0], values[1], eigenVectors[1]);
+      cross(eigenVectors[0], eigenVectors[1], eigenVectors[2]);
+    }
+  }
+}
+
+template <unsigned int VDimension, typename TMatrix, typename TVector, typename TEigenMatrix>
+void
+SymmetricEigenAnalysisClosedForm<VDimension, TMatrix, TVector, TEigenMatrix>::OrderEigenValues(
+  double *       eigenValues,
+  unsigned int * permutation) const
+{
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    permutation[i] = i;
+  }
+  if (m_OrderEigenValues == EigenValueOrderEnum::OrderByMagnitude)
+  {
+    const auto compareAndSwap = [eigenValues, permutation](unsigned int i, unsigned int j) {
+      if (std::abs(eigenValues[j]) < std::abs(eigenValues[i]))
+      {
+        std::swap(eigenValues[i], eigenValues[j]);
+        std::swap(permutation[i], permutation[j]);
+      }
+    };
+    compareAndSwap(0, 1);
+    if constexpr (VDimension == 3)
+    {
+      compareAndSwap(1, 2);
+      compareAndSwap(0, 1);
+    }
+  }
+}
+} // end namespace itk
+
+#endif
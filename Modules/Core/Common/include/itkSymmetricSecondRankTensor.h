@@ -27,6 +27,7 @@
 #include "itkFixedArray.h"
 #include "itkMatrix.h"
 #include "itkSymmetricEigenAnalysis.h"
+#include "itkSymmetricEigenAnalysisClosedForm.h"
 
 namespace itk
 {
@@ -256,19 +256,29 @@ template <typename T, unsigned int VDimension>
 void
 SymmetricSecondRankTensor<T, VDimension>::ComputeEigenValues(EigenValuesArrayType & eigenValues) const
 {
-  SymmetricEigenAnalysisType symmetricEigenSystem;
+  if constexpr (Dimension == 2 || Dimension == 3)
+  {
+    // Closed-form solution, which reads the upper triangle of the tensor.
+    const SymmetricEigenAnalysisClosedForm<Dimension, Self, EigenValuesArrayType, EigenVectorsMatrixType>
+      closedFormEigenSystem;
+    closedFormEigenSystem.ComputeEigenValues(*this, eigenValues);
+  }
+  else
+  {
+    SymmetricEigenAnalysisType symmetricEigenSystem;
 
-  MatrixType tensorMatrix;
+    MatrixType tensorMatrix;
 
-  for (unsigned int row = 0; row < Dimension; ++row)
-  {
-    for (unsigned int col = 0; col < Dimension; ++col)
+    for (unsigned int row = 0; row < Dimension; ++row)
     {
-      tensorMatrix[row][col] = (*this)(row, col);
+      for (unsigned int col = 0; col < Dimension; ++col)
+      {
+        tensorMatrix[row][col] = (*this)(row, col);
+      }
     }
-  }
 
-  symmetricEigenSystem.ComputeEigenValues(tensorMatrix, eigenValues);
+    symmetricEigenSystem.ComputeEigenValues(tensorMatrix, eigenValues);
+  }
 }
 
 /**
@@ -280,19 +290,28 @@ void
 SymmetricSecondRankTensor<T, VDimension>::ComputeEigenAnalysis(EigenValuesArrayType &   eigenValues,
                                                                EigenVectorsMatrixType & eigenVectors) const
 {
-  SymmetricEigenAnalysisType symmetricEigenSystem;
+  if constexpr (Dimension == 2 || Dimension == 3)
+  {
+    const SymmetricEigenAnalysisClosedForm<Dimension, Self, EigenValuesArrayType, EigenVectorsMatrixType>
+      closedFormEigenSystem;
+    closedFormEigenSystem.ComputeEigenValuesAndVectors(*this, eigenValues, eigenVectors);
+  }
+  else
+  {
+    SymmetricEigenAnalysisType symmetricEigenSystem;
 
-  MatrixType tensorMatrix;
+    MatrixType tensorMatrix;
 
-  for (unsigned int row = 0; row < Dimension; ++row)
-  {
-    for (unsigned int col = 0; col < Dimension; ++col)
+    for (unsigned int row = 0; row < Dimension; ++row)
     {
-      tensorMatrix[row][col] = (*this)(row, col);
+      for (unsigned int col = 0; col < Dimension; ++col)
+      {
+        tensorMatrix[row][col] = (*this)(row, col);
+      }
     }
-  }
 
-  symmetricEigenSystem.ComputeEigenValuesAndVectors(tensorMatrix, eigenValues, eigenVectors);
+    symmetricEigenSystem.ComputeEigenValuesAndVectors(tensorMatrix, eigenValues, eigenVectors);
+  }
 }
 
 /**
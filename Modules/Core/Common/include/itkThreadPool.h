@@ -124,6 +124,11 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
   static void
   SetDoNotWaitForThreads(bool doNotWaitForThreads);
 
+  /** Whether the calling thread is one of the threads of the pool, that is
+   * whether it executes a job submitted with AddWork(). */
+  static bool
+  IsCurrentThreadInPool();
+
 protected:
   /** We need access to the mutex in AddWork, and the variable is only
    * visible in the .cxx file, so this method returns it. */
@@ -18,6 +18,7 @@
 #ifndef itkUnaryFunctorImageFilter_h
 #define itkUnaryFunctorImageFilter_h
 
+#include "itkBatchFunctor.h"
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
@@ -85,6 +85,28 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (ImageScanlineBatch::IsSupported<TInputImage, TOutputImage> &&
+                TInputImage::ImageDimension == TOutputImage::ImageDimension &&
+                Functor::HasUnaryBatchOperator<FunctorType, InputImagePixelType, OutputImagePixelType>::value)
+  {
+    // The lines of the region are contiguous in both buffers: pass them to
+    // the batch overload of the functor.
+    if (inputRegionForThread == outputRegionForThread)
+    {
+      ImageScanlineBatch::ForEachScanline(
+        outputRegionForThread,
+        [this, &progress](const SizeValueType               lineLength,
+                          OutputImagePixelType * const      outputLine,
+                          const InputImagePixelType * const inputLine) {
+          m_Functor(inputLine, outputLine, lineLength);
+          progress.Completed(lineLength);
+        },
+        *outputPtr,
+        *inputPtr);
+      return;
+    }
+  }
+
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocationPolicy.h"
+#include "itkImageBufferPool.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+#include "itkThreadPool.h"
+#include <algorithm>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+itkGetGlobalValueMacro(ImageBufferAllocationPolicy,
+                       ImageBufferAllocationPolicy,
+                       GlobalDefault,
+                       ImageBufferAllocationPolicy{});
+
+ImageBufferAllocationPolicy * ImageBufferAllocationPolicy::m_GlobalDefault;
+
+void
+ImageBufferAllocationPolicy::SetGlobalDefault(const ImageBufferAllocationPolicy & policy)
+{
+  itkInitGlobalsMacro(GlobalDefault);
+  *m_GlobalDefault = policy;
+}
+
+ImageBufferAllocationPolicy
+ImageBufferAllocationPolicy::GetGlobalDefault()
+{
+  return *ImageBufferAllocationPolicy::GetGlobalDefaultPointer();
+}
+
+size_t
+ImageBufferAllocationPolicy::GetBufferAlignment(size_t numberOfBytes, size_t elementAlignment) const
+{
+  if ((Alignment & (Alignment - 1)) != 0)
+  {
+    itkGenericExceptionMacro("The alignment of the image buffers, " << Alignment << ", is not a power of two.");
+  }
+  size_t alignment = std::max(Alignment, elementAlignment);
+  if (UseHugePages && numberOfBytes >= HugePageSize)
+  {
+    alignment = std::max(alignment, HugePageSize);
+  }
+  return alignment;
+}
+
+void *
+ImageBufferAllocationPolicy::AllocateBuffer(size_t numberOfBytes, size_t alignment) const
+{
+  void * buffer = UsePool ? ImageBufferPool::Acquire(numberOfBytes, alignment)
+                          : ::operator new(numberOfBytes, std::align_val_t{ alignment }, std::nothrow);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (buffer && UseHugePages && numberOfBytes >= HugePageSize)
+  {
+    // Only the huge pages that lie entirely in the buffer are advised. The
+    // advice is ignored when transparent huge pages are not available.
+    madvise(buffer, numberOfBytes / HugePageSize * HugePageSize, MADV_HUGEPAGE);
+  }
+#endif
+  return buffer;
+}
+
+void
+ImageBufferAllocationPolicy::DeallocateBuffer(void * buffer, size_t alignment, bool fromPool)
+{
+  // Only the buffers acquired from the pool take its lock.
+  if (!fromPool || !ImageBufferPool::Release(buffer, alignment))
+  {
+    ::operator delete(buffer, std::align_val_t{ alignment });
+  }
+}
+
+void
+ImageBufferAllocationPolicy::ParallelizeBuffer(size_t                                      size,
+                                               size_t                                      elementSize,
+                                               const std::function<void(size_t, size_t)> & function) const
+{
+  if (!UseParallelFirstTouch || size < 2 || size < MinimumParallelFirstTouchSize / std::max(elementSize, size_t{ 1 }) ||
+      ThreadPool::IsCurrentThreadInPool())
+  {
+    function(0, size);
+    return;
+  }
+
+  // The work units get contiguous parts of the buffer of about the same
+  // size, like the slabs into which ImageRegionSplitterSlowDimension splits
+  // the buffered region of an image.
+  const auto          multiThreader = MultiThreaderBase::New();
+  const SizeValueType numberOfParts =
+    std::min(static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()), static_cast<SizeValueType>(size));
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfParts,
+    [size, numberOfParts, &function](SizeValueType part) {
+      function(size * part / numberOfParts, size * (part + 1) / numberOfParts);
+    },
+    nullptr);
+}
+
+std::ostream &
+operator<<(std::ostream & out, const ImageBufferAllocationPolicy & policy)
+{
+  return out << "Alignment: " << policy.Alignment << ", UseHugePages: " << (policy.UseHugePages ? "true" : "false")
+             << ", UseParallelFirstTouch: " << (policy.UseParallelFirstTouch ? "true" : "false")
+             << ", UsePool: " << (policy.UsePool ? "true" : "false");
+}
+} // end namespace itk
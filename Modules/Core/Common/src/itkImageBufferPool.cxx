@@ -0,0 +1,223 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkSingleton.h"
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+namespace itk
+{
+struct ImageBufferPool::PoolGlobals
+{
+  // A buffer held by the pool.
+  struct HeldBuffer
+  {
+    void * Buffer;
+    size_t NumberOfBytes;
+    size_t Alignment;
+  };
+  using KeyType = std::pair<size_t, size_t>;
+  using LeastRecentlyReleasedListType = std::list<HeldBuffer>;
+
+  PoolGlobals() = default;
+  ~PoolGlobals() { this->Trim(0); }
+
+  // Deallocate the least recently released buffers until the pool holds at
+  // most maximumNumberOfBytes.
+  void
+  Trim(size_t maximumNumberOfBytes)
+  {
+    while (m_Statistics.NumberOfBytesHeld > maximumNumberOfBytes)
+    {
+      const HeldBuffer & held = m_LeastRecentlyReleased.back();
+      auto               range = m_HeldBuffers.equal_range({ held.NumberOfBytes, held.Alignment });
+      while (range.first->second->Buffer != held.Buffer)
+      {
+        ++range.first;
+      }
+      m_HeldBuffers.erase(range.first);
+      ::operator delete(held.Buffer, std::align_val_t{ held.Alignment });
+      m_Statistics.NumberOfBytesHeld -= held.NumberOfBytes;
+      --m_Statistics.NumberOfBuffersHeld;
+      ++m_Statistics.NumberOfTrimmedBuffers;
+      m_LeastRecentlyReleased.pop_back();
+    }
+  }
+
+  std::mutex m_Mutex{};
+  size_t     m_MaximumNumberOfBytes{ size_t{ 1 } << 30 };
+  Statistics m_Statistics{};
+
+  // The held buffers, most recently released first, and by size class and
+  // alignment.
+  LeastRecentlyReleasedListType                                   m_LeastRecentlyReleased{};
+  std::multimap<KeyType, LeastRecentlyReleasedListType::iterator> m_HeldBuffers{};
+
+  // Size class of the buffers acquired from the pool and not yet released.
+  std::unordered_map<void *, size_t> m_AcquiredBuffers{};
+};
+
+itkGetGlobalSimpleMacro(ImageBufferPool, ImageBufferPool::PoolGlobals, PoolGlobals);
+
+ImageBufferPool::PoolGlobals * ImageBufferPool::m_PoolGlobals;
+
+void
+ImageBufferPool::SetMaximumNumberOfBytes(size_t numberOfBytes)
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  m_PoolGlobals->m_MaximumNumberOfBytes = numberOfBytes;
+  m_PoolGlobals->Trim(numberOfBytes);
+}
+
+size_t
+ImageBufferPool::GetMaximumNumberOfBytes()
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  return m_PoolGlobals->m_MaximumNumberOfBytes;
+}
+
+size_t
+ImageBufferPool::GetSizeClass(size_t numberOfBytes)
+{
+  // Round up to a multiple of an eighth of the largest power of two that is
+  // not larger than the number of bytes, and of a cache line.
+  size_t powerOfTwo = 1;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const size_t granularity = std::max(powerOfTwo / 8, size_t{ 64 });
+  return (numberOfBytes + granularity - 1) / granularity * granularity;
+}
+
+void *
+ImageBufferPool::Acquire(size_t numberOfBytes, size_t alignment)
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const size_t sizeClass = GetSizeClass(numberOfBytes);
+  if (sizeClass < numberOfBytes)
+  {
+    return nullptr;
+  }
+
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  PoolGlobals &                     globals = *m_PoolGlobals;
+  void *                            buffer = nullptr;
+  const auto                        range = globals.m_HeldBuffers.equal_range({ sizeClass, alignment });
+  if (range.first != range.second)
+  {
+    // The most recently released buffer is the most likely to be cached.
+    const auto held = std::prev(range.second);
+    buffer = held->second->Buffer;
+    globals.m_LeastRecentlyReleased.erase(held->second);
+    globals.m_HeldBuffers.erase(held);
+    globals.m_Statistics.NumberOfBytesHeld -= sizeClass;
+    --globals.m_Statistics.NumberOfBuffersHeld;
+    ++globals.m_Statistics.NumberOfHits;
+  }
+  else
+  {
+    buffer = ::operator new(sizeClass, std::align_val_t{ alignment }, std::nothrow);
+    if (!buffer)
+    {
+      // Make room for the buffer.
+      globals.Trim(0);
+      buffer = ::operator new(sizeClass, std::align_val_t{ alignment }, std::nothrow);
+    }
+    if (!buffer)
+    {
+      return nullptr;
+    }
+    ++globals.m_Statistics.NumberOfMisses;
+  }
+  globals.m_AcquiredBuffers.emplace(buffer, sizeClass);
+  return buffer;
+}
+
+bool
+ImageBufferPool::Release(void * buffer, size_t alignment)
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  PoolGlobals &                     globals = *m_PoolGlobals;
+  const auto                        acquired = globals.m_AcquiredBuffers.find(buffer);
+  if (acquired == globals.m_AcquiredBuffers.end())
+  {
+    return false;
+  }
+  const size_t sizeClass = acquired->second;
+  globals.m_AcquiredBuffers.erase(acquired);
+  if (sizeClass > globals.m_MaximumNumberOfBytes)
+  {
+    ::operator delete(buffer, std::align_val_t{ alignment });
+    ++globals.m_Statistics.NumberOfTrimmedBuffers;
+    return true;
+  }
+
+  globals.m_LeastRecentlyReleased.push_front({ buffer, sizeClass, alignment });
+  globals.m_HeldBuffers.emplace(PoolGlobals::KeyType{ sizeClass, alignment }, globals.m_LeastRecentlyReleased.begin());
+  globals.m_Statistics.NumberOfBytesHeld += sizeClass;
+  ++globals.m_Statistics.NumberOfBuffersHeld;
+  globals.Trim(globals.m_MaximumNumberOfBytes);
+  return true;
+}
+
+void
+ImageBufferPool::Clear()
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  m_PoolGlobals->Trim(0);
+}
+
+auto
+ImageBufferPool::GetStatistics() -> Statistics
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  return m_PoolGlobals->m_Statistics;
+}
+
+void
+ImageBufferPool::ResetStatistics()
+{
+  itkInitGlobalsMacro(PoolGlobals);
+  const std::lock_guard<std::mutex> lock(m_PoolGlobals->m_Mutex);
+  Statistics & statistics = m_PoolGlobals->m_Statistics;
+  statistics.NumberOfHits = 0;
+  statistics.NumberOfMisses = 0;
+  statistics.NumberOfTrimmedBuffers = 0;
+}
+
+std::ostream &
+operator<<(std::ostream & out, const ImageBufferPool::Statistics & statistics)
+{
+  return out << "NumberOfHits: " << statistics.NumberOfHits << ", NumberOfMisses: " << statistics.NumberOfMisses
+             << ", NumberOfTrimmedBuffers: " << statistics.NumberOfTrimmedBuffers
+             << ", NumberOfBuffersHeld: " << statistics.NumberOfBuffersHeld
+             << ", NumberOfBytesHeld: " << statistics.NumberOfBytesHeld;
+}
+} // end namespace itk
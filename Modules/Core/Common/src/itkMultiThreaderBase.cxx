@@ -497,6 +497,12 @@ MultiThreaderBase::ParallelizeArray(SizeValueType             firstIndex,
   // else nothing needs to be executed
 }
 
+const char *
+MultiThreaderBase::GetWorkUnitName(const ProcessObject * filter)
+{
+  return filter ? filter->GetNameOfClass() : "MultiThreaderBase";
+}
+
 ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
 MultiThreaderBase::ParallelizeArrayHelper(void * arg)
 {
@@ -517,6 +523,8 @@ MultiThreaderBase::ParallelizeArrayHelper(void * arg)
 
   TotalProgressReporter reporter(acParams->filter, range);
 
+  const PipelineProfiler::ScopedInterval profilerInterval(
+    "WorkUnit", GetWorkUnitName(acParams->filter), acParams->filter);
   for (SizeValueType i = first; i < afterLast; ++i)
   {
     acParams->functor(i);
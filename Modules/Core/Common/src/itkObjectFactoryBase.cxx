@@ -38,6 +38,10 @@
 #include <cstring>
 #include <algorithm>
 #include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
 
 namespace
 {
@@ -148,7 +152,70 @@ ObjectFactoryBase::GetPimplGlobalsPointer() -> ObjectFactoryBasePrivate *
  * classes including <map> and getting long symbol warnings.
  */
 class ObjectFactoryBase::OverrideMap : public std::multimap<std::string, OverrideInformation>
-{};
+{
+public:
+  /** Return the function that creates the objects of the first enabled
+   * override of the named class, or nullptr if there is none. */
+  CreateObjectFunctionBase *
+  FindEnabledOverride(const char * itkclassname);
+
+  /** Forget the overrides found so far. This must be called whenever the
+   * overrides change. */
+  void
+  ClearCache();
+
+private:
+  // The overrides found by FindEnabledOverride, by class name, and the class
+  // names that they refer to. The epoch is incremented whenever the cache is
+  // cleared, so that an override found concurrently is not cached.
+  std::unordered_map<std::string_view, CreateObjectFunctionBase *> m_Cache{};
+  std::list<std::string>                                           m_CacheClassNames{};
+  unsigned long                                                    m_CacheEpoch{ 0 };
+  std::shared_mutex                                                m_CacheMutex{};
+};
+
+CreateObjectFunctionBase *
+ObjectFactoryBase::OverrideMap::FindEnabledOverride(const char * itkclassname)
+{
+  unsigned long epoch;
+  {
+    const std::shared_lock<std::shared_mutex> lock(m_CacheMutex);
+    const auto                                cached = m_Cache.find(itkclassname);
+    if (cached != m_Cache.end())
+    {
+      return cached->second;
+    }
+    epoch = m_CacheEpoch;
+  }
+
+  CreateObjectFunctionBase * createFunction = nullptr;
+  const auto                 end = this->upper_bound(itkclassname);
+  for (auto i = this->lower_bound(itkclassname); i != end; ++i)
+  {
+    if (i->second.m_EnabledFlag)
+    {
+      createFunction = i->second.m_CreateObject;
+      break;
+    }
+  }
+
+  const std::lock_guard<std::shared_mutex> lock(m_CacheMutex);
+  if (epoch == m_CacheEpoch && m_Cache.find(itkclassname) == m_Cache.end())
+  {
+    m_CacheClassNames.emplace_back(itkclassname);
+    m_Cache.emplace(m_CacheClassNames.back(), createFunction);
+  }
+  return createFunction;
+}
+
+void
+ObjectFactoryBase::OverrideMap::ClearCache()
+{
+  const std::lock_guard<std::shared_mutex> lock(m_CacheMutex);
+  m_Cache.clear();
+  m_CacheClassNames.clear();
+  ++m_CacheEpoch;
+}
 
 /**
  * Make possible for application developers to demand an exact match
@@ -206,6 +273,25 @@ ObjectFactoryBase::CreateInstance(const char * itkclassname)
   return nullptr;
 }
 
+/**
+ * Create an instance of a named ITK object, overridden by a named class,
+ * using the loaded factories
+ */
+LightObject::Pointer
+ObjectFactoryBase::CreateInstance(const char * itkclassname, const char * overrideWithName)
+{
+  ObjectFactoryBase::Initialize();
+
+  for (auto & registeredFactory : m_PimplGlobals->m_RegisteredFactories)
+  {
+    if (LightObject::Pointer newobject = registeredFactory->CreateObject(itkclassname, overrideWithName))
+    {
+      return newobject;
+    }
+  }
+  return nullptr;
+}
+
 std::list<LightObject::Pointer>
 ObjectFactoryBase::CreateAllInstance(const char * itkclassname)
 {
@@ -710,17 +796,28 @@ ObjectFactoryBase::RegisterOverride(const char *               classOverride,
   info.m_CreateObject = createFunction;
 
   m_OverrideMap->insert(OverrideMap::value_type(classOverride, info));
+  m_OverrideMap->ClearCache();
 }
 
 LightObject::Pointer
 ObjectFactoryBase::CreateObject(const char * itkclassname)
 {
-  auto start = m_OverrideMap->lower_bound(itkclassname);
-  auto end = m_OverrideMap->upper_bound(itkclassname);
+  // The first enabled override is looked up once per class name, and then
+  // found in the cache.
+  if (CreateObjectFunctionBase * createFunction = m_OverrideMap->FindEnabledOverride(itkclassname))
+  {
+    return createFunction->CreateObject();
+  }
+  return nullptr;
+}
 
-  for (auto i = start; i != end; ++i)
+LightObject::Pointer
+ObjectFactoryBase::CreateObject(const char * itkclassname, const char * overrideWithName)
+{
+  const auto end = m_OverrideMap->upper_bound(itkclassname);
+  for (auto i = m_OverrideMap->lower_bound(itkclassname); i != end; ++i)
   {
-    if (i != m_OverrideMap->end() && i->second.m_EnabledFlag)
+    if (i->second.m_EnabledFlag && i->second.m_OverrideWithName == overrideWithName)
     {
       return i->second.m_CreateObject->CreateObject();
     }
@@ -762,6 +859,7 @@ ObjectFactoryBase::SetEnableFlag(bool flag, const char * className, const char *
       i->second.m_EnabledFlag = flag;
     }
   }
+  m_OverrideMap->ClearCache();
 }
 
 /**
@@ -796,6 +894,7 @@ ObjectFactoryBase::Disable(const char * className)
   {
     i->second.m_EnabledFlag = false;
   }
+  m_OverrideMap->ClearCache();
 }
 
 /**
@@ -0,0 +1,327 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineProfiler.h"
+#include "itkMacro.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+namespace itk
+{
+namespace
+{
+// The events recorded by a thread. Only the thread writes the events, and
+// publishes them by incrementing the number of recorded events.
+struct ThreadBuffer
+{
+  ThreadBuffer(size_t capacity, unsigned int threadIndex)
+    : m_Events(std::max(capacity, size_t{ 1 }))
+    , m_ThreadIndex(threadIndex)
+  {}
+
+  void
+  Record(const PipelineProfiler::Event & event)
+  {
+    const uint64_t            numberOfRecordedEvents = m_NumberOfRecordedEvents.load(std::memory_order_relaxed);
+    PipelineProfiler::Event & slot = m_Events[numberOfRecordedEvents % m_Events.size()];
+    slot = event;
+    slot.ThreadIndex = m_ThreadIndex;
+    m_NumberOfRecordedEvents.store(numberOfRecordedEvents + 1, std::memory_order_release);
+  }
+
+  std::vector<PipelineProfiler::Event> m_Events;
+  std::atomic<uint64_t>                m_NumberOfRecordedEvents{ 0 };
+  const unsigned int                   m_ThreadIndex;
+};
+
+thread_local ThreadBuffer * threadBuffer = nullptr;
+
+void
+WriteJSONString(std::ostream & os, const char * text)
+{
+  os << '"';
+  for (; text && *text; ++text)
+  {
+    if (*text == '"' || *text == '\\')
+    {
+      os << '\\';
+    }
+    os << *text;
+  }
+  os << '"';
+}
+
+// Write a time in nanoseconds as microseconds, the unit of the trace.
+void
+WriteMicroseconds(std::ostream & os, PipelineProfiler::TimeType time)
+{
+  os << time / 1000 << '.' << std::setw(3) << std::setfill('0') << std::abs(time % 1000) << std::setfill(' ');
+}
+
+void
+WriteTraceAtExit()
+{
+  const char * fileName = std::getenv("ITK_PIPELINE_PROFILE");
+  if (fileName && *fileName)
+  {
+    PipelineProfiler::WriteChromeTrace(std::string(fileName));
+  }
+}
+} // namespace
+
+struct PipelineProfiler::ProfilerGlobals
+{
+  ProfilerGlobals()
+  {
+    std::string fileName;
+    if (itksys::SystemTools::GetEnv("ITK_PIPELINE_PROFILE", fileName) && !fileName.empty())
+    {
+      m_Enabled = true;
+      std::atexit(WriteTraceAtExit);
+    }
+  }
+
+  // Returns the buffer of a thread to the free buffers when the thread exits,
+  // so that the threads created later reuse it instead of allocating theirs.
+  struct ThreadBufferOwner
+  {
+    ~ThreadBufferOwner()
+    {
+      if (m_Buffer && m_ProfilerGlobals)
+      {
+        const std::lock_guard<std::mutex> lock(m_ProfilerGlobals->m_Mutex);
+        m_ProfilerGlobals->m_FreeThreadBuffers.push_back(m_Buffer);
+      }
+    }
+
+    ThreadBuffer * m_Buffer{ nullptr };
+  };
+
+  ThreadBuffer *
+  GetThreadBuffer()
+  {
+    if (threadBuffer == nullptr)
+    {
+      thread_local ThreadBufferOwner owner;
+
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      // Only a free buffer of the current capacity is reused.
+      const auto freeBuffer =
+        std::find_if(m_FreeThreadBuffers.rbegin(), m_FreeThreadBuffers.rend(), [this](const ThreadBuffer * buffer) {
+          return buffer->m_Events.size() == std::max(m_ThreadBufferCapacity, size_t{ 1 });
+        });
+      if (freeBuffer != m_FreeThreadBuffers.rend())
+      {
+        threadBuffer = *freeBuffer;
+        m_FreeThreadBuffers.erase(std::next(freeBuffer).base());
+      }
+      else
+      {
+        m_ThreadBuffers.push_back(
+          std::make_unique<ThreadBuffer>(m_ThreadBufferCapacity, static_cast<unsigned int>(m_ThreadBuffers.size())));
+        threadBuffer = m_ThreadBuffers.back().get();
+      }
+      owner.m_Buffer = threadBuffer;
+    }
+    return threadBuffer;
+  }
+
+  std::atomic<bool>                           m_Enabled{ false };
+  const std::chrono::steady_clock::time_point m_StartTime{ std::chrono::steady_clock::now() };
+
+  std::mutex                                 m_Mutex{};
+  size_t                                     m_ThreadBufferCapacity{ 16384 };
+  std::vector<std::unique_ptr<ThreadBuffer>> m_ThreadBuffers{};
+  // The buffers of the threads that exited.
+  std::vector<ThreadBuffer *> m_FreeThreadBuffers{};
+};
+
+itkGetGlobalSimpleMacro(PipelineProfiler, PipelineProfiler::ProfilerGlobals, ProfilerGlobals);
+
+PipelineProfiler::ProfilerGlobals * PipelineProfiler::m_ProfilerGlobals;
+
+void
+PipelineProfiler::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  m_ProfilerGlobals->m_Enabled = enabled;
+}
+
+bool
+PipelineProfiler::GetEnabled()
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  return m_ProfilerGlobals->m_Enabled.load(std::memory_order_relaxed);
+}
+
+void
+PipelineProfiler::SetThreadBufferCapacity(size_t numberOfEvents)
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  const std::lock_guard<std::mutex> lock(m_ProfilerGlobals->m_Mutex);
+  m_ProfilerGlobals->m_ThreadBufferCapacity = numberOfEvents;
+}
+
+size_t
+PipelineProfiler::GetThreadBufferCapacity()
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  const std::lock_guard<std::mutex> lock(m_ProfilerGlobals->m_Mutex);
+  return m_ProfilerGlobals->m_ThreadBufferCapacity;
+}
+
+auto
+PipelineProfiler::GetTime() -> TimeType
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              m_ProfilerGlobals->m_StartTime)
+    .count();
+}
+
+void
+PipelineProfiler::RecordInterval(const char * category,
+                                 const char * name,
+                                 const void * object,
+                                 TimeType     startTime,
+                                 TimeType     endTime)
+{
+  if (!GetEnabled())
+  {
+    return;
+  }
+  Event event;
+  event.Category = category;
+  event.Name = name;
+  event.Object = object;
+  event.StartTime = startTime;
+  event.Duration = endTime - startTime;
+  m_ProfilerGlobals->GetThreadBuffer()->Record(event);
+}
+
+void
+PipelineProfiler::RecordValue(const char * category, const char * name, const void * object, int64_t value)
+{
+  if (!GetEnabled())
+  {
+    return;
+  }
+  Event event;
+  event.Category = category;
+  event.Name = name;
+  event.Object = object;
+  event.StartTime = GetTime();
+  event.Value = value;
+  event.IsInterval = false;
+  m_ProfilerGlobals->GetThreadBuffer()->Record(event);
+}
+
+auto
+PipelineProfiler::GetEvents() -> std::vector<Event>
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  const std::lock_guard<std::mutex> lock(m_ProfilerGlobals->m_Mutex);
+
+  std::vector<Event> events;
+  for (const auto & buffer : m_ProfilerGlobals->m_ThreadBuffers)
+  {
+    const uint64_t numberOfRecordedEvents = buffer->m_NumberOfRecordedEvents.load(std::memory_order_acquire);
+    const uint64_t capacity = buffer->m_Events.size();
+    for (uint64_t i = std::max(numberOfRecordedEvents, capacity) - capacity; i < numberOfRecordedEvents; ++i)
+    {
+      events.push_back(buffer->m_Events[i % capacity]);
+    }
+  }
+  std::stable_sort(events.begin(), events.end(), [](const Event & event1, const Event & event2) {
+    return event1.StartTime < event2.StartTime;
+  });
+  return events;
+}
+
+void
+PipelineProfiler::Clear()
+{
+  itkInitGlobalsMacro(ProfilerGlobals);
+  const std::lock_guard<std::mutex> lock(m_ProfilerGlobals->m_Mutex);
+  for (const auto & buffer : m_ProfilerGlobals->m_ThreadBuffers)
+  {
+    buffer->m_NumberOfRecordedEvents = 0;
+  }
+}
+
+void
+PipelineProfiler::WriteChromeTrace(std::ostream & os)
+{
+  const std::vector<Event> events = GetEvents();
+
+  unsigned int numberOfThreads = 0;
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char * separator = "\n";
+  for (const Event & event : events)
+  {
+    os << separator << "{\"name\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Category);
+    os << ",\"ph\":\"" << (event.IsInterval ? 'X' : 'i') << "\",\"ts\":";
+    WriteMicroseconds(os, event.StartTime);
+    if (event.IsInterval)
+    {
+      os << ",\"dur\":";
+      WriteMicroseconds(os, event.Duration);
+    }
+    else
+    {
+      os << ",\"s\":\"t\"";
+    }
+    os << ",\"pid\":1,\"tid\":" << event.ThreadIndex << ",\"args\":{\"object\":\"" << event.Object << '"';
+    if (!event.IsInterval)
+    {
+      os << ",\"value\":" << event.Value;
+    }
+    os << "}}";
+    separator = ",\n";
+    numberOfThreads = std::max(numberOfThreads, event.ThreadIndex + 1);
+  }
+  for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+       << ",\"args\":{\"name\":\"Thread " << thread << "\"}}";
+  }
+  os << "\n]}\n";
+}
+
+void
+PipelineProfiler::WriteChromeTrace(const std::string & fileName)
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot open the file " << fileName << " to write the pipeline profile.");
+  }
+  WriteChromeTrace(file);
+}
+} // end namespace itk
@@ -170,7 +170,8 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
       ++chunkSize; // we want slightly bigger chunks to be processed first
     }
 
-    auto lambda = [aFunc](SizeValueType start, SizeValueType end) {
+    auto lambda = [aFunc, filter](SizeValueType start, SizeValueType end) {
+      const PipelineProfiler::ScopedInterval profilerInterval("WorkUnit", GetWorkUnitName(filter), filter);
       for (SizeValueType ii = start; ii < end; ++ii)
       {
         aFunc(ii);
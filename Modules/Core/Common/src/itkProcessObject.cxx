@@ -26,6 +26,7 @@
  *
  *=========================================================================*/
 #include "itkProcessObject.h"
+#include "itkPipelineProfiler.h"
 #include <mutex>
 
 #include <cstdio>
@@ -1690,6 +1691,7 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 
   try
   {
+    const PipelineProfiler::ScopedInterval profilerInterval("GenerateData", this->GetNameOfClass(), this);
     this->GenerateData();
   }
   catch (const ProcessAborted &)
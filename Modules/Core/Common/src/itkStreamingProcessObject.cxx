@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include "itkStreamingProcessObject.h"
+#include "itkPipelineProfiler.h"
 
 namespace itk
 {
@@ -37,6 +38,7 @@ StreamingProcessObject::GenerateData()
   // and what the Splitter thinks is a reasonable value.
   //
   unsigned int numberOfInputRequestRegion = this->GetNumberOfInputRequestedRegions();
+  PipelineProfiler::RecordValue("StreamDivisions", this->GetNameOfClass(), this, numberOfInputRequestRegion);
 
   //
   // Loop over the number of pieces, execute the upstream pipeline on each
@@ -81,6 +83,7 @@ StreamingProcessObject::GenerateData()
     //
     try
     {
+      const PipelineProfiler::ScopedInterval profilerInterval("StreamedGenerateData", this->GetNameOfClass(), this);
       this->StreamedGenerateData(piece);
       this->UpdateProgress(static_cast<float>(piece + 1) / numberOfInputRequestRegion);
     }
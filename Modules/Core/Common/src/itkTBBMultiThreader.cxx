@@ -142,6 +142,7 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
         TotalProgressReporter progress(filter, count, 100);
         progress.CheckAbortGenerateData();
 
+        const PipelineProfiler::ScopedInterval profilerInterval("WorkUnit", GetWorkUnitName(filter), filter);
         aFunc(r.begin()); // invoke the function
 
         progress.CompletedPixel();
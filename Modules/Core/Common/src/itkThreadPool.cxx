@@ -32,6 +32,11 @@
 
 namespace itk
 {
+namespace
+{
+// Whether the thread executes ThreadPool::ThreadExecute().
+thread_local bool isThreadOfPool = false;
+} // namespace
 
 struct ThreadPoolGlobals
 {
@@ -186,9 +191,17 @@ ThreadPool::ResumeFromFork()
   instance->AddThreads(threadCount);
 }
 
+bool
+ThreadPool::IsCurrentThreadInPool()
+{
+  return isThreadOfPool;
+}
+
 void
 ThreadPool::ThreadExecute()
 {
+  isThreadOfPool = true;
+
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
 
@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferPool.h"
+#include "itkAddImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Check the statistics of the pool, which are then reset.
+bool
+CheckStatistics(const char *       step,
+                itk::SizeValueType expectedNumberOfHits,
+                itk::SizeValueType expectedNumberOfMisses,
+                itk::SizeValueType expectedNumberOfTrimmedBuffers,
+                itk::SizeValueType expectedNumberOfBuffersHeld,
+                size_t             expectedNumberOfBytesHeld)
+{
+  const auto statistics = itk::ImageBufferPool::GetStatistics();
+  itk::ImageBufferPool::ResetStatistics();
+  if (statistics.NumberOfHits != expectedNumberOfHits || statistics.NumberOfMisses != expectedNumberOfMisses ||
+      statistics.NumberOfTrimmedBuffers != expectedNumberOfTrimmedBuffers ||
+      statistics.NumberOfBuffersHeld != expectedNumberOfBuffersHeld ||
+      statistics.NumberOfBytesHeld != expectedNumberOfBytesHeld)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << step << ": unexpected statistics (" << statistics << ')' << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageBufferPoolTest(int, char *[])
+{
+  ITK_TEST_EXPECT_EQUAL(itk::ImageBufferPool::GetSizeClass(1000), 1024u);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageBufferPool::GetSizeClass(size_t{ 1 } << 20), size_t{ 1 } << 20);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageBufferPool::GetSizeClass((size_t{ 1 } << 20) + 1), (size_t{ 9 } << 17));
+
+  itk::ImageBufferAllocationPolicy poolPolicy;
+  poolPolicy.UsePool = true;
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, float>;
+  const auto createContainer = [](const itk::ImageBufferAllocationPolicy & policy, itk::SizeValueType size) {
+    auto container = ContainerType::New();
+    container->SetAllocationPolicy(policy);
+    container->Reserve(size, true);
+    return container;
+  };
+
+  bool testPassed = true;
+
+  // Buffers of the same size class and alignment are recycled.
+  auto container = createContainer(poolPolicy, 1000);
+  testPassed &= CheckStatistics("Allocation", 0, 1, 0, 0, 0);
+  container->Initialize();
+  testPassed &= CheckStatistics("Release", 0, 0, 0, 1, 4096);
+  container = createContainer(poolPolicy, 990);
+  ITK_TEST_EXPECT_EQUAL((*container)[989], 0.0f);
+  testPassed &= CheckStatistics("Recycling", 1, 0, 0, 0, 0);
+  itk::ImageBufferAllocationPolicy alignedPoolPolicy = poolPolicy;
+  alignedPoolPolicy.Alignment = 64;
+  auto alignedContainer = createContainer(alignedPoolPolicy, 1000);
+  testPassed &= CheckStatistics("Other alignment", 0, 1, 0, 0, 0);
+
+  // The buffers released the longest time ago are trimmed.
+  itk::ImageBufferPool::SetMaximumNumberOfBytes(10000);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageBufferPool::GetMaximumNumberOfBytes(), 10000u);
+  auto otherContainer = createContainer(poolPolicy, 1000);
+  testPassed &= CheckStatistics("Allocation", 0, 1, 0, 0, 0);
+  container = nullptr;
+  alignedContainer = nullptr;
+  otherContainer = nullptr;
+  testPassed &= CheckStatistics("Trimming", 0, 0, 1, 2, 8192);
+  otherContainer = createContainer(poolPolicy, 1000);
+  auto largeContainer = createContainer(poolPolicy, 5000);
+  largeContainer = nullptr;
+  testPassed &= CheckStatistics("Larger than the maximum", 1, 1, 1, 1, 4096);
+  itk::ImageBufferPool::Clear();
+  testPassed &= CheckStatistics("Clear", 0, 0, 1, 0, 0);
+
+  // Buffers that are not acquired from the pool are not released to it.
+  auto alignedOnlyPolicy = alignedPoolPolicy;
+  alignedOnlyPolicy.UsePool = false;
+  createContainer(alignedOnlyPolicy, 1000);
+  createContainer(itk::ImageBufferAllocationPolicy{}, 1000);
+  testPassed &= CheckStatistics("Without the pool", 0, 0, 0, 0, 0);
+  otherContainer = nullptr;
+  itk::ImageBufferPool::Clear();
+  itk::ImageBufferPool::ResetStatistics();
+
+  // The intermediate images released by the pipeline are recycled by the
+  // next update.
+  itk::ImageBufferPool::SetMaximumNumberOfBytes(size_t{ 1 } << 30);
+  itk::ImageBufferAllocationPolicy::SetGlobalDefault(poolPolicy);
+  using ImageType = itk::Image<float, 3>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 64, 64 } });
+  image->Allocate();
+  image->FillBuffer(2.0f);
+
+  auto add = itk::AddImageFilter<ImageType, ImageType, ImageType>::New();
+  add->SetInput(image);
+  add->SetConstant2(1.0f);
+  add->ReleaseDataFlagOn();
+  auto multiply = itk::MultiplyImageFilter<ImageType, ImageType, ImageType>::New();
+  multiply->SetInput(add->GetOutput());
+  multiply->SetConstant2(3.0f);
+  multiply->ReleaseDataBeforeUpdateFlagOn();
+  itk::ImageBufferAllocationPolicy::SetGlobalDefault(itk::ImageBufferAllocationPolicy{});
+  itk::ImageBufferPool::ResetStatistics();
+
+  const size_t imageBytes = 64 * 64 * 64 * sizeof(float);
+  ITK_TRY_EXPECT_NO_EXCEPTION(multiply->Update());
+  testPassed &= CheckStatistics("First update", 0, 2, 0, 1, imageBytes);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    image->Modified();
+    ITK_TRY_EXPECT_NO_EXCEPTION(multiply->Update());
+    testPassed &= CheckStatistics("Next update", 2, 0, 0, 1, imageBytes);
+  }
+  ITK_TEST_EXPECT_EQUAL(multiply->GetOutput()->GetPixel({ { 63, 0, 12 } }), 9.0f);
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
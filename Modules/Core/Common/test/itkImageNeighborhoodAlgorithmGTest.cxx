@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageNeighborhoodAlgorithm.h"
+
+#include "itkConstantBoundaryImageNeighborhoodPixelAccessPolicy.h"
+#include "itkImage.h"
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+#include "itkVectorImage.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using IndexType = itk::Index<Dimension>;
+using OffsetType = itk::Offset<Dimension>;
+using RegionType = itk::ImageRegion<Dimension>;
+
+// A weighted sum of the neighbor pixels, which depends on their order.
+struct WeightedSumKernel
+{
+  template <typename TNeighborhood>
+  float
+  operator()(const TNeighborhood & neighborhood) const
+  {
+    float sum = 0.0f;
+    for (size_t i = 0; i < neighborhood.size(); ++i)
+    {
+      const float pixel = neighborhood[i];
+      sum += static_cast<float>(i + 1) * pixel;
+    }
+    return sum;
+  }
+};
+
+
+// Creates an image, whose pixels are 1, 2, 3, ..., filled in its buffered region.
+ImageType::Pointer
+CreateImage(const RegionType & bufferedRegion)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(bufferedRegion);
+  image->Allocate();
+  float value = 0.0f;
+  for (float & pixel : itk::ImageRegionRange<ImageType>(*image))
+  {
+    pixel = ++value;
+  }
+  return image;
+}
+
+
+// The shape of the neighborhoods: a 3x3 square, and an asymmetric neighbor.
+std::vector<OffsetType>
+CreateOffsets()
+{
+  auto offsets = itk::GenerateRectangularImageNeighborhoodOffsets<Dimension>(itk::Size<Dimension>::Filled(1));
+  offsets.push_back({ { 2, -1 } });
+  return offsets;
+}
+
+
+// Computes the weighted sum of the neighbor pixels index by index, clamping the
+// neighbor indices to the buffered region, or taking the constant outside it.
+float
+ComputeExpectedPixel(const ImageType &               image,
+                     const IndexType &               index,
+                     const std::vector<OffsetType> & offsets,
+                     const bool                      useConstant,
+                     const float                     constant)
+{
+  const RegionType bufferedRegion = image.GetBufferedRegion();
+  float            sum = 0.0f;
+  for (size_t i = 0; i < offsets.size(); ++i)
+  {
+    IndexType neighborIndex = index + offsets[i];
+    float     pixel = constant;
+    if (!useConstant || bufferedRegion.IsInside(neighborIndex))
+    {
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        neighborIndex[d] = std::clamp(neighborIndex[d],
+                                      bufferedRegion.GetIndex(d),
+                                      bufferedRegion.GetUpperIndex()[d]);
+      }
+      pixel = image.GetPixel(neighborIndex);
+    }
+    sum += static_cast<float>(i + 1) * pixel;
+  }
+  return sum;
+}
+
+
+void
+ExpectPixelsInRegion(const ImageType &               inputImage,
+                     const ImageType &               outputImage,
+                     const RegionType &              region,
+                     const std::vector<OffsetType> & offsets,
+                     const bool                      useConstant = false,
+                     const float                     constant = 0.0f)
+{
+  for (const IndexType & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    EXPECT_EQ(outputImage.GetPixel(index), ComputeExpectedPixel(inputImage, index, offsets, useConstant, constant))
+      << "index = " << index;
+  }
+}
+} // namespace
+
+
+// Tests that Transform computes the pixels of the non-boundary region and of
+// the boundary faces like the zero-flux Neumann boundary condition.
+TEST(ImageNeighborhoodAlgorithm, TransformWithZeroFluxNeumannBoundary)
+{
+  const RegionType bufferedRegion({ { -2, 3 } }, { { 11, 8 } });
+  const auto       inputImage = CreateImage(bufferedRegion);
+  const auto       outputImage = ImageType::New();
+  outputImage->SetRegions(bufferedRegion);
+  outputImage->Allocate(true);
+  const auto offsets = CreateOffsets();
+
+  itk::ImageNeighborhoodAlgorithm::Transform(*inputImage, *outputImage, bufferedRegion, offsets, WeightedSumKernel{});
+  ExpectPixelsInRegion(*inputImage, *outputImage, bufferedRegion, offsets);
+
+  // Only the pixels of the specified region are computed.
+  outputImage->FillBuffer(-1.0f);
+  const RegionType region({ { 0, 4 } }, { { 5, 3 } });
+  itk::ImageNeighborhoodAlgorithm::Transform(*inputImage, *outputImage, region, offsets, WeightedSumKernel{});
+  ExpectPixelsInRegion(*inputImage, *outputImage, region, offsets);
+  EXPECT_EQ(outputImage->GetPixel({ { -2, 3 } }), -1.0f);
+  EXPECT_EQ(outputImage->GetPixel({ { 5, 4 } }), -1.0f);
+}
+
+
+// Tests that Transform reads the constant of the constant boundary policy
+// outside the image, also when the image has no non-boundary region.
+TEST(ImageNeighborhoodAlgorithm, TransformWithConstantBoundary)
+{
+  const auto offsets = CreateOffsets();
+  for (const auto & size : { itk::Size<Dimension>{ { 9, 6 } }, itk::Size<Dimension>{ { 2, 2 } } })
+  {
+    const RegionType bufferedRegion(size);
+    const auto       inputImage = CreateImage(bufferedRegion);
+    const auto       outputImage = ImageType::New();
+    outputImage->SetRegions(bufferedRegion);
+    outputImage->Allocate();
+
+    constexpr float constant = 42.0f;
+    itk::ImageNeighborhoodAlgorithm::Transform<itk::ConstantBoundaryImageNeighborhoodPixelAccessPolicy>(
+      *inputImage, *outputImage, bufferedRegion, offsets, WeightedSumKernel{}, nullptr, constant);
+    ExpectPixelsInRegion(*inputImage, *outputImage, bufferedRegion, offsets, true, constant);
+  }
+}
+
+
+// Tests that Transform reads the pixels of a VectorImage, whose pixels are not
+// the elements of its buffer, through the pixel access policies.
+TEST(ImageNeighborhoodAlgorithm, TransformVectorImage)
+{
+  using VectorImageType = itk::VectorImage<float, Dimension>;
+  const RegionType bufferedRegion(itk::Size<Dimension>{ { 8, 7 } });
+  const auto       scalarImage = CreateImage(bufferedRegion);
+  const auto       vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(bufferedRegion);
+  vectorImage->SetNumberOfComponentsPerPixel(2);
+  vectorImage->Allocate();
+  for (const IndexType & index : itk::ImageRegionIndexRange<Dimension>(bufferedRegion))
+  {
+    VectorImageType::PixelType pixel(2);
+    pixel[0] = scalarImage->GetPixel(index);
+    pixel[1] = 0.0f;
+    vectorImage->SetPixel(index, pixel);
+  }
+
+  const auto outputImage = ImageType::New();
+  outputImage->SetRegions(bufferedRegion);
+  outputImage->Allocate();
+  const auto offsets = CreateOffsets();
+
+  itk::ImageNeighborhoodAlgorithm::Transform(
+    *vectorImage, *outputImage, bufferedRegion, offsets, [](const auto & neighborhood) {
+      float sum = 0.0f;
+      float weight = 0.0f;
+      for (const auto & neighbor : neighborhood)
+      {
+        const VectorImageType::PixelType pixel(neighbor);
+        sum += ++weight * (pixel[0] + pixel[1]);
+      }
+      return sum;
+    });
+  ExpectPixelsInRegion(*scalarImage, *outputImage, bufferedRegion, offsets);
+}
+
+
+// Tests that ParallelTransform computes the same pixels as Transform.
+TEST(ImageNeighborhoodAlgorithm, ParallelTransform)
+{
+  const RegionType bufferedRegion(itk::Size<Dimension>{ { 40, 33 } });
+  const auto       inputImage = CreateImage(bufferedRegion);
+  const auto       outputImage = ImageType::New();
+  outputImage->SetRegions(bufferedRegion);
+  outputImage->Allocate();
+  const auto offsets = CreateOffsets();
+
+  const auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->SetMaximumNumberOfThreads(4);
+  multiThreader->SetNumberOfWorkUnits(4);
+  itk::ImageNeighborhoodAlgorithm::ParallelTransform(
+    multiThreader, *inputImage, *outputImage, bufferedRegion, offsets, WeightedSumKernel{});
+  ExpectPixelsInRegion(*inputImage, *outputImage, bufferedRegion, offsets);
+}
@@ -0,0 +1,277 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageReduction.h"
+
+#include "itkImageAdaptor.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using RegionType = ImageType::RegionType;
+
+// Creates an image of positive, negative and zero values, whose lines are not
+// a multiple of the number of lanes.
+ImageType::Pointer
+CreateImage()
+{
+  const auto image = ImageType::New();
+  image->SetRegions(RegionType({ { -2, 3 } }, { { 53, 9 } }));
+  image->Allocate();
+  int value = 1;
+  for (auto & pixel : itk::ImageRegionRange<ImageType>(*image))
+  {
+    value = (value * 37 + 11) % 1001;
+    pixel = static_cast<float>(value - 450) / 8.0f;
+  }
+  return image;
+}
+
+// Passes the pixels of an image, negated.
+class NegatePixelAccessor
+{
+public:
+  using InternalType = float;
+  using ExternalType = float;
+
+  static ExternalType
+  Get(const InternalType & input)
+  {
+    return -input;
+  }
+};
+
+using StatisticsAccumulatorType = itk::Reduction::StatisticsAccumulator<float, double>;
+} // namespace
+
+
+// Tests that the accumulators compute the reductions of arrays, whether or
+// not their length is a multiple of the number of lanes.
+TEST(ImageReduction, Accumulators)
+{
+  for (const itk::SizeValueType numberOfPixels : { 0, 1, 7, 8, 9, 100, 5000 })
+  {
+    std::vector<float> pixels(numberOfPixels);
+    for (itk::SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      pixels[i] = static_cast<float>((i * 7919) % 101) - 50.0f;
+    }
+
+    StatisticsAccumulatorType accumulator;
+    accumulator.AddPixels(pixels.data(), numberOfPixels);
+
+    EXPECT_EQ(accumulator.GetCount(), numberOfPixels);
+    if (numberOfPixels > 0)
+    {
+      EXPECT_EQ(accumulator.GetMinimum(), *std::min_element(pixels.cbegin(), pixels.cend()));
+      EXPECT_EQ(accumulator.GetMaximum(), *std::max_element(pixels.cbegin(), pixels.cend()));
+    }
+    EXPECT_EQ(accumulator.GetSum(), std::accumulate(pixels.cbegin(), pixels.cend(), 0.0));
+    EXPECT_EQ(accumulator.GetSumOfSquares(),
+              std::inner_product(pixels.cbegin(), pixels.cend(), pixels.cbegin(), 0.0));
+  }
+
+  const float pixels[] = { -1.0f, 0.0f, 0.5f, 1.0f, 2.0f, 2.5f, 3.0f, 4.0f };
+
+  itk::Reduction::HistogramAccumulator<float> histogram(4, 0.0, 3.0);
+  histogram.AddPixels(pixels, 8);
+  EXPECT_EQ(histogram.GetFrequencies(), (std::vector<itk::SizeValueType>{ 2, 1, 1, 2 }));
+
+  itk::Reduction::HistogramAccumulator<float> otherHistogram(4, 0.0, 3.0);
+  otherHistogram.AddPixels(pixels + 6, 1);
+  histogram.Merge(otherHistogram);
+  EXPECT_EQ(histogram.GetFrequencies(), (std::vector<itk::SizeValueType>{ 2, 1, 1, 3 }));
+
+  EXPECT_THROW(itk::Reduction::HistogramAccumulator<float>(4, 3.0, 0.0), itk::ExceptionObject);
+}
+
+
+// Tests that the accumulators of a composite accumulator compute their
+// reductions of the pixels in a single pass, and merge them.
+TEST(ImageReduction, CompositeAccumulator)
+{
+  using AccumulatorType = itk::Reduction::CompositeAccumulator<itk::Reduction::MinimumAccumulator<short>,
+                                                               itk::Reduction::CountAccumulator<short>,
+                                                               itk::Reduction::HistogramAccumulator<short>>;
+  std::vector<short> pixels(5000);
+  std::iota(pixels.begin(), pixels.end(), short{ -100 });
+
+  AccumulatorType accumulator1({}, {}, itk::Reduction::HistogramAccumulator<short>(2, 0.0, 10.0));
+  AccumulatorType accumulator2 = accumulator1;
+  accumulator1.AddPixels(pixels.data(), 3000);
+  accumulator2.AddPixels(pixels.data() + 3000, 2000);
+  accumulator2.Merge(accumulator1);
+
+  EXPECT_EQ(accumulator2.GetMinimum(), -100);
+  EXPECT_EQ(accumulator2.GetCount(), 5000u);
+  EXPECT_EQ(accumulator2.GetFrequencies(), (std::vector<itk::SizeValueType>{ 5, 6 }));
+}
+
+
+// Tests that ImageReduction passes the lines of a region of an image and of an
+// image adaptor, with the index of their first pixel.
+TEST(ImageReduction, ForEachLine)
+{
+  const auto image = CreateImage();
+  const auto adaptor = itk::ImageAdaptor<ImageType, NegatePixelAccessor>::New();
+  adaptor->SetImage(image);
+
+  const RegionType region({ { 3, 4 } }, { { 20, 5 } });
+
+  itk::SizeValueType numberOfLines = 0;
+  itk::ImageReduction::ForEachLine(
+    region,
+    [&](const ImageType::IndexType & lineIndex,
+        const itk::SizeValueType     lineLength,
+        const float *                line,
+        const float *                adaptorLine) {
+      EXPECT_EQ(lineIndex[0], 3);
+      EXPECT_EQ(lineIndex[1], 4 + static_cast<itk::IndexValueType>(numberOfLines));
+      ASSERT_EQ(lineLength, 20u);
+      for (itk::SizeValueType i = 0; i < lineLength; ++i)
+      {
+        auto index = lineIndex;
+        index[0] += i;
+        EXPECT_EQ(line[i], image->GetPixel(index));
+        EXPECT_EQ(adaptorLine[i], -image->GetPixel(index));
+      }
+      ++numberOfLines;
+    },
+    *image,
+    *adaptor);
+  EXPECT_EQ(numberOfLines, 5u);
+
+  StatisticsAccumulatorType imageAccumulator;
+  itk::ImageReduction::Accumulate(*image, region, imageAccumulator);
+  StatisticsAccumulatorType adaptorAccumulator;
+  itk::ImageReduction::Accumulate(*adaptor, region, adaptorAccumulator);
+
+  EXPECT_EQ(imageAccumulator.GetCount(), region.GetNumberOfPixels());
+  EXPECT_EQ(imageAccumulator.GetMinimum(), -adaptorAccumulator.GetMaximum());
+  EXPECT_EQ(imageAccumulator.GetSum(), -adaptorAccumulator.GetSum());
+}
+
+
+// Tests that ImageReductionPartials merges the partial reductions in the same
+// order, whatever the order in which they are added.
+TEST(ImageReduction, MergesPartialsDeterministically)
+{
+  const auto image = CreateImage();
+  const auto bufferedRegion = image->GetBufferedRegion();
+
+  std::vector<RegionType> regions;
+  for (itk::IndexValueType y = 0; y < 9; ++y)
+  {
+    RegionType region = bufferedRegion;
+    region.SetIndex(1, bufferedRegion.GetIndex(1) + y);
+    region.SetSize(1, 1);
+    regions.push_back(region);
+  }
+
+  // Merges the partials, after adding them in the specified order, in a
+  // string which records the order of the merges.
+  const auto mergeInOrder = [&regions](const std::vector<size_t> & order) {
+    itk::ImageReductionPartials<std::string, Dimension> partials;
+    for (const size_t i : order)
+    {
+      partials.Add(regions[i], std::to_string(i));
+    }
+    std::string result;
+    partials.MergeInto(result, [](std::string & partial, const std::string & otherPartial) {
+      partial = '(' + partial + otherPartial + ')';
+    });
+    return result;
+  };
+
+  std::vector<size_t> order(regions.size());
+  std::iota(order.begin(), order.end(), 0);
+  const std::string expectedResult = mergeInOrder(order);
+  EXPECT_EQ(expectedResult, "(((((01)(23))((45)(67)))8))");
+
+  std::reverse(order.begin(), order.end());
+  EXPECT_EQ(mergeInOrder(order), expectedResult);
+  std::rotate(order.begin(), order.begin() + 4, order.end());
+  EXPECT_EQ(mergeInOrder(order), expectedResult);
+
+  itk::ImageReductionPartials<StatisticsAccumulatorType, Dimension> statisticsPartials;
+  for (const auto & region : regions)
+  {
+    StatisticsAccumulatorType accumulator;
+    itk::ImageReduction::Accumulate(*image, region, accumulator);
+    statisticsPartials.Add(region, accumulator);
+  }
+  StatisticsAccumulatorType mergedAccumulator;
+  statisticsPartials.MergeInto(mergedAccumulator);
+
+  StatisticsAccumulatorType accumulator;
+  itk::ImageReduction::Accumulate(*image, bufferedRegion, accumulator);
+  EXPECT_EQ(mergedAccumulator.GetCount(), accumulator.GetCount());
+  EXPECT_EQ(mergedAccumulator.GetMinimum(), accumulator.GetMinimum());
+  EXPECT_EQ(mergedAccumulator.GetMaximum(), accumulator.GetMaximum());
+  EXPECT_NEAR(mergedAccumulator.GetMean(), accumulator.GetMean(), 1e-12);
+  EXPECT_NEAR(mergedAccumulator.GetVariance(), accumulator.GetVariance(), 1e-9);
+}
+
+TEST(ImageReduction, MergesPiecesInOrder)
+{
+  const auto bufferedRegion = CreateImage()->GetBufferedRegion();
+
+  // A partial reduction which records the order of the merges, and shares a
+  // token with the other partial reductions, to count those which are kept.
+  struct Partial
+  {
+    std::string           m_Value;
+    std::shared_ptr<char> m_Token;
+  };
+  const auto token = std::make_shared<char>();
+  const auto mergeFunction = [](Partial & partial, const Partial & otherPartial) {
+    partial.m_Value = '(' + partial.m_Value + otherPartial.m_Value + ')';
+  };
+
+  itk::ImageReductionPartials<Partial, Dimension> partials;
+  const std::vector<std::vector<itk::IndexValueType>> pieces = { { 3, 1, 0, 2 }, { 8, 4, 7, 5, 6 } };
+  for (size_t n = 0; n < pieces.size(); ++n)
+  {
+    for (const itk::IndexValueType y : pieces[n])
+    {
+      RegionType region = bufferedRegion;
+      region.SetIndex(1, bufferedRegion.GetIndex(1) + y);
+      region.SetSize(1, 1);
+      partials.Add(region, Partial{ std::to_string(y), token });
+    }
+    // The partial reductions of the piece, and the result of the previous
+    // pieces, are kept until the piece is merged.
+    EXPECT_EQ(token.use_count(), static_cast<long>(1 + pieces[n].size() + (n > 0 ? 1 : 0)));
+    partials.MergePiece(mergeFunction);
+    EXPECT_EQ(token.use_count(), 2);
+  }
+
+  Partial result;
+  partials.MergeInto(result, mergeFunction);
+  EXPECT_EQ(result.m_Value, "((((01)(23))(((45)(67))8)))");
+  EXPECT_EQ(token.use_count(), 1);
+}
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
+#include "itkTestingMacros.h"
+#include <atomic>
+#include <string>
+
+namespace
+{
+// Reserve, grow, shrink and squeeze a container allocated with the policy,
+// and check the alignment and the values of its elements.
+template <typename TElement>
+int
+TestContainer(const itk::ImageBufferAllocationPolicy & policy, const TElement & value, size_t expectedAlignment)
+{
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, TElement>;
+
+  auto container = ContainerType::New();
+  container->SetAllocationPolicy(policy);
+  ITK_TEST_SET_GET_VALUE(policy, container->GetAllocationPolicy());
+
+  const itk::SizeValueType size = 600000;
+  container->Reserve(size, true);
+  bool testPassed = reinterpret_cast<uintptr_t>(container->GetBufferPointer()) % expectedAlignment == 0;
+  for (itk::SizeValueType i = 0; i < size; ++i)
+  {
+    testPassed &= (*container)[i] == TElement{};
+    (*container)[i] = value;
+  }
+
+  container->Reserve(2 * size);
+  testPassed &= reinterpret_cast<uintptr_t>(container->GetBufferPointer()) % expectedAlignment == 0;
+  testPassed &= (*container)[0] == value && (*container)[size - 1] == value;
+  container->Reserve(3);
+  container->Squeeze();
+  ITK_TEST_EXPECT_EQUAL(container->Capacity(), 3);
+  testPassed &= (*container)[0] == value && (*container)[2] == value;
+  container->Initialize();
+  ITK_TEST_EXPECT_TRUE(container->GetBufferPointer() == nullptr);
+
+  if (!testPassed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Unexpected alignment or elements with the policy " << policy << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// A container that allocates its elements with new[] whatever its policy, as
+// the subclasses written before the allocation policies do.
+class NewArrayContainer : public itk::ImportImageContainer<itk::SizeValueType, float>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(NewArrayContainer);
+
+  using Self = NewArrayContainer;
+  using Superclass = itk::ImportImageContainer<itk::SizeValueType, float>;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(NewArrayContainer);
+
+protected:
+  NewArrayContainer() = default;
+  ~NewArrayContainer() override = default;
+
+  float *
+  AllocateElements(ElementIdentifier size, bool) const override
+  {
+    return new float[size]();
+  }
+};
+
+// Number of the parts of a buffer of size floats that are initialized
+// separately.
+unsigned int
+GetNumberOfParts(const itk::ImageBufferAllocationPolicy & policy, size_t size)
+{
+  std::atomic<unsigned int> numberOfParts{ 0 };
+  policy.ParallelizeBuffer(size, sizeof(float), [&numberOfParts](size_t, size_t) { ++numberOfParts; });
+  return numberOfParts;
+}
+} // namespace
+
+int
+itkImportImageContainerAllocationPolicyTest(int, char *[])
+{
+  // Several parts are initialized in parallel, even on a single processor.
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(3);
+
+  itk::ImageBufferAllocationPolicy defaultPolicy;
+  ITK_TEST_EXPECT_TRUE(defaultPolicy.IsDefault());
+  ITK_TEST_EXPECT_TRUE(itk::ImageBufferAllocationPolicy::GetGlobalDefault() == defaultPolicy);
+
+  itk::ImageBufferAllocationPolicy alignedPolicy;
+  alignedPolicy.Alignment = 64;
+  itk::ImageBufferAllocationPolicy firstTouchPolicy = alignedPolicy;
+  firstTouchPolicy.UseParallelFirstTouch = true;
+  itk::ImageBufferAllocationPolicy hugePagePolicy;
+  hugePagePolicy.UseHugePages = true;
+  hugePagePolicy.UseParallelFirstTouch = true;
+  ITK_TEST_EXPECT_TRUE(!hugePagePolicy.IsDefault());
+
+  bool testPassed = true;
+  testPassed &= TestContainer<float>(defaultPolicy, 3.0f, alignof(float)) == EXIT_SUCCESS;
+  testPassed &= TestContainer<float>(alignedPolicy, 3.0f, 64) == EXIT_SUCCESS;
+  testPassed &= TestContainer<float>(firstTouchPolicy, 3.0f, 64) == EXIT_SUCCESS;
+  testPassed &= TestContainer<double>(hugePagePolicy, 3.0, itk::ImageBufferAllocationPolicy::HugePageSize) ==
+                EXIT_SUCCESS;
+  // Elements that are constructed and destroyed.
+  testPassed &= TestContainer<std::string>(firstTouchPolicy, "A string longer than the small buffer", 64) ==
+                EXIT_SUCCESS;
+
+  itk::ImageBufferAllocationPolicy invalidPolicy;
+  invalidPolicy.Alignment = 48;
+  auto invalidContainer = itk::ImportImageContainer<itk::SizeValueType, float>::New();
+  invalidContainer->SetAllocationPolicy(invalidPolicy);
+  ITK_TRY_EXPECT_EXCEPTION(invalidContainer->Reserve(10));
+
+  // The buffers of an override of AllocateElements() are deallocated with
+  // delete[], whatever the policy of the container.
+  auto newArrayContainer = NewArrayContainer::New();
+  newArrayContainer->SetAllocationPolicy(alignedPolicy);
+  newArrayContainer->Reserve(1000);
+  newArrayContainer->Reserve(2000);
+  newArrayContainer->Reserve(10);
+  newArrayContainer->Squeeze();
+  ITK_TEST_EXPECT_EQUAL(newArrayContainer->Capacity(), 10);
+  newArrayContainer->Initialize();
+
+  // The small buffers, and the buffers allocated by the threads of the pool,
+  // are initialized by the calling thread.
+  const size_t largeSize = itk::ImageBufferAllocationPolicy::MinimumParallelFirstTouchSize / sizeof(float);
+  ITK_TEST_EXPECT_TRUE(GetNumberOfParts(firstTouchPolicy, largeSize) > 1);
+  ITK_TEST_EXPECT_EQUAL(GetNumberOfParts(firstTouchPolicy, largeSize - 1), 1);
+  ITK_TEST_EXPECT_EQUAL(GetNumberOfParts(alignedPolicy, largeSize), 1);
+  ITK_TEST_EXPECT_TRUE(!itk::ThreadPool::IsCurrentThreadInPool());
+  auto numberOfPartsInPool = itk::ThreadPool::GetInstance()->AddWork(
+    [firstTouchPolicy, largeSize] { return GetNumberOfParts(firstTouchPolicy, largeSize); });
+  ITK_TEST_EXPECT_EQUAL(numberOfPartsInPool.get(), 1);
+
+  // The images created from now on use the global default policy, which they
+  // keep when they are initialized.
+  itk::ImageBufferAllocationPolicy::SetGlobalDefault(firstTouchPolicy);
+  using ImageType = itk::Image<float, 3>;
+  auto image = ImageType::New();
+  ITK_TEST_EXPECT_TRUE(image->GetPixelContainer()->GetAllocationPolicy() == firstTouchPolicy);
+  itk::ImageBufferAllocationPolicy::SetGlobalDefault(defaultPolicy);
+  image->Initialize();
+  image->SetRegions(ImageType::SizeType{ { 30, 20, 10 } });
+  image->Allocate();
+  ITK_TEST_EXPECT_TRUE(image->GetPixelContainer()->GetAllocationPolicy() == firstTouchPolicy);
+  ITK_TEST_EXPECT_TRUE(reinterpret_cast<uintptr_t>(image->GetBufferPointer()) % 64 == 0);
+  ITK_TEST_EXPECT_EQUAL(image->GetPixel({ { 29, 19, 9 } }), 0.0f);
+  ITK_TEST_EXPECT_TRUE(ImageType::New()->GetPixelContainer()->GetAllocationPolicy() == defaultPolicy);
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -107,3 +107,74 @@ TEST(ObjectFactoryBase, CreatedInstanceHasReferenceCountOfTwo)
   // Avoid a memory leak.
   instance->UnRegister();
 }
+
+
+namespace
+{
+// Another "dummy" object type, created by the overriding factory below.
+class OtherTestObject : public itk::LightObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OtherTestObject);
+
+  using Self = OtherTestObject;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkOverrideGetNameOfClassMacro(OtherTestObject);
+
+  itkFactorylessNewMacro(Self);
+
+protected:
+  OtherTestObject() = default;
+  ~OtherTestObject() override = default;
+};
+
+
+// A test object factory which creates its overrides by name itself.
+class OverridingTestObjectFactory : public TestObjectFactory
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OverridingTestObjectFactory);
+
+  using Self = OverridingTestObjectFactory;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkOverrideGetNameOfClassMacro(OverridingTestObjectFactory);
+
+  itkFactorylessNewMacro(Self);
+
+protected:
+  OverridingTestObjectFactory() = default;
+  ~OverridingTestObjectFactory() override = default;
+
+  itk::LightObject::Pointer
+  CreateObject(const char * itkclassname, const char * overrideWithName) override
+  {
+    if (std::string(overrideWithName) == "Other Test Object")
+    {
+      return OtherTestObject::New().GetPointer();
+    }
+    return Superclass::CreateObject(itkclassname, overrideWithName);
+  }
+};
+} // namespace
+
+
+// Tests that ObjectFactoryBase::CreateInstance, with the name of an override, creates the instance of that override
+// through the virtual CreateObject of the registered factories.
+TEST(ObjectFactoryBase, CreateInstanceOfOverride)
+{
+  const TestObjectFactoryRegistration registration{};
+
+  const auto instance = itk::ObjectFactoryBase::CreateInstance(testObjectTypeName, testObjectTypeName);
+  ASSERT_NE(instance, nullptr);
+  EXPECT_EQ(instance->GetReferenceCount(), 1);
+
+  EXPECT_EQ(itk::ObjectFactoryBase::CreateInstance(testObjectTypeName, "Other Test Object"), nullptr);
+
+  const auto factory = OverridingTestObjectFactory::New();
+  itk::ObjectFactoryBase::RegisterFactory(factory);
+  const auto otherInstance = itk::ObjectFactoryBase::CreateInstance(testObjectTypeName, "Other Test Object");
+  itk::ObjectFactoryBase::UnRegisterFactory(factory);
+  EXPECT_NE(dynamic_cast<OtherTestObject *>(otherInstance.GetPointer()), nullptr);
+}
@@ -0,0 +1,237 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTimeProbe.h"
+#include "itkVersion.h"
+#include "itkTestingMacros.h"
+#include <atomic>
+#include <vector>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+template <unsigned int VIndex>
+class OverridingImage : public ImageType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OverridingImage);
+
+  using Self = OverridingImage;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OverridingImage);
+
+protected:
+  OverridingImage() = default;
+};
+
+// Factory whose overrides may be registered after the factory.
+class OverrideCacheTestFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OverrideCacheTestFactory);
+
+  using Self = OverrideCacheTestFactory;
+  using Pointer = itk::SmartPointer<Self>;
+
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "Override cache test factory";
+  }
+
+  itkFactorylessNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OverrideCacheTestFactory);
+
+  template <unsigned int VIndex>
+  void
+  AddOverride()
+  {
+    this->RegisterOverride(typeid(ImageType).name(),
+                           typeid(OverridingImage<VIndex>).name(),
+                           "Override cache test image",
+                           true,
+                           itk::CreateObjectFunction<OverridingImage<VIndex>>::New());
+  }
+
+protected:
+  OverrideCacheTestFactory() = default;
+};
+
+// Factory which creates images in its own CreateObject(), while enabled, and
+// otherwise uses the default implementation.
+class CreateObjectTestFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CreateObjectTestFactory);
+
+  using Self = CreateObjectTestFactory;
+  using Superclass = itk::ObjectFactoryBase;
+  using Pointer = itk::SmartPointer<Self>;
+
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "Create object test factory";
+  }
+
+  itkFactorylessNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CreateObjectTestFactory);
+
+  bool CreatesImages{ false };
+
+protected:
+  CreateObjectTestFactory() = default;
+
+  itk::LightObject::Pointer
+  CreateObject(const char * itkclassname) override
+  {
+    if (CreatesImages && std::string(itkclassname) == typeid(ImageType).name())
+    {
+      return OverridingImage<3>::New().GetPointer();
+    }
+    return Superclass::CreateObject(itkclassname);
+  }
+};
+
+bool
+ExpectNewImage(const char * expectedClassName)
+{
+  const auto image = ImageType::New();
+  if (std::string(image->GetNameOfClass()) != expectedClassName)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "New() created " << image->GetNameOfClass() << " instead of " << expectedClassName << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkObjectFactoryOverrideCacheTest(int, char *[])
+{
+  bool testPassed = ExpectNewImage("Image");
+
+  // Overrides registered with a factory that is already registered.
+  auto factory = OverrideCacheTestFactory::New();
+  itk::ObjectFactoryBase::RegisterFactory(factory);
+  testPassed &= ExpectNewImage("Image");
+  factory->AddOverride<1>();
+  testPassed &= ExpectNewImage("OverridingImage");
+
+  // A factory registered in front takes precedence.
+  auto frontFactory = OverrideCacheTestFactory::New();
+  frontFactory->AddOverride<2>();
+  itk::ObjectFactoryBase::RegisterFactory(frontFactory, itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
+  ITK_TEST_EXPECT_EQUAL(std::string(ImageType::New()->GetNameOfClass()), "OverridingImage");
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<2> *>(ImageType::New().GetPointer()) != nullptr);
+
+  // Disabled and unregistered overrides are no longer used.
+  frontFactory->Disable(typeid(ImageType).name());
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<1> *>(ImageType::New().GetPointer()) != nullptr);
+  frontFactory->SetEnableFlag(true, typeid(ImageType).name(), typeid(OverridingImage<2>).name());
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<2> *>(ImageType::New().GetPointer()) != nullptr);
+  itk::ObjectFactoryBase::UnRegisterFactory(frontFactory);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<1> *>(ImageType::New().GetPointer()) != nullptr);
+  itk::ObjectFactoryBase::UnRegisterFactory(factory);
+  testPassed &= ExpectNewImage("Image");
+
+  // A factory which overrides CreateObject() keeps being called through it,
+  // and the next factory creates the object when it returns nullptr.
+  auto createObjectFactory = CreateObjectTestFactory::New();
+  itk::ObjectFactoryBase::RegisterFactory(createObjectFactory);
+  itk::ObjectFactoryBase::RegisterFactory(factory);
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<1> *>(ImageType::New().GetPointer()) != nullptr);
+  createObjectFactory->CreatesImages = true;
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<3> *>(ImageType::New().GetPointer()) != nullptr);
+  createObjectFactory->CreatesImages = false;
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<OverridingImage<1> *>(ImageType::New().GetPointer()) != nullptr);
+  itk::ObjectFactoryBase::UnRegisterFactory(factory);
+  itk::ObjectFactoryBase::UnRegisterFactory(createObjectFactory);
+  testPassed &= ExpectNewImage("Image");
+
+  // Concurrent creation, while the cache is filled.
+  std::atomic<unsigned int> numberOfImages{ 0 };
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    1000,
+    [&numberOfImages](itk::SizeValueType) {
+      if (std::string(ImageType::New()->GetNameOfClass()) == "Image" &&
+          std::string(itk::Image<short, 2>::New()->GetNameOfClass()) == "Image")
+      {
+        ++numberOfImages;
+      }
+    },
+    nullptr);
+  ITK_TEST_EXPECT_EQUAL(numberOfImages.load(), 1000u);
+
+  // Throughput of New() for an override of the last of several registered
+  // factories, each of which looks up the override in its cache.
+  std::vector<OverrideCacheTestFactory::Pointer> factories;
+  for (unsigned int i = 0; i < 16; ++i)
+  {
+    factories.push_back(OverrideCacheTestFactory::New());
+    factories.back()->AddOverride<1>();
+    itk::ObjectFactoryBase::RegisterFactory(factories.back());
+    if (i + 1 < 16)
+    {
+      factories.back()->Disable(typeid(ImageType).name());
+    }
+  }
+  testPassed &= ExpectNewImage("OverridingImage");
+
+  constexpr unsigned int numberOfObjects = 200000;
+  itk::TimeProbe         probe;
+  probe.Start();
+  for (unsigned int i = 0; i < numberOfObjects; ++i)
+  {
+    ImageType::New();
+  }
+  probe.Stop();
+  std::cout << "New() throughput with " << factories.size()
+            << " registered factories: " << numberOfObjects / probe.GetTotal() << " objects per second" << std::endl;
+
+  for (const auto & registeredFactory : factories)
+  {
+    itk::ObjectFactoryBase::UnRegisterFactory(registeredFactory);
+  }
+  testPassed &= ExpectNewImage("Image");
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineProfiler.h"
+
+#include "itkExtractImageFilter.h"
+#include "itkImage.h"
+#include "itkStreamingImageFilter.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using EventType = itk::PipelineProfiler::Event;
+
+// Enables the profiler, without any recorded event, while it exists.
+class EnabledProfiler
+{
+public:
+  EnabledProfiler()
+  {
+    itk::PipelineProfiler::Clear();
+    itk::PipelineProfiler::SetEnabled(true);
+  }
+
+  ~EnabledProfiler()
+  {
+    itk::PipelineProfiler::SetEnabled(false);
+    itk::PipelineProfiler::Clear();
+  }
+};
+
+// Executes a pipeline which extracts an image in three streamed pieces.
+void
+ExecutePipeline()
+{
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 48 } });
+  image->AllocateInitialized();
+
+  const auto extractFilter = itk::ExtractImageFilter<ImageType, ImageType>::New();
+  extractFilter->SetInput(image);
+  extractFilter->SetExtractionRegion(image->GetLargestPossibleRegion());
+  extractFilter->SetDirectionCollapseToIdentity();
+  extractFilter->SetNumberOfWorkUnits(4);
+
+  const auto streamingFilter = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamingFilter->SetInput(extractFilter->GetOutput());
+  streamingFilter->SetNumberOfStreamDivisions(3);
+  streamingFilter->Update();
+}
+
+std::vector<EventType>
+GetEvents(const char * category)
+{
+  std::vector<EventType> events = itk::PipelineProfiler::GetEvents();
+  const auto isOtherCategory = [category](const EventType & event) {
+    return std::strcmp(event.Category, category) != 0;
+  };
+  events.erase(std::remove_if(events.begin(), events.end(), isOtherCategory), events.end());
+  return events;
+}
+} // namespace
+
+
+// Tests that the profiler records the execution of a pipeline, with the work
+// units of a filter nested within its GenerateData().
+TEST(PipelineProfiler, RecordsPipelineExecution)
+{
+  const EnabledProfiler enabledProfiler;
+  ExecutePipeline();
+
+  const auto streamDivisions = GetEvents("StreamDivisions");
+  ASSERT_EQ(streamDivisions.size(), 1u);
+  EXPECT_STREQ(streamDivisions.front().Name, "StreamingImageFilter");
+  EXPECT_FALSE(streamDivisions.front().IsInterval);
+  EXPECT_EQ(streamDivisions.front().Value, 3);
+  EXPECT_EQ(GetEvents("StreamedGenerateData").size(), 3u);
+
+  const auto generateData = GetEvents("GenerateData");
+  ASSERT_EQ(generateData.size(), 3u);
+  for (const EventType & event : generateData)
+  {
+    EXPECT_STREQ(event.Name, "ExtractImageFilter");
+    EXPECT_GE(event.Duration, 0);
+  }
+
+  const auto workUnits = GetEvents("WorkUnit");
+  EXPECT_GE(workUnits.size(), 3u);
+  for (const EventType & workUnit : workUnits)
+  {
+    EXPECT_STREQ(workUnit.Name, "ExtractImageFilter");
+    EXPECT_TRUE(std::any_of(generateData.cbegin(), generateData.cend(), [&workUnit](const EventType & event) {
+      return event.Object == workUnit.Object && event.StartTime <= workUnit.StartTime &&
+             workUnit.StartTime + workUnit.Duration <= event.StartTime + event.Duration;
+    }));
+  }
+
+  const auto allocations = GetEvents("Allocation");
+  EXPECT_TRUE(std::any_of(allocations.cbegin(), allocations.cend(), [](const EventType & event) {
+    return event.Value == static_cast<int64_t>(64 * 48 * sizeof(float));
+  }));
+}
+
+
+// Tests that the profiler does not record any event when it is disabled.
+TEST(PipelineProfiler, DoesNotRecordWhenDisabled)
+{
+  itk::PipelineProfiler::Clear();
+  ASSERT_FALSE(itk::PipelineProfiler::GetEnabled());
+  ExecutePipeline();
+  {
+    const itk::PipelineProfiler::ScopedInterval interval("Test", "Interval");
+    itk::PipelineProfiler::SetEnabled(true);
+  }
+  itk::PipelineProfiler::SetEnabled(false);
+  EXPECT_TRUE(itk::PipelineProfiler::GetEvents().empty());
+}
+
+
+// Tests that the ring buffer of a thread keeps its most recent events.
+TEST(PipelineProfiler, KeepsMostRecentEvents)
+{
+  const EnabledProfiler enabledProfiler;
+  const size_t          capacity = itk::PipelineProfiler::GetThreadBufferCapacity();
+  itk::PipelineProfiler::SetThreadBufferCapacity(4);
+
+  std::thread thread([] {
+    for (int i = 0; i < 10; ++i)
+    {
+      itk::PipelineProfiler::RecordValue("Test", "Value", nullptr, i);
+    }
+  });
+  thread.join();
+  itk::PipelineProfiler::SetThreadBufferCapacity(capacity);
+
+  const auto events = GetEvents("Test");
+  ASSERT_EQ(events.size(), 4u);
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(events[i].Value, 6 + i);
+  }
+}
+
+
+// Tests that the threads which start after others exited reuse their ring
+// buffers.
+TEST(PipelineProfiler, ReusesBuffersOfExitedThreads)
+{
+  const EnabledProfiler enabledProfiler;
+  for (int i = 0; i < 5; ++i)
+  {
+    std::thread([i] { itk::PipelineProfiler::RecordValue("Test", "Value", nullptr, i); }).join();
+  }
+
+  const auto events = GetEvents("Test");
+  ASSERT_EQ(events.size(), 5u);
+  for (const EventType & event : events)
+  {
+    EXPECT_EQ(event.ThreadIndex, events.front().ThreadIndex);
+  }
+}
+
+
+// Tests that the trace is written in the Trace Event format of Chrome.
+TEST(PipelineProfiler, WritesChromeTrace)
+{
+  const EnabledProfiler enabledProfiler;
+  {
+    const itk::PipelineProfiler::ScopedInterval interval("Test", "Interval\"");
+  }
+  itk::PipelineProfiler::RecordValue("Test", "Value", nullptr, 42);
+
+  std::ostringstream stream;
+  itk::PipelineProfiler::WriteChromeTrace(stream);
+  const std::string trace = stream.str();
+
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find("{\"name\":\"Interval\\\"\",\"cat\":\"Test\",\"ph\":\"X\",\"ts\":"), std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"Value\",\"cat\":\"Test\",\"ph\":\"i\",\"ts\":"), std::string::npos);
+  EXPECT_NE(trace.find("\"value\":42}"), std::string::npos);
+  EXPECT_NE(trace.find("\"thread_name\""), std::string::npos);
+  EXPECT_EQ(trace.substr(trace.size() - 3), "]}\n");
+}
@@ -0,0 +1,254 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSymmetricEigenAnalysisClosedForm.h"
+#include "itkSymmetricSecondRankTensor.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Compare the eigen analysis of random matrices, and of matrices with
+// repeated eigen values, with that of SymmetricEigenAnalysisFixedDimension,
+// for every ordering of the eigen values.
+template <unsigned int VDimension>
+int
+TestClosedForm(unsigned int numberOfMatrices)
+{
+  using MatrixType = itk::SymmetricSecondRankTensor<double, VDimension>;
+  using VectorType = itk::FixedArray<double, VDimension>;
+  using EigenMatrixType = itk::Matrix<double, VDimension, VDimension>;
+  using ClosedFormType = itk::SymmetricEigenAnalysisClosedForm<VDimension, MatrixType, VectorType, EigenMatrixType>;
+  using ReferenceType =
+    itk::SymmetricEigenAnalysisFixedDimension<VDimension, MatrixType, VectorType, EigenMatrixType>;
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+
+  std::vector<MatrixType> matrices(numberOfMatrices);
+  for (unsigned int n = 0; n < numberOfMatrices; ++n)
+  {
+    // Random rotation of a diagonal matrix, whose eigen values are repeated,
+    // nearly repeated, or of very different magnitudes for some of the
+    // matrices.
+    itk::Matrix<double, VDimension, VDimension> rotation;
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        rotation[i][j] = generator->GetNormalVariate();
+      }
+      for (unsigned int k = 0; k < i; ++k)
+      {
+        double dot = 0.0;
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          dot += rotation[i][j] * rotation[k][j];
+        }
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          rotation[i][j] -= dot * rotation[k][j];
+        }
+      }
+      double norm = 0.0;
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        norm += rotation[i][j] * rotation[i][j];
+      }
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        rotation[i][j] /= std::sqrt(norm);
+      }
+    }
+    double values[VDimension];
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      values[i] = generator->GetUniformVariate(-10.0, 10.0);
+    }
+    switch (n % 6)
+    {
+      case 1:
+        values[VDimension - 1] = values[0];
+        break;
+      case 5:
+        values[VDimension - 1] = values[0] * (1.0 + 1e-7);
+        break;
+      case 2:
+        values[0] = -values[VDimension - 1];
+        break;
+      case 3:
+        values[0] *= 1e-6;
+        break;
+      case 4:
+        for (unsigned int i = 0; i < VDimension; ++i)
+        {
+          values[i] = n % 2 ? values[0] : 0.0;
+        }
+        break;
+      default:
+        break;
+    }
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      for (unsigned int j = i; j < VDimension; ++j)
+      {
+        double component = 0.0;
+        for (unsigned int k = 0; k < VDimension; ++k)
+        {
+          component += rotation[k][i] * values[k] * rotation[k][j];
+        }
+        matrices[n](i, j) = component;
+      }
+    }
+  }
+
+  for (const auto order : { itk::EigenValueOrderEnum::OrderByValue,
+                            itk::EigenValueOrderEnum::OrderByMagnitude,
+                            itk::EigenValueOrderEnum::DoNotOrder })
+  {
+    ClosedFormType closedForm;
+    ReferenceType  reference;
+    closedForm.SetOrderEigenValues(order == itk::EigenValueOrderEnum::OrderByValue);
+    reference.SetOrderEigenValues(order == itk::EigenValueOrderEnum::OrderByValue);
+    if (order == itk::EigenValueOrderEnum::OrderByMagnitude)
+    {
+      closedForm.SetOrderEigenMagnitudes(true);
+      reference.SetOrderEigenMagnitudes(true);
+    }
+    ITK_TEST_EXPECT_EQUAL(closedForm.GetOrderEigenValues(), reference.GetOrderEigenValues());
+    ITK_TEST_EXPECT_EQUAL(closedForm.GetOrderEigenMagnitudes(), reference.GetOrderEigenMagnitudes());
+
+    std::vector<VectorType>      values(numberOfMatrices);
+    std::vector<VectorType>      valuesWithVectors(numberOfMatrices);
+    std::vector<EigenMatrixType> vectors(numberOfMatrices);
+    closedForm.ComputeEigenValues(matrices.data(), values.data(), numberOfMatrices);
+    closedForm.ComputeEigenValuesAndVectors(
+      matrices.data(), valuesWithVectors.data(), vectors.data(), numberOfMatrices);
+
+    for (unsigned int n = 0; n < numberOfMatrices; ++n)
+    {
+      const MatrixType & matrix = matrices[n];
+      double             norm = 0.0;
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          norm = std::max(norm, std::abs(matrix(i, j)));
+        }
+      }
+      // The eigen values are as accurate as those of the iterative solver, also
+      // near repeated eigen values.
+      const double tolerance = 1e-11 * std::max(norm, 1.0);
+
+      VectorType      singleValues;
+      VectorType      referenceValues;
+      EigenMatrixType referenceVectors;
+      closedForm.ComputeEigenValues(matrix, singleValues);
+      reference.ComputeEigenValuesAndVectors(matrix, referenceValues, referenceVectors);
+
+      // Eigen values of equal magnitude may be ordered either way: compare
+      // the sorted eigen values, and check the order separately.
+      VectorType sortedValues = values[n];
+      std::sort(sortedValues.Begin(), sortedValues.End());
+      std::sort(referenceValues.Begin(), referenceValues.End());
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        const double key = order == itk::EigenValueOrderEnum::OrderByMagnitude ? std::abs(values[n][i]) : values[n][i];
+        const double nextKey = i + 1 == VDimension ? key
+                               : order == itk::EigenValueOrderEnum::OrderByMagnitude ? std::abs(values[n][i + 1])
+                                                                                     : values[n][i + 1];
+        if (singleValues[i] != values[n][i] || valuesWithVectors[n][i] != values[n][i] ||
+            std::abs(sortedValues[i] - referenceValues[i]) > tolerance || nextKey < key)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Dimension " << VDimension << ", order " << order << ": eigen values " << values[n]
+                    << " instead of " << referenceValues << " for matrix " << n << ": " << matrix << std::endl;
+          return EXIT_FAILURE;
+        }
+
+        // Each row is a unit eigen vector, orthogonal to the other rows.
+        for (unsigned int k = 0; k < VDimension; ++k)
+        {
+          double dot = 0.0;
+          for (unsigned int j = 0; j < VDimension; ++j)
+          {
+            dot += vectors[n][i][j] * vectors[n][k][j];
+          }
+          double residual = 0.0;
+          for (unsigned int j = 0; j < VDimension; ++j)
+          {
+            residual += matrix(k, j) * vectors[n][i][j];
+          }
+          residual -= values[n][i] * vectors[n][i][k];
+          if (std::abs(dot - (i == k ? 1.0 : 0.0)) > 1e-10 || std::abs(residual) > tolerance)
+          {
+            std::cerr << "Test failed!" << std::endl;
+            std::cerr << "Dimension " << VDimension << ", order " << order << ": eigen vectors " << vectors[n]
+                      << " of eigen values " << values[n] << " for matrix " << n << ": " << matrix << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSymmetricEigenAnalysisClosedFormTest(int, char *[])
+{
+  using ClosedFormType = itk::SymmetricEigenAnalysisClosedForm<3,
+                                                               itk::SymmetricSecondRankTensor<float, 3>,
+                                                               itk::FixedArray<float, 3>,
+                                                               itk::Matrix<float, 3, 3>>;
+  ClosedFormType closedForm;
+  ITK_TEST_EXPECT_TRUE(closedForm.GetOrderEigenValues());
+  ITK_TEST_EXPECT_TRUE(!closedForm.GetOrderEigenMagnitudes());
+  ITK_TEST_EXPECT_EQUAL(closedForm.GetDimension(), 3u);
+  std::cout << closedForm;
+
+  // Single precision pixels, with an overflowing square.
+  itk::SymmetricSecondRankTensor<float, 3> tensor;
+  tensor.Fill(0.0f);
+  tensor(0, 0) = 1e20f;
+  tensor(1, 1) = 2e20f;
+  tensor(0, 1) = 1e20f;
+  itk::FixedArray<float, 3> values;
+  itk::Matrix<float, 3, 3>  vectors;
+  closedForm.ComputeEigenValuesAndVectors(tensor, values, vectors);
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(values[0], 0.0f, 4, 1e10f));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(values[1], 1.5e20f - 0.5e20f * std::sqrt(5.0f), 4, 1e14f));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(values[2], 1.5e20f + 0.5e20f * std::sqrt(5.0f), 4, 1e14f));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(std::abs(vectors[0][2]), 1.0f));
+
+  bool testPassed = true;
+  // Numbers of matrices that are not multiples of the block size.
+  testPassed &= TestClosedForm<2>(1003) == EXIT_SUCCESS;
+  testPassed &= TestClosedForm<3>(1003) == EXIT_SUCCESS;
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -144,10 +144,24 @@ protected:
   CalculateChange() override;
 
   /** This method allocates storage in m_UpdateBuffer.  It is called from
-   * Superclass::GenerateData(). */
+   * Superclass::GenerateData(). No storage is allocated when the time step
+   * is fixed. */
   void
   AllocateUpdateBuffer() override;
 
+  /** Whether the time step returned by the difference function is known
+   * before the changes of an iteration are calculated, as for anisotropic
+   * diffusion. The change of each pixel is then applied as soon as the pixel
+   * is no longer needed to calculate the changes of its neighbors:
+   * CalculateChange() updates the output a slice at a time through small
+   * per-thread buffers, ApplyUpdate() does nothing, and the update buffer is
+   * not allocated. The output is the same as with the update buffer. */
+  virtual bool
+  HasFixedTimeStep() const
+  {
+    return false;
+  }
+
   /** The type of region used for multithreading */
   using ThreadRegionType = typename UpdateBufferType::RegionType;
 
@@ -166,6 +180,20 @@ protected:
   ThreadedCalculateChange(const ThreadRegionType & regionToProcess, ThreadIdType threadId);
 
 private:
+  /** Calculate the change of the pixels of a region into a buffer whose
+   * buffered region contains it. */
+  void
+  CalculateChangeOverRegion(const ThreadRegionType & regionToProcess, UpdateBufferType * buffer, void * globalData);
+
+  /** Add the changes of a buffer, times dt, to the output over a region. */
+  void
+  ApplyUpdateOverRegion(const TimeStepType & dt, const ThreadRegionType & regionToProcess, UpdateBufferType * buffer);
+
+  /** Calculate and apply the changes of an iteration with a fixed time step,
+   * slab by slab along the last dimension. */
+  void
+  CalculateAndApplyChangeBySlices(const TimeStepType & dt);
+
   /** Structure for passing information into static callback methods.  Used in
    * the subclasses' threading mechanisms. */
   struct DenseFDThreadStruct
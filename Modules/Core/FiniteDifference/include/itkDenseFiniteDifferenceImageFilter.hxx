@@ -22,7 +22,9 @@
 #include "itkNumericTraits.h"
 #include "itkNeighborhoodAlgorithm.h"
 
+#include <algorithm>
 #include <functional> // For equal_to.
+#include <vector>
 
 
 namespace itk
@@ -63,6 +65,14 @@ template <typename TInputImage, typename TOutputImage>
 void
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::AllocateUpdateBuffer()
 {
+  // The changes are applied without update buffer when the time step is
+  // fixed.
+  if (this->HasFixedTimeStep())
+  {
+    m_UpdateBuffer->Initialize();
+    return;
+  }
+
   // The update buffer looks just like the output.
   typename TOutputImage::Pointer output = this->GetOutput();
 
@@ -79,6 +89,12 @@ template <typename TInputImage, typename TOutputImage>
 void
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ApplyUpdate(const TimeStepType & dt)
 {
+  // With a fixed time step, the changes are applied by CalculateChange().
+  if (this->HasFixedTimeStep())
+  {
+    return;
+  }
+
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
@@ -121,6 +137,19 @@ template <typename TInputImage, typename TOutputImage>
 auto
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::CalculateChange() -> TimeStepType
 {
+  if (this->HasFixedTimeStep())
+  {
+    const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+
+    void *             globalData = df->GetGlobalDataPointer();
+    const TimeStepType dt = df->ComputeGlobalTimeStep(globalData);
+    df->ReleaseGlobalDataPointer(globalData);
+
+    this->CalculateAndApplyChangeBySlices(dt);
+    this->GetOutput()->Modified();
+    return dt;
+  }
+
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
@@ -188,7 +217,17 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedApplyUpdate
   const ThreadRegionType & regionToProcess,
   ThreadIdType)
 {
-  ImageRegionIterator<UpdateBufferType> u(m_UpdateBuffer, regionToProcess);
+  this->ApplyUpdateOverRegion(dt, regionToProcess, m_UpdateBuffer);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ApplyUpdateOverRegion(
+  const TimeStepType &     dt,
+  const ThreadRegionType & regionToProcess,
+  UpdateBufferType *       buffer)
+{
+  ImageRegionIterator<UpdateBufferType> u(buffer, regionToProcess);
   ImageRegionIterator<OutputImageType>  o(this->GetOutput(), regionToProcess);
 
   while (!u.IsAtEnd())
@@ -205,6 +244,34 @@ auto
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateChange(
   const ThreadRegionType & regionToProcess,
   ThreadIdType) -> TimeStepType
+{
+  // Get the FiniteDifferenceFunction to use in calculations.
+  const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+
+  // Ask the function object for a pointer to a data structure it
+  // will use to manage any global values it needs.  We'll pass this
+  // back to the function object at each calculation and then
+  // again so that the function object can use it to determine a
+  // time step for this iteration.
+  void * globalData = df->GetGlobalDataPointer();
+
+  this->CalculateChangeOverRegion(regionToProcess, m_UpdateBuffer, globalData);
+
+  // Ask the finite difference function to compute the time step for
+  // this iteration.  We give it the global data pointer to use, then
+  // ask it to free the global data memory.
+  TimeStepType timeStep = df->ComputeGlobalTimeStep(globalData);
+  df->ReleaseGlobalDataPointer(globalData);
+
+  return timeStep;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::CalculateChangeOverRegion(
+  const ThreadRegionType & regionToProcess,
+  UpdateBufferType *       buffer,
+  void *                   globalData)
 {
   using SizeType = typename OutputImageType::SizeType;
   using NeighborhoodIteratorType = typename FiniteDifferenceFunctionType::NeighborhoodType;
@@ -213,18 +280,10 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateCh
 
   typename OutputImageType::Pointer output = this->GetOutput();
 
-  // Get the FiniteDifferenceFunction to use in calculations.
   const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
 
   const SizeType radius = df->GetRadius();
 
-  // Ask the function object for a pointer to a data structure it
-  // will use to manage any global values it needs.  We'll pass this
-  // back to the function object at each calculation and then
-  // again so that the function object can use it to determine a
-  // time step for this iteration.
-  void * globalData = df->GetGlobalDataPointer();
-
   // Break the input into a series of regions.  The first region is free
   // of boundary conditions, the rest with boundary conditions.  We operate
   // on the output region because input has been copied to output.
@@ -240,7 +299,7 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateCh
 
   // Process the non-boundary region.
   NeighborhoodIteratorType nD(radius, output, *fIt);
-  UpdateIteratorType       nU(m_UpdateBuffer, *fIt);
+  UpdateIteratorType       nU(buffer, *fIt);
   nD.GoToBegin();
   while (!nD.IsAtEnd())
   {
@@ -253,7 +312,7 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateCh
   for (++fIt; fIt != fEnd; ++fIt)
   {
     NeighborhoodIteratorType bD(radius, output, *fIt);
-    UpdateIteratorType       bU(m_UpdateBuffer, *fIt);
+    UpdateIteratorType       bU(buffer, *fIt);
 
     bD.GoToBegin();
     while (!bD.IsAtEnd())
@@ -263,14 +322,127 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateCh
       ++bU;
     }
   }
+}
 
-  // Ask the finite difference function to compute the time step for
-  // this iteration.  We give it the global data pointer to use, then
-  // ask it to free the global data memory.
-  TimeStepType timeStep = df->ComputeGlobalTimeStep(globalData);
-  df->ReleaseGlobalDataPointer(globalData);
+template <typename TInputImage, typename TOutputImage>
+void
+DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::CalculateAndApplyChangeBySlices(const TimeStepType & dt)
+{
+  constexpr unsigned int slowDimension = ImageDimension - 1;
+
+  const ThreadRegionType region = this->GetOutput()->GetRequestedRegion();
+  const SizeValueType    numberOfSlices = region.GetSize(slowDimension);
+  const SizeValueType    radius = this->GetDifferenceFunction()->GetRadius()[slowDimension];
+
+  // The image is split into slabs of at least 2 * radius slices. The changes
+  // of the first and last radius slices of each slab, which the neighboring
+  // slabs need, are calculated first; each slab is then swept, applying the
+  // change of a slice as soon as the slices after it no longer need it.
+  const SizeValueType numberOfSlabs = std::max<SizeValueType>(
+    1,
+    std::min<SizeValueType>(this->GetNumberOfWorkUnits(),
+                            radius > 0 ? numberOfSlices / (2 * radius) : numberOfSlices));
+
+  const auto computeSlabRegion = [&](SizeValueType slab) {
+    ThreadRegionType    slabRegion = region;
+    const SizeValueType first = slab * numberOfSlices / numberOfSlabs;
+    slabRegion.SetIndex(slowDimension, region.GetIndex(slowDimension) + static_cast<IndexValueType>(first));
+    slabRegion.SetSize(slowDimension, (slab + 1) * numberOfSlices / numberOfSlabs - first);
+    return slabRegion;
+  };
+  const auto slicesRegion = [](ThreadRegionType slices, IndexValueType first, SizeValueType count) {
+    slices.SetIndex(slowDimension, first);
+    slices.SetSize(slowDimension, count);
+    return slices;
+  };
+  const auto allocateBuffer = [](const ThreadRegionType & bufferRegion) {
+    auto buffer = UpdateBufferType::New();
+    buffer->SetRegions(bufferRegion);
+    buffer->Allocate();
+    return buffer;
+  };
+
+  std::vector<typename UpdateBufferType::Pointer> firstSlices(numberOfSlabs);
+  std::vector<typename UpdateBufferType::Pointer> lastSlices(numberOfSlabs);
 
-  return timeStep;
+  const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      const ThreadRegionType slabRegion = computeSlabRegion(slab);
+      const IndexValueType   first = slabRegion.GetIndex(slowDimension);
+      const IndexValueType   end = first + static_cast<IndexValueType>(slabRegion.GetSize(slowDimension));
+      void *                 globalData = df->GetGlobalDataPointer();
+      if (slab > 0 && radius > 0)
+      {
+        firstSlices[slab] = allocateBuffer(slicesRegion(slabRegion, first, radius));
+        this->CalculateChangeOverRegion(firstSlices[slab]->GetBufferedRegion(), firstSlices[slab], globalData);
+      }
+      if (slab + 1 < numberOfSlabs && radius > 0)
+      {
+        lastSlices[slab] = allocateBuffer(slicesRegion(slabRegion, end - static_cast<IndexValueType>(radius), radius));
+        this->CalculateChangeOverRegion(lastSlices[slab]->GetBufferedRegion(), lastSlices[slab], globalData);
+      }
+      df->ReleaseGlobalDataPointer(globalData);
+    },
+    nullptr);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      const ThreadRegionType slabRegion = computeSlabRegion(slab);
+      const IndexValueType   begin =
+        slabRegion.GetIndex(slowDimension) + static_cast<IndexValueType>(firstSlices[slab] ? radius : 0);
+      const IndexValueType end = slabRegion.GetIndex(slowDimension) +
+                                 static_cast<IndexValueType>(slabRegion.GetSize(slowDimension)) -
+                                 static_cast<IndexValueType>(lastSlices[slab] ? radius : 0);
+      void * globalData = df->GetGlobalDataPointer();
+
+      // Ring of the changes of the last radius + 1 slices.
+      std::vector<typename UpdateBufferType::Pointer> changes(radius + 1);
+      for (auto & change : changes)
+      {
+        change = allocateBuffer(slicesRegion(slabRegion, begin, 1));
+      }
+      const auto ringSlot = [&changes, begin](IndexValueType slice) {
+        return changes[static_cast<SizeValueType>(slice - begin) % changes.size()].GetPointer();
+      };
+
+      for (IndexValueType slice = begin; slice < end; ++slice)
+      {
+        UpdateBufferType *     change = ringSlot(slice);
+        const ThreadRegionType sliceRegion = slicesRegion(slabRegion, slice, 1);
+        change->SetRegions(sliceRegion);
+        this->CalculateChangeOverRegion(sliceRegion, change, globalData);
+
+        // The changes of the next slices no longer depend on this one.
+        const IndexValueType finished = slice - static_cast<IndexValueType>(radius);
+        if (finished >= begin)
+        {
+          this->ApplyUpdateOverRegion(dt, ringSlot(finished)->GetBufferedRegion(), ringSlot(finished));
+        }
+      }
+      for (IndexValueType slice = std::max(begin, end - static_cast<IndexValueType>(radius)); slice < end; ++slice)
+      {
+        this->ApplyUpdateOverRegion(dt, ringSlot(slice)->GetBufferedRegion(), ringSlot(slice));
+      }
+      df->ReleaseGlobalDataPointer(globalData);
+
+      // The neighboring slabs needed the first and last slices only to
+      // calculate the changes of their own first and last slices.
+      for (const auto & slices : { firstSlices[slab], lastSlices[slab] })
+      {
+        if (slices)
+        {
+          this->ApplyUpdateOverRegion(dt, slices->GetBufferedRegion(), slices);
+        }
+      }
+    },
+    nullptr);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -136,6 +136,13 @@ protected:
   void
   AllocateUpdateBuffer() override;
 
+  /** The GPU kernels calculate the changes into the update buffer. */
+  bool
+  HasFixedTimeStep() const override
+  {
+    return false;
+  }
+
   /* GPU kernel handle for GPUApplyUpdate */
   int m_ApplyUpdateGPUKernelHandle{};
 };
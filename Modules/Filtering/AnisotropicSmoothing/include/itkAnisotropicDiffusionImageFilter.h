@@ -149,6 +149,14 @@ protected:
   void
   InitializeIteration() override;
 
+  /** The time step of the anisotropic diffusion functions is a parameter, so
+   * the changes are applied without update buffer. */
+  bool
+  HasFixedTimeStep() const override
+  {
+    return true;
+  }
+
   bool m_GradientMagnitudeIsFixed{};
 
 private:
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCurvatureAnisotropicDiffusionImageFilter.h"
+#include "itkGradientAnisotropicDiffusionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Anisotropic diffusion filter that calculates all the changes of an
+// iteration into the update buffer before applying them.
+template <typename TFilter>
+class UpdateBufferFilter : public TFilter
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(UpdateBufferFilter);
+
+  using Self = UpdateBufferFilter;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  UpdateBufferFilter() = default;
+
+  bool
+  HasFixedTimeStep() const override
+  {
+    return false;
+  }
+};
+
+// Diffuse a random image, applying the changes slice by slice with various
+// numbers of work units, and compare the result with that of the update
+// buffer.
+template <typename TFilter>
+int
+TestUpdateBuffer(const typename TFilter::InputImageType::SizeType & size)
+{
+  using ImageType = typename TFilter::InputImageType;
+
+  typename ImageType::IndexType start;
+  start.Fill(-2);
+  const typename ImageType::RegionType region(start, size);
+
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename ImageType::PixelType>(generator->GetUniformVariate(0.0, 100.0)));
+  }
+
+  const auto setUp = [&image](TFilter * filter) {
+    filter->SetInput(image);
+    filter->SetNumberOfIterations(3);
+    filter->SetTimeStep(0.5 / std::pow(2.0, ImageType::ImageDimension + 1));
+    filter->SetConductanceParameter(3.0);
+  };
+
+  auto reference = UpdateBufferFilter<TFilter>::New();
+  setUp(reference);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 2, 3, 8 })
+  {
+    auto filter = TFilter::New();
+    setUp(filter);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(filter->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != reference->GetOutput()->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << filter->GetNameOfClass() << ", dimension " << ImageType::ImageDimension << ", "
+                  << numberOfWorkUnits << " work units: the output at " << it.GetIndex() << " is " << it.Get()
+                  << " instead of " << reference->GetOutput()->GetPixel(it.GetIndex()) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkAnisotropicDiffusionImageFilterUpdateBufferTest(int, char *[])
+{
+  using ImageType2D = itk::Image<float, 2>;
+  using ImageType3D = itk::Image<float, 3>;
+
+  bool testPassed = true;
+  testPassed &=
+    TestUpdateBuffer<itk::GradientAnisotropicDiffusionImageFilter<ImageType2D, ImageType2D>>({ { 31, 17 } }) ==
+    EXIT_SUCCESS;
+  testPassed &=
+    TestUpdateBuffer<itk::CurvatureAnisotropicDiffusionImageFilter<ImageType2D, ImageType2D>>({ { 12, 23 } }) ==
+    EXIT_SUCCESS;
+  // Fewer slices than twice the number of work units.
+  testPassed &=
+    TestUpdateBuffer<itk::GradientAnisotropicDiffusionImageFilter<ImageType3D, ImageType3D>>({ { 15, 11, 5 } }) ==
+    EXIT_SUCCESS;
+  testPassed &=
+    TestUpdateBuffer<itk::CurvatureAnisotropicDiffusionImageFilter<ImageType3D, ImageType3D>>({ { 9, 13, 20 } }) ==
+    EXIT_SUCCESS;
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
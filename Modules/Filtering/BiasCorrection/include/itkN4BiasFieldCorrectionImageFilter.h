@@ -22,11 +22,16 @@
 
 #include "itkArray.h"
 #include "itkBSplineScatteredDataPointSetToImageFilter.h"
+#include "itkImageBufferRange.h"
 #include "itkPointSet.h"
 #include "itkVector.h"
 
 #include "vnl/vnl_vector.h"
 
+#include <array>
+#include <functional>
+#include <vector>
+
 namespace itk
 {
 
@@ -391,33 +396,144 @@ private:
   // N4 algorithm functions:  The basic algorithm iterates between sharpening
   // the intensity histogram of the corrected input image and spatially
   // smoothing those results with a B-spline scalar field estimate of the
-  // bias field.  The former is handled by the function SharpenImage()
-  // whereas the latter is handled by the function UpdateBiasFieldEstimate().
+  // bias field.  The former is handled by the function ComputeSharpeningMapping()
+  // whereas the latter is handled by the function FitResidualBiasField().
   // Convergence is determined by the coefficient of variation of the difference
-  // image between the current bias field estimate and the previous estimate.
+  // image between the current bias field estimate and the previous estimate,
+  // computed by UpdateLogUncorrectedImage().
+  //
+  // The pixels lie on a regular grid, so the B-spline basis functions are
+  // separable along the image axes: they are tabulated once per fitting level
+  // and reused by all the iterations of that level, and the fitting and the
+  // evaluation of the bias field proceed one image row at a time.  The only
+  // full-size image kept during the iterations is the log of the uncorrected
+  // image, updated in place.
+
+  /** Nonzero B-spline basis functions at the grid positions along one image
+   * axis, for a given number of control points along that axis. */
+  struct AxisBSplineWeightsType
+  {
+    /** First control point of the support of each grid position. */
+    std::vector<unsigned int> firstControlPoint;
+    /** SplineOrder + 1 weights per grid position. */
+    std::vector<double> weights;
+    /** Sum of the squared weights of each grid position. */
+    std::vector<double> squaredNorms;
+  };
+  using BSplineWeightsType = std::array<AxisBSplineWeightsType, ImageDimension>;
+
+  /** Mapping E(u|v) of the log intensities to their sharpened values, sampled
+   * at the histogram bins. */
+  struct SharpeningMappingType
+  {
+    vnl_vector<RealType> values;
+    RealType             binMinimum;
+    RealType             histogramSlope;
+  };
+
+  /** Tells whether a pixel, given by its offset in the buffer, is used to
+   * estimate the bias field: it must be in the mask and have a positive
+   * confidence, when these images are set. */
+  struct IncludedPixelPredicateType
+  {
+    ImageBufferRange<const MaskImageType> mask;
+    ImageBufferRange<const RealImageType> confidence;
+    MaskPixelType                         maskLabel;
+    bool                                  useMaskLabel;
+
+    bool
+    operator()(const size_t indexValue) const
+    {
+      return (mask.empty() || (useMaskLabel && mask[indexValue] == maskLabel) ||
+              (!useMaskLabel && mask[indexValue] != MaskPixelType{})) &&
+             (confidence.empty() || confidence[indexValue] > 0.0);
+    }
+  };
+
+  /** Running mean and sum of the squared deviations of a sequence of values,
+   * which can be merged with those of another sequence. */
+  struct RunningStatisticsType
+  {
+    double N{ 0.0 };
+    double mu{ 0.0 };
+    double sigma{ 0.0 };
+
+    void
+    Add(double value);
+
+    void
+    Merge(const RunningStatisticsType & other);
+
+    /** Coefficient of variation of the values. */
+    RealType
+    GetCoefficientOfVariation() const;
+  };
+
+  IncludedPixelPredicateType
+  MakeIncludedPixelPredicate() const;
+
+  /**
+   * Tabulate the B-spline basis functions of the image grid for a control
+   * point lattice.
+   */
+  BSplineWeightsType
+  ComputeBSplineWeights(const BiasFieldControlPointLatticeType *) const;
 
   /**
    * Sharpen the intensity histogram of the current estimate of the corrected
-   * image and map those results to a new estimate of the unsmoothed corrected
-   * image.
+   * image and compute the mapping of its intensities to a new estimate of the
+   * unsmoothed corrected image.
    */
-  void
-  SharpenImage(const RealImageType * unsharpenedImage, RealImageType * sharpenedImage) const;
+  SharpeningMappingType
+  ComputeSharpeningMapping(const RealImageType * unsharpenedImage) const;
+
+  /** Map a log intensity to its sharpened value. */
+  static RealType
+  SharpenPixel(const SharpeningMappingType &, RealType pixel);
 
   /**
-   * Given the unsmoothed estimate of the bias field, this function smooths
-   * the estimate and adds the resulting control point values to the total
-   * bias field estimate.
+   * Fit the B-spline control point lattice of the residual bias field, that
+   * is the difference between the uncorrected image and its sharpened
+   * estimate, which is computed on the fly.
    */
-  RealImagePointer
-  UpdateBiasFieldEstimate(RealImageType *, size_t);
+  typename BiasFieldControlPointLatticeType::Pointer
+  FitResidualBiasField(const RealImageType *, const SharpeningMappingType &, const BSplineWeightsType &) const;
 
   /**
-   * Convergence is determined by the coefficient of variation of the difference
-   * image between the current bias field estimate and the previous estimate.
+   * Remove the residual bias field of a control point lattice from the log
+   * of the uncorrected image, in place, and return the coefficient of
+   * variation of the exponential of the residual bias field.
    */
   RealType
-  CalculateConvergenceMeasurement(const RealImageType *, const RealImageType *) const;
+  UpdateLogUncorrectedImage(RealImageType *,
+                            const BiasFieldControlPointLatticeType *,
+                            const BSplineWeightsType &) const;
+
+  /**
+   * Evaluate the B-spline field of a control point lattice along one image
+   * row.  The collapsed buffer holds the lattice values summed along all the
+   * axes but the first one.
+   */
+  void
+  EvaluateBSplineRow(const BiasFieldControlPointLatticeType *,
+                     const BSplineWeightsType &,
+                     SizeValueType         row,
+                     std::vector<double> & collapsed,
+                     std::vector<double> & values) const;
+
+  /**
+   * Process the image rows in parallel, in NumberOfRowChunks contiguous chunks
+   * of rows.  The function is called with the chunk number and the range of
+   * rows of the chunk.
+   */
+  void
+  ParallelizeRows(const std::function<void(SizeValueType, SizeValueType, SizeValueType)> & rowsFunction) const;
+
+  /** The number of chunks of rows does not depend on the number of work units,
+   * so that the sums over the chunks are done in the same order, and the output
+   * is the same for any number of work units.  Each chunk holds its own copy of
+   * the histogram and of the lattices of the B-spline fitting. */
+  static constexpr SizeValueType NumberOfRowChunks = 32;
 
   MaskPixelType m_MaskLabel{};
   bool          m_UseMaskLabel{ false };
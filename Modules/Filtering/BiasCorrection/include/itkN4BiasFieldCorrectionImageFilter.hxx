@@ -19,17 +19,11 @@
 #define itkN4BiasFieldCorrectionImageFilter_hxx
 
 
-#include "itkAddImageFilter.h"
 #include "itkBSplineControlPointImageFilter.h"
-#include "itkDivideImageFilter.h"
-#include "itkExpImageFilter.h"
+#include "itkCoxDeBoorBSplineKernelFunction.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBufferRange.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
-#include "itkImageRegionIterator.h"
-#include "itkImageRegionIteratorWithIndex.h"
-#include "itkImportImageFilter.h"
 #include "itkIterationReporter.h"
-#include "itkSubtractImageFilter.h"
 #include "itkVectorIndexSelectionCastImageFilter.h"
 
 ITK_GCC_PRAGMA_PUSH
@@ -87,8 +81,6 @@ template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 void
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::GenerateData()
 {
-  this->AllocateOutputs();
-
   const InputImageType * inputImage = this->GetInput();
   using RegionType = typename InputImageType::RegionType;
   const RegionType inputRegion = inputImage->GetBufferedRegion();
@@ -109,110 +101,119 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     itkExceptionMacro("If a confidence image is specified, its size should be equal to the input image size");
   }
 
-  // Calculate the log of the input image.
-  RealImagePointer logInputImage = RealImageType::New();
-  logInputImage->CopyInformation(inputImage);
-  logInputImage->SetRegions(inputRegion);
-  logInputImage->Allocate(false);
-
-  ImageAlgorithm::Copy(inputImage, logInputImage.GetPointer(), inputRegion, inputRegion);
-
-  const auto          maskImageBufferRange = MakeImageBufferRange(maskImage);
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(confidenceImage);
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  const ImageBufferRange logInputImageBufferRange{ *logInputImage };
-  const size_t           numberOfPixels = logInputImageBufferRange.size();
-
-  // Number of pixels of the input image that are included with the filter.
-  size_t numberOfIncludedPixels = 0;
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  unsigned int maximumNumberOfLevels = 1;
+  for (unsigned int d = 0; d < this->m_NumberOfFittingLevels.Size(); ++d)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    if (this->m_NumberOfFittingLevels[d] > maximumNumberOfLevels)
     {
-      ++numberOfIncludedPixels;
-      auto && logInputPixel = logInputImageBufferRange[indexValue];
-
-      if (logInputPixel > typename InputImageType::PixelType{})
-      {
-        logInputPixel = std::log(static_cast<RealType>(logInputPixel));
-      }
+      maximumNumberOfLevels = this->m_NumberOfFittingLevels[d];
     }
   }
+  if (this->m_MaximumNumberOfIterations.Size() != maximumNumberOfLevels)
+  {
+    itkExceptionMacro("Number of iteration levels is not equal to the max number of levels.");
+  }
 
-  // Duplicate logInputImage since we reuse the original at each iteration.
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (this->m_NumberOfControlPoints[d] < this->m_SplineOrder + 1)
+    {
+      itkExceptionMacro("The number of control points must be greater than the spline order.");
+    }
+  }
 
-  using DuplicatorType = ImageDuplicator<RealImageType>;
-  auto duplicator = DuplicatorType::New();
-  duplicator->SetInputImage(logInputImage);
-  duplicator->Update();
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
-  RealImagePointer logUncorrectedImage = duplicator->GetOutput();
+  // Calculate the log of the input image.  It is the initial estimate of the
+  // log of the uncorrected image, from which the residual bias field
+  // estimates are then removed in place.
+  RealImagePointer logUncorrectedImage = RealImageType::New();
+  logUncorrectedImage->CopyInformation(inputImage);
+  logUncorrectedImage->SetRegions(inputRegion);
+  logUncorrectedImage->Allocate(false);
 
-  // Provide an initial log bias field of zeros
+  ImageAlgorithm::Copy(inputImage, logUncorrectedImage.GetPointer(), inputRegion, inputRegion);
 
-  RealImagePointer logBiasField = RealImageType::New();
-  logBiasField->CopyInformation(inputImage);
-  logBiasField->SetRegions(inputImage->GetLargestPossibleRegion());
-  logBiasField->AllocateInitialized();
+  const ImageBufferRange logUncorrectedImageBufferRange{ *logUncorrectedImage };
+  const SizeValueType    rowLength = inputImageSize[0];
 
-  RealImagePointer logSharpenedImage = RealImageType::New();
-  logSharpenedImage->CopyInformation(inputImage);
-  logSharpenedImage->SetRegions(inputImage->GetLargestPossibleRegion());
-  logSharpenedImage->Allocate(false);
+  const IncludedPixelPredicateType isIncluded = this->MakeIncludedPixelPredicate();
 
-  // Iterate until convergence or iterative exhaustion.
-  unsigned int maximumNumberOfLevels = 1;
-  for (unsigned int d = 0; d < this->m_NumberOfFittingLevels.Size(); ++d)
-  {
-    if (this->m_NumberOfFittingLevels[d] > maximumNumberOfLevels)
+  this->ParallelizeRows([&](SizeValueType, SizeValueType firstRow, SizeValueType lastRow) {
+    for (size_t indexValue = firstRow * rowLength; indexValue < lastRow * rowLength; ++indexValue)
     {
-      maximumNumberOfLevels = this->m_NumberOfFittingLevels[d];
+      if (isIncluded(indexValue))
+      {
+        const RealType logInputPixel = logUncorrectedImageBufferRange[indexValue];
+        if (logInputPixel > RealType{})
+        {
+          logUncorrectedImageBufferRange[indexValue] = std::log(logInputPixel);
+        }
+      }
     }
+  });
+
+  // Provide an initial log bias field of zeros, whose control point lattice
+  // covers the parametric domain of the input image.
+  const RegionType & largestRegion = inputImage->GetLargestPossibleRegion();
+
+  typename BiasFieldControlPointLatticeType::SizeType    latticeSize;
+  typename BiasFieldControlPointLatticeType::PointType   latticeOrigin;
+  typename BiasFieldControlPointLatticeType::SpacingType latticeSpacing;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    latticeSize[d] = this->m_NumberOfControlPoints[d];
+
+    RealType domain = inputImage->GetSpacing()[d] * static_cast<RealType>(largestRegion.GetSize()[d] - 1);
+    latticeSpacing[d] = domain / static_cast<RealType>(latticeSize[d] - this->m_SplineOrder);
+    latticeOrigin[d] = -0.5 * latticeSpacing[d] * (this->m_SplineOrder - 1);
   }
-  if (this->m_MaximumNumberOfIterations.Size() != maximumNumberOfLevels)
+  latticeOrigin = inputImage->GetDirection() * latticeOrigin;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    itkExceptionMacro("Number of iteration levels is not equal to the max number of levels.");
+    latticeOrigin[d] += inputImage->GetOrigin()[d] + inputImage->GetSpacing()[d] * largestRegion.GetIndex()[d];
   }
 
+  this->m_LogBiasFieldControlPointLattice = BiasFieldControlPointLatticeType::New();
+  this->m_LogBiasFieldControlPointLattice->SetOrigin(latticeOrigin);
+  this->m_LogBiasFieldControlPointLattice->SetSpacing(latticeSpacing);
+  this->m_LogBiasFieldControlPointLattice->SetDirection(inputImage->GetDirection());
+  this->m_LogBiasFieldControlPointLattice->SetRegions(latticeSize);
+  this->m_LogBiasFieldControlPointLattice->AllocateInitialized();
+
+  // Iterate until convergence or iterative exhaustion.
   for (this->m_CurrentLevel = 0; this->m_CurrentLevel < maximumNumberOfLevels; this->m_CurrentLevel++)
   {
     IterationReporter reporter(this, 0, 1);
 
+    // The basis functions only depend on the size of the control point
+    // lattice, which is the same for all the iterations of a level.
+    const BSplineWeightsType bsplineWeights = this->ComputeBSplineWeights(this->m_LogBiasFieldControlPointLattice);
+
     this->m_ElapsedIterations = 0;
     this->m_CurrentConvergenceMeasurement = NumericTraits<RealType>::max();
     while (this->m_ElapsedIterations++ < this->m_MaximumNumberOfIterations[this->m_CurrentLevel] &&
            this->m_CurrentConvergenceMeasurement > this->m_ConvergenceThreshold)
     {
-      // Sharpen the current estimate of the uncorrected image.
-      this->SharpenImage(logUncorrectedImage, logSharpenedImage);
-
-      using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-      auto subtracter1 = SubtracterType::New();
-      subtracter1->SetInput1(logUncorrectedImage);
-      subtracter1->SetInput2(logSharpenedImage);
-
-      RealImagePointer residualBiasField = subtracter1->GetOutput();
-      residualBiasField->Update();
-
-      // Smooth the residual bias field estimate and add the resulting
-      // control point grid to get the new total bias field estimate.
-
-      RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField, numberOfIncludedPixels);
-
-      this->m_CurrentConvergenceMeasurement = this->CalculateConvergenceMeasurement(logBiasField, newLogBiasField);
-      logBiasField = newLogBiasField;
-
-      auto subtracter2 = SubtracterType::New();
-      subtracter2->SetInput1(logInputImage);
-      subtracter2->SetInput2(logBiasField);
+      // Sharpen the current estimate of the uncorrected image and smooth the
+      // residual bias field estimate.
+      const SharpeningMappingType mapping = this->ComputeSharpeningMapping(logUncorrectedImage);
+
+      const typename BiasFieldControlPointLatticeType::Pointer residualLattice =
+        this->FitResidualBiasField(logUncorrectedImage, mapping, bsplineWeights);
+
+      // Add the resulting control point grid to get the new total bias field
+      // estimate, and remove the residual bias field from the uncorrected
+      // image.
+      const ImageBufferRange latticeBufferRange{ *this->m_LogBiasFieldControlPointLattice };
+      const ImageBufferRange residualLatticeBufferRange{ *residualLattice };
+      for (size_t indexValue = 0; indexValue < latticeBufferRange.size(); ++indexValue)
+      {
+        latticeBufferRange[indexValue] = latticeBufferRange[indexValue] + residualLatticeBufferRange[indexValue];
+      }
 
-      logUncorrectedImage = subtracter2->GetOutput();
-      logUncorrectedImage->Update();
+      this->m_CurrentConvergenceMeasurement =
+        this->UpdateLogUncorrectedImage(logUncorrectedImage, residualLattice, bsplineWeights);
 
       reporter.CompletedStep();
     }
@@ -220,12 +221,11 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     using BSplineReconstructerType = BSplineControlPointImageFilter<BiasFieldControlPointLatticeType, ScalarImageType>;
     auto reconstructer = BSplineReconstructerType::New();
     reconstructer->SetInput(this->m_LogBiasFieldControlPointLattice);
-    reconstructer->SetOrigin(logBiasField->GetOrigin());
-    reconstructer->SetSpacing(logBiasField->GetSpacing());
-    reconstructer->SetDirection(logBiasField->GetDirection());
-    reconstructer->SetSize(logBiasField->GetLargestPossibleRegion().GetSize());
+    reconstructer->SetOrigin(inputImage->GetOrigin());
+    reconstructer->SetSpacing(inputImage->GetSpacing());
+    reconstructer->SetDirection(inputImage->GetDirection());
+    reconstructer->SetSize(largestRegion.GetSize());
     reconstructer->SetSplineOrder(this->m_SplineOrder);
-    reconstructer->Update();
 
     auto numberOfLevels = MakeFilled<typename BSplineReconstructerType::ArrayType>(1);
     for (unsigned int d = 0; d < ImageDimension; ++d)
@@ -239,89 +239,180 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
     this->m_LogBiasFieldControlPointLattice = reconstructer->RefineControlPointLattice(numberOfLevels);
   }
 
-  using CustomBinaryFilter = itk::BinaryGeneratorImageFilter<InputImageType, RealImageType, OutputImageType>;
-  auto expAndDivFilter = CustomBinaryFilter::New();
-  auto expAndDivLambda = [](const typename InputImageType::PixelType & input,
-                            const typename RealImageType::PixelType &  biasField) -> typename OutputImageType::PixelType
+  // Release the uncorrected image before allocating the output, which is the
+  // input divided by the exponential of the log bias field.
+  logUncorrectedImage = nullptr;
+
+  this->AllocateOutputs();
+
+  const BSplineWeightsType bsplineWeights = this->ComputeBSplineWeights(this->m_LogBiasFieldControlPointLattice);
+  const auto               inputImageBufferRange = MakeImageBufferRange(inputImage);
+  const ImageBufferRange   outputImageBufferRange{ *this->GetOutput() };
+
+  this->ParallelizeRows([&](SizeValueType, SizeValueType firstRow, SizeValueType lastRow) {
+    std::vector<double> collapsed;
+    std::vector<double> logBiasField;
+    for (SizeValueType row = firstRow; row < lastRow; ++row)
+    {
+      this->EvaluateBSplineRow(this->m_LogBiasFieldControlPointLattice, bsplineWeights, row, collapsed, logBiasField);
+      for (SizeValueType x = 0; x < rowLength; ++x)
+      {
+        const size_t indexValue = row * rowLength + x;
+        outputImageBufferRange[indexValue] = static_cast<typename OutputImageType::PixelType>(
+          inputImageBufferRange[indexValue] / std::exp(static_cast<RealType>(logBiasField[x])));
+      }
+    }
+  });
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::MakeIncludedPixelPredicate() const
+  -> IncludedPixelPredicateType
+{
+  return IncludedPixelPredicateType{ MakeImageBufferRange(this->GetMaskImage()),
+                                     MakeImageBufferRange(this->GetConfidenceImage()),
+                                     this->GetMaskLabel(),
+                                     this->GetUseMaskLabel() };
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ComputeBSplineWeights(
+  const BiasFieldControlPointLatticeType * controlPointLattice) const -> BSplineWeightsType
+{
+  using KernelType = CoxDeBoorBSplineKernelFunction<3>;
+  auto kernel = KernelType::New();
+  kernel->SetSplineOrder(this->m_SplineOrder);
+
+  const typename InputImageType::SizeType imageSize = this->GetInput()->GetBufferedRegion().GetSize();
+  const unsigned int                      numberOfWeights = this->m_SplineOrder + 1;
+
+  // Same tolerance as BSplineScatteredDataPointSetToImageFilter, to keep the
+  // last grid position within the parametric domain.
+  constexpr double bsplineEpsilon = 1e-3;
+
+  BSplineWeightsType bsplineWeights;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    return static_cast<typename OutputImageType::PixelType>(input / std::exp(biasField));
-  };
-  expAndDivFilter->SetFunctor(expAndDivLambda);
-  expAndDivFilter->SetInput1(inputImage);
-  expAndDivFilter->SetInput2(logBiasField);
-  expAndDivFilter->Update();
-
-  this->GraftOutput(expAndDivFilter->GetOutput());
+    AxisBSplineWeightsType & axisWeights = bsplineWeights[d];
+    axisWeights.firstControlPoint.resize(imageSize[d]);
+    axisWeights.weights.resize(imageSize[d] * numberOfWeights);
+    axisWeights.squaredNorms.resize(imageSize[d]);
+
+    const auto totalNumberOfSpans =
+      static_cast<double>(controlPointLattice->GetLargestPossibleRegion().GetSize()[d] - this->m_SplineOrder);
+    const double scale = imageSize[d] > 1 ? totalNumberOfSpans / static_cast<double>(imageSize[d] - 1) : 0.0;
+    const double epsilon = scale * bsplineEpsilon;
+
+    for (SizeValueType j = 0; j < imageSize[d]; ++j)
+    {
+      double u = scale * static_cast<double>(j);
+      if (itk::Math::abs(u - totalNumberOfSpans) <= epsilon)
+      {
+        u = totalNumberOfSpans - epsilon;
+      }
+      const auto span = static_cast<unsigned int>(u);
+      axisWeights.firstControlPoint[j] = span;
+
+      double squaredNorm = 0.0;
+      for (unsigned int k = 0; k < numberOfWeights; ++k)
+      {
+        const double weight =
+          kernel->Evaluate(u - static_cast<double>(span + k) + 0.5 * (static_cast<double>(this->m_SplineOrder) - 1.0));
+        axisWeights.weights[j * numberOfWeights + k] = weight;
+        squaredNorm += weight * weight;
+      }
+      axisWeights.squaredNorms[j] = squaredNorm;
+    }
+  }
+  return bsplineWeights;
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
-void
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::SharpenImage(
-  const RealImageType * unsharpenedImage,
-  RealImageType *       sharpenedImage) const
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ComputeSharpeningMapping(
+  const RealImageType * unsharpenedImage) const -> SharpeningMappingType
 {
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
+  const IncludedPixelPredicateType isIncluded = this->MakeIncludedPixelPredicate();
 
   // Build the histogram for the uncorrected image.  Store copy
   // in a vnl_vector to utilize vnl FFT routines.  Note that variables
   // in real space are denoted by a single uppercase letter whereas their
   // frequency counterparts are indicated by a trailing lowercase 'f'.
+  // The intensity range and the histogram are computed for each chunk of
+  // rows on its own, then merged in the order of the chunks.
 
-  RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
-  RealType binMinimum = NumericTraits<RealType>::max();
+  const auto          unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
+  const SizeValueType rowLength = unsharpenedImage->GetBufferedRegion().GetSize(0);
 
-  const auto   unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
-  const size_t numberOfPixels = unsharpenedImageBufferRange.size();
+  std::vector<RealType> chunkBinMaximum(NumberOfRowChunks, NumericTraits<RealType>::NonpositiveMin());
+  std::vector<RealType> chunkBinMinimum(NumberOfRowChunks, NumericTraits<RealType>::max());
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeRows([&](SizeValueType chunk, SizeValueType firstRow, SizeValueType lastRow) {
+    RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
+    RealType binMinimum = NumericTraits<RealType>::max();
+    for (size_t indexValue = firstRow * rowLength; indexValue < lastRow * rowLength; ++indexValue)
     {
-      RealType pixel = unsharpenedImageBufferRange[indexValue];
-      if (pixel > binMaximum)
-      {
-        binMaximum = pixel;
-      }
-      else if (pixel < binMinimum)
+      if (isIncluded(indexValue))
       {
-        binMinimum = pixel;
+        const RealType pixel = unsharpenedImageBufferRange[indexValue];
+        binMaximum = std::max(binMaximum, pixel);
+        binMinimum = std::min(binMinimum, pixel);
       }
     }
-  }
-  RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
+    chunkBinMaximum[chunk] = binMaximum;
+    chunkBinMinimum[chunk] = binMinimum;
+  });
+
+  const RealType binMaximum = *std::max_element(chunkBinMaximum.cbegin(), chunkBinMaximum.cend());
+  const RealType binMinimum = *std::min_element(chunkBinMinimum.cbegin(), chunkBinMinimum.cend());
+  RealType       histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
 
   // Create the intensity profile (within the masked region, if applicable)
   // using a triangular parzen windowing scheme.
 
-  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  std::vector<std::vector<double>> chunkHistograms(NumberOfRowChunks);
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+  this->ParallelizeRows([&](SizeValueType chunk, SizeValueType firstRow, SizeValueType lastRow) {
+    std::vector<double> & histogram = chunkHistograms[chunk];
+    histogram.assign(this->m_NumberOfHistogramBins, 0.0);
+    for (size_t indexValue = firstRow * rowLength; indexValue < lastRow * rowLength; ++indexValue)
     {
-      RealType pixel = unsharpenedImageBufferRange[indexValue];
-
-      RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
-      unsigned int idx = itk::Math::floor(cidx);
-      RealType     offset = cidx - static_cast<RealType>(idx);
-
-      if (offset == 0.0)
+      if (isIncluded(indexValue))
       {
-        H[idx] += 1.0;
+        RealType pixel = unsharpenedImageBufferRange[indexValue];
+
+        RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
+        unsigned int idx = itk::Math::floor(cidx);
+        RealType     offset = cidx - static_cast<RealType>(idx);
+
+        if (offset == 0.0)
+        {
+          histogram[idx] += 1.0;
+        }
+        else if (idx < this->m_NumberOfHistogramBins - 1)
+        {
+          histogram[idx] += 1.0 - offset;
+          histogram[idx + 1] += offset;
+        }
       }
-      else if (idx < this->m_NumberOfHistogramBins - 1)
+    }
+  });
+
+  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+
+  for (unsigned int n = 0; n < this->m_NumberOfHistogramBins; ++n)
+  {
+    double binCount = 0.0;
+    for (const std::vector<double> & histogram : chunkHistograms)
+    {
+      if (!histogram.empty())
       {
-        H[idx] += 1.0 - offset;
-        H[idx + 1] += offset;
+        binCount += histogram[n];
       }
     }
+    H[n] = static_cast<RealType>(binCount);
   }
 
   // Determine information about the intensity histogram and zero-pad
@@ -441,167 +532,351 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Sharpen
 
   // Remove the zero-padding from the mapping.
 
-  E = E.extract(this->m_NumberOfHistogramBins, histogramOffset);
+  SharpeningMappingType mapping;
+  mapping.values = E.extract(this->m_NumberOfHistogramBins, histogramOffset);
+  mapping.binMinimum = binMinimum;
+  mapping.histogramSlope = histogramSlope;
+  return mapping;
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::SharpenPixel(
+  const SharpeningMappingType & mapping,
+  const RealType                pixel) -> RealType
+{
+  const vnl_vector<RealType> & E = mapping.values;
+  const RealType               cidx = (pixel - mapping.binMinimum) / mapping.histogramSlope;
+  const unsigned int           idx = itk::Math::floor(cidx);
 
-  // Sharpen the image with the new mapping, E(u|v)
-  sharpenedImage->FillBuffer(0);
+  if (idx < E.size() - 1)
+  {
+    return E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+  }
+  return E.back();
+}
 
-  const ImageBufferRange sharpenedImageBufferRange{ *sharpenedImage };
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::FitResidualBiasField(
+  const RealImageType *         logUncorrectedImage,
+  const SharpeningMappingType & mapping,
+  const BSplineWeightsType &    bsplineWeights) const -> typename BiasFieldControlPointLatticeType::Pointer
+{
+  const IncludedPixelPredicateType isIncluded = this->MakeIncludedPixelPredicate();
+
+  const auto                              logUncorrectedImageBufferRange = MakeImageBufferRange(logUncorrectedImage);
+  const typename InputImageType::SizeType imageSize = logUncorrectedImage->GetBufferedRegion().GetSize();
+  const SizeValueType                     rowLength = imageSize[0];
+
+  const typename BiasFieldControlPointLatticeType::RegionType & latticeRegion =
+    this->m_LogBiasFieldControlPointLattice->GetLargestPossibleRegion();
+  const SizeValueType numberOfControlPoints = latticeRegion.GetNumberOfPixels();
+  const SizeValueType rowNumberOfControlPoints = latticeRegion.GetSize(0);
+  SizeValueType       latticeStrides[ImageDimension];
+  latticeStrides[0] = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    latticeStrides[d] = latticeStrides[d - 1] * latticeRegion.GetSize(d - 1);
+  }
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  const unsigned int numberOfWeights = this->m_SplineOrder + 1;
+  SizeValueType      numberOfRowCombinations = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    numberOfRowCombinations *= numberOfWeights;
+  }
+
+  // Each chunk of rows accumulates the numerator (delta) and the denominator
+  // (omega) of the control point values of the multilevel B-spline
+  // approximation of Lee et al., on its own lattices.  The basis functions
+  // being separable, the contributions of the pixels of a row are first
+  // accumulated along the first axis, then spread over the other axes.
+  std::vector<std::vector<double>> chunkDeltaLattices(NumberOfRowChunks);
+  std::vector<std::vector<double>> chunkOmegaLattices(NumberOfRowChunks);
+
+  this->ParallelizeRows([&](SizeValueType chunk, SizeValueType firstRow, SizeValueType lastRow) {
+    std::vector<double> & deltaLattice = chunkDeltaLattices[chunk];
+    std::vector<double> & omegaLattice = chunkOmegaLattices[chunk];
+    deltaLattice.assign(numberOfControlPoints, 0.0);
+    omegaLattice.assign(numberOfControlPoints, 0.0);
+
+    std::vector<double> rowDelta(rowNumberOfControlPoints);
+    std::vector<double> rowOmega(rowNumberOfControlPoints);
+
+    const AxisBSplineWeightsType & rowWeights = bsplineWeights[0];
+    for (SizeValueType row = firstRow; row < lastRow; ++row)
     {
-      RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
-      unsigned int idx = itk::Math::floor(cidx);
+      std::fill(rowDelta.begin(), rowDelta.end(), 0.0);
+      std::fill(rowOmega.begin(), rowOmega.end(), 0.0);
+      bool rowHasIncludedPixels = false;
+
+      for (SizeValueType x = 0; x < rowLength; ++x)
+      {
+        const size_t indexValue = row * rowLength + x;
+        if (!isIncluded(indexValue))
+        {
+          continue;
+        }
+        rowHasIncludedPixels = true;
+
+        // The residual is the difference between the uncorrected image and
+        // its sharpened estimate.
+        const RealType pixel = logUncorrectedImageBufferRange[indexValue];
+        const RealType residualPixel = pixel - SharpenPixel(mapping, pixel);
+
+        double confidenceWeight = 1.0;
+        if (!isIncluded.confidence.empty())
+        {
+          confidenceWeight = isIncluded.confidence[indexValue];
+        }
+
+        const double   scaledResidual = confidenceWeight * residualPixel / rowWeights.squaredNorms[x];
+        const unsigned int firstControlPoint = rowWeights.firstControlPoint[x];
+        const double * weights = &rowWeights.weights[x * numberOfWeights];
+        for (unsigned int k = 0; k < numberOfWeights; ++k)
+        {
+          const double squaredWeight = weights[k] * weights[k];
+          rowDelta[firstControlPoint + k] += scaledResidual * squaredWeight * weights[k];
+          rowOmega[firstControlPoint + k] += confidenceWeight * squaredWeight;
+        }
+      }
+      if (!rowHasIncludedPixels)
+      {
+        continue;
+      }
 
-      RealType correctedPixel = 0;
-      if (idx < E.size() - 1)
+      SizeValueType rowPosition[ImageDimension];
+      double        rowSquaredNorm = 1.0;
+      SizeValueType remainingRows = row;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
       {
-        correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+        rowPosition[d] = remainingRows % imageSize[d];
+        remainingRows /= imageSize[d];
+        rowSquaredNorm *= bsplineWeights[d].squaredNorms[rowPosition[d]];
       }
-      else
+
+      for (SizeValueType combination = 0; combination < numberOfRowCombinations; ++combination)
       {
-        correctedPixel = E.back();
+        double        weight = 1.0;
+        SizeValueType latticeOffset = 0;
+        SizeValueType remainingCombination = combination;
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          const unsigned int k = remainingCombination % numberOfWeights;
+          remainingCombination /= numberOfWeights;
+          weight *= bsplineWeights[d].weights[rowPosition[d] * numberOfWeights + k];
+          latticeOffset += (bsplineWeights[d].firstControlPoint[rowPosition[d]] + k) * latticeStrides[d];
+        }
+        const double squaredWeight = weight * weight;
+        const double deltaWeight = squaredWeight * weight / rowSquaredNorm;
+        for (SizeValueType c = 0; c < rowNumberOfControlPoints; ++c)
+        {
+          deltaLattice[latticeOffset + c] += deltaWeight * rowDelta[c];
+          omegaLattice[latticeOffset + c] += squaredWeight * rowOmega[c];
+        }
       }
-      sharpenedImageBufferRange[indexValue] = correctedPixel;
     }
+  });
+
+  // Accumulate the lattices of all the chunks to calculate the control point
+  // values.
+
+  auto residualLattice = BiasFieldControlPointLatticeType::New();
+  residualLattice->CopyInformation(this->m_LogBiasFieldControlPointLattice);
+  residualLattice->SetRegions(latticeRegion);
+  residualLattice->Allocate(false);
+
+  const ImageBufferRange residualLatticeBufferRange{ *residualLattice };
+  for (SizeValueType n = 0; n < numberOfControlPoints; ++n)
+  {
+    double delta = 0.0;
+    double omega = 0.0;
+    for (SizeValueType chunk = 0; chunk < NumberOfRowChunks; ++chunk)
+    {
+      if (!chunkDeltaLattices[chunk].empty())
+      {
+        delta += chunkDeltaLattices[chunk][n];
+        omega += chunkOmegaLattices[chunk][n];
+      }
+    }
+
+    ScalarType phi{};
+    if (Math::NotAlmostEquals(omega, 0.0))
+    {
+      phi[0] = static_cast<RealType>(delta / omega);
+      if (itk::Math::isnan(phi[0]) || itk::Math::isinf(phi[0]))
+      {
+        phi[0] = 0;
+      }
+    }
+    residualLatticeBufferRange[n] = phi;
   }
+  return residualLattice;
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
-typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
-  RealImageType * fieldEstimate,
-  const size_t    numberOfIncludedPixels)
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateLogUncorrectedImage(
+  RealImageType *                          logUncorrectedImage,
+  const BiasFieldControlPointLatticeType * residualLattice,
+  const BSplineWeightsType &               bsplineWeights) const -> RealType
 {
-  // Temporarily set the direction cosine to identity since the B-spline
-  // approximation algorithm works in parametric space and not physical
-  // space.
-  typename ScalarImageType::DirectionType identity;
-  identity.SetIdentity();
-
-  const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
-  const SizeValueType                          numberOfPixels = bufferedRegion.GetNumberOfPixels();
-  const bool                                   filterHandlesMemory = false;
-
-  using ImporterType = ImportImageFilter<RealType, ImageDimension>;
-  auto importer = ImporterType::New();
-  importer->SetImportPointer(fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory);
-  importer->SetRegion(fieldEstimate->GetBufferedRegion());
-  importer->SetOrigin(fieldEstimate->GetOrigin());
-  importer->SetSpacing(fieldEstimate->GetSpacing());
-  importer->SetDirection(identity);
-  importer->Update();
-
-  const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
-
-  PointSetPointer fieldPoints = PointSetType::New();
-  auto &          pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-  pointSTLContainer.reserve(numberOfIncludedPixels);
-  auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-  pointDataSTLContainer.reserve(numberOfIncludedPixels);
-
-  auto   weights = BSplineFilterType::WeightsContainerType::New();
-  auto & weightSTLContainer = weights->CastToSTLContainer();
-  weightSTLContainer.reserve(numberOfIncludedPixels);
-
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
-                                                      parametricFieldEstimate->GetRequestedRegion());
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      PointType point;
-      parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+  const IncludedPixelPredicateType isIncluded = this->MakeIncludedPixelPredicate();
+
+  const ImageBufferRange logUncorrectedImageBufferRange{ *logUncorrectedImage };
+  const SizeValueType    rowLength = logUncorrectedImage->GetBufferedRegion().GetSize(0);
 
-      ScalarType scalar;
-      scalar[0] = It.Get();
+  // Convergence is determined by the coefficient of variation of the
+  // exponential of the difference between the previous and the new bias field
+  // estimates over the mask region, that is of the exponential of the residual
+  // bias field.  The mean and the sum of the squared deviations of each chunk
+  // of rows are merged in the order of the chunks.
+  std::vector<RunningStatisticsType> chunkStatistics(NumberOfRowChunks);
 
-      pointDataSTLContainer.push_back(scalar);
-      pointSTLContainer.push_back(point);
+  this->ParallelizeRows([&](SizeValueType chunk, SizeValueType firstRow, SizeValueType lastRow) {
+    RunningStatisticsType & statistics = chunkStatistics[chunk];
 
-      RealType confidenceWeight = 1.0;
-      if (!confidenceImageBufferRange.empty())
+    std::vector<double> collapsed;
+    std::vector<double> residualBiasField;
+    for (SizeValueType row = firstRow; row < lastRow; ++row)
+    {
+      this->EvaluateBSplineRow(residualLattice, bsplineWeights, row, collapsed, residualBiasField);
+      for (SizeValueType x = 0; x < rowLength; ++x)
       {
-        confidenceWeight = confidenceImageBufferRange[indexValue];
+        const size_t indexValue = row * rowLength + x;
+        if (isIncluded(indexValue))
+        {
+          const auto residualPixel = static_cast<RealType>(residualBiasField[x]);
+          logUncorrectedImageBufferRange[indexValue] = logUncorrectedImageBufferRange[indexValue] - residualPixel;
+          statistics.Add(std::exp(-residualPixel));
+        }
       }
-      weightSTLContainer.push_back(confidenceWeight);
     }
+  });
+
+  RunningStatisticsType statistics;
+  for (const RunningStatisticsType & chunk : chunkStatistics)
+  {
+    statistics.Merge(chunk);
   }
+  return statistics.GetCoefficientOfVariation();
+}
 
-  auto bspliner = BSplineFilterType::New();
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RunningStatisticsType::Add(const double value)
+{
+  N += 1.0;
 
-  typename BSplineFilterType::ArrayType numberOfControlPoints;
-  auto                                  numberOfFittingLevels = MakeFilled<typename BSplineFilterType::ArrayType>(1);
-  for (unsigned int d = 0; d < ImageDimension; ++d)
+  if (N > 1.0)
   {
-    if (!this->m_LogBiasFieldControlPointLattice)
-    {
-      numberOfControlPoints[d] = this->m_NumberOfControlPoints[d];
-    }
-    else
-    {
-      numberOfControlPoints[d] = this->m_LogBiasFieldControlPointLattice->GetLargestPossibleRegion().GetSize()[d];
-    }
+    sigma = sigma + itk::Math::sqr(value - mu) * (N - 1.0) / N;
   }
+  mu = mu * (1.0 - 1.0 / N) + value / N;
+}
 
-  typename ScalarImageType::PointType parametricOrigin = fieldEstimate->GetOrigin();
-  for (unsigned int d = 0; d < ImageDimension; ++d)
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RunningStatisticsType::Merge(
+  const RunningStatisticsType & other)
+{
+  if (other.N > 0.0)
   {
-    parametricOrigin[d] += (fieldEstimate->GetSpacing()[d] * fieldEstimate->GetLargestPossibleRegion().GetIndex()[d]);
+    const double totalN = N + other.N;
+    const double difference = other.mu - mu;
+    sigma += other.sigma + itk::Math::sqr(difference) * N * other.N / totalN;
+    mu += difference * other.N / totalN;
+    N = totalN;
   }
-  bspliner->SetOrigin(parametricOrigin);
-  bspliner->SetSpacing(fieldEstimate->GetSpacing());
-  bspliner->SetSize(fieldEstimate->GetLargestPossibleRegion().GetSize());
-  bspliner->SetDirection(fieldEstimate->GetDirection());
-  bspliner->SetGenerateOutputImage(false);
-  bspliner->SetNumberOfLevels(numberOfFittingLevels);
-  bspliner->SetSplineOrder(this->m_SplineOrder);
-  bspliner->SetNumberOfControlPoints(numberOfControlPoints);
-  bspliner->SetInput(fieldPoints);
-  bspliner->SetPointWeights(weights);
-  bspliner->Update();
-
-  typename BiasFieldControlPointLatticeType::Pointer phiLattice = bspliner->GetPhiLattice();
-
-  // Add the bias field control points to the current estimate.
-
-  if (!this->m_LogBiasFieldControlPointLattice)
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+auto
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RunningStatisticsType::
+  GetCoefficientOfVariation() const -> RealType
+{
+  return static_cast<RealType>(std::sqrt(sigma / (N - 1.0)) / mu);
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::EvaluateBSplineRow(
+  const BiasFieldControlPointLatticeType * controlPointLattice,
+  const BSplineWeightsType &               bsplineWeights,
+  const SizeValueType                      row,
+  std::vector<double> &                    collapsed,
+  std::vector<double> &                    values) const
+{
+  const typename BiasFieldControlPointLatticeType::RegionType & latticeRegion =
+    controlPointLattice->GetLargestPossibleRegion();
+  const ScalarType * lattice = controlPointLattice->GetBufferPointer();
+
+  const unsigned int numberOfWeights = this->m_SplineOrder + 1;
+  SizeValueType      latticeStrides[ImageDimension];
+  SizeValueType      rowPosition[ImageDimension];
+  SizeValueType      numberOfRowCombinations = 1;
+  SizeValueType      remainingRows = row;
+  latticeStrides[0] = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
   {
-    this->m_LogBiasFieldControlPointLattice = phiLattice;
+    latticeStrides[d] = latticeStrides[d - 1] * latticeRegion.GetSize(d - 1);
+    rowPosition[d] = remainingRows % bsplineWeights[d].firstControlPoint.size();
+    remainingRows /= bsplineWeights[d].firstControlPoint.size();
+    numberOfRowCombinations *= numberOfWeights;
   }
-  else
+
+  // Collapse the lattice along all the axes but the first one.
+  collapsed.assign(latticeRegion.GetSize(0), 0.0);
+  for (SizeValueType combination = 0; combination < numberOfRowCombinations; ++combination)
   {
-    // Ensure that the two lattices occupy the same physical space.  Not
-    // necessary for performance since the parameters of the reconstructed
-    // bias field are specified later in this function in the reconstructer.
-    phiLattice->CopyInformation(this->m_LogBiasFieldControlPointLattice);
-
-    using AdderType = AddImageFilter<BiasFieldControlPointLatticeType,
-                                     BiasFieldControlPointLatticeType,
-                                     BiasFieldControlPointLatticeType>;
-    auto adder = AdderType::New();
-    adder->SetInput1(this->m_LogBiasFieldControlPointLattice);
-    adder->SetInput2(phiLattice);
-    adder->Update();
-
-    this->m_LogBiasFieldControlPointLattice = adder->GetOutput();
+    double        weight = 1.0;
+    SizeValueType latticeOffset = 0;
+    SizeValueType remainingCombination = combination;
+    for (unsigned int d = 1; d < ImageDimension; ++d)
+    {
+      const unsigned int k = remainingCombination % numberOfWeights;
+      remainingCombination /= numberOfWeights;
+      weight *= bsplineWeights[d].weights[rowPosition[d] * numberOfWeights + k];
+      latticeOffset += (bsplineWeights[d].firstControlPoint[rowPosition[d]] + k) * latticeStrides[d];
+    }
+    for (SizeValueType c = 0; c < collapsed.size(); ++c)
+    {
+      collapsed[c] += weight * lattice[latticeOffset + c][0];
+    }
   }
 
-  RealImagePointer smoothField = this->ReconstructBiasField(this->m_LogBiasFieldControlPointLattice);
-  smoothField->SetRegions(this->GetInput()->GetRequestedRegion());
-  return smoothField;
+  const AxisBSplineWeightsType & rowWeights = bsplineWeights[0];
+  values.resize(rowWeights.firstControlPoint.size());
+  for (SizeValueType x = 0; x < values.size(); ++x)
+  {
+    const double * weights = &rowWeights.weights[x * numberOfWeights];
+    const double * controlPoints = &collapsed[rowWeights.firstControlPoint[x]];
+    double         value = 0.0;
+    for (unsigned int k = 0; k < numberOfWeights; ++k)
+    {
+      value += weights[k] * controlPoints[k];
+    }
+    values[x] = value;
+  }
+}
+
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ParallelizeRows(
+  const std::function<void(SizeValueType, SizeValueType, SizeValueType)> & rowsFunction) const
+{
+  const typename InputImageType::RegionType & region = this->GetInput()->GetBufferedRegion();
+  const SizeValueType                         numberOfRows =
+    region.GetSize(0) > 0 ? region.GetNumberOfPixels() / region.GetSize(0) : SizeValueType{ 0 };
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    NumberOfRowChunks,
+    [&](SizeValueType chunk) {
+      rowsFunction(chunk, chunk * numberOfRows / NumberOfRowChunks, (chunk + 1) * numberOfRows / NumberOfRowChunks);
+    },
+    nullptr);
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
@@ -636,52 +911,7 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Reconst
   return biasField;
 }
 
-template <typename TInputImage, typename TMaskImage, typename TOutputImage>
-typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealType
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::CalculateConvergenceMeasurement(
-  const RealImageType * fieldEstimate1,
-  const RealImageType * fieldEstimate2) const
-{
-  using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-  auto subtracter = SubtracterType::New();
-  subtracter->SetInput1(fieldEstimate1);
-  subtracter->SetInput2(fieldEstimate2);
-  subtracter->Update();
-
-  // Calculate statistics over the mask region
-
-  RealType mu = 0.0;
-  RealType sigma = 0.0;
-  RealType N = 0.0;
 
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  const auto   subtracterImageBufferRange = MakeImageBufferRange(subtracter->GetOutput());
-  const size_t numberOfPixels = subtracterImageBufferRange.size();
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      RealType pixel = std::exp(subtracterImageBufferRange[indexValue]);
-      N += 1.0;
-
-      if (N > 1.0)
-      {
-        sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
-      }
-      mu = mu * (1.0 - 1.0 / N) + pixel / N;
-    }
-  }
-  sigma = std::sqrt(sigma / (N - 1.0));
-
-  return (sigma / mu);
-}
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 void
@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Coefficient of variation of the pixels of one tissue class.
+template <typename TImage, typename TMaskImage>
+double
+CoefficientOfVariation(const TImage * image, const TMaskImage * tissue, typename TMaskImage::PixelType label)
+{
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  double count = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (tissue->GetPixel(it.GetIndex()) == label)
+    {
+      sum += it.Get();
+      sumOfSquares += itk::Math::sqr(it.Get());
+      count += 1.0;
+    }
+  }
+  const double mean = sum / count;
+  return std::sqrt(sumOfSquares / count - mean * mean) / mean;
+}
+
+// Correct a two-class image corrupted by a smooth multiplicative bias field,
+// within a spherical mask.
+template <unsigned int VDimension>
+int
+TestSyntheticBiasField(const itk::Size<VDimension> & size)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using MaskImageType = itk::Image<unsigned char, VDimension>;
+  using FilterType = itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType>;
+
+  typename ImageType::IndexType start;
+  start.Fill(2);
+  const typename ImageType::RegionType region(start, size);
+  typename ImageType::SpacingType      spacing;
+  typename ImageType::PointType        origin;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    spacing[d] = 1.0 + 0.25 * d;
+    origin[d] = -10.0 * d;
+  }
+
+  auto image = ImageType::New();
+  auto mask = MaskImageType::New();
+  auto tissue = MaskImageType::New();
+  for (itk::ImageBase<VDimension> * output : { static_cast<itk::ImageBase<VDimension> *>(image.GetPointer()),
+                                               static_cast<itk::ImageBase<VDimension> *>(mask.GetPointer()),
+                                               static_cast<itk::ImageBase<VDimension> *>(tissue.GetPointer()) })
+  {
+    output->SetRegions(region);
+    output->SetSpacing(spacing);
+    output->SetOrigin(origin);
+  }
+  image->Allocate();
+  mask->Allocate();
+  tissue->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    double x[VDimension];
+    double squaredRadius = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      x[d] = static_cast<double>(it.GetIndex()[d] - start[d]) / (size[d] - 1) * 2.0 - 1.0;
+      squaredRadius += x[d] * x[d];
+    }
+    const unsigned char label = std::sin(6.0 * x[0]) * std::cos(5.0 * x[1]) > 0.0 ? 1 : 2;
+    const double        bias = std::exp(0.3 * x[0] - 0.2 * x[0] * x[1] + 0.1 * x[VDimension - 1]);
+    const double        value = label == 1 ? 100.0 : 60.0;
+    it.Set(static_cast<float>(value * bias + generator->GetNormalVariate(0.0, 1.0)));
+    mask->SetPixel(it.GetIndex(), squaredRadius < 1.0 ? 1 : 0);
+    tissue->SetPixel(it.GetIndex(), squaredRadius < 1.0 ? label : 0);
+  }
+
+  // The output must be the same, bit for bit, for any number of work units.
+  const unsigned int           numberOfWorkUnits[] = { 1, 3, 8 };
+  typename ImageType::Pointer  outputs[3];
+  typename FilterType::Pointer filters[3];
+  for (unsigned int n = 0; n < 3; ++n)
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetMaskImage(mask);
+    typename FilterType::VariableSizeArrayType maximumNumberOfIterations(3);
+    maximumNumberOfIterations.Fill(20);
+    filter->SetMaximumNumberOfIterations(maximumNumberOfIterations);
+    filter->SetNumberOfFittingLevels(3);
+    filter->SetConvergenceThreshold(1e-5);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits[n]);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    outputs[n] = filter->GetOutput();
+    filters[n] = filter;
+  }
+
+  // The bias field of the output is the bias field reconstructed from the
+  // control point lattice, whose region starts at the zero index.
+  const typename FilterType::RealImagePointer logBiasField =
+    filters[0]->ReconstructBiasField(filters[0]->GetLogBiasFieldControlPointLattice());
+  logBiasField->SetRegions(region);
+  double maximumBiasFieldDifference = 0.0;
+  unsigned int numberOfWorkUnitsDifferences = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(outputs[0], region); !it.IsAtEnd(); ++it)
+  {
+    const typename ImageType::IndexType & index = it.GetIndex();
+    const double                          output = it.Get();
+    const double                          scale = std::max(1.0, std::abs(output));
+    const double correctedInput = image->GetPixel(index) / std::exp(logBiasField->GetPixel(index));
+    maximumBiasFieldDifference = std::max(maximumBiasFieldDifference, std::abs(correctedInput - output) / scale);
+    for (unsigned int n = 1; n < 3; ++n)
+    {
+      if (outputs[n]->GetPixel(index) != it.Get())
+      {
+        ++numberOfWorkUnitsDifferences;
+      }
+    }
+  }
+  for (unsigned int n = 1; n < 3; ++n)
+  {
+    using LatticeType = typename FilterType::BiasFieldControlPointLatticeType;
+    const LatticeType * lattice = filters[n]->GetLogBiasFieldControlPointLattice();
+    const LatticeType * expectedLattice = filters[0]->GetLogBiasFieldControlPointLattice();
+    for (itk::ImageRegionConstIteratorWithIndex<LatticeType> it(lattice, lattice->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != expectedLattice->GetPixel(it.GetIndex()))
+      {
+        ++numberOfWorkUnitsDifferences;
+      }
+    }
+    if (filters[n]->GetCurrentConvergenceMeasurement() != filters[0]->GetCurrentConvergenceMeasurement())
+    {
+      ++numberOfWorkUnitsDifferences;
+    }
+  }
+
+  const double inputVariation = CoefficientOfVariation<ImageType, MaskImageType>(image, tissue, 1);
+  const double outputVariation = CoefficientOfVariation<ImageType, MaskImageType>(outputs[0], tissue, 1);
+
+  std::cout << "Dimension " << VDimension << ": coefficient of variation of the bright tissue " << inputVariation
+            << " before correction, " << outputVariation << " after correction; maximum relative difference "
+            << maximumBiasFieldDifference << " with the reconstructed bias field, " << numberOfWorkUnitsDifferences
+            << " values differ with 3 or 8 work units" << std::endl;
+
+  if (outputVariation > 0.5 * inputVariation)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The bias field is not corrected." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (maximumBiasFieldDifference > 1e-4)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The output does not match the reconstructed bias field." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (numberOfWorkUnitsDifferences > 0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The output depends on the number of work units." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkN4BiasFieldCorrectionImageFilterSyntheticTest(int, char *[])
+{
+  bool testPassed = true;
+  testPassed &= TestSyntheticBiasField<2>(itk::Size<2>{ { 120, 100 } }) == EXIT_SUCCESS;
+  testPassed &= TestSyntheticBiasField<3>(itk::Size<3>{ { 40, 36, 30 } }) == EXIT_SUCCESS;
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
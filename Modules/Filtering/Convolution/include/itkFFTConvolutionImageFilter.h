@@ -37,6 +37,22 @@ namespace itk
  * convolution theorem to accelerate the convolution computation when
  * the kernel is large.
  *
+ * When Tiling is on, the output requested region is computed tile by tile
+ * with the overlap-save method: each tile of the output is padded by the
+ * kernel radius, transformed, multiplied by a kernel spectrum computed once
+ * for all the tiles, and transformed back, and the tiles are processed
+ * concurrently.  The tile size is chosen so that the FFT buffers of a tile
+ * fit in TileMemoryBudget bytes, which keeps them in cache and avoids the
+ * large padded complex images of the whole requested region.  Tiling is
+ * ignored by the deconvolution filters derived from this class.
+ *
+ * When KernelSpectrumCaching is on, the Fourier transform of the padded
+ * kernel is kept between updates, and reused as long as the kernel, the
+ * padded input region and Normalize do not change.  This avoids
+ * transforming the same kernel again when the filter, or one of the
+ * deconvolution filters derived from it, is run repeatedly on images of
+ * the same size.
+ *
  * \warning This filter ignores the spacing, origin, and orientation
  * of the kernel image and treats them as identical to those in the
  * input image.
@@ -111,6 +127,26 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get whether the output is computed tile by tile with the
+   * overlap-save method. Defaults to false. */
+  itkSetMacro(Tiling, bool);
+  itkGetConstMacro(Tiling, bool);
+  itkBooleanMacro(Tiling);
+
+  /** Set/Get the number of bytes the FFT buffers of a single tile may
+   * use when Tiling is on. The tiles are never smaller than twice the
+   * kernel, so the budget may be exceeded with large kernels. Defaults
+   * to 16 MiB. */
+  itkSetMacro(TileMemoryBudget, SizeValueType);
+  itkGetConstMacro(TileMemoryBudget, SizeValueType);
+
+  /** Set/Get whether the Fourier transform of the kernel is kept between
+   * updates and reused while the kernel and the padded input region are
+   * unchanged. Defaults to false. */
+  itkSetMacro(KernelSpectrumCaching, bool);
+  itkGetConstMacro(KernelSpectrumCaching, bool);
+  itkBooleanMacro(KernelSpectrumCaching);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -133,6 +169,15 @@ protected:
   void
   GenerateData() override;
 
+  /** Compute the output tile by tile when Tiling is on. */
+  void
+  GenerateTiledData();
+
+  /** Compute the size of the tiles of a region, and the size of their
+   * FFT, from the kernel size and the tile memory budget. */
+  void
+  ComputeTileSize(const OutputSizeType & regionSize, OutputSizeType & tileSize, InternalSizeType & fftSize) const;
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -209,6 +254,17 @@ private:
   SizeValueType      m_SizeGreatestPrimeFactor{};
   InternalSizeType   m_FFTPadSize{ { 0 } };
   InternalRegionType m_PaddedInputRegion{};
+  bool               m_Tiling{ false };
+  SizeValueType      m_TileMemoryBudget{ 16 * 1024 * 1024 };
+  bool               m_KernelSpectrumCaching{ false };
+
+  // The cached kernel spectrum, and what it was computed from.
+  InternalComplexImagePointerType        m_CachedKernelSpectrum{};
+  typename KernelImageType::ConstPointer m_CachedKernel{};
+  ModifiedTimeType                       m_CachedKernelTime{ 0 };
+  KernelRegionType                       m_CachedKernelRegion{};
+  InternalRegionType                     m_CachedPaddedInputRegion{};
+  bool                                   m_CachedNormalize{ false };
 };
 } // namespace itk
 
@@ -26,11 +26,15 @@
 #include "itkExtractImageFilter.h"
 #include "itkFFTPadImageFilter.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
+#include "itkProgressTransformer.h"
 #include "itkRegionOfInterestImageFilter.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -82,6 +86,12 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  if (m_Tiling)
+  {
+    this->GenerateTiledData();
+    return;
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -112,6 +122,211 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateTiledData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType *        input = this->GetInput();
+  OutputImageType *             output = this->GetOutput();
+  const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+  const OutputRegionType        requestedRegion = output->GetRequestedRegion();
+  const KernelSizeType          kernelRadius = this->GetKernelRadius();
+
+  OutputSizeType   tileSize;
+  InternalSizeType fftSize;
+  this->ComputeTileSize(requestedRegion.GetSize(), tileSize, fftSize);
+
+  OutputSizeType numberOfTiles;
+  SizeValueType  totalNumberOfTiles = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    numberOfTiles[dim] = (requestedRegion.GetSize()[dim] + tileSize[dim] - 1) / tileSize[dim];
+    totalNumberOfTiles *= numberOfTiles[dim];
+  }
+
+  // All the tiles are transformed with the same size, so that a single
+  // kernel spectrum serves them all.
+  m_PaddedInputRegion = InternalRegionType(fftSize);
+  const bool xDimensionIsOdd = this->GetXDimensionIsOdd();
+
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+  InternalComplexImagePointerType kernel = nullptr;
+  this->PrepareKernel(this->GetKernelImage(), kernel, progress, 0.1f);
+
+  InternalIndexType validIndex;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    validIndex[dim] = static_cast<IndexValueType>(kernelRadius[dim]);
+  }
+
+  // Each tile is transformed by a single thread, and the tiles are
+  // processed concurrently.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  ProgressTransformer tilesProgress(0.1f, 1.0f, this);
+  multiThreader->ParallelizeArray(
+    0,
+    totalNumberOfTiles,
+    [&](SizeValueType tile) {
+      OutputIndexType tileIndex;
+      OutputSizeType  tileRegionSize;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        const SizeValueType position = tile % numberOfTiles[dim];
+        tile /= numberOfTiles[dim];
+        tileIndex[dim] = requestedRegion.GetIndex()[dim] + static_cast<IndexValueType>(position * tileSize[dim]);
+        tileRegionSize[dim] = std::min(tileSize[dim], requestedRegion.GetSize()[dim] - position * tileSize[dim]);
+      }
+      const OutputRegionType tileRegion(tileIndex, tileRegionSize);
+
+      InputRegionType paddedTileRegion = tileRegion;
+      paddedTileRegion.PadByRadius(kernelRadius);
+      const InternalRegionType localRegion(paddedTileRegion.GetSize());
+
+      // Copy the tile padded by the kernel radius at the origin of the FFT
+      // buffer, and fill the rest of the buffer with zeros.
+      InternalImagePointerType paddedTile = InternalImageType::New();
+      paddedTile->SetRegions(fftSize);
+      paddedTile->Allocate(localRegion.GetSize() != fftSize);
+
+      const InputRegionType & bufferedRegion = input->GetBufferedRegion();
+      if (bufferedRegion.IsInside(paddedTileRegion))
+      {
+        ImageRegionConstIterator<InputImageType> inputIt(input, paddedTileRegion);
+        ImageRegionIterator<InternalImageType>   tileIt(paddedTile, localRegion);
+        for (; !inputIt.IsAtEnd(); ++inputIt, ++tileIt)
+        {
+          tileIt.Set(static_cast<TInternalPrecision>(inputIt.Get()));
+        }
+      }
+      else
+      {
+        const typename InputImageType::OffsetType offset = paddedTileRegion.GetIndex() - InputIndexType();
+        ImageRegionIteratorWithIndex<InternalImageType> tileIt(paddedTile, localRegion);
+        for (; !tileIt.IsAtEnd(); ++tileIt)
+        {
+          const InputIndexType index = tileIt.GetIndex() + offset;
+          tileIt.Set(static_cast<TInternalPrecision>(bufferedRegion.IsInside(index)
+                                                       ? input->GetPixel(index)
+                                                       : boundaryCondition->GetPixel(index, input)));
+        }
+      }
+
+      auto fftFilter = FFTFilterType::New();
+      fftFilter->SetNumberOfWorkUnits(1);
+      fftFilter->SetInput(paddedTile);
+      fftFilter->Update();
+      InternalComplexImagePointerType spectrum = fftFilter->GetOutput();
+      spectrum->DisconnectPipeline();
+      fftFilter = nullptr;
+      paddedTile = nullptr;
+
+      InternalComplexType *       spectrumBuffer = spectrum->GetBufferPointer();
+      const InternalComplexType * kernelBuffer = kernel->GetBufferPointer();
+      const SizeValueType         numberOfPixels = spectrum->GetBufferedRegion().GetNumberOfPixels();
+      for (SizeValueType i = 0; i < numberOfPixels; ++i)
+      {
+        spectrumBuffer[i] *= kernelBuffer[i];
+      }
+
+      auto ifftFilter = IFFTFilterType::New();
+      ifftFilter->SetActualXDimensionIsOdd(xDimensionIsOdd);
+      ifftFilter->SetNumberOfWorkUnits(1);
+      ifftFilter->SetInput(spectrum);
+      ifftFilter->Update();
+
+      // Only the part of the tile that is at least the kernel radius away
+      // from the borders of the padded tile is free of wrap-around.
+      ImageRegionConstIterator<InternalImageType> resultIt(ifftFilter->GetOutput(),
+                                                           InternalRegionType(validIndex, tileRegionSize));
+      ImageRegionIterator<OutputImageType>        outputIt(output, tileRegion);
+      for (; !outputIt.IsAtEnd(); ++resultIt, ++outputIt)
+      {
+        outputIt.Set(static_cast<OutputPixelType>(resultIt.Get()));
+      }
+    },
+    tilesProgress.GetProcessObject());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::ComputeTileSize(
+  const OutputSizeType & regionSize,
+  OutputSizeType &       tileSize,
+  InternalSizeType &     fftSize) const
+{
+  // Smallest size not smaller than the given size that can be factored by
+  // primes not greater than SizeGreatestPrimeFactor, as in FFTPadImageFilter.
+  const auto fftFriendlySize = [this](SizeValueType size) {
+    if (m_SizeGreatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(size) > m_SizeGreatestPrimeFactor)
+      {
+        ++size;
+      }
+    }
+    else if (m_SizeGreatestPrimeFactor == 1)
+    {
+      size += size % 2;
+    }
+    return size;
+  };
+
+  const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+  const KernelSizeType kernelRadius = this->GetKernelRadius();
+
+  // The tile, its half Hermitian spectrum and its inverse transform.
+  constexpr SizeValueType bytesPerPixel = 3 * sizeof(TInternalPrecision);
+
+  OutputSizeType minimumTileSize;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    tileSize[dim] = regionSize[dim];
+    minimumTileSize[dim] = std::min(regionSize[dim], std::max<SizeValueType>(2 * kernelSize[dim], 8));
+  }
+
+  // Halve the largest side of the tile until its FFT buffers fit in the budget.
+  while (true)
+  {
+    SizeValueType numberOfBytes = bytesPerPixel;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      fftSize[dim] = fftFriendlySize(tileSize[dim] + 2 * kernelRadius[dim]);
+      numberOfBytes *= fftSize[dim];
+    }
+    if (numberOfBytes <= m_TileMemoryBudget)
+    {
+      break;
+    }
+
+    unsigned int largestDimension = ImageDimension;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      if (tileSize[dim] > minimumTileSize[dim] &&
+          (largestDimension == ImageDimension || tileSize[dim] > tileSize[largestDimension]))
+      {
+        largestDimension = dim;
+      }
+    }
+    if (largestDimension == ImageDimension)
+    {
+      break;
+    }
+    tileSize[largestDimension] = std::max((tileSize[largestDimension] + 1) / 2, minimumTileSize[largestDimension]);
+  }
+
+  // Spread the region evenly over the tiles.
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const SizeValueType numberOfTiles = (regionSize[dim] + tileSize[dim] - 1) / tileSize[dim];
+    tileSize[dim] = (regionSize[dim] + numberOfTiles - 1) / numberOfTiles;
+    fftSize[dim] = fftFriendlySize(tileSize[dim] + 2 * kernelRadius[dim]);
+  }
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -340,6 +555,21 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   KernelRegionType kernelRegion = kernel->GetLargestPossibleRegion();
   KernelSizeType   kernelSize = kernelRegion.GetSize();
 
+  // The kernel time also covers a kernel regenerated by its pipeline.
+  const ModifiedTimeType kernelTime = std::max(kernel->GetMTime(), kernel->GetUpdateMTime());
+  if (!m_KernelSpectrumCaching)
+  {
+    m_CachedKernelSpectrum = nullptr;
+    m_CachedKernel = nullptr;
+  }
+  else if (m_CachedKernelSpectrum != nullptr && m_CachedKernel == kernel && m_CachedKernelTime == kernelTime &&
+           m_CachedKernelRegion == kernelRegion && m_CachedPaddedInputRegion == m_PaddedInputRegion &&
+           m_CachedNormalize == this->GetNormalize())
+  {
+    preparedKernel = m_CachedKernelSpectrum;
+    return;
+  }
+
   InputSizeType                      inputPadSize = m_PaddedInputRegion.GetSize();
   typename KernelImageType::SizeType kernelUpperBound;
   for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -430,6 +660,17 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   kernelInfoFilter->Update();
 
   preparedKernel = kernelInfoFilter->GetOutput();
+
+  if (m_KernelSpectrumCaching)
+  {
+    preparedKernel->DisconnectPipeline();
+    m_CachedKernelSpectrum = preparedKernel;
+    m_CachedKernel = kernel;
+    m_CachedKernelTime = kernelTime;
+    m_CachedKernelRegion = kernelRegion;
+    m_CachedPaddedInputRegion = m_PaddedInputRegion;
+    m_CachedNormalize = this->GetNormalize();
+  }
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
@@ -526,6 +767,10 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "Tiling: " << (m_Tiling ? "On" : "Off") << std::endl;
+  os << indent << "TileMemoryBudget: " << m_TileMemoryBudget << std::endl;
+  os << indent << "KernelSpectrumCaching: " << (m_KernelSpectrumCaching ? "On" : "Off") << std::endl;
+  itkPrintSelfObjectMacro(CachedKernelSpectrum);
 }
 
 } // namespace itk
@@ -108,6 +108,17 @@ namespace itk
  * The size of this NCC image is, by definition,
  * size(fixedImage) + size(movingImage) - 1.
  *
+ * Tiling:
+ * When Tiling is on, the correlation is computed tile by tile with the
+ * overlap-save method.  The spectra of the moving image and mask are computed
+ * once, and each tile of the output only transforms the part of the fixed
+ * image and mask it overlaps, with FFTs sized so that the buffers of a tile
+ * fit in TileMemoryBudget bytes.  The tiles are processed concurrently.
+ * This avoids the complex images of size(fixedImage) + size(movingImage) - 1
+ * that dominate the memory use of the filter, but the whole output is still
+ * computed at once, since the overlap threshold and the precision tolerance
+ * depend on all of it.
+ *
  * Example filter usage:
    \code
    using FilterType = itk::MaskedFFTNormalizedCorrelationImageFilter< ShortImageType, DoubleImageType >;
@@ -216,6 +227,19 @@ public:
   /** Get the maximum number of overlapping pixels. */
   itkGetMacro(MaximumNumberOfOverlappingPixels, SizeValueType);
 
+  /** Set/Get whether the correlation is computed tile by tile with the
+   * overlap-save method. Defaults to false. */
+  itkSetMacro(Tiling, bool);
+  itkGetConstMacro(Tiling, bool);
+  itkBooleanMacro(Tiling);
+
+  /** Set/Get the number of bytes the FFT buffers of a single tile may use
+   * when Tiling is on. The tiles are never smaller than the moving image,
+   * so the budget may be exceeded with large moving images. Defaults to
+   * 16 MiB. */
+  itkSetMacro(TileMemoryBudget, SizeValueType);
+  itkGetConstMacro(TileMemoryBudget, SizeValueType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(OutputPixelTypeIsFloatingPointCheck, (Concept::IsFloatingPoint<OutputPixelType>));
@@ -272,6 +296,25 @@ protected:
   void
   EnlargeOutputRequestedRegion(DataObject * output) override;
 
+  /** Compute the correlation tile by tile when Tiling is on. */
+  void
+  GenerateTiledData();
+
+  /** Compute the size of the tiles of the correlation image, and the size
+   * of their FFT, from the size of the moving image and the tile memory
+   * budget. */
+  void
+  ComputeTileSize(const RealSizeType &  combinedImageSize,
+                  const InputSizeType & movingImageSize,
+                  RealSizeType &        tileSize,
+                  RealSizeType &        FFTImageSize);
+
+  /** Clamp the correlation to [-1, 1], and set it to zero where the
+   * denominator is below the precision tolerance or where too few pixels
+   * overlap. */
+  RealImagePointer
+  PostProcessCorrelation(RealImageType * NCC, RealImageType * denominator, RealImageType * numberOfOverlapPixels);
+
   typename TMaskImage::Pointer
   PreProcessMask(const InputImageType * inputImage, const MaskImageType * inputMask);
 
@@ -341,6 +384,9 @@ private:
   const unsigned int m_TotalForwardAndInverseFFTs{ 12 };
   /** The total accumulated progress */
   float m_AccumulatedProgress{};
+
+  bool          m_Tiling{ false };
+  SizeValueType m_TileMemoryBudget{ 16 * 1024 * 1024 };
 };
 } // end namespace itk
 
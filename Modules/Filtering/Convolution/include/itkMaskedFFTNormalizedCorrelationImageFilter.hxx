@@ -20,8 +20,12 @@
 
 #include "itkFlipImageFilter.h"
 #include "itkForwardFFTImageFilter.h"
+#include "itkHalfHermitianToRealInverseFFTImageFilter.h"
 #include "itkInverseFFTImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkProgressTransformer.h"
+#include "itkRealToHalfHermitianForwardFFTImageFilter.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkDivideImageFilter.h"
 #include "itkSubtractImageFilter.h"
@@ -110,6 +114,12 @@ template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateData()
 {
+  if (m_Tiling)
+  {
+    this->GenerateTiledData();
+    return;
+  }
+
   // Store the input images.
   InputImagePointer fixedImage = InputImageType::New();
   fixedImage->Graft(this->GetFixedImage());
@@ -237,12 +247,348 @@ MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>
   fixedDenom = nullptr;         // No longer needed
   rotatedMovingDenom = nullptr; // No longer needed
 
-  // Determine a tolerance on the precision of the denominator values.
-  const double precisionTolerance = CalculatePrecisionTolerance<RealImageType>(denominator);
-
   RealImagePointer NCC = this->ElementQuotient<RealImageType>(numerator, denominator);
   numerator = nullptr; // No longer needed
 
+  // Store the output origin computed in GenerateOutputInformation so that it can be reset after the Graft.
+  RealPointType outputOrigin = this->GetOutput()->GetOrigin();
+  outputImage->Graft(this->PostProcessCorrelation(NCC, denominator, numberOfOverlapPixels));
+  outputImage->SetOrigin(outputOrigin);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateTiledData()
+{
+  using InputIndexType = typename InputImageType::IndexType;
+  using InputPixelType = typename InputImageType::PixelType;
+  using MaskPixelType = typename MaskImageType::PixelType;
+  using FFTFilterType = RealToHalfHermitianForwardFFTImageFilter<RealImageType, FFTImageType>;
+  using IFFTFilterType = HalfHermitianToRealInverseFFTImageFilter<FFTImageType, RealImageType>;
+
+  const InputImageType * fixedImage = this->GetFixedImage();
+  const InputImageType * movingImage = this->GetMovingImage();
+  const MaskImageType *  fixedMask = this->GetFixedImageMask();
+  const MaskImageType *  movingMask = this->GetMovingImageMask();
+
+  const InputRegionType fixedRegion = fixedImage->GetLargestPossibleRegion();
+  const InputRegionType movingRegion = movingImage->GetLargestPossibleRegion();
+  const InputSizeType   movingSize = movingRegion.GetSize();
+
+  RealSizeType combinedImageSize;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    combinedImageSize[i] = fixedRegion.GetSize()[i] + movingSize[i] - 1;
+  }
+
+  RealSizeType tileSize;
+  RealSizeType FFTImageSize;
+  this->ComputeTileSize(combinedImageSize, movingSize, tileSize, FFTImageSize);
+
+  const auto allocateBuffer = [&FFTImageSize]() {
+    RealImagePointer buffer = RealImageType::New();
+    buffer->SetRegions(FFTImageSize);
+    buffer->AllocateInitialized();
+    return buffer;
+  };
+
+  // Copy the masked intensities of a region of an image, the mask and the
+  // squared masked intensities into zero padded buffers, as PreProcessMask()
+  // and PreProcessImage() do.
+  const auto copyMaskedImage = [](const InputImageType * image,
+                                  const MaskImageType *  mask,
+                                  const InputRegionType & region,
+                                  const auto &           toBufferIndex,
+                                  RealImageType *        imageBuffer,
+                                  RealImageType *        maskBuffer,
+                                  RealImageType *        squaredImageBuffer) {
+    for (ImageRegionConstIteratorWithIndex<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      const InputIndexType & index = it.GetIndex();
+      if (mask && mask->GetPixel(index) <= MaskPixelType{})
+      {
+        continue;
+      }
+      const InputPixelType value = it.Get();
+      const RealIndexType  bufferIndex = toBufferIndex(index);
+      imageBuffer->SetPixel(bufferIndex, static_cast<RealPixelType>(value));
+      maskBuffer->SetPixel(bufferIndex, NumericTraits<RealPixelType>::OneValue());
+      squaredImageBuffer->SetPixel(bufferIndex, static_cast<RealPixelType>(value * value));
+    }
+  };
+
+  // Transform a buffer and release it.
+  const auto forwardFFT = [](RealImagePointer & buffer, ThreadIdType numberOfWorkUnits) {
+    auto FFTFilter = FFTFilterType::New();
+    FFTFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    FFTFilter->SetInput(buffer);
+    FFTFilter->Update();
+    FFTImagePointer outputImage = FFTFilter->GetOutput();
+    outputImage->DisconnectPipeline();
+    buffer = nullptr;
+    return outputImage;
+  };
+
+  // Correlate two images from their spectra.
+  const bool xDimensionIsOdd = FFTImageSize[0] % 2 != 0;
+  const auto correlate = [xDimensionIsOdd](const FFTImageType * FFT1, const FFTImageType * FFT2) {
+    auto product = FFTImageType::New();
+    product->SetRegions(FFT1->GetLargestPossibleRegion());
+    product->Allocate();
+    const typename FFTImageType::PixelType * FFT1Buffer = FFT1->GetBufferPointer();
+    const typename FFTImageType::PixelType * FFT2Buffer = FFT2->GetBufferPointer();
+    typename FFTImageType::PixelType *       productBuffer = product->GetBufferPointer();
+    const SizeValueType                      numberOfPixels = product->GetBufferedRegion().GetNumberOfPixels();
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      productBuffer[i] = FFT1Buffer[i] * FFT2Buffer[i];
+    }
+
+    auto IFFTFilter = IFFTFilterType::New();
+    IFFTFilter->SetActualXDimensionIsOdd(xDimensionIsOdd);
+    IFFTFilter->SetNumberOfWorkUnits(1);
+    IFFTFilter->SetInput(product);
+    IFFTFilter->Update();
+    RealImagePointer outputImage = IFFTFilter->GetOutput();
+    outputImage->DisconnectPipeline();
+    return outputImage;
+  };
+
+  // The spectra of the rotated moving image, of its mask and of its square
+  // are shared by all the tiles.
+  RealImagePointer rotatedMovingImage = allocateBuffer();
+  RealImagePointer rotatedMovingMask = allocateBuffer();
+  RealImagePointer rotatedMovingSquaredImage = allocateBuffer();
+  const InputIndexType & movingIndex = movingRegion.GetIndex();
+  copyMaskedImage(
+    movingImage,
+    movingMask,
+    movingRegion,
+    [&movingIndex, &movingSize](const InputIndexType & index) {
+      RealIndexType rotatedIndex;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        rotatedIndex[i] = static_cast<IndexValueType>(movingSize[i]) - 1 - (index[i] - movingIndex[i]);
+      }
+      return rotatedIndex;
+    },
+    rotatedMovingImage,
+    rotatedMovingMask,
+    rotatedMovingSquaredImage);
+  const FFTImagePointer rotatedMovingFFT = forwardFFT(rotatedMovingImage, this->GetNumberOfWorkUnits());
+  const FFTImagePointer rotatedMovingMaskFFT = forwardFFT(rotatedMovingMask, this->GetNumberOfWorkUnits());
+  const FFTImagePointer rotatedMovingSquaredFFT =
+    forwardFFT(rotatedMovingSquaredImage, this->GetNumberOfWorkUnits());
+  this->UpdateProgress(0.1f);
+
+  const RealRegionType combinedRegion(combinedImageSize);
+  RealImagePointer     NCC = RealImageType::New();
+  NCC->SetRegions(combinedRegion);
+  NCC->Allocate();
+  RealImagePointer denominator = RealImageType::New();
+  denominator->SetRegions(combinedRegion);
+  denominator->Allocate();
+  RealImagePointer numberOfOverlapPixels = RealImageType::New();
+  numberOfOverlapPixels->SetRegions(combinedRegion);
+  numberOfOverlapPixels->Allocate();
+
+  RealSizeType  numberOfTiles;
+  SizeValueType totalNumberOfTiles = 1;
+  RealIndexType validIndex;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    numberOfTiles[i] = (combinedImageSize[i] + tileSize[i] - 1) / tileSize[i];
+    totalNumberOfTiles *= numberOfTiles[i];
+    validIndex[i] = static_cast<IndexValueType>(movingSize[i]) - 1;
+  }
+
+  // Each tile is transformed by a single thread, and the tiles are
+  // processed concurrently.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  ProgressTransformer tilesProgress(0.1f, 0.95f, this);
+  multiThreader->ParallelizeArray(
+    0,
+    totalNumberOfTiles,
+    [&](SizeValueType tile) {
+      RealIndexType tileIndex;
+      RealSizeType  tileRegionSize;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        const SizeValueType position = tile % numberOfTiles[i];
+        tile /= numberOfTiles[i];
+        tileIndex[i] = static_cast<IndexValueType>(position * tileSize[i]);
+        tileRegionSize[i] = std::min(tileSize[i], combinedImageSize[i] - position * tileSize[i]);
+      }
+      const RealRegionType tileRegion(tileIndex, tileRegionSize);
+
+      // The tile only depends on the fixed pixels from movingSize - 1 pixels
+      // before the tile to the end of the tile, which are copied at the
+      // origin of the buffers.
+      InputRegionType fixedTileRegion;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        fixedTileRegion.SetIndex(i, fixedRegion.GetIndex()[i] + tileIndex[i] - validIndex[i]);
+        fixedTileRegion.SetSize(i, tileRegionSize[i] + movingSize[i] - 1);
+      }
+      const InputIndexType fixedTileIndex = fixedTileRegion.GetIndex();
+
+      RealImagePointer fixedImageBuffer = allocateBuffer();
+      RealImagePointer fixedMaskBuffer = allocateBuffer();
+      RealImagePointer fixedSquaredImageBuffer = allocateBuffer();
+      if (fixedTileRegion.Crop(fixedRegion))
+      {
+        copyMaskedImage(
+          fixedImage,
+          fixedMask,
+          fixedTileRegion,
+          [&fixedTileIndex](const InputIndexType & index) {
+            RealIndexType bufferIndex;
+            for (unsigned int i = 0; i < ImageDimension; ++i)
+            {
+              bufferIndex[i] = index[i] - fixedTileIndex[i];
+            }
+            return bufferIndex;
+          },
+          fixedImageBuffer,
+          fixedMaskBuffer,
+          fixedSquaredImageBuffer);
+      }
+      FFTImagePointer fixedFFT = forwardFFT(fixedImageBuffer, 1);
+      FFTImagePointer fixedMaskFFT = forwardFFT(fixedMaskBuffer, 1);
+      FFTImagePointer fixedSquaredFFT = forwardFFT(fixedSquaredImageBuffer, 1);
+
+      const RealImagePointer overlap = correlate(fixedMaskFFT, rotatedMovingMaskFFT);
+      const RealImagePointer fixedCumulativeSum = correlate(fixedFFT, rotatedMovingMaskFFT);
+      const RealImagePointer rotatedMovingCumulativeSum = correlate(fixedMaskFFT, rotatedMovingFFT);
+      const RealImagePointer crossCorrelation = correlate(fixedFFT, rotatedMovingFFT);
+      const RealImagePointer fixedSquaredCumulativeSum = correlate(fixedSquaredFFT, rotatedMovingMaskFFT);
+      const RealImagePointer rotatedMovingSquaredCumulativeSum = correlate(fixedMaskFFT, rotatedMovingSquaredFFT);
+      fixedFFT = nullptr;
+      fixedMaskFFT = nullptr;
+      fixedSquaredFFT = nullptr;
+
+      // Same as DivideImageFilter.
+      const auto divide = [](RealPixelType numerator, RealPixelType denominator) {
+        return Math::NotAlmostEquals(denominator, RealPixelType{}) ? numerator / denominator
+                                                                    : NumericTraits<RealPixelType>::max(numerator);
+      };
+
+      // Only the part of the buffers that follows the first movingSize - 1
+      // pixels is free of wrap-around.
+      const RealRegionType                    validRegion(validIndex, tileRegionSize);
+      ImageRegionConstIterator<RealImageType> overlapIt(overlap, validRegion);
+      ImageRegionConstIterator<RealImageType> fixedSumIt(fixedCumulativeSum, validRegion);
+      ImageRegionConstIterator<RealImageType> movingSumIt(rotatedMovingCumulativeSum, validRegion);
+      ImageRegionConstIterator<RealImageType> crossIt(crossCorrelation, validRegion);
+      ImageRegionConstIterator<RealImageType> fixedSquaredSumIt(fixedSquaredCumulativeSum, validRegion);
+      ImageRegionConstIterator<RealImageType> movingSquaredSumIt(rotatedMovingSquaredCumulativeSum, validRegion);
+      ImageRegionIterator<RealImageType>      NCCIt(NCC, tileRegion);
+      ImageRegionIterator<RealImageType>      denominatorIt(denominator, tileRegion);
+      ImageRegionIterator<RealImageType>      numberOfOverlapPixelsIt(numberOfOverlapPixels, tileRegion);
+      for (; !NCCIt.IsAtEnd(); ++overlapIt,
+                               ++fixedSumIt,
+                               ++movingSumIt,
+                               ++crossIt,
+                               ++fixedSquaredSumIt,
+                               ++movingSquaredSumIt,
+                               ++NCCIt,
+                               ++denominatorIt,
+                               ++numberOfOverlapPixelsIt)
+      {
+        const RealPixelType numberOfPixels =
+          std::max(Math::Round<RealPixelType, RealPixelType>(overlapIt.Get()), RealPixelType{});
+        const RealPixelType fixedSum = fixedSumIt.Get();
+        const RealPixelType movingSum = movingSumIt.Get();
+        const RealPixelType numerator = crossIt.Get() - divide(fixedSum * movingSum, numberOfPixels);
+        const RealPixelType fixedDenom =
+          std::max(fixedSquaredSumIt.Get() - divide(fixedSum * fixedSum, numberOfPixels), RealPixelType{});
+        const RealPixelType movingDenom =
+          std::max(movingSquaredSumIt.Get() - divide(movingSum * movingSum, numberOfPixels), RealPixelType{});
+        const RealPixelType denominatorValue = std::sqrt(fixedDenom * movingDenom);
+
+        NCCIt.Set(divide(numerator, denominatorValue));
+        denominatorIt.Set(denominatorValue);
+        numberOfOverlapPixelsIt.Set(numberOfPixels);
+      }
+    },
+    tilesProgress.GetProcessObject());
+
+  // Store the output origin computed in GenerateOutputInformation so that it can be reset after the Graft.
+  OutputImagePointer outputImage = this->GetOutput();
+  RealPointType      outputOrigin = outputImage->GetOrigin();
+  outputImage->Graft(this->PostProcessCorrelation(NCC, denominator, numberOfOverlapPixels));
+  outputImage->SetOrigin(outputOrigin);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::ComputeTileSize(
+  const RealSizeType &  combinedImageSize,
+  const InputSizeType & movingImageSize,
+  RealSizeType &        tileSize,
+  RealSizeType &        FFTImageSize)
+{
+  // The spectra of the three fixed buffers, the product of two spectra and
+  // the six inverse transforms.
+  constexpr SizeValueType bytesPerPixel = 10 * sizeof(RealPixelType);
+
+  RealSizeType minimumTileSize;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    tileSize[i] = combinedImageSize[i];
+    minimumTileSize[i] = std::min(combinedImageSize[i], std::max<SizeValueType>(movingImageSize[i], 8));
+  }
+
+  // Halve the largest side of the tile until its FFT buffers fit in the budget.
+  while (true)
+  {
+    SizeValueType numberOfBytes = bytesPerPixel;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      FFTImageSize[i] = this->FindClosestValidDimension(static_cast<int>(tileSize[i] + movingImageSize[i] - 1));
+      numberOfBytes *= FFTImageSize[i];
+    }
+    if (numberOfBytes <= m_TileMemoryBudget)
+    {
+      break;
+    }
+
+    unsigned int largestDimension = ImageDimension;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      if (tileSize[i] > minimumTileSize[i] &&
+          (largestDimension == ImageDimension || tileSize[i] > tileSize[largestDimension]))
+      {
+        largestDimension = i;
+      }
+    }
+    if (largestDimension == ImageDimension)
+    {
+      break;
+    }
+    tileSize[largestDimension] = std::max((tileSize[largestDimension] + 1) / 2, minimumTileSize[largestDimension]);
+  }
+
+  // Spread the correlation image evenly over the tiles.
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const SizeValueType numberOfTiles = (combinedImageSize[i] + tileSize[i] - 1) / tileSize[i];
+    tileSize[i] = (combinedImageSize[i] + numberOfTiles - 1) / numberOfTiles;
+    FFTImageSize[i] = this->FindClosestValidDimension(static_cast<int>(tileSize[i] + movingImageSize[i] - 1));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>::PostProcessCorrelation(
+  RealImageType * NCC,
+  RealImageType * denominator,
+  RealImageType * numberOfOverlapPixels) -> RealImagePointer
+{
+  // Determine a tolerance on the precision of the denominator values.
+  const double precisionTolerance = this->CalculatePrecisionTolerance<RealImageType>(denominator);
+
   // Given the numberOfOverlapPixels, we can check that the m_RequiredNumberOfOverlappingPixels is not set higher than
   // the actual maximum overlap voxels.  If it is, we set m_RequiredNumberOfOverlappingPixels to be this maximum.
   using CalculatorType = itk::MinimumMaximumImageCalculator<RealImageType>;
@@ -282,10 +628,10 @@ MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>
   postProcessor->SetInPlace(true); // Save some memory
   postProcessor->Update();
 
-  // Store the output origin computed in GenerateOutputInformation so that it can be reset after the Graft.
-  RealPointType outputOrigin = this->GetOutput()->GetOrigin();
-  outputImage->Graft(postProcessor->GetOutput());
-  outputImage->SetOrigin(outputOrigin);
+
+  RealImagePointer outputImage = postProcessor->GetOutput();
+  outputImage->DisconnectPipeline();
+  return outputImage;
 }
 
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
@@ -740,6 +1086,12 @@ MaskedFFTNormalizedCorrelationImageFilter<TInputImage, TOutputImage, TMaskImage>
                                                                                             Indent         indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "RequiredNumberOfOverlappingPixels: " << m_RequiredNumberOfOverlappingPixels << std::endl;
+  os << indent << "RequiredFractionOfOverlappingPixels: " << m_RequiredFractionOfOverlappingPixels << std::endl;
+  os << indent << "MaximumNumberOfOverlappingPixels: " << m_MaximumNumberOfOverlappingPixels << std::endl;
+  os << indent << "Tiling: " << (m_Tiling ? "On" : "Off") << std::endl;
+  os << indent << "TileMemoryBudget: " << m_TileMemoryBudget << std::endl;
 }
 
 } // end namespace itk
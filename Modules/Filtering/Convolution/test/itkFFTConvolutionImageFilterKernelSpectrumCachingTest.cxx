@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using FilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+ImageType::Pointer
+MakeImage(const ImageType::SizeType & size, double frequency)
+{
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>(1.0 + std::sin(frequency * index[0]) + 2.0 * std::cos(frequency * index[1])));
+  }
+  return image;
+}
+
+// Compare the output of the caching filter with the convolution computed
+// from scratch.
+bool
+CheckOutput(FilterType * cachingFilter, const char * description)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(cachingFilter->GetInput());
+  filter->SetKernelImage(cachingFilter->GetKernelImage());
+  filter->SetNormalize(cachingFilter->GetNormalize());
+  try
+  {
+    cachingFilter->UpdateLargestPossibleRegion();
+    filter->Update();
+  }
+  catch (const itk::ExceptionObject & excp)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Unexpected exception (" << description << "): " << excp << std::endl;
+    return false;
+  }
+
+  const ImageType * expected = filter->GetOutput();
+  const ImageType * output = cachingFilter->GetOutput();
+  double            maximumDifference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    maximumDifference =
+      std::max(maximumDifference, static_cast<double>(std::abs(it.Get() - output->GetPixel(it.GetIndex()))));
+  }
+  std::cout << description << ": maximum difference " << maximumDifference << std::endl;
+  if (maximumDifference > 1e-4)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The convolution with a cached kernel spectrum differs from the convolution computed from scratch"
+              << " (" << description << ")." << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterKernelSpectrumCachingTest(int, char *[])
+{
+  const ImageType::SizeType size{ { 64, 50 } };
+  const auto                kernel = MakeImage(ImageType::SizeType{ { 5, 7 } }, 0.9);
+
+  auto filter = FilterType::New();
+  ITK_TEST_EXPECT_TRUE(!filter->GetKernelSpectrumCaching());
+  ITK_TEST_SET_GET_BOOLEAN(filter, KernelSpectrumCaching, true);
+
+  bool testPassed = true;
+
+  filter->SetInput(MakeImage(size, 0.3));
+  filter->SetKernelImage(kernel);
+  testPassed &= CheckOutput(filter, "first update");
+
+  // The cached spectrum is reused for another image of the same size.
+  filter->SetInput(MakeImage(size, 0.5));
+  testPassed &= CheckOutput(filter, "same size");
+
+  // The spectrum is computed again when the kernel is modified.
+  kernel->SetPixel({ { 2, 3 } }, 10.0f);
+  kernel->Modified();
+  testPassed &= CheckOutput(filter, "modified kernel");
+
+  filter->NormalizeOn();
+  testPassed &= CheckOutput(filter, "normalized kernel");
+
+  // The spectrum is computed again when the padded size changes.
+  filter->SetInput(MakeImage(ImageType::SizeType{ { 40, 70 } }, 0.3));
+  testPassed &= CheckOutput(filter, "other size");
+
+  // The tiles share the cached spectrum.
+  filter->TilingOn();
+  filter->SetTileMemoryBudget(8192);
+  testPassed &= CheckOutput(filter, "tiling");
+  filter->SetInput(MakeImage(ImageType::SizeType{ { 40, 70 } }, 0.7));
+  testPassed &= CheckOutput(filter, "tiling, same size");
+
+  filter->KernelSpectrumCachingOff();
+  testPassed &= CheckOutput(filter, "caching off");
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
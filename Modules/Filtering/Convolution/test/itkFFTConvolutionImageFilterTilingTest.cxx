@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, double frequency)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double value = 1.0;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      value += std::sin(frequency * (d + 1) * it.GetIndex()[d]) * (d + 1);
+    }
+    it.Set(static_cast<typename TImage::PixelType>(value));
+  }
+  return image;
+}
+
+// Compare the tiled convolution of a region of an image with the convolution
+// of the whole image.
+template <unsigned int VDimension>
+int
+TestTiling(const itk::Size<VDimension> & size,
+           const itk::Size<VDimension> & kernelSize,
+           itk::SizeValueType            tileMemoryBudget,
+           bool                          constantBoundary,
+           unsigned int                  numberOfStreamDivisions)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using FilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+  const auto image = MakeImage<ImageType>(size, 0.3);
+  const auto kernel = MakeImage<ImageType>(kernelSize, 0.7);
+
+  itk::ConstantBoundaryCondition<ImageType> boundaryCondition;
+  boundaryCondition.SetConstant(2.0f);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  filter->NormalizeOn();
+  if (constantBoundary)
+  {
+    filter->SetBoundaryCondition(&boundaryCondition);
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  auto tiledFilter = FilterType::New();
+  tiledFilter->SetInput(image);
+  tiledFilter->SetKernelImage(kernel);
+  tiledFilter->NormalizeOn();
+  if (constantBoundary)
+  {
+    tiledFilter->SetBoundaryCondition(&boundaryCondition);
+  }
+  ITK_TEST_SET_GET_BOOLEAN(tiledFilter, Tiling, true);
+  tiledFilter->SetTileMemoryBudget(tileMemoryBudget);
+  ITK_TEST_SET_GET_VALUE(tileMemoryBudget, tiledFilter->GetTileMemoryBudget());
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(tiledFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  const ImageType * expected = filter->GetOutput();
+  const ImageType * output = streamer->GetOutput();
+  double            maximumDifference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    maximumDifference =
+      std::max(maximumDifference, static_cast<double>(std::abs(it.Get() - output->GetPixel(it.GetIndex()))));
+  }
+  std::cout << "Dimension " << VDimension << ", budget " << tileMemoryBudget << ", " << numberOfStreamDivisions
+            << " stream divisions: maximum difference " << maximumDifference << std::endl;
+  if (maximumDifference > 1e-4)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The tiled convolution differs from the convolution of the whole image." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterTilingTest(int, char *[])
+{
+  auto filter = itk::FFTConvolutionImageFilter<itk::Image<float, 2>>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, FFTConvolutionImageFilter, ConvolutionImageFilterBase);
+  ITK_TEST_EXPECT_TRUE(!filter->GetTiling());
+
+  bool testPassed = true;
+
+  const itk::Size<2> size2D{ { 97, 83 } };
+  testPassed &= TestTiling<2>(size2D, itk::Size<2>{ { 5, 6 } }, 8192, false, 1) == EXIT_SUCCESS;
+  testPassed &= TestTiling<2>(size2D, itk::Size<2>{ { 7, 3 } }, 20000, true, 1) == EXIT_SUCCESS;
+  testPassed &= TestTiling<2>(size2D, itk::Size<2>{ { 7, 3 } }, 20000, false, 5) == EXIT_SUCCESS;
+  testPassed &= TestTiling<2>(size2D, itk::Size<2>{ { 4, 4 } }, 1 << 24, false, 3) == EXIT_SUCCESS;
+
+  const itk::Size<3> size3D{ { 31, 27, 23 } };
+  testPassed &= TestTiling<3>(size3D, itk::Size<3>{ { 3, 4, 5 } }, 30000, false, 1) == EXIT_SUCCESS;
+  testPassed &= TestTiling<3>(size3D, itk::Size<3>{ { 3, 4, 5 } }, 30000, true, 4) == EXIT_SUCCESS;
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMaskedFFTNormalizedCorrelationImageFilter.h"
+#include "itkFFTNormalizedCorrelationImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, double phase)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double value = 0.0;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      value += std::sin(0.3 * (d + 1) * it.GetIndex()[d] + phase) * (d + 1);
+    }
+    it.Set(static_cast<typename TImage::PixelType>(100.0 * value));
+  }
+  return image;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeMask(const typename TImage::SizeType & size, int period)
+{
+  auto mask = TImage::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    itk::IndexValueType sum = 0;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      sum += it.GetIndex()[d];
+    }
+    it.Set(sum % period == 0 ? 0 : 3);
+  }
+  return mask;
+}
+
+template <typename TImage>
+bool
+SameCorrelation(const TImage * expected, const TImage * correlation)
+{
+  if (expected->GetLargestPossibleRegion() != correlation->GetLargestPossibleRegion() ||
+      expected->GetOrigin() != correlation->GetOrigin())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The tiled correlation has a different geometry." << std::endl;
+    return false;
+  }
+  double maximumDifference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    maximumDifference = std::max(maximumDifference, std::abs(it.Get() - correlation->GetPixel(it.GetIndex())));
+  }
+  std::cout << "  maximum difference " << maximumDifference << std::endl;
+  if (maximumDifference > 1e-5)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The tiled correlation differs from the correlation of the whole images." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Compare the tiled masked correlation with the correlation of the whole images.
+template <unsigned int VDimension>
+int
+TestTiling(const itk::Size<VDimension> & fixedSize,
+           const itk::Size<VDimension> & movingSize,
+           itk::SizeValueType            tileMemoryBudget,
+           double                        requiredFractionOfOverlappingPixels)
+{
+  using InputImageType = itk::Image<short, VDimension>;
+  using OutputImageType = itk::Image<double, VDimension>;
+  using MaskImageType = itk::Image<unsigned char, VDimension>;
+  using FilterType = itk::MaskedFFTNormalizedCorrelationImageFilter<InputImageType, OutputImageType, MaskImageType>;
+
+  const auto fixedImage = MakeImage<InputImageType>(fixedSize, 0.0);
+  const auto movingImage = MakeImage<InputImageType>(movingSize, 1.0);
+  const auto fixedMask = MakeMask<MaskImageType>(fixedSize, 5);
+  const auto movingMask = MakeMask<MaskImageType>(movingSize, 7);
+
+  std::cout << "Dimension " << VDimension << ", budget " << tileMemoryBudget << ", required fraction "
+            << requiredFractionOfOverlappingPixels << std::endl;
+
+  typename OutputImageType::Pointer outputs[2];
+  for (const bool tiling : { false, true })
+  {
+    auto filter = FilterType::New();
+    filter->SetFixedImage(fixedImage);
+    filter->SetMovingImage(movingImage);
+    filter->SetFixedImageMask(fixedMask);
+    filter->SetMovingImageMask(movingMask);
+    filter->SetRequiredFractionOfOverlappingPixels(requiredFractionOfOverlappingPixels);
+    filter->SetTiling(tiling);
+    filter->SetTileMemoryBudget(tileMemoryBudget);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    outputs[tiling] = filter->GetOutput();
+  }
+  return SameCorrelation<OutputImageType>(outputs[0], outputs[1]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace
+
+int
+itkMaskedFFTNormalizedCorrelationImageFilterTilingTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+
+  auto filter = itk::MaskedFFTNormalizedCorrelationImageFilter<ImageType, ImageType>::New();
+  ITK_TEST_EXPECT_TRUE(!filter->GetTiling());
+  ITK_TEST_SET_GET_BOOLEAN(filter, Tiling, true);
+  filter->SetTileMemoryBudget(1024);
+  ITK_TEST_SET_GET_VALUE(1024, filter->GetTileMemoryBudget());
+
+  bool testPassed = true;
+
+  testPassed &= TestTiling<2>(itk::Size<2>{ { 97, 83 } }, itk::Size<2>{ { 11, 9 } }, 30000, 0.0) == EXIT_SUCCESS;
+  testPassed &= TestTiling<2>(itk::Size<2>{ { 97, 83 } }, itk::Size<2>{ { 11, 9 } }, 30000, 0.3) == EXIT_SUCCESS;
+  testPassed &= TestTiling<2>(itk::Size<2>{ { 40, 50 } }, itk::Size<2>{ { 60, 30 } }, 30000, 0.1) == EXIT_SUCCESS;
+  testPassed &= TestTiling<3>(itk::Size<3>{ { 21, 19, 17 } }, itk::Size<3>{ { 5, 6, 7 } }, 60000, 0.2) == EXIT_SUCCESS;
+
+  // The unmasked filter computes its correlation with the same tiles.
+  const itk::Size<2> fixedSize{ { 67, 59 } };
+  const itk::Size<2> movingSize{ { 13, 8 } };
+  const auto         fixedImage = MakeImage<ImageType>(fixedSize, 0.0);
+  const auto         movingImage = MakeImage<ImageType>(movingSize, 0.5);
+  using FFTFilterType = itk::FFTNormalizedCorrelationImageFilter<ImageType, itk::Image<double, 2>>;
+  FFTFilterType::OutputImageType::Pointer outputs[2];
+  for (const bool tiling : { false, true })
+  {
+    auto fftFilter = FFTFilterType::New();
+    fftFilter->SetFixedImage(fixedImage);
+    fftFilter->SetMovingImage(movingImage);
+    fftFilter->SetTiling(tiling);
+    fftFilter->SetTileMemoryBudget(20000);
+    ITK_TRY_EXPECT_NO_EXCEPTION(fftFilter->Update());
+    outputs[tiling] = fftFilter->GetOutput();
+  }
+  std::cout << "FFTNormalizedCorrelationImageFilter" << std::endl;
+  testPassed &= SameCorrelation<FFTFilterType::OutputImageType>(outputs[0], outputs[1]);
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -136,6 +136,11 @@ public:
     BaseSamplerPointer    sampler;
     EigenValuesCacheType  eigenValsCache;
     EigenVectorsCacheType eigenVecsCache;
+    // Buffer offsets, values and squared weights of the in-bounds elements
+    // of the patch being denoised, for scalar images
+    std::vector<OffsetValueType> patchOffsets;
+    std::vector<PixelType>       patchValues;
+    std::vector<RealValueType>   patchSquaredWeights;
   };
 
   /** Set/Get flag indicating whether smooth-disc patch weights should be used.
@@ -161,6 +166,34 @@ public:
   itkSetClampMacro(KernelBandwidthFractionPixelsForEstimation, double, 0.01, 1.0);
   itkGetConstReferenceMacro(KernelBandwidthFractionPixelsForEstimation, double);
 
+  /** Set/Get flag indicating whether the patch distances computed for the kernel
+   *  bandwidth sigma estimation should be cached.
+   *
+   *  The Newton-Raphson iterations of the estimation only change sigma, not the
+   *  image. When this flag is true, the patches selected by the first iteration and
+   *  their distances are stored, and the following iterations reuse them instead of
+   *  searching for and comparing patches again. The estimate is unchanged for
+   *  deterministic samplers, while random samplers then use the same patches in all
+   *  iterations. The cache holds 2 * NumIndependentComponents values for each selected
+   *  patch of each pixel used for the estimation, hence this flag is false by default.
+   */
+  itkSetMacro(KernelBandwidthDistanceCaching, bool);
+  itkBooleanMacro(KernelBandwidthDistanceCaching);
+  itkGetConstMacro(KernelBandwidthDistanceCaching, bool);
+
+  /** Set/Get flag indicating whether the image update of scalar images should skip
+   *  the selected patches whose Gaussian weight is negligible.
+   *
+   *  When this flag is true, the distance to a selected patch stops being computed
+   *  once it exceeds the smallest distance found so far by 2 ln(1/eps) sigma^2, where
+   *  eps is the machine epsilon, and the patch is skipped. Its weight would be below
+   *  eps relative to the largest weight, so the output changes by about eps relative,
+   *  but it is no longer bit-for-bit identical, hence this flag is false by default.
+   */
+  itkSetMacro(SkipNegligiblePatches, bool);
+  itkBooleanMacro(SkipNegligiblePatches);
+  itkGetConstMacro(SkipNegligiblePatches, bool);
+
   /** Set/Get flag indicating whether conditional derivatives should be used
     estimating sigma. */
   itkSetMacro(ComputeConditionalDerivatives, bool);
@@ -406,7 +439,7 @@ protected:
 
   virtual ThreadDataStruct
   ThreadedComputeSigmaUpdate(const InputImageRegionType & regionToProcess,
-                             const int                    itkNotUsed(threadId),
+                             const int                    threadId,
                              ThreadDataStruct             threadData);
 
   virtual RealArrayType
@@ -516,6 +549,26 @@ private:
                           FixedArray<TensorValueT, 3> &           eigenVals,
                           Matrix<TensorValueT, 3, 3> &            eigenVecs);
 
+  /** Store the buffer offsets, values and squared weights of the in-bounds elements
+   * of a scalar patch in the thread data, in the order in which the patch distances
+   * are summed, the center element last. The weight of element jj is patchWeights[jj]
+   * if patchWeights is not null, and weight otherwise. */
+  void
+  GatherScalarPatch(const InputImagePatchIterator & patch,
+                    const PatchWeightsType *        patchWeights,
+                    RealValueType                   weight,
+                    ThreadDataStruct &              threadData) const;
+
+  /** Compute the weighted squared distance between the first numberOfElements
+   * elements of the patch gathered by GatherScalarPatch and the patch centered at
+   * selectedCenter. The computation stops as soon as the partial sum exceeds
+   * maximumSquaredNorm. */
+  static RealValueType
+  ComputeScalarPatchSquaredNorm(const PixelType *        selectedCenter,
+                                const ThreadDataStruct & threadData,
+                                SizeValueType            numberOfElements,
+                                RealValueType            maximumSquaredNorm);
+
   RealType
   AddEuclideanUpdate(const RealType & a, const RealType & b);
 
@@ -558,6 +611,18 @@ private:
   ShortArrayType m_SigmaConverged{};
   double         m_KernelBandwidthMultiplicationFactor{ 1.0 };
 
+  /** Buffer offsets of the patch elements relative to the patch center. */
+  std::vector<OffsetValueType> m_PatchBufferOffsets{};
+
+  bool m_KernelBandwidthDistanceCaching{ false };
+  bool m_SkipNegligiblePatches{ false };
+  bool m_KernelBandwidthDistancesCached{ false };
+
+  /** Number of selected patches for each pixel used for the kernel bandwidth
+   * estimation, and their squared distances, per work unit. */
+  std::vector<std::vector<unsigned int>>  m_CachedNumberOfSelectedPatches{};
+  std::vector<std::vector<RealValueType>> m_CachedSquaredNorms{};
+
   RealType m_NoiseSigma{};
   RealType m_NoiseSigmaSquared{};
   bool     m_NoiseSigmaIsSet{ false };
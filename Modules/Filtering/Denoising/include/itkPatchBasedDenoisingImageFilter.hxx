@@ -809,6 +809,75 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeSignedEuclidea
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::GatherScalarPatch(
+  const InputImagePatchIterator & patch,
+  const PatchWeightsType *        patchWeights,
+  RealValueType                   weight,
+  ThreadDataStruct &              threadData) const
+{
+  const unsigned int lengthPatch = this->GetPatchLengthInVoxels();
+  const unsigned int center = (lengthPatch - 1) / 2;
+
+  threadData.patchOffsets.clear();
+  threadData.patchValues.clear();
+  threadData.patchSquaredWeights.clear();
+
+  const auto addElement = [&](unsigned int jj) {
+    bool            isInBounds;
+    const PixelType value = patch.GetPixel(jj, isInBounds);
+    if (isInBounds)
+    {
+      const RealValueType elementWeight = patchWeights ? (*patchWeights)[jj] : weight;
+      threadData.patchOffsets.push_back(m_PatchBufferOffsets[jj]);
+      threadData.patchValues.push_back(value);
+      threadData.patchSquaredWeights.push_back(elementWeight * elementWeight);
+    }
+  };
+
+  // Same order as the partially unrolled loops comparing the patches
+  for (unsigned int jj = 0, kk = center + 1; jj < center; ++jj, ++kk)
+  {
+    addElement(jj);
+    addElement(kk);
+  }
+  addElement(center);
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeScalarPatchSquaredNorm(
+  const PixelType *        selectedCenter,
+  const ThreadDataStruct & threadData,
+  SizeValueType            numberOfElements,
+  RealValueType            maximumSquaredNorm) -> RealValueType
+{
+  const OffsetValueType * offsets = threadData.patchOffsets.data();
+  const PixelType *       values = threadData.patchValues.data();
+  const RealValueType *   squaredWeights = threadData.patchSquaredWeights.data();
+
+  // Check the partial sum once per block of elements, to keep the inner loop
+  // free of branches
+  constexpr SizeValueType blockSize = 16;
+
+  RealValueType squaredNorm = 0.0;
+  for (SizeValueType first = 0; first < numberOfElements; first += blockSize)
+  {
+    const SizeValueType last = std::min(first + blockSize, numberOfElements);
+    for (SizeValueType jj = first; jj < last; ++jj)
+    {
+      const RealValueType diff = selectedCenter[offsets[jj]] - values[jj];
+      squaredNorm += squaredWeights[jj] * diff * diff;
+    }
+    if (squaredNorm > maximumSquaredNorm)
+    {
+      break;
+    }
+  }
+  return squaredNorm;
+}
+
 template <typename TInputImage, typename TOutputImage>
 template <typename TensorValueT>
 void
@@ -1323,6 +1392,23 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::InitializeIteration()
 {
   const PatchRadiusType radius = this->GetPatchRadiusInVoxels();
 
+  // Buffer offsets of the patch elements, to compare scalar patches directly
+  // in the output buffer
+  using PatchNeighborhoodType = Neighborhood<PixelValueType, ImageDimension>;
+  const unsigned int      lengthPatch = this->GetPatchLengthInVoxels();
+  const OffsetValueType * offsetTable = this->m_OutputImage->GetOffsetTable();
+  PatchNeighborhoodType   patchNeighborhood;
+  patchNeighborhood.SetRadius(radius);
+  m_PatchBufferOffsets.assign(lengthPatch, 0);
+  for (unsigned int jj = 0; jj < lengthPatch; ++jj)
+  {
+    const typename PatchNeighborhoodType::OffsetType offset = patchNeighborhood.GetOffset(jj);
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      m_PatchBufferOffsets[jj] += offset[dim] * offsetTable[dim];
+    }
+  }
+
   // Have sampler update any internal structures
   // across the entire image for each iteration
   m_SearchSpaceList->SetImage(this->m_OutputImage);
@@ -1433,6 +1519,13 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeKernelBandwidt
 
   RealArrayType sigmaUpdate;
 
+  // Distances cached by a previous estimation are stale, since the image changed
+  const unsigned int numberOfCaches =
+    m_KernelBandwidthDistanceCaching ? this->GetMultiThreader()->GetNumberOfWorkUnits() : 0;
+  m_KernelBandwidthDistancesCached = false;
+  m_CachedNumberOfSelectedPatches.assign(numberOfCaches, {});
+  m_CachedSquaredNorms.assign(numberOfCaches, {});
+
   // Perform Newton-Raphson optimization to find the optimal kernel sigma
   for (unsigned int i = 0; i < MaxSigmaUpdateIterations; ++i)
   {
@@ -1441,6 +1534,7 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeKernelBandwidt
     // Multi-threaded computation of the first and second derivatives
     // of the entropy with respect to sigma
     this->GetMultiThreader()->SingleMethodExecute();
+    m_KernelBandwidthDistancesCached = m_KernelBandwidthDistanceCaching;
 
     // Accumulate results from each thread and appropriately update sigma after
     // checks to prevent divergence or invalid
@@ -1472,6 +1566,11 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeKernelBandwidt
     }
   } // end Newton-Raphson iterations
 
+  // Release the cached patch distances
+  m_KernelBandwidthDistancesCached = false;
+  m_CachedNumberOfSelectedPatches.clear();
+  m_CachedSquaredNorms.clear();
+
   // Undo rescale of Gaussian kernel sigma put the multiplication factor back
   // in
   for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
@@ -1513,7 +1612,7 @@ template <typename TInputImage, typename TOutputImage>
 auto
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeSigmaUpdate(
   const InputImageRegionType & regionToProcess,
-  const int                    itkNotUsed(threadId),
+  const int                    threadId,
   ThreadDataStruct             threadData) -> ThreadDataStruct
 {
   // Create two images to list adaptors, one for the iteration over the region
@@ -1576,6 +1675,24 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeSigmaU
   }
   inList->SetRegion(*fIt);
 
+  // The patch distances do not depend on sigma, so they may be computed once
+  // per estimation and reused by the following Newton-Raphson iterations
+  const bool                   readCache = m_KernelBandwidthDistanceCaching && m_KernelBandwidthDistancesCached;
+  const bool                   fillCache = m_KernelBandwidthDistanceCaching && !m_KernelBandwidthDistancesCached;
+  std::vector<RealValueType>   squaredNorms;
+  std::vector<unsigned int> *  cachedNumberOfSelectedPatches = nullptr;
+  std::vector<RealValueType> * cachedSquaredNorms = nullptr;
+  if (m_KernelBandwidthDistanceCaching)
+  {
+    cachedNumberOfSelectedPatches = &m_CachedNumberOfSelectedPatches[threadId];
+    cachedSquaredNorms = &m_CachedSquaredNorms[threadId];
+  }
+  SizeValueType cachedSample = 0;
+  SizeValueType cachedSquaredNormsPosition = 0;
+
+  const SizeValueType   normsPerPatch = 2 * m_NumIndependentComponents;
+  const RealValueType * patchSquaredNorms = nullptr;
+
   unsigned int sampleNum = 0;
   for (SampleIteratorType sampleIt = inList->Begin(); sampleIt != inList->End(); ++sampleIt, ++sampleNum)
   {
@@ -1584,39 +1701,200 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeSigmaU
       // Skip this sample
       continue;
     }
-    InputImagePatchIterator currentPatch = sampleIt.GetMeasurementVector()[0];
-    IndexType               nIndex = currentPatch.GetIndex();
-    InstanceIdentifier      currentPatchId = inList->GetImage()->ComputeOffset(nIndex);
-
-    // Select a set of patches from the full image, excluding points that have
-    // neighbors outside the boundary at locations different than that of the
-    // current patch.
-    // For example, say we have a 7x10 image and current patch index == (0,1)
-    // with radius = 2.
-    // Then the sampler should be constrained to only select other patches with
-    // indices in the range (0:7-2-1,1:10-2-1) == (0:4,1:7)
-    // Conversely if the current patch index == (5,8) with radius = 2,
-    // the sampler should only select other patches with indices in the range
-    // (2:5,2:8)
-    // That is, the range formula is min(index,radius):max(index,size-radius-1)
-
-    typename OutputImageType::RegionType region = inputImage->GetLargestPossibleRegion();
-    IndexType                            rIndex;
-    typename OutputImageType::SizeType   rSize = region.GetSize();
-    for (unsigned int dim = 0; dim < OutputImageType::ImageDimension; ++dim)
+
+    unsigned int numPatches = 0;
+    if (readCache)
     {
-      rIndex[dim] = std::min(nIndex[dim], static_cast<IndexValueType>(radius[dim]));
-      rSize[dim] = std::max(nIndex[dim], static_cast<IndexValueType>(rSize[dim] - radius[dim] - 1)) - rIndex[dim] + 1;
+      numPatches = (*cachedNumberOfSelectedPatches)[cachedSample++];
+      patchSquaredNorms = cachedSquaredNorms->data() + cachedSquaredNormsPosition;
+      cachedSquaredNormsPosition += numPatches * normsPerPatch;
     }
-    region.SetIndex(rIndex);
-    region.SetSize(rSize);
+    else
+    {
+      InputImagePatchIterator currentPatch = sampleIt.GetMeasurementVector()[0];
+      IndexType               nIndex = currentPatch.GetIndex();
+      InstanceIdentifier      currentPatchId = inList->GetImage()->ComputeOffset(nIndex);
+
+      // Select a set of patches from the full image, excluding points that have
+      // neighbors outside the boundary at locations different than that of the
+      // current patch.
+      // For example, say we have a 7x10 image and current patch index == (0,1)
+      // with radius = 2.
+      // Then the sampler should be constrained to only select other patches with
+      // indices in the range (0:7-2-1,1:10-2-1) == (0:4,1:7)
+      // Conversely if the current patch index == (5,8) with radius = 2,
+      // the sampler should only select other patches with indices in the range
+      // (2:5,2:8)
+      // That is, the range formula is min(index,radius):max(index,size-radius-1)
+
+      typename OutputImageType::RegionType region = inputImage->GetLargestPossibleRegion();
+      IndexType                            rIndex;
+      typename OutputImageType::SizeType   rSize = region.GetSize();
+      for (unsigned int dim = 0; dim < OutputImageType::ImageDimension; ++dim)
+      {
+        rIndex[dim] = std::min(nIndex[dim], static_cast<IndexValueType>(radius[dim]));
+        rSize[dim] =
+          std::max(nIndex[dim], static_cast<IndexValueType>(rSize[dim] - radius[dim] - 1)) - rIndex[dim] + 1;
+      }
+      region.SetIndex(rIndex);
+      region.SetSize(rSize);
+
+      typename BaseSamplerType::SubsamplePointer selectedPatches = BaseSamplerType::SubsampleType::New();
+      sampler->SetRegionConstraint(region);
+      sampler->CanSelectQueryOff();
+      sampler->Search(currentPatchId, selectedPatches);
+
+      numPatches = selectedPatches->GetTotalFrequency();
+
+      if (numPatches == 0)
+      {
+        InputImagePatchIterator queryIt = sampler->GetSample()->GetMeasurementVector(currentPatchId)[0];
+        itkDebugMacro("unexpected index for current patch, search results are empty."
+                      << "\ncurrent patch id: " << currentPatchId << "\ncurrent patch index: " << nIndex
+                      << "\nindex calculated by searcher: " << queryIt.GetIndex(queryIt.GetCenterNeighborhoodIndex())
+                      << "\npatch accessed by searcher: ");
+      }
+
+      // The squared norms of the selected patches, followed by the squared
+      // norms of their centers, for each selected patch
+      std::vector<RealValueType> & norms = fillCache ? *cachedSquaredNorms : squaredNorms;
+      if (!fillCache)
+      {
+        norms.clear();
+      }
+      const SizeValueType firstNorm = norms.size();
+
+      if constexpr (std::is_same_v<PixelType, typename NumericTraits<PixelType>::ValueType>)
+      {
+        // Compare the patches directly in the output buffer. Because we are
+        // processing a region whose pixels are all in bounds, the whole patches
+        // are compared.
+        const PixelType * outputBuffer = output->GetBufferPointer();
+        this->GatherScalarPatch(currentPatch, nullptr, m_IntensityRescaleInvFactor[0], threadData);
+        const SizeValueType numberOfElements = threadData.patchOffsets.size() - 1;
+        const PixelType     centerValue = threadData.patchValues[numberOfElements];
+        const RealValueType centerSquaredWeight = threadData.patchSquaredWeights[numberOfElements];
+        for (const InstanceIdentifier selectedId : selectedPatches->GetIdHolder())
+        {
+          const PixelType * selectedCenter = outputBuffer + selectedId;
+          RealValueType     squaredNorm = ComputeScalarPatchSquaredNorm(
+            selectedCenter, threadData, numberOfElements, NumericTraits<RealValueType>::max());
+          const RealValueType centerDiff = *selectedCenter - centerValue;
+          const RealValueType centerPatchSquaredNorm = centerSquaredWeight * centerDiff * centerDiff;
+          squaredNorm += centerPatchSquaredNorm;
+          norms.push_back(squaredNorm);
+          norms.push_back(centerPatchSquaredNorm);
+        }
+      }
+      else
+      {
+        VariableLengthVector<PixelType> currentPatchVec(lengthPatch);
+        // Store the current patch prior to iterating over the selected patches
+        // to avoid repeatedly calling GetPixel for this patch
+        // because we know we are processing a region whose pixels are all in
+        // bounds, we don't need to check this any further when dealing with the
+        // patches
+        for (unsigned int jj = 0; jj < lengthPatch; ++jj)
+        {
+          currentPatchVec[jj] = currentPatch.GetPixel(jj);
+        }
 
-    typename BaseSamplerType::SubsamplePointer selectedPatches = BaseSamplerType::SubsampleType::New();
-    sampler->SetRegionConstraint(region);
-    sampler->CanSelectQueryOff();
-    sampler->Search(currentPatchId, selectedPatches);
+        IndexType               lastSelectedIdx;
+        IndexType               currSelectedIdx;
+        InputImagePatchIterator selectedPatch;
+        if (numPatches > 0)
+        {
+          selectedPatch = selectedPatches->Begin().GetMeasurementVector()[0];
+          lastSelectedIdx = selectedPatch.GetIndex();
+        }
 
-    const unsigned int numPatches = selectedPatches->GetTotalFrequency();
+        RealType      centerPatchDifference;
+        RealArrayType squaredNorm(m_NumIndependentComponents);
+        RealArrayType centerPatchSquaredNorm(m_NumIndependentComponents);
+        RealArrayType tmpNorm1(m_NumIndependentComponents);
+        RealArrayType tmpNorm2(m_NumIndependentComponents);
+
+        bool useCachedComputations = false;
+        for (typename BaseSamplerType::SubsampleConstIterator selectedIt = selectedPatches->Begin();
+             selectedIt != selectedPatches->End();
+             ++selectedIt)
+        {
+          currSelectedIdx = selectedIt.GetMeasurementVector()[0].GetIndex();
+          selectedPatch += currSelectedIdx - lastSelectedIdx;
+          lastSelectedIdx = currSelectedIdx;
+          // Since we make sure that the search query can only take place in a
+          // certain image region it is sufficient to rely on the fact that the
+          // current patch is in bounds
+
+          selectedPatch.NeedToUseBoundaryConditionOff();
+
+          // This partial loop unrolling works because the length of the patch is
+          // always odd guaranteeing that center - 0 == lengthPatch - center+1
+          // always
+          squaredNorm.Fill(0.0);
+          for (unsigned int jj = 0, kk = center + 1; jj < center; ++jj, ++kk)
+          {
+            // Rescale intensities, and differences, to a range of 100
+            RealType diff1;
+            RealType diff2;
+            this->ComputeDifferenceAndWeightedSquaredNorm(currentPatchVec[jj],
+                                                          selectedPatch.GetPixel(jj),
+                                                          m_IntensityRescaleInvFactor,
+                                                          useCachedComputations,
+                                                          jj,
+                                                          threadData.eigenValsCache,
+                                                          threadData.eigenVecsCache,
+                                                          diff1,
+                                                          tmpNorm1);
+            this->ComputeDifferenceAndWeightedSquaredNorm(currentPatchVec[kk],
+                                                          selectedPatch.GetPixel(kk),
+                                                          m_IntensityRescaleInvFactor,
+                                                          useCachedComputations,
+                                                          kk,
+                                                          threadData.eigenValsCache,
+                                                          threadData.eigenVecsCache,
+                                                          diff2,
+                                                          tmpNorm2);
+            for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
+            {
+              squaredNorm[ic] += tmpNorm1[ic];
+              squaredNorm[ic] += tmpNorm2[ic];
+            }
+          }
+
+          // Rescale intensities, and differences, to a range of 100
+          this->ComputeDifferenceAndWeightedSquaredNorm(currentPatchVec[center],
+                                                        selectedPatch.GetPixel(center),
+                                                        m_IntensityRescaleInvFactor,
+                                                        useCachedComputations,
+                                                        center,
+                                                        threadData.eigenValsCache,
+                                                        threadData.eigenVecsCache,
+                                                        centerPatchDifference,
+                                                        centerPatchSquaredNorm);
+          useCachedComputations = true;
+
+          for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
+          {
+            squaredNorm[ic] += centerPatchSquaredNorm[ic];
+          }
+          for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
+          {
+            norms.push_back(squaredNorm[ic]);
+          }
+          for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
+          {
+            norms.push_back(centerPatchSquaredNorm[ic]);
+          }
+        } // end for each selected patch
+      }
+
+      if (fillCache)
+      {
+        cachedNumberOfSelectedPatches->push_back(numPatches);
+      }
+      patchSquaredNorms = norms.data() + firstNorm;
+    }
 
     RealArrayType probJointEntropy(m_NumIndependentComponents);
     RealArrayType probJointEntropyFirstDerivative(m_NumIndependentComponents);
@@ -1632,120 +1910,29 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeSigmaU
     probPatchEntropyFirstDerivative.Fill(0.0);
     probPatchEntropySecondDerivative.Fill(0.0);
 
-    VariableLengthVector<PixelType> currentPatchVec(lengthPatch);
-    // Store the current patch prior to iterating over the selected patches
-    // to avoid repeatedly calling GetPixel for this patch
-    // because we know we are processing a region whose pixels are all in
-    // bounds, we don't need to check this any further when dealing with the
-    // patches
-    for (unsigned int jj = 0; jj < lengthPatch; ++jj)
-    {
-      currentPatchVec[jj] = currentPatch.GetPixel(jj);
-    }
-
-    IndexType               lastSelectedIdx;
-    IndexType               currSelectedIdx;
-    InputImagePatchIterator selectedPatch;
-    if (numPatches > 0)
-    {
-      selectedPatch = selectedPatches->Begin().GetMeasurementVector()[0];
-      lastSelectedIdx = selectedPatch.GetIndex();
-    }
-    else
-    {
-      InputImagePatchIterator queryIt = sampler->GetSample()->GetMeasurementVector(currentPatchId)[0];
-      itkDebugMacro("unexpected index for current patch, search results are empty."
-                    << "\ncurrent patch id: " << currentPatchId << "\ncurrent patch index: " << nIndex
-                    << "\nindex calculated by searcher: " << queryIt.GetIndex(queryIt.GetCenterNeighborhoodIndex())
-                    << "\npatch accessed by searcher: ");
-    }
-
-    RealType      centerPatchDifference;
-    RealArrayType squaredNorm(m_NumIndependentComponents);
-    RealArrayType centerPatchSquaredNorm(m_NumIndependentComponents);
-    RealArrayType tmpNorm1(m_NumIndependentComponents);
-    RealArrayType tmpNorm2(m_NumIndependentComponents);
-
-    bool useCachedComputations = false;
-    for (typename BaseSamplerType::SubsampleConstIterator selectedIt = selectedPatches->Begin();
-         selectedIt != selectedPatches->End();
-         ++selectedIt)
+    for (unsigned int ii = 0; ii < numPatches; ++ii, patchSquaredNorms += normsPerPatch)
     {
-      currSelectedIdx = selectedIt.GetMeasurementVector()[0].GetIndex();
-      selectedPatch += currSelectedIdx - lastSelectedIdx;
-      lastSelectedIdx = currSelectedIdx;
-      // Since we make sure that the search query can only take place in a
-      // certain image region it is sufficient to rely on the fact that the
-      // current patch is in bounds
-
-      selectedPatch.NeedToUseBoundaryConditionOff();
-
-      // This partial loop unrolling works because the length of the patch is
-      // always odd guaranteeing that center - 0 == lengthPatch - center+1
-      // always
-      squaredNorm.Fill(0.0);
-      for (unsigned int jj = 0, kk = center + 1; jj < center; ++jj, ++kk)
-      {
-        // Rescale intensities, and differences, to a range of 100
-        RealType diff1;
-        RealType diff2;
-        this->ComputeDifferenceAndWeightedSquaredNorm(currentPatchVec[jj],
-                                                      selectedPatch.GetPixel(jj),
-                                                      m_IntensityRescaleInvFactor,
-                                                      useCachedComputations,
-                                                      jj,
-                                                      threadData.eigenValsCache,
-                                                      threadData.eigenVecsCache,
-                                                      diff1,
-                                                      tmpNorm1);
-        this->ComputeDifferenceAndWeightedSquaredNorm(currentPatchVec[kk],
-                                                      selectedPatch.GetPixel(kk),
-                                                      m_IntensityRescaleInvFactor,
-                                                      useCachedComputations,
-                                                      kk,
-                                                      threadData.eigenValsCache,
-                                                      threadData.eigenVecsCache,
-                                                      diff2,
-                                                      tmpNorm2);
-        for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
-        {
-          squaredNorm[ic] += tmpNorm1[ic];
-          squaredNorm[ic] += tmpNorm2[ic];
-        }
-      }
-
-      // Rescale intensities, and differences, to a range of 100
-      this->ComputeDifferenceAndWeightedSquaredNorm(currentPatchVec[center],
-                                                    selectedPatch.GetPixel(center),
-                                                    m_IntensityRescaleInvFactor,
-                                                    useCachedComputations,
-                                                    center,
-                                                    threadData.eigenValsCache,
-                                                    threadData.eigenVecsCache,
-                                                    centerPatchDifference,
-                                                    centerPatchSquaredNorm);
-      useCachedComputations = true;
-
       for (unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic)
       {
-        squaredNorm[ic] += centerPatchSquaredNorm[ic];
+        const RealValueType squaredNorm = patchSquaredNorms[ic];
+        const RealValueType centerPatchSquaredNorm = patchSquaredNorms[m_NumIndependentComponents + ic];
 
         const RealValueType sigmaKernel = m_KernelBandwidthSigma[ic];
-        const RealValueType distanceJointEntropy = std::sqrt(squaredNorm[ic]);
+        const RealValueType distanceJointEntropy = std::sqrt(squaredNorm);
 
         const RealValueType gaussianJointEntropy = exp(-itk::Math::sqr(distanceJointEntropy / sigmaKernel) / 2.0);
 
         probJointEntropy[ic] += gaussianJointEntropy;
 
-        const RealValueType factorJoint = squaredNorm[ic] / pow(sigmaKernel, 3.0) - (lengthPatch * 1 / sigmaKernel);
+        const RealValueType factorJoint = squaredNorm / pow(sigmaKernel, 3.0) - (lengthPatch * 1 / sigmaKernel);
 
         probJointEntropyFirstDerivative[ic] += gaussianJointEntropy * factorJoint;
         probJointEntropySecondDerivative[ic] +=
           gaussianJointEntropy * (itk::Math::sqr(factorJoint) + (lengthPatch * 1 / itk::Math::sqr(sigmaKernel)) -
-                                  (3.0 * squaredNorm[ic] / pow(sigmaKernel, 4.0)));
+                                  (3.0 * squaredNorm / pow(sigmaKernel, 4.0)));
         if (m_ComputeConditionalDerivatives)
         {
-          const RealValueType distancePatchEntropySquared = squaredNorm[ic] - centerPatchSquaredNorm[ic];
+          const RealValueType distancePatchEntropySquared = squaredNorm - centerPatchSquaredNorm;
           const RealValueType distancePatchEntropy = std::sqrt(distancePatchEntropySquared);
           const RealValueType gaussianPatchEntropy = exp(-itk::Math::sqr(distancePatchEntropy / sigmaKernel) / 2.0);
           probPatchEntropy[ic] += gaussianPatchEntropy;
@@ -2157,6 +2344,50 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeGradientJointE
   sampler->CanSelectQueryOn();
   sampler->Search(currentPatchId, selectedPatches);
 
+  if constexpr (std::is_same_v<PixelType, typename NumericTraits<PixelType>::ValueType>)
+  {
+    // Compare the in-bounds elements of the patches directly in the output
+    // buffer. With SkipNegligiblePatches, once the partial distance of a
+    // selected patch exceeds the smallest distance found so far by
+    // negligibleSquaredNorm, its Gaussian weight is below the machine epsilon
+    // relative to the largest weight, so the patch is skipped.
+    const PatchWeightsType patchWeights = this->GetPatchWeights();
+    this->GatherScalarPatch(currentPatch, &patchWeights, 1.0, threadData);
+    const SizeValueType numberOfElements = threadData.patchOffsets.size() - 1;
+    const PixelType     centerValue = threadData.patchValues[numberOfElements];
+    const RealValueType centerSquaredWeight = threadData.patchSquaredWeights[numberOfElements];
+    const PixelType *   outputBuffer = output->GetBufferPointer();
+
+    const RealValueType squaredKernelSigma = itk::Math::sqr(m_KernelBandwidthSigma[0]);
+    const RealValueType negligibleSquaredNorm =
+      -2.0 * std::log(NumericTraits<RealValueType>::epsilon()) * squaredKernelSigma;
+    RealValueType minimumSquaredNorm = NumericTraits<RealValueType>::max();
+
+    RealValueType sumOfGaussiansJointEntropy = 0.0;
+    RealType      gradientJointEntropy = m_ZeroPixel;
+    for (const InstanceIdentifier selectedId : selectedPatches->GetIdHolder())
+    {
+      const PixelType *   selectedCenter = outputBuffer + selectedId;
+      const RealValueType maximumSquaredNorm =
+        m_SkipNegligiblePatches ? minimumSquaredNorm + negligibleSquaredNorm : NumericTraits<RealValueType>::infinity();
+      RealValueType       squaredNorm =
+        ComputeScalarPatchSquaredNorm(selectedCenter, threadData, numberOfElements, maximumSquaredNorm);
+      if (squaredNorm > maximumSquaredNorm)
+      {
+        continue;
+      }
+      const RealType centerPatchDifference = *selectedCenter - centerValue;
+      squaredNorm += centerSquaredWeight * centerPatchDifference * centerPatchDifference;
+      minimumSquaredNorm = std::min(minimumSquaredNorm, squaredNorm);
+
+      const RealValueType distanceJointEntropy = squaredNorm / squaredKernelSigma;
+      const RealValueType gaussianJointEntropy = exp(-distanceJointEntropy / 2.0);
+      sumOfGaussiansJointEntropy += gaussianJointEntropy;
+      gradientJointEntropy += centerPatchDifference * gaussianJointEntropy;
+    }
+    return gradientJointEntropy / (sumOfGaussiansJointEntropy + m_MinProbability);
+  }
+
   const unsigned int numPatches = selectedPatches->GetTotalFrequency();
 
   RealType                             centerPatchDifference = m_ZeroPixel;
@@ -2411,6 +2642,8 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostrea
      << std::endl;
 
   itkPrintSelfBooleanMacro(ComputeConditionalDerivatives);
+  itkPrintSelfBooleanMacro(KernelBandwidthDistanceCaching);
+  itkPrintSelfBooleanMacro(SkipNegligiblePatches);
 
   os << indent << "MinSigma: " << m_MinSigma << std::endl;
   os << indent << "MinProbability: " << m_MinProbability << std::endl;
@@ -51,6 +51,8 @@ doDenoising(const std::string & inputFileName, const std::string & outputFileNam
   ITK_TEST_SET_GET_VALUE(kernelBandwidthSigma, filter->GetKernelBandwidthSigma());
   ITK_TEST_SET_GET_VALUE(0.20, filter->GetKernelBandwidthFractionPixelsForEstimation());
   ITK_TEST_SET_GET_BOOLEAN(filter, ComputeConditionalDerivatives, false);
+  ITK_TEST_SET_GET_BOOLEAN(filter, KernelBandwidthDistanceCaching, false);
+  ITK_TEST_SET_GET_BOOLEAN(filter, SkipNegligiblePatches, false);
   ITK_TEST_SET_GET_BOOLEAN(filter, UseFastTensorComputations, true);
   ITK_TEST_SET_GET_VALUE(1.0, filter->GetKernelBandwidthMultiplicationFactor());
   ITK_TEST_SET_GET_VALUE(0, filter->GetNoiseSigma());
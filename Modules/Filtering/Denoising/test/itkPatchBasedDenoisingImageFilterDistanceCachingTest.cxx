@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPatchBasedDenoisingImageFilter.h"
+#include "itkSpatialNeighborSubsampler.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Denoise a noisy step edge with and without caching the patch distances of
+// the kernel bandwidth estimation. With a deterministic sampler, the estimated
+// kernel bandwidth and the denoised images are the same.
+template <typename TImage>
+int
+TestDistanceCaching(const typename TImage::SizeType & size)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using FilterType = itk::PatchBasedDenoisingImageFilter<ImageType, ImageType>;
+  using SamplerType =
+    itk::Statistics::SpatialNeighborSubsampler<typename FilterType::PatchSampleType, typename ImageType::RegionType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double value = it.GetIndex()[0] < static_cast<itk::IndexValueType>(size[0] / 2) ? 50.0 : 150.0;
+    PixelType    pixel;
+    if constexpr (std::is_arithmetic_v<PixelType>)
+    {
+      pixel = value + generator->GetNormalVariate(0.0, 100.0);
+    }
+    else
+    {
+      for (unsigned int pc = 0; pc < PixelType::Dimension; ++pc)
+      {
+        pixel[pc] = value + generator->GetNormalVariate(0.0, 100.0);
+      }
+    }
+    it.Set(pixel);
+  }
+
+  typename ImageType::Pointer        outputs[2];
+  typename FilterType::RealArrayType kernelBandwidthSigmas[2];
+  for (const bool caching : { false, true })
+  {
+    auto sampler = SamplerType::New();
+    sampler->SetRadius(3);
+
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetSampler(sampler);
+    filter->SetPatchRadius(2);
+    filter->SetNumberOfIterations(2);
+    filter->KernelBandwidthEstimationOn();
+    filter->SetKernelBandwidthUpdateFrequency(1);
+    filter->SetKernelBandwidthDistanceCaching(caching);
+    filter->SetNumberOfWorkUnits(2);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    outputs[caching] = filter->GetOutput();
+    kernelBandwidthSigmas[caching] = filter->GetKernelBandwidthSigma();
+  }
+
+  std::cout << "Dimension " << ImageType::ImageDimension << ", "
+            << itk::NumericTraits<PixelType>::GetLength(PixelType{}) << " components: kernel bandwidth sigma "
+            << kernelBandwidthSigmas[0] << " without caching, " << kernelBandwidthSigmas[1] << " with caching"
+            << std::endl;
+
+  if (kernelBandwidthSigmas[0] != kernelBandwidthSigmas[1])
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The kernel bandwidth estimated with cached patch distances differs." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(outputs[0], outputs[0]->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (it.Get() != outputs[1]->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The image denoised with cached patch distances differs at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Denoise a noisy step edge with and without skipping the selected patches of
+// negligible weight. The denoised images differ by about the machine epsilon.
+int
+TestNegligiblePatchSkipping()
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::PatchBasedDenoisingImageFilter<ImageType, ImageType>;
+  using SamplerType = itk::Statistics::SpatialNeighborSubsampler<FilterType::PatchSampleType, ImageType::RegionType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(itk::Size<2>{ { 40, 30 } });
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>((it.GetIndex()[0] < 20 ? 50.0 : 150.0) + generator->GetNormalVariate(0.0, 100.0)));
+  }
+
+  ImageType::Pointer outputs[2];
+  for (const bool skipping : { false, true })
+  {
+    auto sampler = SamplerType::New();
+    sampler->SetRadius(5);
+
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetSampler(sampler);
+    filter->SetPatchRadius(2);
+    filter->SetNumberOfIterations(2);
+    filter->KernelBandwidthEstimationOff();
+    filter->SetKernelBandwidthSigma(FilterType::RealArrayType(1, 5.0));
+    filter->SetSkipNegligiblePatches(skipping);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    outputs[skipping] = filter->GetOutput();
+  }
+
+  double maximumDifference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(outputs[0], outputs[0]->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    maximumDifference =
+      std::max(maximumDifference, std::abs(static_cast<double>(it.Get()) - outputs[1]->GetPixel(it.GetIndex())));
+  }
+  std::cout << "Maximum difference when skipping the negligible patches: " << maximumDifference << std::endl;
+
+  if (maximumDifference > 1e-3)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Skipping the negligible patches changes the denoised image by " << maximumDifference << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkPatchBasedDenoisingImageFilterDistanceCachingTest(int, char *[])
+{
+  using FilterType = itk::PatchBasedDenoisingImageFilter<itk::Image<float, 2>, itk::Image<float, 2>>;
+
+  auto filter = FilterType::New();
+  ITK_TEST_EXPECT_TRUE(!filter->GetKernelBandwidthDistanceCaching());
+  ITK_TEST_SET_GET_BOOLEAN(filter, KernelBandwidthDistanceCaching, true);
+
+  bool testPassed = true;
+  testPassed &= TestDistanceCaching<itk::Image<float, 2>>(itk::Size<2>{ { 40, 30 } }) == EXIT_SUCCESS;
+  testPassed &= TestDistanceCaching<itk::Image<float, 3>>(itk::Size<3>{ { 16, 14, 12 } }) == EXIT_SUCCESS;
+  testPassed &=
+    TestDistanceCaching<itk::Image<itk::Vector<float, 2>, 2>>(itk::Size<2>{ { 30, 24 } }) == EXIT_SUCCESS;
+  testPassed &= TestNegligiblePatchSkipping() == EXIT_SUCCESS;
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
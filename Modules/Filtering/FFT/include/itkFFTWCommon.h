@@ -33,6 +33,7 @@
 
 #endif
 
+#include <functional>
 #include <mutex>
 
 namespace itk
@@ -386,6 +387,124 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+  /** Execute a transform with a plan of the FFTWGlobalConfiguration plan
+   * cache, which is created only if no plan has been cached for the same
+   * sizes, flags, number of threads and array alignments. When given,
+   * fillInput is called once the plan is available and before it is
+   * executed, so that a buffer which the planner may destroy can be filled
+   * after the planning. */
+  static void
+  Execute_dft_c2r(int                           rank,
+                  const int *                   n,
+                  ComplexType *                 in,
+                  PixelType *                   out,
+                  unsigned int                  flags,
+                  int                           threads = 1,
+                  bool                          canDestroyInput = false,
+                  const std::function<void()> & fillInput = {})
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto plan = FFTWGlobalConfiguration::GetCachedPlan(
+      MakePlanKey(FFTWGlobalConfiguration::PlanKind::ComplexToReal, rank, n, in, out, flags, threads),
+      [&]() { return MakePlanPointer(Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput)); });
+    if (fillInput)
+    {
+      fillInput();
+    }
+    fftwf_execute_dft_c2r(static_cast<PlanType>(plan.get()), in, out);
+#  else
+    PlanType plan = Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    if (fillInput)
+    {
+      fillInput();
+    }
+    Execute(plan);
+    DestroyPlan(plan);
+#  endif
+  }
+
+  static void
+  Execute_dft_r2c(int           rank,
+                  const int *   n,
+                  PixelType *   in,
+                  ComplexType * out,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto plan = FFTWGlobalConfiguration::GetCachedPlan(
+      MakePlanKey(FFTWGlobalConfiguration::PlanKind::RealToComplex, rank, n, in, out, flags, threads),
+      [&]() { return MakePlanPointer(Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput)); });
+    fftwf_execute_dft_r2c(static_cast<PlanType>(plan.get()), in, out);
+#  else
+    PlanType plan = Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+#  endif
+  }
+
+  static void
+  Execute_dft(int           rank,
+              const int *   n,
+              ComplexType * in,
+              ComplexType * out,
+              int           sign,
+              unsigned int  flags,
+              int           threads = 1,
+              bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto kind = sign == FFTW_FORWARD ? FFTWGlobalConfiguration::PlanKind::ComplexToComplexForward
+                                           : FFTWGlobalConfiguration::PlanKind::ComplexToComplexBackward;
+    const auto plan = FFTWGlobalConfiguration::GetCachedPlan(
+      MakePlanKey(kind, rank, n, in, out, flags, threads),
+      [&]() { return MakePlanPointer(Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput)); });
+    fftwf_execute_dft(static_cast<PlanType>(plan.get()), in, out);
+#  else
+    PlanType plan = Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+#  endif
+  }
+
+#  ifndef ITK_USE_CUFFTW
+private:
+  template <typename TInput, typename TOutput>
+  static FFTWGlobalConfiguration::PlanKey
+  MakePlanKey(FFTWGlobalConfiguration::PlanKind kind,
+              int                               rank,
+              const int *                       n,
+              TInput *                          in,
+              TOutput *                         out,
+              unsigned int                      flags,
+              int                               threads)
+  {
+    FFTWGlobalConfiguration::PlanKey key;
+    key.m_SinglePrecision = true;
+    key.m_Kind = kind;
+    key.m_Sizes.assign(n, n + rank);
+    key.m_Flags = flags;
+    key.m_Threads = threads;
+    key.m_InputAlignment = fftwf_alignment_of(reinterpret_cast<PixelType *>(in));
+    key.m_OutputAlignment = fftwf_alignment_of(reinterpret_cast<PixelType *>(out));
+    key.m_InPlace = static_cast<void *>(in) == static_cast<void *>(out);
+    return key;
+  }
+
+  static FFTWGlobalConfiguration::PlanPointer
+  MakePlanPointer(PlanType plan)
+  {
+    // The mutex is captured so that the plans released while the global
+    // configuration is destroyed do not access it again.
+    FFTWGlobalConfiguration::MutexType * mutex = &FFTWGlobalConfiguration::GetLockMutex();
+    return FFTWGlobalConfiguration::PlanPointer(plan, [mutex](void * p) {
+      const std::lock_guard<FFTWGlobalConfiguration::MutexType> lockGuard(*mutex);
+      fftwf_destroy_plan(static_cast<PlanType>(p));
+    });
+  }
+#  endif
 };
 
 #endif // ITK_USE_FFTWF
@@ -715,6 +834,124 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+  /** Execute a transform with a plan of the FFTWGlobalConfiguration plan
+   * cache, which is created only if no plan has been cached for the same
+   * sizes, flags, number of threads and array alignments. When given,
+   * fillInput is called once the plan is available and before it is
+   * executed, so that a buffer which the planner may destroy can be filled
+   * after the planning. */
+  static void
+  Execute_dft_c2r(int                           rank,
+                  const int *                   n,
+                  ComplexType *                 in,
+                  PixelType *                   out,
+                  unsigned int                  flags,
+                  int                           threads = 1,
+                  bool                          canDestroyInput = false,
+                  const std::function<void()> & fillInput = {})
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto plan = FFTWGlobalConfiguration::GetCachedPlan(
+      MakePlanKey(FFTWGlobalConfiguration::PlanKind::ComplexToReal, rank, n, in, out, flags, threads),
+      [&]() { return MakePlanPointer(Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput)); });
+    if (fillInput)
+    {
+      fillInput();
+    }
+    fftw_execute_dft_c2r(static_cast<PlanType>(plan.get()), in, out);
+#  else
+    PlanType plan = Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    if (fillInput)
+    {
+      fillInput();
+    }
+    Execute(plan);
+    DestroyPlan(plan);
+#  endif
+  }
+
+  static void
+  Execute_dft_r2c(int           rank,
+                  const int *   n,
+                  PixelType *   in,
+                  ComplexType * out,
+                  unsigned int  flags,
+                  int           threads = 1,
+                  bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto plan = FFTWGlobalConfiguration::GetCachedPlan(
+      MakePlanKey(FFTWGlobalConfiguration::PlanKind::RealToComplex, rank, n, in, out, flags, threads),
+      [&]() { return MakePlanPointer(Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput)); });
+    fftw_execute_dft_r2c(static_cast<PlanType>(plan.get()), in, out);
+#  else
+    PlanType plan = Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+#  endif
+  }
+
+  static void
+  Execute_dft(int           rank,
+              const int *   n,
+              ComplexType * in,
+              ComplexType * out,
+              int           sign,
+              unsigned int  flags,
+              int           threads = 1,
+              bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto kind = sign == FFTW_FORWARD ? FFTWGlobalConfiguration::PlanKind::ComplexToComplexForward
+                                           : FFTWGlobalConfiguration::PlanKind::ComplexToComplexBackward;
+    const auto plan = FFTWGlobalConfiguration::GetCachedPlan(
+      MakePlanKey(kind, rank, n, in, out, flags, threads),
+      [&]() { return MakePlanPointer(Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput)); });
+    fftw_execute_dft(static_cast<PlanType>(plan.get()), in, out);
+#  else
+    PlanType plan = Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    Execute(plan);
+    DestroyPlan(plan);
+#  endif
+  }
+
+#  ifndef ITK_USE_CUFFTW
+private:
+  template <typename TInput, typename TOutput>
+  static FFTWGlobalConfiguration::PlanKey
+  MakePlanKey(FFTWGlobalConfiguration::PlanKind kind,
+              int                               rank,
+              const int *                       n,
+              TInput *                          in,
+              TOutput *                         out,
+              unsigned int                      flags,
+              int                               threads)
+  {
+    FFTWGlobalConfiguration::PlanKey key;
+    key.m_SinglePrecision = false;
+    key.m_Kind = kind;
+    key.m_Sizes.assign(n, n + rank);
+    key.m_Flags = flags;
+    key.m_Threads = threads;
+    key.m_InputAlignment = fftw_alignment_of(reinterpret_cast<PixelType *>(in));
+    key.m_OutputAlignment = fftw_alignment_of(reinterpret_cast<PixelType *>(out));
+    key.m_InPlace = static_cast<void *>(in) == static_cast<void *>(out);
+    return key;
+  }
+
+  static FFTWGlobalConfiguration::PlanPointer
+  MakePlanPointer(PlanType plan)
+  {
+    // The mutex is captured so that the plans released while the global
+    // configuration is destroyed do not access it again.
+    FFTWGlobalConfiguration::MutexType * mutex = &FFTWGlobalConfiguration::GetLockMutex();
+    return FFTWGlobalConfiguration::PlanPointer(plan, [mutex](void * p) {
+      const std::lock_guard<FFTWGlobalConfiguration::MutexType> lockGuard(*mutex);
+      fftw_destroy_plan(static_cast<PlanType>(p));
+    });
+  }
+#  endif
 };
 
 #endif
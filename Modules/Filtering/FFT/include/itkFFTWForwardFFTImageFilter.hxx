@@ -23,7 +23,7 @@
 #include "itkMetaDataObject.h"
 #include "itkProgressReporter.h"
 #include "itkMultiThreaderBase.h"
-
+#include <algorithm>
 #include <iostream>
 
 namespace itk
@@ -91,9 +91,8 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   fftwOutput->SetRegions(fftwOutputRegion);
   fftwOutput->Allocate();
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  int                              flags = m_PlanRigor;
+  auto * in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
+  int    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -107,14 +106,15 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,
-                                     sizes,
-                                     in,
-                                     (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
-                                     flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  // FFTW uses at most one thread per work unit.
+  const auto numberOfThreads =
+    static_cast<int>(std::min(this->GetNumberOfWorkUnits(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  FFTWProxyType::Execute_dft_r2c(ImageDimension,
+                                 sizes,
+                                 in,
+                                 (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
+                                 flags,
+                                 numberOfThreads);
 
   // Expand the half image to the full image size
   using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
@@ -35,6 +35,12 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <functional>
+#  include <list>
+#  include <map>
+#  include <memory>
+#  include <tuple>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -56,6 +62,9 @@ struct FFTWGlobalConfigurationGlobals;
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+// ITK_FFTW_PLAN_CACHE_SIZE - Defines the number of plans kept in
+//                            the plan cache (32 by default, 0
+//                            disables the cache).
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -219,6 +228,80 @@ public:
   static std::mutex &
   GetLockMutex();
 
+  /** Kind of transform of a cached plan. */
+  enum class PlanKind : uint8_t
+  {
+    RealToComplex,
+    ComplexToReal,
+    ComplexToComplexForward,
+    ComplexToComplexBackward
+  };
+
+  /** Key of a plan in the plan cache. A plan may be executed on other
+   * arrays than the ones it was created with, as long as they have the
+   * same alignment, and are in place if and only if the original ones
+   * were. */
+  struct PlanKey
+  {
+    bool             m_SinglePrecision;
+    PlanKind         m_Kind;
+    std::vector<int> m_Sizes;
+    unsigned int     m_Flags;
+    int              m_Threads;
+    int              m_InputAlignment;
+    int              m_OutputAlignment;
+    bool             m_InPlace;
+
+    bool
+    operator<(const PlanKey & other) const
+    {
+      return std::tie(m_SinglePrecision,
+                      m_Kind,
+                      m_Sizes,
+                      m_Flags,
+                      m_Threads,
+                      m_InputAlignment,
+                      m_OutputAlignment,
+                      m_InPlace) < std::tie(other.m_SinglePrecision,
+                                            other.m_Kind,
+                                            other.m_Sizes,
+                                            other.m_Flags,
+                                            other.m_Threads,
+                                            other.m_InputAlignment,
+                                            other.m_OutputAlignment,
+                                            other.m_InPlace);
+    }
+  };
+
+  /** A plan of either precision, destroyed when the last filter using it
+   * releases it after it has left the plan cache. */
+  using PlanPointer = std::shared_ptr<void>;
+
+  /** Get the plan cached for a key, or create it with createPlan() and
+   * cache it. The least recently used plans are released when the cache
+   * holds more than PlanCacheSize plans. */
+  static PlanPointer
+  GetCachedPlan(const PlanKey & key, const std::function<PlanPointer()> & createPlan);
+
+  /**
+   * \brief Set/Get the number of plans kept in the plan cache.
+   *
+   * The FFTW filters reuse the cached plans of the transforms they have
+   * already computed, which avoids planning again when the same sizes are
+   * transformed repeatedly, as in iterative deconvolution. A size of 0
+   * disables the cache. If the environmental variable
+   * "ITK_FFTW_PLAN_CACHE_SIZE" is set, then the environmental setting
+   * overrides the default of 32 plans.
+   */
+  static void
+  SetPlanCacheSize(const SizeValueType v);
+  static SizeValueType
+  GetPlanCacheSize();
+
+  /** Release all the plans of the plan cache. */
+  static void
+  ClearPlanCache();
+
   /** Set/Get whether a new wisdom is available compared to the
    * initial state. If a new wisdom is available, the wisdoms
    * may be written to the cache file
@@ -368,6 +451,7 @@ private:
   static FFTWGlobalConfigurationGlobals * m_PimplGlobals;
 
   std::mutex  m_Mutex;
+  std::mutex  m_PlanCacheMutex;
   bool        m_NewWisdomAvailable{ false };
   int         m_PlanRigor{ 0 };
   bool        m_WriteWisdomCache{ false };
@@ -376,6 +460,12 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  // The plans of the cache, from the most to the least recently used.
+  using PlanCacheListType = std::list<std::pair<PlanKey, PlanPointer>>;
+  PlanCacheListType                              m_PlanCache;
+  std::map<PlanKey, PlanCacheListType::iterator> m_PlanCacheIndex;
+  SizeValueType                                  m_PlanCacheSize{ 32 };
 };
 } // namespace itk
 #endif
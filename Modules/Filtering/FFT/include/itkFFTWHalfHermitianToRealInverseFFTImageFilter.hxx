@@ -21,6 +21,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkMultiThreaderBase.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -90,33 +91,29 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     }
   }
   ();
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
-  if (!m_CanUseDestructiveAlgorithm)
-  {
-    // complex<double> and double[2] types are compatible memory layouts.
-    // The reinterpret_cast is used here to
-    // make the "C" fftw library compatible with the c++ complex<double>.
-    std::copy_n(
-      inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
-  }
-  FFTWProxyType::Execute(plan);
+  // FFTW uses at most one thread per work unit, like the forward transform.
+  const auto numberOfThreads =
+    static_cast<int>(std::min(this->GetNumberOfWorkUnits(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  FFTWProxyType::Execute_dft_c2r(
+    ImageDimension, sizes, in, out, m_PlanRigor, numberOfThreads, !m_CanUseDestructiveAlgorithm, [&]() {
+      if (!m_CanUseDestructiveAlgorithm)
+      {
+        // complex<double> and double[2] types are compatible memory layouts.
+        // The reinterpret_cast is used here to
+        // make the "C" fftw library compatible with the c++ complex<double>.
+        std::copy_n(
+          inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
+      }
+    });
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
   if (!m_CanUseDestructiveAlgorithm)
   {
     delete[] in;
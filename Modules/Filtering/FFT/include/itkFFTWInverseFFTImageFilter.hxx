@@ -23,6 +23,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkMultiThreaderBase.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -82,8 +83,7 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
 
   auto * in = (typename FFTWProxyType::ComplexType *)fullToHalfFilter->GetOutput()->GetBufferPointer();
 
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -91,12 +91,10 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_c2r(
-    ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), false);
-  FFTWProxyType::Execute(plan);
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  // FFTW uses at most one thread per work unit.
+  const auto numberOfThreads =
+    static_cast<int>(std::min(this->GetNumberOfWorkUnits(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  FFTWProxyType::Execute_dft_c2r(ImageDimension, sizes, in, out, m_PlanRigor, numberOfThreads, false);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -20,6 +20,7 @@
 
 #include "itkProgressReporter.h"
 #include "itkMultiThreaderBase.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -73,10 +74,9 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     totalOutputSize *= outputSize[i];
   }
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  auto *                           out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
-  int                              flags = m_PlanRigor;
+  auto * in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
+  auto * out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
+  int    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -90,10 +90,12 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(
-    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  // The plan uses no more threads than the work units of the filter, so that
+  // a filter restricted to a single work unit, as for the tiles of a tiled
+  // convolution, does not start threads of its own.
+  const auto numberOfThreads =
+    static_cast<int>(std::min(this->GetNumberOfWorkUnits(), MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  FFTWProxyType::Execute_dft_r2c(ImageDimension, sizes, in, out, flags, numberOfThreads);
 }
 
 template <typename TInputImage, typename TOutputImage>
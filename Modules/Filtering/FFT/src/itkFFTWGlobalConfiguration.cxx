@@ -404,6 +404,21 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    std::string planCacheSizeString;
+    if (itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE_SIZE", planCacheSizeString))
+    {
+      try
+      {
+        this->m_PlanCacheSize = static_cast<SizeValueType>(std::stoul(planCacheSizeString));
+      }
+      catch (...)
+      {
+        itkWarningMacro("Warning: Invalid FFTW PLAN CACHE SIZE: " << planCacheSizeString);
+      }
+    }
+  }
+
 #  if defined(ITK_USE_FFTWF)
   // TODO:  Investigate if this is really a warnable situation.
   //       fftw should work just fine without threads
@@ -485,6 +500,10 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The cached plans must be destroyed before FFTW is cleaned up.
+  this->m_PlanCacheIndex.clear();
+  this->m_PlanCache.clear();
+
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -737,6 +756,91 @@ FFTWGlobalConfiguration::GetLockMutex()
   return GetInstance()->m_Mutex;
 }
 
+FFTWGlobalConfiguration::PlanPointer
+FFTWGlobalConfiguration::GetCachedPlan(const PlanKey & key, const std::function<PlanPointer()> & createPlan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer instance = GetInstance();
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    const auto                        found = instance->m_PlanCacheIndex.find(key);
+    if (found != instance->m_PlanCacheIndex.end())
+    {
+      instance->m_PlanCache.splice(instance->m_PlanCache.begin(), instance->m_PlanCache, found->second);
+      return found->second->second;
+    }
+  }
+
+  // The plan is created without holding the cache lock, because planning
+  // may take long with the most rigorous planner flags.
+  PlanPointer plan = createPlan();
+
+  // The plans released by the cache are destroyed after the cache lock.
+  PlanCacheListType releasedPlans;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    if (instance->m_PlanCacheSize == 0)
+    {
+      return plan;
+    }
+    const auto found = instance->m_PlanCacheIndex.find(key);
+    if (found != instance->m_PlanCacheIndex.end())
+    {
+      // Another thread has cached the same plan in the meantime.
+      releasedPlans.emplace_front(key, plan);
+      instance->m_PlanCache.splice(instance->m_PlanCache.begin(), instance->m_PlanCache, found->second);
+      return found->second->second;
+    }
+    instance->m_PlanCache.emplace_front(key, plan);
+    instance->m_PlanCacheIndex[key] = instance->m_PlanCache.begin();
+    while (instance->m_PlanCache.size() > instance->m_PlanCacheSize)
+    {
+      instance->m_PlanCacheIndex.erase(instance->m_PlanCache.back().first);
+      releasedPlans.splice(releasedPlans.begin(), instance->m_PlanCache, std::prev(instance->m_PlanCache.end()));
+    }
+  }
+  return plan;
+}
+
+void
+FFTWGlobalConfiguration::SetPlanCacheSize(const SizeValueType v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer     instance = GetInstance();
+  PlanCacheListType releasedPlans;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    instance->m_PlanCacheSize = v;
+    while (instance->m_PlanCache.size() > instance->m_PlanCacheSize)
+    {
+      instance->m_PlanCacheIndex.erase(instance->m_PlanCache.back().first);
+      releasedPlans.splice(releasedPlans.begin(), instance->m_PlanCache, std::prev(instance->m_PlanCache.end()));
+    }
+  }
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCacheSize;
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer     instance = GetInstance();
+  PlanCacheListType releasedPlans;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    instance->m_PlanCacheIndex.clear();
+    releasedPlans.swap(instance->m_PlanCache);
+  }
+}
+
 void
 FFTWGlobalConfiguration::SetNewWisdomAvailable(const bool v)
 {
@@ -0,0 +1,217 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTWGlobalConfiguration.h"
+#include "itkFFTWForwardFFTImageFilter.h"
+#include "itkFFTWHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ConfigurationType = itk::FFTWGlobalConfiguration;
+
+ConfigurationType::PlanKey
+MakeKey(int size, unsigned int flags)
+{
+  ConfigurationType::PlanKey key;
+  key.m_SinglePrecision = false;
+  key.m_Kind = ConfigurationType::PlanKind::RealToComplex;
+  key.m_Sizes = { size, size };
+  key.m_Flags = flags;
+  key.m_Threads = 1;
+  key.m_InputAlignment = 0;
+  key.m_OutputAlignment = 0;
+  key.m_InPlace = false;
+  return key;
+}
+
+// Get the plan cached for a key, counting the plans created.
+ConfigurationType::PlanPointer
+GetPlan(const ConfigurationType::PlanKey & key, unsigned int & numberOfCreatedPlans)
+{
+  return ConfigurationType::GetCachedPlan(key, [&numberOfCreatedPlans]() {
+    ++numberOfCreatedPlans;
+    return ConfigurationType::PlanPointer(std::make_shared<int>(0));
+  });
+}
+
+// Transform images of several sizes and contents with the plan cache, and
+// check the results against those computed without it.
+template <typename TPixel>
+int
+TestFilters()
+{
+  using ImageType = itk::Image<TPixel, 2>;
+  using ForwardType = itk::FFTWRealToHalfHermitianForwardFFTImageFilter<ImageType>;
+  using InverseType = itk::FFTWHalfHermitianToRealInverseFFTImageFilter<typename ForwardType::OutputImageType>;
+  using FullForwardType = itk::FFTWForwardFFTImageFilter<ImageType>;
+
+  const auto createImage = [](const typename ImageType::SizeType & size, double phase) {
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<TPixel>(std::sin(0.3 * it.GetIndex()[0] + phase) + std::cos(0.7 * it.GetIndex()[1] * phase)));
+    }
+    return image;
+  };
+
+  // Forward and inverse transforms, the inverse transform using either a
+  // copy of its input or its input buffer.
+  const auto transform = [](ImageType * image, int rigor, bool releaseData) {
+    auto forward = ForwardType::New();
+    forward->SetInput(image);
+    forward->SetPlanRigor(rigor);
+    forward->SetReleaseDataFlag(releaseData);
+    auto fullForward = FullForwardType::New();
+    fullForward->SetInput(image);
+    fullForward->SetPlanRigor(rigor);
+    auto inverse = InverseType::New();
+    inverse->SetInput(forward->GetOutput());
+    inverse->SetActualXDimensionIsOdd(image->GetLargestPossibleRegion().GetSize(0) % 2 == 1);
+    inverse->SetPlanRigor(rigor);
+    inverse->Update();
+    fullForward->Update();
+    return std::make_pair(typename ImageType::Pointer(inverse->GetOutput()),
+                          typename FullForwardType::OutputImageType::Pointer(fullForward->GetOutput()));
+  };
+
+  const double tolerance = std::is_same_v<TPixel, float> ? 1e-4 : 1e-10;
+  bool         testPassed = true;
+  const typename ImageType::SizeType sizes[] = { { { 16, 12 } }, { { 16, 12 } }, { { 15, 12 } }, { { 16, 12 } } };
+  const int rigors[] = { FFTW_ESTIMATE, FFTW_ESTIMATE, FFTW_ESTIMATE, FFTW_MEASURE };
+  for (unsigned int n = 0; n < 4; ++n)
+  {
+    for (const bool releaseData : { false, true })
+    {
+      const typename ImageType::Pointer image = createImage(sizes[n], 0.5 + n);
+
+      ConfigurationType::SetPlanCacheSize(0);
+      const auto expected = transform(image, rigors[n], releaseData);
+      ConfigurationType::SetPlanCacheSize(32);
+      const auto cached = transform(image, rigors[n], releaseData);
+
+      itk::ImageRegionConstIterator<ImageType> imageIt(image, image->GetBufferedRegion());
+      itk::ImageRegionConstIterator<ImageType> expectedIt(expected.first, image->GetBufferedRegion());
+      itk::ImageRegionConstIterator<ImageType> cachedIt(cached.first, image->GetBufferedRegion());
+      for (; !imageIt.IsAtEnd(); ++imageIt, ++expectedIt, ++cachedIt)
+      {
+        if (std::abs(cachedIt.Get() - imageIt.Get()) > tolerance ||
+            std::abs(cachedIt.Get() - expectedIt.Get()) > tolerance)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Transform " << n << ": the inverse transform of the forward transform is "
+                    << cachedIt.Get() << " with the plan cache and " << expectedIt.Get()
+                    << " without it, instead of " << imageIt.Get() << std::endl;
+          testPassed = false;
+          break;
+        }
+      }
+      using ComplexImageType = typename FullForwardType::OutputImageType;
+      itk::ImageRegionConstIterator<ComplexImageType> expectedFullIt(expected.second, image->GetBufferedRegion());
+      itk::ImageRegionConstIterator<ComplexImageType> cachedFullIt(cached.second, image->GetBufferedRegion());
+      for (; !expectedFullIt.IsAtEnd(); ++expectedFullIt, ++cachedFullIt)
+      {
+        if (std::abs(cachedFullIt.Get() - expectedFullIt.Get()) > tolerance * sizes[n][0] * sizes[n][1])
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Transform " << n << ": the forward transform is " << cachedFullIt.Get()
+                    << " with the plan cache and " << expectedFullIt.Get() << " without it" << std::endl;
+          testPassed = false;
+          break;
+        }
+      }
+    }
+  }
+  ConfigurationType::ClearPlanCache();
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace
+
+int
+itkFFTWPlanCacheTest(int, char *[])
+{
+  ConfigurationType::ClearPlanCache();
+  ConfigurationType::SetPlanCacheSize(2);
+  ITK_TEST_EXPECT_EQUAL(ConfigurationType::GetPlanCacheSize(), 2u);
+
+  unsigned int numberOfCreatedPlans = 0;
+
+  // A miss creates the plan, a hit returns the cached plan.
+  const ConfigurationType::PlanPointer plan = GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 1u);
+  ITK_TEST_EXPECT_TRUE(GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans) == plan);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 1u);
+
+  // Another size or another plan rigor needs another plan.
+  const ConfigurationType::PlanPointer otherSizePlan = GetPlan(MakeKey(17, FFTW_ESTIMATE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 2u);
+  ITK_TEST_EXPECT_TRUE(otherSizePlan != plan);
+  ITK_TEST_EXPECT_TRUE(GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans) == plan);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 2u);
+
+  // The plan of the other rigor evicts the least recently used plan, of the
+  // other size.
+  const ConfigurationType::PlanPointer otherRigorPlan = GetPlan(MakeKey(16, FFTW_MEASURE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 3u);
+  ITK_TEST_EXPECT_TRUE(otherRigorPlan != plan);
+  ITK_TEST_EXPECT_TRUE(GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans) == plan);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 3u);
+  ITK_TEST_EXPECT_TRUE(GetPlan(MakeKey(17, FFTW_ESTIMATE), numberOfCreatedPlans) != otherSizePlan);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 4u);
+
+  // Reducing the size of the cache keeps the most recently used plans.
+  ConfigurationType::SetPlanCacheSize(1);
+  GetPlan(MakeKey(17, FFTW_ESTIMATE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 4u);
+  GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 5u);
+
+  // Clearing the cache releases all the plans.
+  ConfigurationType::ClearPlanCache();
+  GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 6u);
+
+  // A cache of size 0 keeps no plan.
+  ConfigurationType::SetPlanCacheSize(0);
+  GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans);
+  GetPlan(MakeKey(16, FFTW_ESTIMATE), numberOfCreatedPlans);
+  ITK_TEST_EXPECT_EQUAL(numberOfCreatedPlans, 8u);
+
+  // The filters give the same results with and without the plan cache, when
+  // the cached plans are executed on other arrays, and when the size or the
+  // rigor of the transforms changes.
+  bool testPassed = true;
+#if defined(ITK_USE_FFTWF)
+  testPassed &= TestFilters<float>() == EXIT_SUCCESS;
+#endif
+#if defined(ITK_USE_FFTWD)
+  testPassed &= TestFilters<double>() == EXIT_SUCCESS;
+#endif
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
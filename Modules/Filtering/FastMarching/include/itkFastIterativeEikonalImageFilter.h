@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeEikonalImageFilter_h
+#define itkFastIterativeEikonalImageFilter_h
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+
+namespace itk
+{
+/**
+ * \class FastIterativeEikonalImageFilter
+ * \brief Solve an Eikonal equation on an image with the parallel Fast
+ * Iterative Method.
+ *
+ * This filter computes the same arrival time as FastMarchingImageFilterBase,
+ * i.e. the solution of the upwind discretization of the Eikonal equation,
+ * but without processing the nodes one at a time in increasing order of
+ * their value. Instead, it maintains an active list of the nodes next to
+ * the front and updates all of them at once, with all the available work
+ * units, until their value converges, as described in
+ *
+ * W.-K. Jeong, R.T. Whitaker. "A Fast Iterative Method for Eikonal
+ * Equations", SIAM Journal on Scientific Computing, 30(5):2512-2534, 2008.
+ *
+ * Each iteration solves the active nodes from the values of the previous
+ * iteration, so that the output does not depend on the number of work units.
+ *
+ * The speed image or constant, the trial, alive and forbidden points and
+ * the output information are specified as for FastMarchingImageFilterBase.
+ * Since the nodes are not processed in order, the only supported stopping
+ * criterion is FastMarchingThresholdStoppingCriterion: the front does not
+ * propagate from nodes whose value reaches the threshold. Topology checks are
+ * not supported either. The collected points, if any, are not ordered.
+ *
+ * \sa FastMarchingImageFilterBase
+ * \sa FastMarchingThresholdStoppingCriterion
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TInput, typename TOutput>
+class ITK_TEMPLATE_EXPORT FastIterativeEikonalImageFilter : public FastMarchingImageFilterBase<TInput, TOutput>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FastIterativeEikonalImageFilter);
+
+  using Self = FastIterativeEikonalImageFilter;
+  using Superclass = FastMarchingImageFilterBase<TInput, TOutput>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using typename Superclass::Traits;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(FastIterativeEikonalImageFilter);
+
+  using typename Superclass::OutputImageType;
+  using typename Superclass::OutputPixelType;
+  using typename Superclass::NodeType;
+  using typename Superclass::NodePairType;
+  using typename Superclass::InternalNodeStructure;
+  using typename Superclass::InternalNodeStructureArray;
+
+  using ThresholdStoppingCriterionType = FastMarchingThresholdStoppingCriterion<TInput, TOutput>;
+
+  static constexpr unsigned int ImageDimension = Superclass::ImageDimension;
+
+  /** Set/Get the convergence tolerance. An active node is removed from the
+   * active list once its value changes by less than this tolerance between
+   * two iterations. */
+  itkSetMacro(ConvergenceTolerance, double);
+  itkGetConstMacro(ConvergenceTolerance, double);
+
+  /** Get the number of iterations of the last update. */
+  itkGetConstMacro(NumberOfIterations, SizeValueType);
+
+protected:
+  FastIterativeEikonalImageFilter() = default;
+  ~FastIterativeEikonalImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+  /** Compute the value of a node from the current values of its neighbors.
+   * It only reads the output image, so that it can be called concurrently. */
+  OutputPixelType
+  SolveNode(OutputImageType * oImage, const NodeType & iNode) const;
+
+private:
+  double        m_ConvergenceTolerance{ 1e-6 };
+  SizeValueType m_NumberOfIterations{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFastIterativeEikonalImageFilter.hxx"
+#endif
+
+#endif // itkFastIterativeEikonalImageFilter_h
@@ -0,0 +1,282 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeEikonalImageFilter_hxx
+#define itkFastIterativeEikonalImageFilter_hxx
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMultiThreaderBase.h"
+
+namespace itk
+{
+
+template <typename TInput, typename TOutput>
+void
+FastIterativeEikonalImageFilter<TInput, TOutput>::GenerateData()
+{
+  if (this->m_TopologyCheck != Superclass::TopologyCheckEnum::Nothing)
+  {
+    itkExceptionMacro("Topology checks are not supported by the fast iterative method");
+  }
+
+  auto * thresholdCriterion = dynamic_cast<ThresholdStoppingCriterionType *>(this->m_StoppingCriterion.GetPointer());
+  if (this->m_StoppingCriterion.IsNotNull() && thresholdCriterion == nullptr)
+  {
+    itkExceptionMacro("The fast iterative method only supports FastMarchingThresholdStoppingCriterion, got "
+                      << this->m_StoppingCriterion->GetNameOfClass());
+  }
+
+  OutputImageType * output = this->GetOutput();
+
+  this->Initialize(output);
+
+  // The trial points are processed through the active list instead of the
+  // priority queue.
+  this->m_Heap.Clear();
+
+  const OutputPixelType threshold = thresholdCriterion->GetThreshold();
+  const OutputPixelType largeValue = this->m_LargeValue;
+
+  const auto forEachNeighbor = [this](const NodeType & node, const auto & function) {
+    NodeType neighbor = node;
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      for (int s = -1; s < 2; s += 2)
+      {
+        neighbor[j] = node[j] + s;
+        if (neighbor[j] >= this->m_StartIndex[j] && neighbor[j] <= this->m_LastIndex[j])
+        {
+          function(neighbor);
+        }
+      }
+      neighbor[j] = node[j];
+    }
+  };
+
+  // The front starts from the neighbors of the trial points.
+  std::vector<NodeType> activeNodes;
+  for (const NodePairType & trialPoint : *this->m_TrialPoints)
+  {
+    const NodeType & node = trialPoint.GetNode();
+    if (this->m_BufferedRegion.IsInside(node) &&
+        this->GetLabelValueForGivenNode(node) == Traits::InitialTrial && trialPoint.GetValue() < threshold)
+    {
+      forEachNeighbor(node, [this, &activeNodes](const NodeType & neighbor) {
+        if (this->GetLabelValueForGivenNode(neighbor) == Traits::Far)
+        {
+          this->SetLabelValueForGivenNode(neighbor, Traits::Trial);
+          activeNodes.push_back(neighbor);
+        }
+      });
+    }
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  constexpr unsigned int NumberOfNeighbors = 2 * ImageDimension;
+
+  std::vector<OutputPixelType> values;
+  std::vector<unsigned char>   converged;
+  std::vector<NodePairType>    candidates;
+  std::vector<NodeType>        nextActiveNodes;
+
+  m_NumberOfIterations = 0;
+
+  while (!activeNodes.empty())
+  {
+    const SizeValueType numberOfActiveNodes = activeNodes.size();
+
+    // Solve all the active nodes from the values of the previous iteration.
+    values.resize(numberOfActiveNodes);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfActiveNodes,
+      [this, output, &activeNodes, &values](SizeValueType i) { values[i] = this->SolveNode(output, activeNodes[i]); },
+      nullptr);
+
+    // Each work unit writes to its own nodes only.
+    converged.resize(numberOfActiveNodes);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfActiveNodes,
+      [this, output, &activeNodes, &values, &converged](SizeValueType i) {
+        const OutputPixelType previousValue = output->GetPixel(activeNodes[i]);
+        if (values[i] < previousValue)
+        {
+          output->SetPixel(activeNodes[i], values[i]);
+        }
+        converged[i] =
+          static_cast<double>(previousValue) - static_cast<double>(values[i]) <= this->m_ConvergenceTolerance;
+      },
+      nullptr);
+
+    // The neighbors of the converged nodes whose value would decrease are
+    // added to the active list.
+    candidates.assign(numberOfActiveNodes * NumberOfNeighbors, NodePairType(NodeType(), largeValue));
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfActiveNodes,
+      [this, output, threshold, &forEachNeighbor, &activeNodes, &converged, &candidates](SizeValueType i) {
+        if (!converged[i] || !(output->GetPixel(activeNodes[i]) < threshold))
+        {
+          return;
+        }
+        SizeValueType candidate = i * NumberOfNeighbors;
+        forEachNeighbor(activeNodes[i], [this, output, &candidates, &candidate](const NodeType & neighbor) {
+          if (this->GetLabelValueForGivenNode(neighbor) == Traits::Far)
+          {
+            const OutputPixelType value = this->SolveNode(output, neighbor);
+            if (value < output->GetPixel(neighbor))
+            {
+              candidates[candidate] = NodePairType(neighbor, value);
+            }
+          }
+          ++candidate;
+        });
+      },
+      nullptr);
+
+    nextActiveNodes.clear();
+    for (SizeValueType i = 0; i < numberOfActiveNodes; ++i)
+    {
+      if (converged[i])
+      {
+        this->SetLabelValueForGivenNode(activeNodes[i], Traits::Far);
+      }
+      else
+      {
+        nextActiveNodes.push_back(activeNodes[i]);
+      }
+    }
+    for (const NodePairType & candidate : candidates)
+    {
+      const NodeType & node = candidate.GetNode();
+      if (candidate.GetValue() < largeValue && this->GetLabelValueForGivenNode(node) == Traits::Far)
+      {
+        output->SetPixel(node, candidate.GetValue());
+        this->SetLabelValueForGivenNode(node, Traits::Trial);
+        nextActiveNodes.push_back(node);
+      }
+    }
+    activeNodes.swap(nextActiveNodes);
+
+    ++m_NumberOfIterations;
+
+    if (this->GetAbortGenerateData())
+    {
+      this->InvokeEvent(AbortEvent());
+      this->ResetPipeline();
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Process aborted.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+    }
+  }
+
+  // Label the nodes reached by the front as the fast marching method does.
+  OutputPixelType targetReachedValue{};
+
+  ImageRegionIteratorWithIndex<typename Superclass::LabelImageType> labelIt(this->m_LabelImage,
+                                                                           this->m_BufferedRegion);
+  ImageRegionConstIterator<OutputImageType>                         outputIt(output, this->m_BufferedRegion);
+  for (; !labelIt.IsAtEnd(); ++labelIt, ++outputIt)
+  {
+    const unsigned char label = labelIt.Get();
+    if (label == Traits::Far || label == Traits::InitialTrial)
+    {
+      const OutputPixelType value = outputIt.Get();
+      if (value < threshold)
+      {
+        labelIt.Set(Traits::Alive);
+        targetReachedValue = std::max(targetReachedValue, value);
+        if (this->m_CollectPoints)
+        {
+          this->m_ProcessedPoints->push_back(NodePairType(labelIt.GetIndex(), value));
+        }
+      }
+      else if (value < largeValue)
+      {
+        labelIt.Set(Traits::Trial);
+      }
+    }
+  }
+
+  this->m_TargetReachedValue = targetReachedValue;
+}
+
+template <typename TInput, typename TOutput>
+auto
+FastIterativeEikonalImageFilter<TInput, TOutput>::SolveNode(OutputImageType * oImage, const NodeType & iNode) const
+  -> OutputPixelType
+{
+  const OutputPixelType largeValue = this->m_LargeValue;
+
+  InternalNodeStructureArray neighbors;
+  bool                       hasKnownNeighbor = false;
+
+  for (unsigned int j = 0; j < ImageDimension; ++j)
+  {
+    InternalNodeStructure & neighbor = neighbors[j];
+    neighbor.m_Node = iNode;
+    neighbor.m_Value = largeValue;
+    neighbor.m_Axis = j;
+
+    // Find smallest valued neighbor in this dimension
+    NodeType neighborNode = iNode;
+    for (int s = -1; s < 2; s += 2)
+    {
+      neighborNode[j] = iNode[j] + s;
+      if (neighborNode[j] >= this->m_StartIndex[j] && neighborNode[j] <= this->m_LastIndex[j])
+      {
+        const unsigned char label = this->GetLabelValueForGivenNode(neighborNode);
+        if (label != Traits::Forbidden && label != Traits::Topology)
+        {
+          const OutputPixelType value = oImage->GetPixel(neighborNode);
+          if (value < neighbor.m_Value)
+          {
+            neighbor.m_Value = value;
+            neighbor.m_Node = neighborNode;
+          }
+        }
+      }
+    }
+    hasKnownNeighbor |= neighbor.m_Value < largeValue;
+  }
+
+  if (!hasKnownNeighbor)
+  {
+    return largeValue;
+  }
+
+  const double solution = this->Solve(oImage, iNode, neighbors);
+  return solution < static_cast<double>(largeValue) ? static_cast<OutputPixelType>(solution) : largeValue;
+}
+
+template <typename TInput, typename TOutput>
+void
+FastIterativeEikonalImageFilter<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ConvergenceTolerance: " << m_ConvergenceTolerance << std::endl;
+  os << indent << "NumberOfIterations: " << m_NumberOfIterations << std::endl;
+}
+} // end namespace itk
+#endif // itkFastIterativeEikonalImageFilter_hxx
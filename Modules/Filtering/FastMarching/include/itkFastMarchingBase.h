@@ -22,11 +22,9 @@
 #include "itkIntTypes.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkFastMarchingPriorityQueue.h"
 #include "ITKFastMarchingExport.h"
 
-#include <queue>
-#include <functional>
-
 namespace itk
 {
 /**
@@ -63,8 +61,11 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper node to
- * update.
+ * uses an indexed binary heap, which supports decreasing the value of a node
+ * already in the heap, to locate the next proper node to update. Optionally,
+ * an untidy priority queue with O(1) insertion and removal can be used
+ * instead, at the cost of a bounded error on the processing order
+ * (see FastMarchingPriorityQueue).
  *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
@@ -91,10 +92,6 @@ extern ITKFastMarching_EXPORT std::ostream &
  *    \li Superclass (itk::ImageToImageFilter or
  * itk::QuadEdgeMeshToQuadEdgeMeshFilter )
  *
- * \todo In the current implementation, std::priority_queue only allows
- * taking nodes out from the front and putting nodes in from the back.
- * Use itk::PriorityQueueContainer instead.
- *
  * \par Topology constraints:
  * Additional flexibility in this class includes the implementation of
  * topology constraints for image-based fast marching.  Further details
@@ -163,18 +160,6 @@ public:
   using StoppingCriterionType = FastMarchingStoppingCriterionBase<TInput, TOutput>;
   using StoppingCriterionPointer = typename StoppingCriterionType::Pointer;
 
-  /*
-  using ElementIdentifier = long;
-
-  using PriorityQueueElementType = MinPriorityQueueElementWrapper< NodeType,
-    OutputPixelType,
-    ElementIdentifier >;
-
-  using PriorityQueueType = PriorityQueueContainer< PriorityQueueElementType,
-    PriorityQueueElementType, OutputPixelType, ElementIdentifier >;
-  using PriorityQueuePointer = typename PriorityQueueType::Pointer;
-  */
-
   using TopologyCheckEnum = FastMarchingTraitsEnums::TopologyCheck;
 #if !defined(ITK_LEGACY_REMOVE)
   using TopologyCheckType = FastMarchingTraitsEnums::TopologyCheck;
@@ -230,6 +215,20 @@ public:
   itkGetConstReferenceMacro(CollectPoints, bool);
   itkBooleanMacro(CollectPoints);
 
+  /** Set/Get whether the trial nodes are stored in an untidy priority queue
+   * (Yatziv et al.), which inserts and removes nodes in constant time, instead
+   * of a binary heap. The nodes are then processed in increasing order of
+   * their values up to UntidyPriorityQueueBucketWidth, which also bounds the
+   * error introduced on the output values. Off by default. */
+  itkSetMacro(UseUntidyPriorityQueue, bool);
+  itkGetConstReferenceMacro(UseUntidyPriorityQueue, bool);
+  itkBooleanMacro(UseUntidyPriorityQueue);
+
+  /** Set/Get the width of the buckets of the untidy priority queue, in units
+   * of the output values. Must be positive when UseUntidyPriorityQueue is on. */
+  itkSetMacro(UntidyPriorityQueueBucketWidth, double);
+  itkGetConstMacro(UntidyPriorityQueueBucketWidth, double);
+
 protected:
   /** \brief Constructor */
   FastMarchingBase();
@@ -254,11 +253,10 @@ protected:
 
   bool m_CollectPoints{};
 
-  // PriorityQueuePointer m_Heap;
-  using HeapContainerType = std::vector<NodePairType>;
-  using NodeComparerType = std::greater<NodePairType>;
+  bool   m_UseUntidyPriorityQueue{ false };
+  double m_UntidyPriorityQueueBucketWidth{ 0.0 };
 
-  using PriorityQueueType = std::priority_queue<NodePairType, HeapContainerType, NodeComparerType>;
+  using PriorityQueueType = FastMarchingPriorityQueue<NodePairType>;
 
   PriorityQueueType m_Heap{};
 
@@ -268,6 +266,25 @@ protected:
   virtual IdentifierType
   GetTotalNumberOfNodes() const = 0;
 
+  /** \brief Get the identifier of a given node, in [0, GetTotalNumberOfNodes()),
+   * used to find the node in the heap. By default, the nodes have no
+   * identifier, PriorityQueueType::NoIdentifier, and the updated trial nodes
+   * are pushed again in the heap, their outdated entries being discarded when
+   * they are popped. */
+  virtual IdentifierType
+  GetNodeIdentifier(const NodeType & itkNotUsed(iNode)) const
+  {
+    return PriorityQueueType::NoIdentifier;
+  }
+
+  /** \brief Insert a node in the heap of trial nodes, or update its value if
+   * it is already there */
+  void
+  PushTrialNode(const NodePairType & iNodePair)
+  {
+    m_Heap.Push(this->GetNodeIdentifier(iNodePair.GetNode()), iNodePair);
+  }
+
   /** \brief Get the output value (front value) for a given node */
   virtual const OutputPixelType
   GetOutputValue(OutputDomainType * oDomain, const NodeType & iNode) const = 0;
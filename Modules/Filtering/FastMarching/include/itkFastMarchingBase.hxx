@@ -36,7 +36,6 @@ FastMarchingBase<TInput, TOutput>::FastMarchingBase()
   m_ProcessedPoints = nullptr;
   m_ForbiddenPoints = nullptr;
 
-  // m_Heap = PriorityQueueType::New();
   m_SpeedConstant = 1.;
   m_InverseSpeed = -1.;
   m_NormalizationFactor = 1.;
@@ -57,6 +56,8 @@ FastMarchingBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) c
   os << indent << "Speed constant: " << m_SpeedConstant << std::endl;
   os << indent << "Topology check: " << m_TopologyCheck << std::endl;
   os << indent << "Normalization Factor: " << m_NormalizationFactor << std::endl;
+  os << indent << "UseUntidyPriorityQueue: " << (m_UseUntidyPriorityQueue ? "On" : "Off") << std::endl;
+  os << indent << "UntidyPriorityQueueBucketWidth: " << m_UntidyPriorityQueueBucketWidth << std::endl;
 }
 
 // -----------------------------------------------------------------------------
@@ -90,17 +91,17 @@ FastMarchingBase<TInput, TOutput>::Initialize(OutputDomainType * oDomain)
     }
   }
 
+  if (m_UseUntidyPriorityQueue && !(m_UntidyPriorityQueueBucketWidth > 0.0))
+  {
+    itkExceptionMacro("UntidyPriorityQueueBucketWidth must be positive when UseUntidyPriorityQueue is On");
+  }
+
   // make sure the heap is empty
-  while (!m_Heap.empty())
+  m_Heap.SetUntidy(m_UseUntidyPriorityQueue);
+  if (m_UseUntidyPriorityQueue)
   {
-    m_Heap.pop();
+    m_Heap.SetBucketWidth(m_UntidyPriorityQueueBucketWidth);
   }
-  /*
-  while ( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }
-  */
 
   this->InitializeOutput(oDomain);
 
@@ -127,18 +128,10 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
 
   try
   {
-    // while( !m_Heap->Empty() )
-    while (!m_Heap.empty())
+    while (!m_Heap.Empty())
     {
-      // PriorityQueueElementType element = m_Heap->Peek();
-      // m_Heap->Pop();
-      //
-      // NodeType current_node = element.m_Element;
-      // OutputPixelType current_value = element.m_Priority;
-
-
-      NodePairType current_node_pair = m_Heap.top();
-      m_Heap.pop();
+      NodePairType current_node_pair = m_Heap.Peek();
+      m_Heap.Pop();
 
       NodeType current_node = current_node_pair.GetNode();
       current_value = this->GetOutputValue(output, current_node);
@@ -181,14 +174,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
     // it.
     //
     // RELEASE MEMORY!!!
-    while (!m_Heap.empty())
-    {
-      m_Heap.pop();
-    }
-    /*while( !m_Heap->Empty() )
-      {
-      m_Heap->Pop();
-      }*/
+    m_Heap.Clear();
 
     throw ProcessAborted(__FILE__, __LINE__);
   }
@@ -196,14 +182,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
   m_TargetReachedValue = current_value;
 
   // let's release some useless memory...
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*while( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }*/
+  m_Heap.Clear();
 }
 // -----------------------------------------------------------------------------
 
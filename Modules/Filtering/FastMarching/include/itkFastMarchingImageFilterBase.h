@@ -190,6 +190,9 @@ protected:
   IdentifierType
   GetTotalNumberOfNodes() const override;
 
+  IdentifierType
+  GetNodeIdentifier(const NodeType & iNode) const override;
+
   void
   SetOutputValue(OutputImageType * oImage, const NodeType & iNode, const OutputPixelType & iValue) override;
 
@@ -111,6 +111,13 @@ FastMarchingImageFilterBase<TInput, TOutput>::GetTotalNumberOfNodes() const
   return this->m_BufferedRegion.GetNumberOfPixels();
 }
 
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingImageFilterBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode) const
+{
+  return static_cast<IdentifierType>(m_LabelImage->ComputeOffset(iNode));
+}
+
 template <typename TInput, typename TOutput>
 void
 FastMarchingImageFilterBase<TInput, TOutput>::SetOutputValue(OutputImageType *       oImage,
@@ -199,7 +206,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::UpdateValue(OutputImageType * oIma
     this->SetLabelValueForGivenNode(iNode, Traits::Trial);
 
     // Insert point into trial heap
-    this->m_Heap.push(NodePairType(iNode, outputPixel));
+    this->PushTrialNode(NodePairType(iNode, outputPixel));
   }
 }
 
@@ -462,6 +469,9 @@ FastMarchingImageFilterBase<TInput, TOutput>::InitializeOutput(OutputImageType *
   m_LabelImage->Allocate();
   m_LabelImage->FillBuffer(Traits::Far);
 
+  // Allocate the heap position of every node once
+  this->m_Heap.Reserve(this->GetTotalNumberOfNodes());
+
   NodeType        idx;
   OutputPixelType outputPixel = this->m_LargeValue;
 
@@ -562,8 +572,7 @@ FastMarchingImageFilterBase<TInput, TOutput>::InitializeOutput(OutputImageType *
         outputPixel = pointsIter->Value().GetValue();
         this->SetOutputValue(oImage, idx, outputPixel);
 
-        // this->m_Heap->Push( PriorityQueueElementType( idx, pointsIter->second ) );
-        this->m_Heap.push(pointsIter->Value());
+        this->PushTrialNode(pointsIter->Value());
       }
       ++pointsIter;
     }
@@ -0,0 +1,436 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastMarchingPriorityQueue_h
+#define itkFastMarchingPriorityQueue_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastMarchingPriorityQueue
+ * \brief Priority queue of the trial nodes of fast marching methods.
+ *
+ * Each node is given by a NodePair and a unique identifier in
+ * [0, numberOfNodes), e.g. the offset of an image index in the buffer or the
+ * identifier of a mesh point, or by NoIdentifier when the node has none.
+ *
+ * By default the queue is an indexed binary min-heap: pushing a node which is
+ * already in the queue updates its value (decrease-key) instead of adding a
+ * duplicate, so that the heap never holds more than one entry per node. The
+ * table mapping the node identifiers to their heap positions is allocated
+ * once, with Reserve(). The nodes pushed with NoIdentifier are added as new
+ * entries, as with a std::priority_queue, and the caller must discard their
+ * outdated entries.
+ *
+ * Optionally, the queue can be made "untidy", as proposed in
+ *
+ * L. Yatziv, A. Bartesaghi, G. Sapiro. "O(N) implementation of the fast
+ * marching algorithm", Journal of Computational Physics, 212(2):393-399, 2006.
+ *
+ * The values are then quantized into buckets of width BucketWidth, stored in
+ * a circular array, and nodes are processed first-in first-out within a
+ * bucket. Push and Pop are O(1), and the nodes are popped in increasing order
+ * of their values up to BucketWidth. Updated nodes are pushed again; the
+ * previous entries are left in the queue and must be discarded by the caller
+ * by comparing their value to the current value of the node. The circular
+ * array holds at most MaximumNumberOfBuckets buckets: when the values span
+ * more buckets, the queue moves its nodes to a binary heap, without node
+ * identifiers, until it is cleared.
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TNodePair>
+class FastMarchingPriorityQueue
+{
+public:
+  using Self = FastMarchingPriorityQueue;
+
+  using NodePairType = TNodePair;
+  using NodeType = typename NodePairType::NodeType;
+  using OutputPixelType = typename NodePairType::OutputPixelType;
+
+  /** Identifier of the nodes which are not found in the queue when their
+   * value is updated, but pushed again. */
+  static constexpr IdentifierType NoIdentifier = NumericTraits<IdentifierType>::max();
+
+  /** Maximum number of buckets of the untidy priority queue. */
+  static constexpr SizeValueType MaximumNumberOfBuckets = SizeValueType{ 1 } << 20;
+
+  FastMarchingPriorityQueue() = default;
+
+  /** Set/Get whether the queue is an untidy priority queue. Must be called
+   * while the queue is empty. */
+  void
+  SetUntidy(bool untidy)
+  {
+    this->Clear();
+    m_Untidy = untidy;
+  }
+  bool
+  GetUntidy() const
+  {
+    return m_Untidy;
+  }
+
+  /** Set/Get the width of the buckets of the untidy priority queue, in units
+   * of the node values. It bounds the error on the processing order. */
+  void
+  SetBucketWidth(double bucketWidth)
+  {
+    if (!(bucketWidth > 0.0))
+    {
+      itkGenericExceptionMacro("The bucket width of the untidy priority queue must be positive, got " << bucketWidth);
+    }
+    m_BucketWidth = bucketWidth;
+  }
+  double
+  GetBucketWidth() const
+  {
+    return m_BucketWidth;
+  }
+
+  /** Allocate the tables for numberOfNodes node identifiers. */
+  void
+  Reserve(SizeValueType numberOfNodes)
+  {
+    if (!m_Untidy)
+    {
+      m_Positions.assign(numberOfNodes, NotInHeap);
+    }
+  }
+
+  bool
+  Empty() const
+  {
+    return m_Size == 0;
+  }
+
+  /** Number of entries in the queue, including the outdated ones of an untidy
+   * queue. */
+  SizeValueType
+  Size() const
+  {
+    return m_Size;
+  }
+
+  /** Insert a node, or update its value if it is already in the queue. */
+  void
+  Push(IdentifierType nodeId, const NodePairType & nodePair)
+  {
+    if (m_Untidy)
+    {
+      if (!m_BucketsOverflowed)
+      {
+        this->PushInBucket(nodePair);
+        return;
+      }
+      nodeId = NoIdentifier;
+    }
+
+    if (nodeId == NoIdentifier)
+    {
+      this->PushInHeap(nodeId, nodePair);
+      return;
+    }
+    if (nodeId >= m_Positions.size())
+    {
+      m_Positions.resize(std::max(static_cast<SizeValueType>(nodeId + 1), 2 * m_Positions.size()), NotInHeap);
+    }
+
+    const IdentifierType position = m_Positions[nodeId];
+    if (position == NotInHeap)
+    {
+      this->PushInHeap(nodeId, nodePair);
+    }
+    else
+    {
+      const OutputPixelType previousValue = m_Heap[position].m_NodePair.GetValue();
+      m_Heap[position].m_NodePair = nodePair;
+      if (nodePair.GetValue() < previousValue)
+      {
+        this->SiftUp(position);
+      }
+      else
+      {
+        this->SiftDown(position);
+      }
+    }
+  }
+
+  /** Node with the smallest value. The queue must not be empty. */
+  const NodePairType &
+  Peek()
+  {
+    if (m_Untidy && !m_BucketsOverflowed)
+    {
+      this->MoveToFirstNonEmptyBucket();
+      const BucketType & bucket = m_Buckets[m_CurrentBucket];
+      return bucket.m_Elements[bucket.m_Front];
+    }
+    return m_Heap.front().m_NodePair;
+  }
+
+  /** Remove the node with the smallest value. The queue must not be empty. */
+  void
+  Pop()
+  {
+    if (m_Untidy && !m_BucketsOverflowed)
+    {
+      this->MoveToFirstNonEmptyBucket();
+      BucketType & bucket = m_Buckets[m_CurrentBucket];
+      if (++bucket.m_Front == bucket.m_Elements.size())
+      {
+        bucket.m_Elements.clear();
+        bucket.m_Front = 0;
+      }
+      --m_Size;
+      return;
+    }
+
+    this->SetPosition(m_Heap.front().m_NodeId, NotInHeap);
+    if (m_Heap.size() > 1)
+    {
+      m_Heap.front() = m_Heap.back();
+      this->SetPosition(m_Heap.front().m_NodeId, 0);
+      m_Heap.pop_back();
+      this->SiftDown(0);
+    }
+    else
+    {
+      m_Heap.pop_back();
+    }
+    --m_Size;
+  }
+
+  /** Remove all the nodes and release the memory. */
+  void
+  Clear()
+  {
+    HeapContainerType().swap(m_Heap);
+    std::vector<IdentifierType>().swap(m_Positions);
+    std::vector<BucketType>().swap(m_Buckets);
+    m_FirstBucketKey = 0;
+    m_CurrentBucket = 0;
+    m_Popped = false;
+    m_BucketsOverflowed = false;
+    m_Size = 0;
+  }
+
+private:
+  static constexpr IdentifierType NotInHeap = NumericTraits<IdentifierType>::max();
+
+  struct HeapElementType
+  {
+    IdentifierType m_NodeId;
+    NodePairType   m_NodePair;
+  };
+  using HeapContainerType = std::vector<HeapElementType>;
+
+  using BucketKeyType = std::int64_t;
+
+  struct BucketType
+  {
+    std::vector<NodePairType> m_Elements;
+    SizeValueType             m_Front{ 0 };
+  };
+
+  void
+  SetPosition(IdentifierType nodeId, IdentifierType position)
+  {
+    if (nodeId != NoIdentifier)
+    {
+      m_Positions[nodeId] = position;
+    }
+  }
+
+  void
+  PushInHeap(IdentifierType nodeId, const NodePairType & nodePair)
+  {
+    m_Heap.push_back(HeapElementType{ nodeId, nodePair });
+    ++m_Size;
+    this->SiftUp(m_Heap.size() - 1);
+  }
+
+  void
+  SiftUp(IdentifierType position)
+  {
+    HeapElementType element = m_Heap[position];
+    while (position > 0)
+    {
+      const IdentifierType parent = (position - 1) / 2;
+      if (!(element.m_NodePair.GetValue() < m_Heap[parent].m_NodePair.GetValue()))
+      {
+        break;
+      }
+      m_Heap[position] = m_Heap[parent];
+      this->SetPosition(m_Heap[position].m_NodeId, position);
+      position = parent;
+    }
+    m_Heap[position] = element;
+    this->SetPosition(element.m_NodeId, position);
+  }
+
+  void
+  SiftDown(IdentifierType position)
+  {
+    const IdentifierType size = m_Heap.size();
+    HeapElementType      element = m_Heap[position];
+    for (IdentifierType child = 2 * position + 1; child < size; child = 2 * position + 1)
+    {
+      if (child + 1 < size && m_Heap[child + 1].m_NodePair.GetValue() < m_Heap[child].m_NodePair.GetValue())
+      {
+        ++child;
+      }
+      if (!(m_Heap[child].m_NodePair.GetValue() < element.m_NodePair.GetValue()))
+      {
+        break;
+      }
+      m_Heap[position] = m_Heap[child];
+      this->SetPosition(m_Heap[position].m_NodeId, position);
+      position = child;
+    }
+    m_Heap[position] = element;
+    this->SetPosition(element.m_NodeId, position);
+  }
+
+  void
+  PushInBucket(const NodePairType & nodePair)
+  {
+    const BucketKeyType key = this->GetBucketKey(nodePair.GetValue());
+    if (m_Buckets.empty())
+    {
+      m_Buckets.resize(MinimumNumberOfBuckets);
+      m_FirstBucketKey = key;
+      m_CurrentBucket = 0;
+    }
+    else if (key < m_FirstBucketKey && !m_Popped)
+    {
+      // Nothing has been processed yet, e.g. while the trial points are
+      // inserted: move the first bucket down instead of losing the order.
+      const auto offset = static_cast<SizeValueType>(m_FirstBucketKey - key);
+      if (offset >= MaximumNumberOfBuckets - m_Buckets.size())
+      {
+        this->MoveBucketsToHeap();
+        this->PushInHeap(NoIdentifier, nodePair);
+        return;
+      }
+      this->ResizeBuckets(m_Buckets.size() + offset, offset);
+      m_FirstBucketKey = key;
+    }
+
+    // Values smaller than the current bucket are processed next.
+    const auto bucket = static_cast<SizeValueType>(std::max(key, m_FirstBucketKey) - m_FirstBucketKey);
+    if (bucket >= m_Buckets.size())
+    {
+      if (bucket >= MaximumNumberOfBuckets)
+      {
+        this->MoveBucketsToHeap();
+        this->PushInHeap(NoIdentifier, nodePair);
+        return;
+      }
+      this->ResizeBuckets(bucket + 1, 0);
+    }
+
+    m_Buckets[(m_CurrentBucket + bucket) % m_Buckets.size()].m_Elements.push_back(nodePair);
+    ++m_Size;
+  }
+
+  BucketKeyType
+  GetBucketKey(const OutputPixelType & value) const
+  {
+    constexpr double maximumKey = 1e15;
+    const double     key = std::floor(static_cast<double>(value) / m_BucketWidth);
+    return static_cast<BucketKeyType>(std::clamp(key, -maximumKey, maximumKey));
+  }
+
+  void
+  MoveToFirstNonEmptyBucket()
+  {
+    m_Popped = true;
+    while (m_Buckets[m_CurrentBucket].m_Elements.empty())
+    {
+      m_CurrentBucket = (m_CurrentBucket + 1) % m_Buckets.size();
+      ++m_FirstBucketKey;
+    }
+  }
+
+  /** Move the nodes of the buckets to the binary heap, which then holds all
+   * the nodes of the queue. */
+  void
+  MoveBucketsToHeap()
+  {
+    m_BucketsOverflowed = true;
+    m_Size = 0;
+    for (const BucketType & bucket : m_Buckets)
+    {
+      for (SizeValueType ii = bucket.m_Front; ii < bucket.m_Elements.size(); ++ii)
+      {
+        this->PushInHeap(NoIdentifier, bucket.m_Elements[ii]);
+      }
+    }
+    std::vector<BucketType>().swap(m_Buckets);
+  }
+
+  /** Reallocate the circular array with at least minimumNumberOfBuckets
+   * buckets, the current bucket being moved to the given offset. */
+  void
+  ResizeBuckets(SizeValueType minimumNumberOfBuckets, SizeValueType offset)
+  {
+    SizeValueType numberOfBuckets = 2 * m_Buckets.size();
+    while (numberOfBuckets < minimumNumberOfBuckets)
+    {
+      numberOfBuckets *= 2;
+    }
+
+    std::vector<BucketType> buckets(numberOfBuckets);
+    for (SizeValueType ii = 0; ii < m_Buckets.size(); ++ii)
+    {
+      std::swap(buckets[offset + ii], m_Buckets[(m_CurrentBucket + ii) % m_Buckets.size()]);
+    }
+    m_Buckets.swap(buckets);
+    m_CurrentBucket = 0;
+  }
+
+  static constexpr SizeValueType MinimumNumberOfBuckets = 256;
+
+  bool   m_Untidy{ false };
+  double m_BucketWidth{ 1.0 };
+
+  HeapContainerType           m_Heap{};
+  std::vector<IdentifierType> m_Positions{};
+
+  std::vector<BucketType> m_Buckets{};
+  BucketKeyType           m_FirstBucketKey{ 0 };
+  SizeValueType           m_CurrentBucket{ 0 };
+  bool                    m_Popped{ false };
+  bool                    m_BucketsOverflowed{ false };
+
+  SizeValueType m_Size{ 0 };
+};
+} // end namespace itk
+
+#endif // itkFastMarchingPriorityQueue_h
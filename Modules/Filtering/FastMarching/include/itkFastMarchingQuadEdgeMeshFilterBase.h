@@ -110,6 +110,9 @@ protected:
   IdentifierType
   GetTotalNumberOfNodes() const override;
 
+  IdentifierType
+  GetNodeIdentifier(const NodeType & iNode) const override;
+
   void
   SetOutputValue(OutputMeshType * oMesh, const NodeType & iNode, const OutputPixelType & iValue) override;
 
@@ -40,6 +40,13 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::GetTotalNumberOfNodes() con
   return this->GetInput()->GetNumberOfPoints();
 }
 
+template <typename TInput, typename TOutput>
+IdentifierType
+FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::GetNodeIdentifier(const NodeType & iNode) const
+{
+  return static_cast<IdentifierType>(iNode);
+}
+
 template <typename TInput, typename TOutput>
 void
 FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::SetOutputValue(OutputMeshType *        oMesh,
@@ -205,7 +212,7 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::UpdateValue(OutputMeshType
 
       this->SetLabelValueForGivenNode(iNode, Traits::Trial);
 
-      this->m_Heap.push(NodePairType(iNode, outputPixel));
+      this->PushTrialNode(NodePairType(iNode, outputPixel));
     }
   }
   else
@@ -618,6 +625,9 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::InitializeOutput(OutputMesh
 
   m_Label.clear();
 
+  // Allocate the heap position of every node once
+  this->m_Heap.Reserve(this->GetTotalNumberOfNodes());
+
   if (this->m_AlivePoints)
   {
     NodePairContainerConstIterator pointsIter = this->m_AlivePoints->Begin();
@@ -675,7 +685,7 @@ FastMarchingQuadEdgeMeshFilterBase<TInput, TOutput>::InitializeOutput(OutputMesh
         this->SetLabelValueForGivenNode(idx, Traits::InitialTrial);
         this->SetOutputValue(oMesh, idx, outputPixel);
 
-        this->m_Heap.push(pointsIter->Value());
+        this->PushTrialNode(pointsIter->Value());
       }
 
       ++pointsIter;
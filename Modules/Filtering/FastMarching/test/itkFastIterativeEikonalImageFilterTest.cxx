@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastIterativeEikonalImageFilter.h"
+#include "itkFastMarchingNumberOfElementsStoppingCriterion.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using PixelType = float;
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+using FastIterativeType = itk::FastIterativeEikonalImageFilter<ImageType, ImageType>;
+using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+using NodePairType = FastMarchingType::NodePairType;
+using NodePairContainerType = FastMarchingType::NodePairContainerType;
+
+// Set up a filter with a varying speed, two trial points and a wall of
+// forbidden points. The front does not reach the image boundary before the
+// threshold.
+template <typename TFilter>
+void
+SetUpFilter(TFilter * filter, PixelType threshold)
+{
+  auto speedImage = ImageType::New();
+  speedImage->SetRegions(ImageType::SizeType::Filled(64));
+  speedImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> speedIt(speedImage, speedImage->GetBufferedRegion());
+  for (speedIt.GoToBegin(); !speedIt.IsAtEnd(); ++speedIt)
+  {
+    speedIt.Set(1.0 + 0.5 * std::sin(0.2 * speedIt.GetIndex()[0]) * std::cos(0.3 * speedIt.GetIndex()[1]));
+  }
+
+  auto trial = NodePairContainerType::New();
+  trial->push_back(NodePairType(ImageType::IndexType{ { 24, 32 } }, 0.0));
+  trial->push_back(NodePairType(ImageType::IndexType{ { 44, 32 } }, 3.0));
+
+  auto forbidden = NodePairContainerType::New();
+  for (itk::IndexValueType y = 20; y < 45; ++y)
+  {
+    forbidden->push_back(NodePairType(ImageType::IndexType{ { 34, y } }, 0.0));
+  }
+
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(threshold);
+
+  filter->SetInput(speedImage);
+  filter->SetStoppingCriterion(criterion);
+  filter->SetTrialPoints(trial);
+  filter->SetForbiddenPoints(forbidden);
+}
+} // namespace
+
+int
+itkFastIterativeEikonalImageFilterTest(int, char *[])
+{
+  auto filter = FastIterativeType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, FastIterativeEikonalImageFilter, FastMarchingImageFilterBase);
+
+  ITK_TEST_EXPECT_EQUAL(filter->GetConvergenceTolerance(), 1e-6);
+  filter->SetConvergenceTolerance(1e-4);
+  ITK_TEST_SET_GET_VALUE(1e-4, filter->GetConvergenceTolerance());
+  filter->SetConvergenceTolerance(0.0);
+
+  constexpr PixelType threshold = 12.0;
+
+  auto fastMarching = FastMarchingType::New();
+  SetUpFilter(fastMarching.GetPointer(), threshold);
+  ITK_TRY_EXPECT_NO_EXCEPTION(fastMarching->Update());
+
+  SetUpFilter(filter.GetPointer(), threshold);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  std::cout << "Number of iterations: " << filter->GetNumberOfIterations() << std::endl;
+
+  // The fast iterative method converges to the fast marching solution.
+  bool   testPassed = true;
+  double maximumError = 0.0;
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> fmIt(fastMarching->GetOutput(),
+                                                         fastMarching->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType>          fimIt(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  for (; !fmIt.IsAtEnd(); ++fmIt, ++fimIt)
+  {
+    if (fmIt.Get() < threshold)
+    {
+      maximumError = std::max(maximumError, static_cast<double>(std::abs(fmIt.Get() - fimIt.Get())));
+      if (filter->GetLabelImage()->GetPixel(fmIt.GetIndex()) != FastIterativeType::Traits::Alive &&
+          fastMarching->GetLabelImage()->GetPixel(fmIt.GetIndex()) == FastIterativeType::Traits::Alive)
+      {
+        std::cerr << "Node " << fmIt.GetIndex() << " should be alive" << std::endl;
+        testPassed = false;
+      }
+    }
+  }
+  std::cout << "Maximum difference with the fast marching method: " << maximumError << std::endl;
+
+  if (maximumError > 1e-3)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The fast iterative method differs from the fast marching method by " << maximumError << std::endl;
+    testPassed = false;
+  }
+
+  // The output does not depend on the number of work units.
+  auto singleThreaded = FastIterativeType::New();
+  SetUpFilter(singleThreaded.GetPointer(), threshold);
+  singleThreaded->SetConvergenceTolerance(0.0);
+  singleThreaded->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleThreaded->Update());
+
+  itk::ImageRegionConstIterator<ImageType> singleIt(singleThreaded->GetOutput(),
+                                                    singleThreaded->GetOutput()->GetBufferedRegion());
+  for (fimIt.GoToBegin(); !fimIt.IsAtEnd(); ++fimIt, ++singleIt)
+  {
+    if (itk::Math::NotExactlyEquals(fimIt.Get(), singleIt.Get()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The output depends on the number of work units" << std::endl;
+      testPassed = false;
+      break;
+    }
+  }
+
+  // The alive points keep their value.
+  const ImageType::IndexType aliveIndex{ { 24, 36 } };
+  auto                       alive = NodePairContainerType::New();
+  alive->push_back(NodePairType(aliveIndex, 1.0));
+  singleThreaded->SetAlivePoints(alive);
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleThreaded->Update());
+  ITK_TEST_EXPECT_EQUAL(singleThreaded->GetOutput()->GetPixel(aliveIndex), 1.0);
+  ITK_TEST_EXPECT_EQUAL(singleThreaded->GetLabelImage()->GetPixel(aliveIndex), FastIterativeType::Traits::Alive);
+
+  // Only the threshold stopping criterion is supported.
+  auto numberOfElementsCriterion =
+    itk::FastMarchingNumberOfElementsStoppingCriterion<ImageType, ImageType>::New();
+  numberOfElementsCriterion->SetTargetNumberOfElements(10);
+  filter->SetStoppingCriterion(numberOfElementsCriterion);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
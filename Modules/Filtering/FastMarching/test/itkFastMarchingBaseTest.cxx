@@ -150,6 +150,12 @@ itkFastMarchingBaseTest(int argc, char * argv[])
     bool collectPoints = false;
     ITK_TEST_EXPECT_EQUAL(collectPoints, fmm->GetCollectPoints());
 
+    bool useUntidyPriorityQueue = false;
+    ITK_TEST_EXPECT_EQUAL(useUntidyPriorityQueue, fmm->GetUseUntidyPriorityQueue());
+
+    double untidyPriorityQueueBucketWidth = 0.0;
+    ITK_TEST_EXPECT_EQUAL(untidyPriorityQueueBucketWidth, fmm->GetUntidyPriorityQueueBucketWidth());
+
     // Check other values
     topologyCheck = ImageFastMarching::TopologyCheckEnum::Strict;
     fmm->SetTopologyCheck(topologyCheck);
@@ -183,6 +189,13 @@ itkFastMarchingBaseTest(int argc, char * argv[])
     collectPoints = true;
     ITK_TEST_SET_GET_BOOLEAN(fmm, CollectPoints, collectPoints);
 
+    useUntidyPriorityQueue = true;
+    ITK_TEST_SET_GET_BOOLEAN(fmm, UseUntidyPriorityQueue, useUntidyPriorityQueue);
+
+    untidyPriorityQueueBucketWidth = 0.1;
+    fmm->SetUntidyPriorityQueueBucketWidth(untidyPriorityQueueBucketWidth);
+    ITK_TEST_SET_GET_VALUE(untidyPriorityQueueBucketWidth, fmm->GetUntidyPriorityQueueBucketWidth());
+
     fmm->SetInput(input);
 
     ITK_TRY_EXPECT_EXCEPTION(fmm->Update());
@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingPriorityQueue.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using PixelType = float;
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+// Compute the arrival time from the center of a 64x64 image with a varying
+// speed, with either the binary heap or the untidy priority queue.
+ImageType::Pointer
+ComputeArrivalTime(bool useUntidyPriorityQueue, double bucketWidth)
+{
+  using FastMarchingType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+  using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+
+  auto speedImage = ImageType::New();
+  speedImage->SetRegions(ImageType::SizeType::Filled(64));
+  speedImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> speedIt(speedImage, speedImage->GetBufferedRegion());
+  for (speedIt.GoToBegin(); !speedIt.IsAtEnd(); ++speedIt)
+  {
+    speedIt.Set(1.0 + 0.5 * std::sin(0.2 * speedIt.GetIndex()[0]) * std::cos(0.3 * speedIt.GetIndex()[1]));
+  }
+
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(1000.0);
+
+  auto trial = FastMarchingType::NodePairContainerType::New();
+  trial->push_back(FastMarchingType::NodePairType(ImageType::IndexType{ { 32, 32 } }, 0.0));
+
+  auto marcher = FastMarchingType::New();
+  marcher->SetInput(speedImage);
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetTrialPoints(trial);
+  marcher->SetUseUntidyPriorityQueue(useUntidyPriorityQueue);
+  marcher->SetUntidyPriorityQueueBucketWidth(bucketWidth);
+  marcher->Update();
+
+  return marcher->GetOutput();
+}
+} // namespace
+
+int
+itkFastMarchingPriorityQueueTest(int, char *[])
+{
+  using NodePairType = itk::NodePair<itk::IdentifierType, double>;
+  using PriorityQueueType = itk::FastMarchingPriorityQueue<NodePairType>;
+
+  constexpr itk::IdentifierType numberOfNodes = 1000;
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(12345);
+
+  std::vector<double> values(numberOfNodes);
+  for (auto & value : values)
+  {
+    value = generator->GetUniformVariate(0.0, 100.0);
+  }
+
+  // The binary heap holds a single entry per node, with its last value.
+  PriorityQueueType heap;
+  heap.Reserve(numberOfNodes);
+  for (itk::IdentifierType ii = 0; ii < numberOfNodes; ++ii)
+  {
+    heap.Push(ii, NodePairType(ii, values[ii]));
+  }
+  for (itk::IdentifierType ii = 0; ii < numberOfNodes; ii += 3)
+  {
+    values[ii] *= 0.5;
+    heap.Push(ii, NodePairType(ii, values[ii]));
+  }
+  ITK_TEST_EXPECT_EQUAL(heap.Size(), numberOfNodes);
+
+  double previousValue = itk::NumericTraits<double>::NonpositiveMin();
+  while (!heap.Empty())
+  {
+    const NodePairType nodePair = heap.Peek();
+    heap.Pop();
+    if (nodePair.GetValue() < previousValue || nodePair.GetValue() != values[nodePair.GetNode()])
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Node " << nodePair.GetNode() << " popped out of order with value " << nodePair.GetValue()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    previousValue = nodePair.GetValue();
+  }
+
+  // The nodes without identifier are pushed again when they are updated.
+  PriorityQueueType duplicateHeap;
+  duplicateHeap.Push(PriorityQueueType::NoIdentifier, NodePairType(0, 2.0));
+  duplicateHeap.Push(PriorityQueueType::NoIdentifier, NodePairType(1, 3.0));
+  duplicateHeap.Push(PriorityQueueType::NoIdentifier, NodePairType(0, 1.0));
+  ITK_TEST_EXPECT_EQUAL(duplicateHeap.Size(), 3);
+  ITK_TEST_EXPECT_EQUAL(duplicateHeap.Peek().GetValue(), 1.0);
+  duplicateHeap.Pop();
+  ITK_TEST_EXPECT_EQUAL(duplicateHeap.Peek().GetValue(), 2.0);
+  duplicateHeap.Pop();
+  ITK_TEST_EXPECT_EQUAL(duplicateHeap.Peek().GetNode(), 1);
+
+  // The untidy priority queue is ordered up to the bucket width.
+  constexpr double bucketWidth = 0.5;
+  PriorityQueueType untidyQueue;
+  untidyQueue.SetUntidy(true);
+  ITK_TRY_EXPECT_EXCEPTION(untidyQueue.SetBucketWidth(0.0));
+  untidyQueue.SetBucketWidth(bucketWidth);
+  for (itk::IdentifierType ii = 0; ii < numberOfNodes; ++ii)
+  {
+    untidyQueue.Push(ii, NodePairType(ii, values[ii]));
+  }
+  ITK_TEST_EXPECT_EQUAL(untidyQueue.Size(), numberOfNodes);
+
+  previousValue = itk::NumericTraits<double>::NonpositiveMin();
+  while (!untidyQueue.Empty())
+  {
+    const NodePairType nodePair = untidyQueue.Peek();
+    untidyQueue.Pop();
+    if (nodePair.GetValue() < previousValue - bucketWidth)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Node " << nodePair.GetNode() << " popped out of order with value " << nodePair.GetValue()
+                << " after " << previousValue << std::endl;
+      return EXIT_FAILURE;
+    }
+    previousValue = std::max(previousValue, nodePair.GetValue());
+  }
+
+  // When the values span more buckets than MaximumNumberOfBuckets, the untidy
+  // priority queue moves its nodes to a binary heap, which orders them exactly.
+  untidyQueue.SetUntidy(true);
+  untidyQueue.SetBucketWidth(100.0 / PriorityQueueType::MaximumNumberOfBuckets);
+  for (itk::IdentifierType ii = 0; ii < numberOfNodes; ++ii)
+  {
+    untidyQueue.Push(ii, NodePairType(ii, values[ii]));
+    untidyQueue.Push(ii, NodePairType(ii, 100.0 * values[ii]));
+  }
+  ITK_TEST_EXPECT_EQUAL(untidyQueue.Size(), 2 * numberOfNodes);
+
+  previousValue = itk::NumericTraits<double>::NonpositiveMin();
+  while (!untidyQueue.Empty())
+  {
+    const NodePairType nodePair = untidyQueue.Peek();
+    untidyQueue.Pop();
+    if (nodePair.GetValue() < previousValue)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Node " << nodePair.GetNode() << " popped out of order with value " << nodePair.GetValue()
+                << " after the overflow of the buckets" << std::endl;
+      return EXIT_FAILURE;
+    }
+    previousValue = nodePair.GetValue();
+  }
+
+  // Fast marching with the untidy priority queue stays close to the exact one.
+  const ImageType::Pointer exact = ComputeArrivalTime(false, 0.0);
+  const ImageType::Pointer untidy = ComputeArrivalTime(true, 0.01);
+
+  double                                  maximumError = 0.0;
+  itk::ImageRegionConstIterator<ImageType> exactIt(exact, exact->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> untidyIt(untidy, untidy->GetBufferedRegion());
+  for (; !exactIt.IsAtEnd(); ++exactIt, ++untidyIt)
+  {
+    maximumError = std::max(maximumError, static_cast<double>(std::abs(exactIt.Get() - untidyIt.Get())));
+  }
+  std::cout << "Maximum error of the untidy priority queue: " << maximumError << std::endl;
+
+  if (maximumError > 0.1)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The untidy priority queue error " << maximumError << " is too large." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ITK_TRY_EXPECT_EXCEPTION(ComputeArrivalTime(true, 0.0));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -52,6 +52,28 @@ namespace itk
  * Manduchi (Bilateral Filtering for Gray and ColorImages. IEEE
  * ICCV. 1998.)
  *
+ * The exact filter visits the whole domain neighborhood of every pixel,
+ * so its cost grows with the domain sigma. When UseBilateralGrid is on,
+ * the filter is instead approximated with a bilateral grid: the image is
+ * splatted into a grid with one spatial dimension per image dimension and
+ * one range dimension, with cells spaced by the domain and range sigmas,
+ * the grid is blurred, and the output is interpolated from the grid. The
+ * cost is then roughly linear in the number of pixels and independent of
+ * the domain sigma, but the Radius and the range Gaussian samples are not
+ * used, and the result differs from the exact filter, especially near the
+ * image boundaries. The difference to the exact filter is estimated on
+ * NumberOfApproximationErrorSamples pixels of the output, and reported by
+ * GetApproximationError() and GetMaximumApproximationError(). Since the
+ * cells are never smaller than a pixel, a small domain sigma or a small
+ * range sigma relative to the dynamic range makes the grid larger than the
+ * image; when it would exceed MaximumBilateralGridMemorySize, the filter
+ * runs the exact filter instead, and GetBilateralGridUsed() is false.
+ *
+ * The bilateral grid was described by Paris and Durand (A Fast
+ * Approximation of the Bilateral Filter using a Signal Processing
+ * Approach. ECCV. 2006.) and by Chen, Paris and Durand (Real-time
+ * Edge-Aware Image Processing with the Bilateral Grid. SIGGRAPH. 2007.)
+ *
  * \sa GaussianOperator
  * \sa RecursiveGaussianImageFilter
  * \sa DiscreteGaussianImageFilter
@@ -169,6 +191,36 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
 
+  /** Set/Get whether the filter is approximated with a bilateral grid,
+   * whose cost does not depend on the domain sigma. Default is false. */
+  itkSetMacro(UseBilateralGrid, bool);
+  itkGetConstMacro(UseBilateralGrid, bool);
+  itkBooleanMacro(UseBilateralGrid);
+
+  /** Set/Get the maximum number of bytes of the bilateral grid. When the
+   * grid would be larger, the exact filter is run instead. Default is
+   * 1 GiB. */
+  itkSetMacro(MaximumBilateralGridMemorySize, SizeValueType);
+  itkGetConstMacro(MaximumBilateralGridMemorySize, SizeValueType);
+
+  /** Get whether the last update used the bilateral grid. It is false when
+   * UseBilateralGrid is off, or when the grid would have exceeded
+   * MaximumBilateralGridMemorySize. */
+  itkGetConstMacro(BilateralGridUsed, bool);
+
+  /** Set/Get the number of output pixels on which the exact filter is
+   * evaluated to estimate the error of the bilateral grid. The samples are
+   * evenly spread over the output requested region. 0 disables the
+   * estimate. Default is 1000. */
+  itkSetMacro(NumberOfApproximationErrorSamples, SizeValueType);
+  itkGetConstMacro(NumberOfApproximationErrorSamples, SizeValueType);
+
+  /** Get the root mean square and the maximum absolute difference between
+   * the bilateral grid and the exact filter on the sampled pixels of the
+   * last update. Both are 0 when the bilateral grid was not used. */
+  itkGetConstMacro(ApproximationError, double);
+  itkGetConstMacro(MaximumApproximationError, double);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputPixelType>));
@@ -190,6 +242,23 @@ protected:
   void
   BeforeThreadedGenerateData() override;
 
+  /** Run the exact filter, or the bilateral grid when UseBilateralGrid is
+   * on. */
+  void
+  GenerateData() override;
+
+  /** Compute the output with a bilateral grid. */
+  void
+  GenerateBilateralGridData();
+
+  /** Estimate the difference between the output and the exact filter. */
+  void
+  ComputeApproximationError();
+
+  /** Compute the exact filtered value at the center of a neighborhood. */
+  OutputPixelRealType
+  ComputeFilteredValue(const NeighborhoodIteratorType & neighborhoodIt) const;
+
   /** Standard pipeline method. This filter is implemented as a multi-threaded
    * filter. */
   void
@@ -205,6 +274,17 @@ protected:
   GenerateInputRequestedRegion() override;
 
 private:
+  /** Spacing and number of cells along each axis of the bilateral grid. The
+   * axis 0 is the range axis, and the axis d + 1 is the axis d of the
+   * image. */
+  using GridCellSizeType = FixedArray<double, ImageDimension + 1>;
+  using GridSizeType = FixedArray<SizeValueType, ImageDimension + 1>;
+
+  /** Compute the geometry of the bilateral grid, and return its number of
+   * bytes. */
+  double
+  ComputeBilateralGridGeometry(GridCellSizeType & cellSize, GridSizeType & gridSize) const;
+
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
   double m_RangeSigma{};
@@ -230,7 +310,16 @@ private:
   unsigned long       m_NumberOfRangeGaussianSamples{};
   double              m_DynamicRange{};
   double              m_DynamicRangeUsed{};
+  double              m_InputMinimum{};
   std::vector<double> m_RangeGaussianTable{};
+
+  /** Bilateral grid approximation. */
+  bool          m_UseBilateralGrid{ false };
+  SizeValueType m_MaximumBilateralGridMemorySize{ SizeValueType{ 1 } << 30 };
+  bool          m_BilateralGridUsed{ false };
+  SizeValueType m_NumberOfApproximationErrorSamples{ 1000 };
+  double        m_ApproximationError{ 0.0 };
+  double        m_MaximumApproximationError{ 0.0 };
 };
 } // end namespace itk
 
@@ -24,7 +24,10 @@
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkTotalProgressReporter.h"
 #include "itkStatisticsImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkProgressTransformer.h"
 
+#include <algorithm>
 #include <cmath> // For abs.
 
 namespace itk
@@ -217,6 +220,7 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
   double v;
 
   m_DynamicRange = (static_cast<double>(statistics->GetMaximum()) - static_cast<double>(statistics->GetMinimum()));
+  m_InputMinimum = static_cast<double>(statistics->GetMinimum());
 
   m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
 
@@ -235,10 +239,7 @@ void
 BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  typename TInputImage::ConstPointer   input = this->GetInput();
-  typename TOutputImage::Pointer       output = this->GetOutput();
-  typename TInputImage::IndexValueType i;
-  const double                         rangeDistanceThreshold = m_DynamicRangeUsed;
+  typename TOutputImage::Pointer output = this->GetOutput();
 
   ZeroFluxNeumannBoundaryCondition<TInputImage> BC;
 
@@ -247,24 +248,11 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType faceList =
     fC(this->GetInput(), outputRegionForThread, m_GaussianKernel.GetRadius());
 
-  OutputPixelRealType centerPixel;
-  OutputPixelRealType val;
-  OutputPixelRealType tableArg;
-  OutputPixelRealType normFactor;
-  OutputPixelRealType rangeGaussian;
-  OutputPixelRealType rangeDistance;
-  OutputPixelRealType pixel;
-  OutputPixelRealType gaussianProduct;
-
-  const double distanceToTableIndex = static_cast<double>(m_NumberOfRangeGaussianSamples) / m_DynamicRangeUsed;
-
   // Process all the faces, the NeighborhoodIterator will determine
   // whether a specified region needs to use the boundary conditions or
   // not.
   NeighborhoodIteratorType             b_iter;
   ImageRegionIterator<OutputImageType> o_iter;
-  KernelConstIteratorType              k_it;
-  KernelConstIteratorType              kernelEnd = m_GaussianKernel.End();
 
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
@@ -277,46 +265,373 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 
     while (!b_iter.IsAtEnd())
     {
-      // Setup
-      centerPixel = static_cast<OutputPixelRealType>(b_iter.GetCenterPixel());
-      val = 0.0;
-      normFactor = 0.0;
+      // store the filtered value
+      o_iter.Set(static_cast<OutputPixelType>(this->ComputeFilteredValue(b_iter)));
+
+      ++b_iter;
+      ++o_iter;
+      progress.CompletedPixel();
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+BilateralImageFilter<TInputImage, TOutputImage>::ComputeFilteredValue(
+  const NeighborhoodIteratorType & neighborhoodIt) const -> OutputPixelRealType
+{
+  const double rangeDistanceThreshold = m_DynamicRangeUsed;
+  const double distanceToTableIndex = static_cast<double>(m_NumberOfRangeGaussianSamples) / m_DynamicRangeUsed;
+
+  // Setup
+  const auto          centerPixel = static_cast<OutputPixelRealType>(neighborhoodIt.GetCenterPixel());
+  OutputPixelRealType val = 0.0;
+  OutputPixelRealType normFactor = 0.0;
+
+  // Walk the neighborhood of the input and the kernel
+  typename TInputImage::IndexValueType i = 0;
+  const KernelConstIteratorType        kernelEnd = m_GaussianKernel.End();
+  for (KernelConstIteratorType k_it = m_GaussianKernel.Begin(); k_it < kernelEnd; ++k_it, ++i)
+  {
+    // range distance between neighborhood pixel and neighborhood center
+    const auto pixel = static_cast<OutputPixelRealType>(neighborhoodIt.GetPixel(i));
+    // flip sign if needed
+    const OutputPixelRealType rangeDistance = std::abs(pixel - centerPixel);
+
+    // if the range distance is close enough, then use the pixel
+    if (rangeDistance < rangeDistanceThreshold)
+    {
+      // look up the range gaussian in a table
+      const OutputPixelRealType tableArg = rangeDistance * distanceToTableIndex;
+      const OutputPixelRealType rangeGaussian = m_RangeGaussianTable[Math::Floor<SizeValueType>(tableArg)];
+
+      // normalization factor so filter integrates to one
+      // (product of the domain and the range gaussian)
+      const OutputPixelRealType gaussianProduct = (*k_it) * rangeGaussian;
+      normFactor += gaussianProduct;
+
+      // Input Image * Domain Gaussian * Range Gaussian
+      val += pixel * gaussianProduct;
+    }
+  }
+  // normalize the value
+  return val / normFactor;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  m_ApproximationError = 0.0;
+  m_MaximumApproximationError = 0.0;
+  m_BilateralGridUsed = false;
+  if (!m_UseBilateralGrid)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  this->AllocateOutputs();
+  this->BeforeThreadedGenerateData();
+
+  // The grid needs the dynamic range computed by BeforeThreadedGenerateData()
+  // to know its size.
+  GridCellSizeType cellSize;
+  GridSizeType     gridSize;
+  const double     gridMemorySize = this->ComputeBilateralGridGeometry(cellSize, gridSize);
+  if (gridMemorySize <= static_cast<double>(m_MaximumBilateralGridMemorySize))
+  {
+    m_BilateralGridUsed = true;
+    this->GenerateBilateralGridData();
+    this->ComputeApproximationError();
+    return;
+  }
+
+  itkDebugMacro("The bilateral grid would take " << gridMemorySize << " bytes, more than "
+                                                 << m_MaximumBilateralGridMemorySize << "; running the exact filter");
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->SetUpdateProgress(this->GetThreaderUpdateProgress());
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    this->GetOutput()->GetRequestedRegion(),
+    [this](const OutputImageRegionType & outputRegionForThread) {
+      this->DynamicThreadedGenerateData(outputRegionForThread);
+    },
+    this);
+}
+
+template <typename TInputImage, typename TOutputImage>
+double
+BilateralImageFilter<TInputImage, TOutputImage>::ComputeBilateralGridGeometry(GridCellSizeType & cellSize,
+                                                                              GridSizeType &     gridSize) const
+{
+  if (!(m_RangeSigma > 0.0))
+  {
+    itkExceptionMacro("RangeSigma must be positive with a bilateral grid, but is " << m_RangeSigma);
+  }
+
+  const InputImageType *                     input = this->GetInput();
+  const typename InputImageType::RegionType  inputRegion = input->GetRequestedRegion();
+  const typename InputImageType::SpacingType inputSpacing = input->GetSpacing();
+
+  // The cells are spaced by one sigma along each axis, but never by less
+  // than a pixel, and the grid is padded by one cell on both sides.
+  cellSize[0] = m_RangeSigma;
+  gridSize[0] = static_cast<SizeValueType>(m_DynamicRange / m_RangeSigma) + 3;
+  double numberOfCells = static_cast<double>(gridSize[0]);
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (!(m_DomainSigma[d] > 0.0))
+    {
+      itkExceptionMacro("DomainSigma must be positive with a bilateral grid, but is " << m_DomainSigma);
+    }
+    cellSize[d + 1] = std::max(m_DomainSigma[d] / inputSpacing[d], 1.0);
+    gridSize[d + 1] = static_cast<SizeValueType>((inputRegion.GetSize(d) - 1) / cellSize[d + 1]) + 3;
+    numberOfCells *= static_cast<double>(gridSize[d + 1]);
+  }
+
+  // Each cell holds two doubles.
+  return 2.0 * sizeof(double) * numberOfCells;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::GenerateBilateralGridData()
+{
+  const InputImageType *                     input = this->GetInput();
+  OutputImageType *                          output = this->GetOutput();
+  const typename InputImageType::RegionType  inputRegion = input->GetRequestedRegion();
+  const typename InputImageType::SpacingType inputSpacing = input->GetSpacing();
+
+  // The axis 0 of the grid is the range axis, and the axis d + 1 is the
+  // axis d of the image.
+  constexpr unsigned int GridDimension = ImageDimension + 1;
+  GridCellSizeType       cellSize;
+  GridSizeType           gridSize;
+  double                 blurWeight[GridDimension];
+  SizeValueType          gridStride[GridDimension];
+  this->ComputeBilateralGridGeometry(cellSize, gridSize);
+
+  SizeValueType numberOfCells = 1;
+  for (unsigned int a = 0; a < GridDimension; ++a)
+  {
+    gridStride[a] = numberOfCells;
+    numberOfCells *= gridSize[a];
+  }
+
+  // The multilinear splatting and slicing each blur the grid with a
+  // variance of 1/6 cell^2, so the grid itself is blurred with the 3-tap
+  // kernel [w, 1 - 2w, w] of variance 2w for the total variance to match
+  // the Gaussians.
+  blurWeight[0] = 1.0 / 3.0;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const double sigmaInCells = m_DomainSigma[d] / inputSpacing[d] / cellSize[d + 1];
+    blurWeight[d + 1] = std::max(0.5 * (sigmaInCells * sigmaInCells - 1.0 / 3.0), 0.0);
+  }
+
+  // Continuous grid coordinates of a pixel.
+  const auto gridCoordinates = [&](const typename InputImageType::IndexType & index,
+                                   const InputPixelType &                     value,
+                                   double                                     coordinates[GridDimension]) {
+    coordinates[0] = (static_cast<double>(value) - m_InputMinimum) / cellSize[0] + 1.0;
+    coordinates[0] = std::min(std::max(coordinates[0], 0.0), static_cast<double>(gridSize[0] - 2));
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      coordinates[d + 1] = static_cast<double>(index[d] - inputRegion.GetIndex(d)) / cellSize[d + 1] + 1.0;
+    }
+  };
+
+  // Each cell holds the sum of the weighted pixel values, and the sum of
+  // the weights.
+  std::vector<double> grid(2 * numberOfCells, 0.0);
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // Splat the pixels in the grid. The slabs of the last grid axis are
+  // splatted concurrently, each from the pixels within one cell of it, so
+  // that no cell is written by two threads.
+  constexpr unsigned int lastAxis = GridDimension - 1;
+  ProgressTransformer    splatProgress(0.0f, 0.4f, this);
+  multiThreader->ParallelizeArray(
+    0,
+    gridSize[lastAxis],
+    [&](SizeValueType slab) {
+      const double firstPosition = std::floor((static_cast<double>(slab) - 2.0) * cellSize[lastAxis]);
+      const double lastPosition = std::ceil(static_cast<double>(slab) * cellSize[lastAxis]);
+      const auto   numberOfPositions = static_cast<double>(inputRegion.GetSize(lastAxis - 1));
+      const auto   first = static_cast<IndexValueType>(std::max(firstPosition, 0.0));
+      const auto   last = static_cast<IndexValueType>(std::min(lastPosition, numberOfPositions - 1.0));
+      if (first > last)
+      {
+        return;
+      }
+      typename InputImageType::RegionType slabRegion = inputRegion;
+      slabRegion.SetIndex(lastAxis - 1, inputRegion.GetIndex(lastAxis - 1) + first);
+      slabRegion.SetSize(lastAxis - 1, static_cast<SizeValueType>(last - first + 1));
 
-      // Walk the neighborhood of the input and the kernel
-      for (i = 0, k_it = m_GaussianKernel.Begin(); k_it < kernelEnd; ++k_it, ++i)
+      double coordinates[GridDimension];
+      for (ImageRegionConstIteratorWithIndex<InputImageType> it(input, slabRegion); !it.IsAtEnd(); ++it)
       {
-        // range distance between neighborhood pixel and neighborhood center
-        pixel = static_cast<OutputPixelRealType>(b_iter.GetPixel(i));
-        // flip sign if needed
-        rangeDistance = std::abs(pixel - centerPixel);
+        const InputPixelType value = it.Get();
+        gridCoordinates(it.GetIndex(), value, coordinates);
+        const double slabWeight = 1.0 - std::abs(coordinates[lastAxis] - static_cast<double>(slab));
+        if (slabWeight <= 0.0)
+        {
+          continue;
+        }
 
-        // if the range distance is close enough, then use the pixel
-        if (rangeDistance < rangeDistanceThreshold)
+        SizeValueType base = slab * gridStride[lastAxis];
+        double        fraction[GridDimension];
+        for (unsigned int a = 0; a < lastAxis; ++a)
         {
-          // look up the range gaussian in a table
-          tableArg = rangeDistance * distanceToTableIndex;
-          rangeGaussian = m_RangeGaussianTable[Math::Floor<SizeValueType>(tableArg)];
+          const double cell = std::floor(coordinates[a]);
+          fraction[a] = coordinates[a] - cell;
+          base += static_cast<SizeValueType>(cell) * gridStride[a];
+        }
+        for (unsigned int corner = 0; corner < (1u << lastAxis); ++corner)
+        {
+          double        weight = slabWeight;
+          SizeValueType offset = base;
+          for (unsigned int a = 0; a < lastAxis; ++a)
+          {
+            if (corner & (1u << a))
+            {
+              weight *= fraction[a];
+              offset += gridStride[a];
+            }
+            else
+            {
+              weight *= 1.0 - fraction[a];
+            }
+          }
+          grid[2 * offset] += weight * static_cast<double>(value);
+          grid[2 * offset + 1] += weight;
+        }
+      }
+    },
+    splatProgress.GetProcessObject());
 
-          // normalization factor so filter integrates to one
-          // (product of the domain and the range gaussian)
-          gaussianProduct = (*k_it) * rangeGaussian;
-          normFactor += gaussianProduct;
+  // Blur the grid along each axis, line by line.
+  for (unsigned int a = 0; a < GridDimension; ++a)
+  {
+    const double weight = blurWeight[a];
+    if (weight <= 0.0)
+    {
+      continue;
+    }
+    const SizeValueType stride = gridStride[a];
+    const SizeValueType length = gridSize[a];
+    ProgressTransformer blurProgress(0.4f + 0.1f * a / GridDimension, 0.4f + 0.1f * (a + 1) / GridDimension, this);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfCells / length,
+      [&](SizeValueType line) {
+        const SizeValueType first = (line / stride) * stride * length + line % stride;
+        for (unsigned int component = 0; component < 2; ++component)
+        {
+          double previous = 0.0;
+          for (SizeValueType i = 0; i < length; ++i)
+          {
+            double &     current = grid[2 * (first + i * stride) + component];
+            const double next = i + 1 < length ? grid[2 * (first + (i + 1) * stride) + component] : 0.0;
+            const double value = current;
+            current = weight * (previous + next) + (1.0 - 2.0 * weight) * value;
+            previous = value;
+          }
+        }
+      },
+      blurProgress.GetProcessObject());
+  }
 
-          // Input Image * Domain Gaussian * Range Gaussian
-          val += pixel * gaussianProduct;
+  // Slice the grid at the pixels of the output.
+  ProgressTransformer sliceProgress(0.5f, 0.95f, this);
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    output->GetRequestedRegion(),
+    [&](const OutputImageRegionType & outputRegionForThread) {
+      ImageRegionConstIteratorWithIndex<InputImageType> inputIt(input, outputRegionForThread);
+      ImageRegionIterator<OutputImageType>              outputIt(output, outputRegionForThread);
+      double                                            coordinates[GridDimension];
+      double                                            fraction[GridDimension];
+      for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+      {
+        const InputPixelType value = inputIt.Get();
+        gridCoordinates(inputIt.GetIndex(), value, coordinates);
+        SizeValueType base = 0;
+        for (unsigned int a = 0; a < GridDimension; ++a)
+        {
+          const double cell = std::floor(coordinates[a]);
+          fraction[a] = coordinates[a] - cell;
+          base += static_cast<SizeValueType>(cell) * gridStride[a];
         }
+        double weightedSum = 0.0;
+        double sumOfWeights = 0.0;
+        for (unsigned int corner = 0; corner < (1u << GridDimension); ++corner)
+        {
+          double        weight = 1.0;
+          SizeValueType offset = base;
+          for (unsigned int a = 0; a < GridDimension; ++a)
+          {
+            if (corner & (1u << a))
+            {
+              weight *= fraction[a];
+              offset += gridStride[a];
+            }
+            else
+            {
+              weight *= 1.0 - fraction[a];
+            }
+          }
+          weightedSum += weight * grid[2 * offset];
+          sumOfWeights += weight * grid[2 * offset + 1];
+        }
+        const double filtered = sumOfWeights > 0.0 ? weightedSum / sumOfWeights : static_cast<double>(value);
+        outputIt.Set(static_cast<OutputPixelType>(filtered));
       }
-      // normalize the value
-      val /= normFactor;
+    },
+    sliceProgress.GetProcessObject());
+}
 
-      // store the filtered value
-      o_iter.Set(static_cast<OutputPixelType>(val));
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::ComputeApproximationError()
+{
+  if (m_NumberOfApproximationErrorSamples == 0)
+  {
+    return;
+  }
 
-      ++b_iter;
-      ++o_iter;
-      progress.CompletedPixel();
+  const InputImageType *        input = this->GetInput();
+  const OutputImageType *       output = this->GetOutput();
+  const OutputImageRegionType & region = output->GetRequestedRegion();
+  const SizeValueType           numberOfPixels = region.GetNumberOfPixels();
+  const SizeValueType step = std::max(numberOfPixels / m_NumberOfApproximationErrorSamples, SizeValueType{ 1 });
+
+  // Evaluate the exact filter as DynamicThreadedGenerateData() does.
+  ZeroFluxNeumannBoundaryCondition<TInputImage> BC;
+  NeighborhoodIteratorType neighborhoodIt(m_GaussianKernel.GetRadius(), input, input->GetRequestedRegion());
+  neighborhoodIt.OverrideBoundaryCondition(&BC);
+
+  double        sumOfSquares = 0.0;
+  SizeValueType numberOfSamples = 0;
+  for (SizeValueType sample = 0; sample < numberOfPixels; sample += step)
+  {
+    typename OutputImageType::IndexType index;
+    SizeValueType                       offset = sample;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      index[d] = region.GetIndex(d) + static_cast<IndexValueType>(offset % region.GetSize(d));
+      offset /= region.GetSize(d);
     }
+    neighborhoodIt.SetLocation(index);
+    const auto   exact = static_cast<double>(this->ComputeFilteredValue(neighborhoodIt));
+    const double difference = std::abs(static_cast<double>(output->GetPixel(index)) - exact);
+    sumOfSquares += difference * difference;
+    m_MaximumApproximationError = std::max(m_MaximumApproximationError, difference);
+    ++numberOfSamples;
   }
+  m_ApproximationError = std::sqrt(sumOfSquares / static_cast<double>(numberOfSamples));
+  this->UpdateProgress(1.0f);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -333,6 +648,12 @@ BilateralImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "UseBilateralGrid: " << (m_UseBilateralGrid ? "On" : "Off") << std::endl;
+  os << indent << "MaximumBilateralGridMemorySize: " << m_MaximumBilateralGridMemorySize << std::endl;
+  os << indent << "BilateralGridUsed: " << (m_BilateralGridUsed ? "true" : "false") << std::endl;
+  os << indent << "NumberOfApproximationErrorSamples: " << m_NumberOfApproximationErrorSamples << std::endl;
+  os << indent << "ApproximationError: " << m_ApproximationError << std::endl;
+  os << indent << "MaximumApproximationError: " << m_MaximumApproximationError << std::endl;
 }
 } // end namespace itk
 
@@ -18,6 +18,8 @@
 #ifndef itkHessianRecursiveGaussianImageFilter_hxx
 #define itkHessianRecursiveGaussianImageFilter_hxx
 
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkProgressAccumulator.h"
 
@@ -178,7 +180,9 @@ HessianRecursiveGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   const typename TInputImage::ConstPointer inputImage(this->GetInput());
 
-  m_ImageAdaptor->SetImage(this->GetOutput());
+  OutputImageType * outputImage = this->GetOutput();
+
+  m_ImageAdaptor->SetImage(outputImage);
 
   m_ImageAdaptor->SetLargestPossibleRegion(inputImage->GetLargestPossibleRegion());
 
@@ -293,25 +297,28 @@ HessianRecursiveGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
 
       // Copy the results to the corresponding component
       // on the output image of vectors
-      m_ImageAdaptor->SelectNthElement(element++);
-
-      ImageRegionIteratorWithIndex<RealImageType> it(derivativeImage, derivativeImage->GetRequestedRegion());
-
-      ImageRegionIteratorWithIndex<OutputImageAdaptorType> ot(m_ImageAdaptor, m_ImageAdaptor->GetRequestedRegion());
+      const unsigned int component = element++;
 
       const RealType spacingA = inputImage->GetSpacing()[dima];
       const RealType spacingB = inputImage->GetSpacing()[dimb];
 
       const RealType factor = spacingA * spacingB;
 
-      it.GoToBegin();
-      ot.GoToBegin();
-      while (!it.IsAtEnd())
-      {
-        ot.Set(it.Get() / factor);
-        ++it;
-        ++ot;
-      }
+      this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+        outputImage->GetRequestedRegion(),
+        [outputImage, &derivativeImage, component, factor](const typename OutputImageType::RegionType & region) {
+          ImageRegionConstIterator<RealImageType> it(derivativeImage, region);
+          ImageRegionIterator<OutputImageType>    ot(outputImage, region);
+          while (!it.IsAtEnd())
+          {
+            DefaultConvertPixelTraits<OutputPixelType>::SetNthComponent(
+              component, ot.Value(), static_cast<OutputComponentType>(it.Get() / factor));
+            ++it;
+            ++ot;
+          }
+        },
+        nullptr);
 
       derivativeImage->ReleaseData();
     }
@@ -18,14 +18,15 @@
 #ifndef itkHessianToObjectnessMeasureImageFilter_hxx
 #define itkHessianToObjectnessMeasureImageFilter_hxx
 
-#include "itkImageRegionIterator.h"
-#include "itkSymmetricEigenAnalysis.h"
+#include "itkImageScanlineIterator.h"
+#include "itkSymmetricEigenAnalysisClosedForm.h"
 #include "itkProgressReporter.h"
 #include "itkTotalProgressReporter.h"
 
 #include "itkMath.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -59,118 +60,145 @@ HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreade
 
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels(), 1000);
 
-  // Calculator for computation of the eigen values
-  using CalculatorType = SymmetricEigenAnalysisFixedDimension<ImageDimension, InputPixelType, EigenValueArrayType>;
+  // Calculator for computation of the eigen values; the eigen values of 2x2
+  // and 3x3 matrices have a closed form, computed a scanline at a time.
+  using ClosedFormCalculatorType =
+    SymmetricEigenAnalysisClosedForm<(ImageDimension == 2 ? 2 : 3), InputPixelType, EigenValueArrayType>;
+  using CalculatorType =
+    std::conditional_t<ImageDimension == 2 || ImageDimension == 3,
+                       ClosedFormCalculatorType,
+                       SymmetricEigenAnalysisFixedDimension<ImageDimension, InputPixelType, EigenValueArrayType>>;
   CalculatorType eigenCalculator;
 
+  std::vector<InputPixelType>      linePixels;
+  std::vector<EigenValueArrayType> lineEigenValues;
+
   // Walk the region of eigen values and get the objectness measure
-  ImageRegionConstIterator<InputImageType> it(input, outputRegionForThread);
-  ImageRegionIterator<OutputImageType>     oit(output, outputRegionForThread);
+  ImageScanlineConstIterator<InputImageType> it(input, outputRegionForThread);
+  ImageScanlineIterator<OutputImageType>     oit(output, outputRegionForThread);
 
   while (!it.IsAtEnd())
   {
-    // Compute eigen values
-    EigenValueArrayType eigenValues;
-    eigenCalculator.ComputeEigenValues(it.Get(), eigenValues);
-
-    // Sort the eigenvalues by magnitude but retain their sign.
-    // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
-    EigenValueArrayType sortedEigenValues = eigenValues;
-    std::sort(sortedEigenValues.Begin(), sortedEigenValues.End(), AbsLessCompare());
-
-    // Check whether eigenvalues have the right sign
-    bool signConstraintsSatisfied = true;
-    for (unsigned int i = m_ObjectDimension; i < ImageDimension; ++i)
-    {
-      if ((m_BrightObject && sortedEigenValues[i] > 0.0) || (!m_BrightObject && sortedEigenValues[i] < 0.0))
-      {
-        signConstraintsSatisfied = false;
-        break;
-      }
-    }
-
-    if (!signConstraintsSatisfied)
+    // Compute the eigen values of the scanline
+    linePixels.clear();
+    while (!it.IsAtEndOfLine())
     {
-      oit.Set(OutputPixelType{});
+      linePixels.push_back(it.Get());
       ++it;
-      ++oit;
-      progress.CompletedPixel();
-      continue;
     }
-
-    EigenValueArrayType sortedAbsEigenValues;
-    for (unsigned int i = 0; i < ImageDimension; ++i)
+    lineEigenValues.resize(linePixels.size());
+    if constexpr (ImageDimension == 2 || ImageDimension == 3)
     {
-      sortedAbsEigenValues[i] = itk::Math::abs(sortedEigenValues[i]);
+      eigenCalculator.ComputeEigenValues(linePixels.data(), lineEigenValues.data(), linePixels.size());
     }
-
-    // Initialize the objectness measure
-    double objectnessMeasure = 1.0;
-
-    // Compute objectness from eigenvalue ratios and second-order structureness
-    if (m_ObjectDimension < ImageDimension - 1)
+    else
     {
-      double rA = sortedAbsEigenValues[m_ObjectDimension];
-      double rADenominatorBase = 1.0;
-      for (unsigned int j = m_ObjectDimension + 1; j < ImageDimension; ++j)
+      for (size_t n = 0; n < linePixels.size(); ++n)
       {
-        rADenominatorBase *= sortedAbsEigenValues[j];
+        eigenCalculator.ComputeEigenValues(linePixels[n], lineEigenValues[n]);
       }
-      if (itk::Math::abs(rADenominatorBase) > 0.0)
+    }
+
+    for (const EigenValueArrayType & eigenValues : lineEigenValues)
+    {
+      // Sort the eigenvalues by magnitude but retain their sign.
+      // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
+      EigenValueArrayType sortedEigenValues = eigenValues;
+      std::sort(sortedEigenValues.Begin(), sortedEigenValues.End(), AbsLessCompare());
+
+      // Check whether eigenvalues have the right sign
+      bool signConstraintsSatisfied = true;
+      for (unsigned int i = m_ObjectDimension; i < ImageDimension; ++i)
       {
-        if (itk::Math::abs(m_Alpha) > 0.0)
+        if ((m_BrightObject && sortedEigenValues[i] > 0.0) || (!m_BrightObject && sortedEigenValues[i] < 0.0))
         {
-          rA /= std::pow(rADenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension - 1));
-          objectnessMeasure *= 1.0 - std::exp(-0.5 * itk::Math::sqr(rA) / itk::Math::sqr(m_Alpha));
+          signConstraintsSatisfied = false;
+          break;
         }
       }
-      else
+
+      if (!signConstraintsSatisfied)
       {
-        objectnessMeasure = 0.0;
+        oit.Set(OutputPixelType{});
+        ++oit;
+        continue;
       }
-    }
 
-    if (m_ObjectDimension > 0)
-    {
-      double rB = sortedAbsEigenValues[m_ObjectDimension - 1];
-      double rBDenominatorBase = 1.0;
-      for (unsigned int j = m_ObjectDimension; j < ImageDimension; ++j)
+      EigenValueArrayType sortedAbsEigenValues;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
       {
-        rBDenominatorBase *= sortedAbsEigenValues[j];
+        sortedAbsEigenValues[i] = itk::Math::abs(sortedEigenValues[i]);
+      }
+
+      // Initialize the objectness measure
+      double objectnessMeasure = 1.0;
+
+      // Compute objectness from eigenvalue ratios and second-order structureness
+      if (m_ObjectDimension < ImageDimension - 1)
+      {
+        double rA = sortedAbsEigenValues[m_ObjectDimension];
+        double rADenominatorBase = 1.0;
+        for (unsigned int j = m_ObjectDimension + 1; j < ImageDimension; ++j)
+        {
+          rADenominatorBase *= sortedAbsEigenValues[j];
+        }
+        if (itk::Math::abs(rADenominatorBase) > 0.0)
+        {
+          if (itk::Math::abs(m_Alpha) > 0.0)
+          {
+            rA /= std::pow(rADenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension - 1));
+            objectnessMeasure *= 1.0 - std::exp(-0.5 * itk::Math::sqr(rA) / itk::Math::sqr(m_Alpha));
+          }
+        }
+        else
+        {
+          objectnessMeasure = 0.0;
+        }
       }
-      if (itk::Math::abs(rBDenominatorBase) > 0.0 && itk::Math::abs(m_Beta) > 0.0)
+
+      if (m_ObjectDimension > 0)
       {
-        rB /= std::pow(rBDenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension));
+        double rB = sortedAbsEigenValues[m_ObjectDimension - 1];
+        double rBDenominatorBase = 1.0;
+        for (unsigned int j = m_ObjectDimension; j < ImageDimension; ++j)
+        {
+          rBDenominatorBase *= sortedAbsEigenValues[j];
+        }
+        if (itk::Math::abs(rBDenominatorBase) > 0.0 && itk::Math::abs(m_Beta) > 0.0)
+        {
+          rB /= std::pow(rBDenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension));
 
-        objectnessMeasure *= std::exp(-0.5 * itk::Math::sqr(rB) / itk::Math::sqr(m_Beta));
+          objectnessMeasure *= std::exp(-0.5 * itk::Math::sqr(rB) / itk::Math::sqr(m_Beta));
+        }
+        else
+        {
+          objectnessMeasure = 0.0;
+        }
       }
-      else
+
+      if (itk::Math::abs(m_Gamma) > 0.0)
       {
-        objectnessMeasure = 0.0;
+        double frobeniusNormSquared = 0.0;
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          frobeniusNormSquared += itk::Math::sqr(sortedAbsEigenValues[i]);
+        }
+        objectnessMeasure *= 1.0 - std::exp(-0.5 * frobeniusNormSquared / itk::Math::sqr(m_Gamma));
       }
-    }
 
-    if (itk::Math::abs(m_Gamma) > 0.0)
-    {
-      double frobeniusNormSquared = 0.0;
-      for (unsigned int i = 0; i < ImageDimension; ++i)
+      // Just in case, scale by largest absolute eigenvalue
+      if (m_ScaleObjectnessMeasure)
       {
-        frobeniusNormSquared += itk::Math::sqr(sortedAbsEigenValues[i]);
+        objectnessMeasure *= sortedAbsEigenValues[ImageDimension - 1];
       }
-      objectnessMeasure *= 1.0 - std::exp(-0.5 * frobeniusNormSquared / itk::Math::sqr(m_Gamma));
-    }
 
-    // Just in case, scale by largest absolute eigenvalue
-    if (m_ScaleObjectnessMeasure)
-    {
-      objectnessMeasure *= sortedAbsEigenValues[ImageDimension - 1];
+      oit.Set(static_cast<OutputPixelType>(objectnessMeasure));
+      ++oit;
     }
+    progress.Completed(lineEigenValues.size());
 
-    oit.Set(static_cast<OutputPixelType>(objectnessMeasure));
-
-    ++it;
-    ++oit;
-    progress.CompletedPixel();
+    it.NextLine();
+    oit.NextLine();
   }
 }
 
@@ -62,6 +62,15 @@ extern ITKImageFeature_EXPORT std::ostream &
  * The filter computes a second output image (accessed by the GetScalesOutput method)
  * containing the scales at which each pixel gave the best response.
  *
+ * The best response is accumulated directly in the output image, so that
+ * only the Hessian image of the current scale and the running maximum are
+ * kept in memory. The Hessian-based measure may further be evaluated in
+ * NumberOfStreamDivisions pieces of the Hessian image, each of which is merged
+ * into the running maximum before the next one is computed. This reduces the
+ * memory of the per-scale measure image, and gives the same result as long as
+ * the Hessian-based measure is evaluated pixel by pixel, as the
+ * HessianToObjectnessMeasureImageFilter is.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Generalizing vesselness with respect to dimensionality and shape"
@@ -117,9 +126,8 @@ public:
   /** Hessian computation filter. */
   using HessianFilterType = HessianRecursiveGaussianImageFilter<InputImageType, HessianImageType>;
 
-  /** Update image buffer that holds the best objectness response. This is not redundant from
-   the output image because the latter may not be of float type, which is required for the comparisons
-   between responses at different scales. */
+  /** Kept for backward compatibility. The best objectness response is accumulated in the output image, since the
+   responses at all scales are of the output pixel type. */
   using UpdateBufferType = Image<double, Self::ImageDimension>;
   using BufferValueType = typename UpdateBufferType::ValueType;
 
@@ -201,6 +209,12 @@ public:
   itkGetConstMacro(GenerateHessianOutput, bool);
   itkBooleanMacro(GenerateHessianOutput);
 
+  /** Set/Get the number of pieces in which the Hessian-based measure is
+   * evaluated at each scale. Defaults to 1, i.e., the measure of the whole
+   * image is computed at once. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
   /** This is overloaded to create the Scales and Hessian output images */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
 
@@ -222,15 +236,14 @@ protected:
   MakeOutput(DataObjectPointerArraySizeType idx) override;
 
 private:
+  /** Merge the response of the Hessian-based measure within the given region
+   * into the best response held by the output image. */
   void
-  UpdateMaximumResponse(double sigma);
+  UpdateMaximumResponse(double sigma, const OutputRegionType & region);
 
   double
   ComputeSigmaValue(int scaleLevel);
 
-  void
-  AllocateUpdateBuffer();
-
   bool m_NonNegativeHessianBasedMeasure{};
 
   double m_SigmaMinimum{};
@@ -243,10 +256,10 @@ private:
 
   typename HessianFilterType::Pointer m_HessianFilter{};
 
-  typename UpdateBufferType::Pointer m_UpdateBuffer{};
-
   bool m_GenerateScalesOutput{};
   bool m_GenerateHessianOutput{};
+
+  unsigned int m_NumberOfStreamDivisions{ 1 };
 };
 } // end namespace itk
 
@@ -19,6 +19,7 @@
 #define itkMultiScaleHessianBasedMeasureImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "itkMath.h"
 
 /*
@@ -48,9 +49,6 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   m_HessianFilter = HessianFilterType::New();
   m_HessianToMeasureFilter = nullptr;
 
-  // Instantiate Update buffer
-  m_UpdateBuffer = UpdateBufferType::New();
-
   m_GenerateScalesOutput = false;
   m_GenerateHessianOutput = false;
 
@@ -92,45 +90,27 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 void
-MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::AllocateUpdateBuffer()
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::GenerateData()
 {
-  /* The update buffer looks just like the output and holds the best response
-     in the  objectness measure */
-
-  typename TOutputImage::Pointer output = this->GetOutput();
-
-  // this copies meta data describing the output such as origin,
-  // spacing and the largest region
-  m_UpdateBuffer->CopyInformation(output);
-
-  m_UpdateBuffer->SetRequestedRegion(output->GetRequestedRegion());
-  m_UpdateBuffer->SetBufferedRegion(output->GetBufferedRegion());
-  m_UpdateBuffer->Allocate();
+  if (m_HessianToMeasureFilter.IsNull())
+  {
+    itkExceptionMacro(" HessianToMeasure filter is not set. Use SetHessianToMeasureFilter() ");
+  }
 
-  // Update buffer is used for > comparisons so make it really really small,
-  // just to be sure. Thanks to Hauke Heibel.
+  // TODO: Move the allocation to a derived AllocateOutputs method
+  // Allocate the output, which holds the best response over the scales
+  // computed so far. The responses are compared with the < operator, so
+  // start from the smallest possible response.
+  OutputImageType * output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
   if (m_NonNegativeHessianBasedMeasure)
   {
-    m_UpdateBuffer->FillBuffer(BufferValueType{});
+    output->FillBuffer(OutputPixelType{});
   }
   else
   {
-    m_UpdateBuffer->FillBuffer(itk::NumericTraits<BufferValueType>::NonpositiveMin());
-  }
-}
-
-template <typename TInputImage, typename THessianImage, typename TOutputImage>
-void
-MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::GenerateData()
-{
-  // TODO: Move the allocation to a derived AllocateOutputs method
-  // Allocate the output
-  this->GetOutput()->SetBufferedRegion(this->GetOutput()->GetRequestedRegion());
-  this->GetOutput()->Allocate();
-
-  if (m_HessianToMeasureFilter.IsNull())
-  {
-    itkExceptionMacro(" HessianToMeasure filter is not set. Use SetHessianToMeasureFilter() ");
+    output->FillBuffer(NumericTraits<OutputPixelType>::NonpositiveMin());
   }
 
   if (m_GenerateScalesOutput)
@@ -156,15 +136,20 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
     hessianImage->FillBuffer(zeroTensor);
   }
 
-  // Allocate the buffer
-  AllocateUpdateBuffer();
-
   typename InputImageType::ConstPointer input = this->GetInput();
 
   this->m_HessianFilter->SetInput(input);
 
   this->m_HessianFilter->SetNormalizeAcrossScale(true);
 
+  m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
+
+  // The measure is evaluated piece by piece, each piece being merged into the
+  // best response before the next one is computed.
+  const OutputRegionType outputRegion = output->GetBufferedRegion();
+  const auto             splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int     numberOfPieces = splitter->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
+
   // Create a process accumulator for tracking the progress of this
   // minipipeline
   auto progress = ProgressAccumulator::New();
@@ -174,7 +159,7 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   if (m_NumberOfSigmaSteps > 0)
   {
     progress->RegisterInternalFilter(this->m_HessianFilter, .5 / m_NumberOfSigmaSteps);
-    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / m_NumberOfSigmaSteps);
+    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / (m_NumberOfSigmaSteps * numberOfPieces));
   }
 
   for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
@@ -185,90 +170,88 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
     m_HessianFilter->SetSigma(sigma);
 
-    m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
-
-    m_HessianToMeasureFilter->Update();
-
-    this->UpdateMaximumResponse(sigma);
-  }
-
-  // Write out the best response to the output image
-  // we can assume that the meta-data should match between these two
-  // image, therefore we iterate over the desired output region
-  OutputRegionType                      outputRegion = this->GetOutput()->GetBufferedRegion();
-  ImageRegionIterator<UpdateBufferType> it(m_UpdateBuffer, outputRegion);
+    for (unsigned int piece = 0; piece < numberOfPieces; ++piece)
+    {
+      OutputRegionType pieceRegion = outputRegion;
+      splitter->GetSplit(piece, numberOfPieces, pieceRegion);
 
-  ImageRegionIterator<TOutputImage> oit(this->GetOutput(), outputRegion);
+      // The Hessian filter requires its largest possible region, so that the
+      // Hessian image is computed only once per scale.
+      m_HessianToMeasureFilter->GetOutput()->SetRequestedRegion(pieceRegion);
+      m_HessianToMeasureFilter->GetOutput()->Update();
 
-  while (!oit.IsAtEnd())
-  {
-    oit.Value() = static_cast<OutputPixelType>(it.Get());
-    ++oit;
-    ++it;
+      this->UpdateMaximumResponse(sigma, pieceRegion);
+    }
   }
 
-  // Release data from the update buffer.
-  m_UpdateBuffer->ReleaseData();
+  // Release the images of the last scale.
+  m_HessianFilter->GetOutput()->ReleaseData();
+  m_HessianToMeasureFilter->GetOutput()->ReleaseData();
 }
 
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 void
-MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(double sigma)
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(
+  double                   sigma,
+  const OutputRegionType & region)
 {
   // the meta-data should match between these images, therefore we
-  // iterate over the desired output region
-  OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
-
-  ImageRegionIterator<UpdateBufferType> oit(m_UpdateBuffer, outputRegion);
-
-  typename ScalesImageType::Pointer    scalesImage = static_cast<ScalesImageType *>(this->ProcessObject::GetOutput(1));
-  ImageRegionIterator<ScalesImageType> osit;
-
-  typename HessianImageType::Pointer hessianImage = static_cast<HessianImageType *>(this->ProcessObject::GetOutput(2));
-  ImageRegionIterator<HessianImageType> ohit;
-
-  if (m_GenerateScalesOutput)
-  {
-    osit = ImageRegionIterator<ScalesImageType>(scalesImage, outputRegion);
-    osit.GoToBegin();
-  }
-  if (m_GenerateHessianOutput)
-  {
-    ohit = ImageRegionIterator<HessianImageType>(hessianImage, outputRegion);
-    ohit.GoToBegin();
-  }
+  // iterate over the same region of each of them
+  OutputImageType *        output = this->GetOutput();
+  const OutputImageType *  response = m_HessianToMeasureFilter->GetOutput();
+  ScalesImageType *        scalesImage = static_cast<ScalesImageType *>(this->ProcessObject::GetOutput(1));
+  HessianImageType *       hessianImage = static_cast<HessianImageType *>(this->ProcessObject::GetOutput(2));
+  const HessianImageType * hessian = m_HessianFilter->GetOutput();
+  const auto               scale = static_cast<ScalesPixelType>(sigma);
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, output, response, scalesImage, hessianImage, hessian, scale](const OutputRegionType & regionForThread) {
+      ImageRegionIterator<OutputImageType>       oit(output, regionForThread);
+      ImageRegionConstIterator<OutputImageType>  it(response, regionForThread);
+      ImageRegionIterator<ScalesImageType>       osit;
+      ImageRegionIterator<HessianImageType>      ohit;
+      ImageRegionConstIterator<HessianImageType> hit;
 
-  using HessianToMeasureOutputImageType = typename HessianToMeasureFilterType::OutputImageType;
-
-  ImageRegionIterator<HessianToMeasureOutputImageType> it(m_HessianToMeasureFilter->GetOutput(), outputRegion);
-  ImageRegionIterator<HessianImageType>                hit(m_HessianFilter->GetOutput(), outputRegion);
-
-  while (!oit.IsAtEnd())
-  {
-    if (oit.Value() < it.Value())
-    {
-      oit.Value() = it.Value();
       if (m_GenerateScalesOutput)
       {
-        osit.Value() = static_cast<ScalesPixelType>(sigma);
+        osit = ImageRegionIterator<ScalesImageType>(scalesImage, regionForThread);
       }
       if (m_GenerateHessianOutput)
       {
-        ohit.Value() = hit.Value();
+        ohit = ImageRegionIterator<HessianImageType>(hessianImage, regionForThread);
+        hit = ImageRegionConstIterator<HessianImageType>(hessian, regionForThread);
       }
-    }
-    ++oit;
-    ++it;
-    if (m_GenerateScalesOutput)
-    {
-      ++osit;
-    }
-    if (m_GenerateHessianOutput)
-    {
-      ++ohit;
-      ++hit;
-    }
-  }
+
+      while (!oit.IsAtEnd())
+      {
+        if (oit.Value() < it.Value())
+        {
+          oit.Value() = it.Value();
+          if (m_GenerateScalesOutput)
+          {
+            osit.Value() = scale;
+          }
+          if (m_GenerateHessianOutput)
+          {
+            ohit.Value() = hit.Value();
+          }
+        }
+        ++oit;
+        ++it;
+        if (m_GenerateScalesOutput)
+        {
+          ++osit;
+        }
+        if (m_GenerateHessianOutput)
+        {
+          ++ohit;
+          ++hit;
+        }
+      }
+    },
+    nullptr);
 }
 
 
@@ -360,6 +343,7 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   os << indent << "NonNegativeHessianBasedMeasure:  " << m_NonNegativeHessianBasedMeasure << std::endl;
   os << indent << "GenerateScalesOutput: " << m_GenerateScalesOutput << std::endl;
   os << indent << "GenerateHessianOutput: " << m_GenerateHessianOutput << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 }
 } // end namespace itk
 
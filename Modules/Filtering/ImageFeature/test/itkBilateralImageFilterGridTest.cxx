@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBilateralImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Compare the bilateral grid with the exact filter on a noisy image made of
+// two flat regions separated by a step edge.
+template <unsigned int VDimension>
+int
+TestBilateralGrid(const itk::Size<VDimension> & size, double domainSigma, double rangeSigma)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using FilterType = itk::BilateralImageFilter<ImageType, ImageType>;
+
+  constexpr double step = 100.0;
+  constexpr double noise = 5.0;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double value = it.GetIndex()[0] < static_cast<itk::IndexValueType>(size[0] / 2) ? 0.0 : step;
+    it.Set(static_cast<float>(value + generator->GetNormalVariate(0.0, noise * noise)));
+  }
+
+  typename ImageType::Pointer outputs[2];
+  double                      approximationError = 0.0;
+  double                      maximumApproximationError = 0.0;
+  for (const bool useBilateralGrid : { false, true })
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetDomainSigma(domainSigma);
+    filter->SetRangeSigma(rangeSigma);
+    filter->SetUseBilateralGrid(useBilateralGrid);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+    ITK_TEST_EXPECT_EQUAL(filter->GetBilateralGridUsed(), useBilateralGrid);
+    outputs[useBilateralGrid] = filter->GetOutput();
+    approximationError = filter->GetApproximationError();
+    maximumApproximationError = filter->GetMaximumApproximationError();
+  }
+
+  // The difference to the exact filter over the whole image, away from the
+  // image boundary where the exact filter replicates the boundary pixels.
+  typename ImageType::RegionType interior = image->GetBufferedRegion();
+  interior.ShrinkByRadius(static_cast<itk::SizeValueType>(2.0 * domainSigma));
+  double sumOfSquares = 0.0;
+  double edgeJump = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(outputs[0], interior); !it.IsAtEnd(); ++it)
+  {
+    const double difference = it.Get() - outputs[1]->GetPixel(it.GetIndex());
+    sumOfSquares += difference * difference;
+  }
+  const double interiorError = std::sqrt(sumOfSquares / static_cast<double>(interior.GetNumberOfPixels()));
+
+  // The edge is preserved.
+  typename ImageType::IndexType left = interior.GetIndex();
+  left[0] = static_cast<itk::IndexValueType>(size[0] / 2) - 1;
+  typename ImageType::IndexType right = left;
+  right[0] += 1;
+  edgeJump = outputs[1]->GetPixel(right) - outputs[1]->GetPixel(left);
+
+  std::cout << "Dimension " << VDimension << ", domain sigma " << domainSigma << ", range sigma " << rangeSigma
+            << ": interior error " << interiorError << ", estimated error " << approximationError
+            << ", maximum estimated error " << maximumApproximationError << ", edge jump " << edgeJump << std::endl;
+
+  if (interiorError > 0.1 * noise || approximationError <= 0.0 || approximationError > noise ||
+      maximumApproximationError < approximationError || edgeJump < 0.9 * step)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The bilateral grid is not close enough to the exact filter." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkBilateralImageFilterGridTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::BilateralImageFilter<ImageType, ImageType>;
+
+  auto filter = FilterType::New();
+  ITK_TEST_EXPECT_TRUE(!filter->GetUseBilateralGrid());
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseBilateralGrid, true);
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfApproximationErrorSamples(), 1000u);
+  filter->SetNumberOfApproximationErrorSamples(500);
+  ITK_TEST_SET_GET_VALUE(500u, filter->GetNumberOfApproximationErrorSamples());
+  ITK_TEST_EXPECT_EQUAL(filter->GetMaximumBilateralGridMemorySize(), itk::SizeValueType{ 1 } << 30);
+
+  bool testPassed = true;
+  testPassed &= TestBilateralGrid<2>(itk::Size<2>{ { 120, 90 } }, 4.0, 20.0) == EXIT_SUCCESS;
+  testPassed &= TestBilateralGrid<2>(itk::Size<2>{ { 120, 90 } }, 1.5, 10.0) == EXIT_SUCCESS;
+  testPassed &= TestBilateralGrid<3>(itk::Size<3>{ { 40, 30, 20 } }, 3.0, 20.0) == EXIT_SUCCESS;
+
+  // When the grid would exceed its memory cap, the exact filter is run
+  // instead.
+  auto image = ImageType::New();
+  image->SetRegions(itk::Size<2>{ { 8, 8 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(10 * it.GetIndex()[0] + it.GetIndex()[1]));
+  }
+  auto exactFilter = FilterType::New();
+  exactFilter->SetInput(image);
+  exactFilter->SetDomainSigma(1.0);
+  exactFilter->SetRangeSigma(5.0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(exactFilter->Update());
+  filter->SetInput(image);
+  filter->SetDomainSigma(1.0);
+  filter->SetRangeSigma(5.0);
+  filter->SetMaximumBilateralGridMemorySize(1000);
+  ITK_TEST_SET_GET_VALUE(1000u, filter->GetMaximumBilateralGridMemorySize());
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_TRUE(!filter->GetBilateralGridUsed());
+  ITK_TEST_EXPECT_EQUAL(filter->GetApproximationError(), 0.0);
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(exactFilter->GetOutput(), image->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(filter->GetOutput()->GetPixel(it.GetIndex()), it.Get());
+  }
+
+  // The range sigma must be positive.
+  filter->SetRangeSigma(0.0);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
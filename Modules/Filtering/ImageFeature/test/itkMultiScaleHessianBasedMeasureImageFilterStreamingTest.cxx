@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHessianToObjectnessMeasureImageFilter.h"
+#include "itkMultiScaleHessianBasedMeasureImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Enhance noisy tubes of different radii, evaluating the measure in one or
+// several pieces, and compare the best responses, scales and Hessians with
+// those of an explicit loop over the scales.
+template <unsigned int VDimension>
+int
+TestStreamedMeasure(const itk::Size<VDimension> & size, bool nonNegativeHessianBasedMeasure)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using HessianImageType = itk::Image<itk::SymmetricSecondRankTensor<double, VDimension>, VDimension>;
+  using ObjectnessFilterType = itk::HessianToObjectnessMeasureImageFilter<HessianImageType, ImageType>;
+  using FilterType = itk::MultiScaleHessianBasedMeasureImageFilter<ImageType, HessianImageType, ImageType>;
+  using HessianFilterType = typename FilterType::HessianFilterType;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    // Tubes along the first axis, whose radius grows with the last index.
+    const double x = it.GetIndex()[1] % 16 - 7.5;
+    const double radius = 1.0 + 3.0 * it.GetIndex()[VDimension - 1] / size[VDimension - 1];
+    const double value = std::abs(x) < radius ? 100.0 : 0.0;
+    it.Set(static_cast<float>(value + generator->GetNormalVariate(0.0, 25.0)));
+  }
+
+  constexpr double       sigmaMinimum = 0.5;
+  constexpr double       sigmaMaximum = 4.0;
+  constexpr unsigned int numberOfSigmaSteps = 4;
+
+  auto objectnessFilter = ObjectnessFilterType::New();
+  objectnessFilter->SetBrightObject(true);
+  objectnessFilter->SetObjectDimension(1);
+  objectnessFilter->SetScaleObjectnessMeasure(!nonNegativeHessianBasedMeasure);
+
+  // Reference: the best response over an explicit loop over the scales.
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetHessianToMeasureFilter(objectnessFilter);
+  filter->SetSigmaMinimum(sigmaMinimum);
+  filter->SetSigmaMaximum(sigmaMaximum);
+  filter->SetNumberOfSigmaSteps(numberOfSigmaSteps);
+  filter->SetNonNegativeHessianBasedMeasure(nonNegativeHessianBasedMeasure);
+  filter->GenerateScalesOutputOn();
+  filter->GenerateHessianOutputOn();
+
+  auto hessianFilter = HessianFilterType::New();
+  hessianFilter->SetInput(image);
+  hessianFilter->SetNormalizeAcrossScale(true);
+  auto referenceObjectnessFilter = ObjectnessFilterType::New();
+  referenceObjectnessFilter->SetBrightObject(true);
+  referenceObjectnessFilter->SetObjectDimension(1);
+  referenceObjectnessFilter->SetScaleObjectnessMeasure(!nonNegativeHessianBasedMeasure);
+  referenceObjectnessFilter->SetInput(hessianFilter->GetOutput());
+
+  auto referenceImage = ImageType::New();
+  referenceImage->SetRegions(size);
+  referenceImage->Allocate();
+  referenceImage->FillBuffer(nonNegativeHessianBasedMeasure ? 0.0f : itk::NumericTraits<float>::NonpositiveMin());
+  auto referenceScales = FilterType::ScalesImageType::New();
+  referenceScales->SetRegions(size);
+  referenceScales->AllocateInitialized();
+  auto referenceHessian = HessianImageType::New();
+  referenceHessian->SetRegions(size);
+  referenceHessian->Allocate();
+  referenceHessian->FillBuffer(typename HessianImageType::PixelType(0.0));
+  for (unsigned int scaleLevel = 0; scaleLevel < numberOfSigmaSteps; ++scaleLevel)
+  {
+    const double sigma =
+      std::exp(std::log(sigmaMinimum) + scaleLevel * (std::log(sigmaMaximum) - std::log(sigmaMinimum)) /
+                                          (numberOfSigmaSteps - 1));
+    hessianFilter->SetSigma(sigma);
+    ITK_TRY_EXPECT_NO_EXCEPTION(referenceObjectnessFilter->Update());
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(referenceImage, referenceImage->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      const float response = referenceObjectnessFilter->GetOutput()->GetPixel(it.GetIndex());
+      if (it.Get() < response)
+      {
+        it.Set(response);
+        referenceScales->SetPixel(it.GetIndex(), static_cast<float>(sigma));
+        referenceHessian->SetPixel(it.GetIndex(), hessianFilter->GetOutput()->GetPixel(it.GetIndex()));
+      }
+    }
+  }
+
+  for (const unsigned int numberOfStreamDivisions : { 1, 3 })
+  {
+    filter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(filter->GetOutput(), referenceImage->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      const typename ImageType::IndexType & index = it.GetIndex();
+      if (it.Get() != referenceImage->GetPixel(index) ||
+          filter->GetScalesOutput()->GetPixel(index) != referenceScales->GetPixel(index) ||
+          filter->GetHessianOutput()->GetPixel(index) != referenceHessian->GetPixel(index))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Dimension " << VDimension << ", " << numberOfStreamDivisions
+                  << " stream divisions: the best response differs at " << index << ": " << it.Get()
+                  << " instead of " << referenceImage->GetPixel(index) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMultiScaleHessianBasedMeasureImageFilterStreamingTest(int, char *[])
+{
+  using FilterType = itk::MultiScaleHessianBasedMeasureImageFilter<
+    itk::Image<float, 2>,
+    itk::Image<itk::SymmetricSecondRankTensor<double, 2>, 2>,
+    itk::Image<float, 2>>;
+
+  auto filter = FilterType::New();
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfStreamDivisions(), 1u);
+  ITK_TEST_SET_GET_VALUE(4u, (filter->SetNumberOfStreamDivisions(4), filter->GetNumberOfStreamDivisions()));
+  filter->SetNumberOfStreamDivisions(0);
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfStreamDivisions(), 1u);
+
+  bool testPassed = true;
+  for (const bool nonNegativeHessianBasedMeasure : { true, false })
+  {
+    testPassed &= TestStreamedMeasure<2>(itk::Size<2>{ { 48, 40 } }, nonNegativeHessianBasedMeasure) == EXIT_SUCCESS;
+    testPassed &=
+      TestStreamedMeasure<3>(itk::Size<3>{ { 20, 24, 18 } }, nonNegativeHessianBasedMeasure) == EXIT_SUCCESS;
+  }
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
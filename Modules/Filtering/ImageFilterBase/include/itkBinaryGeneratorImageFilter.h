@@ -18,6 +18,7 @@
 #ifndef itkBinaryGeneratorImageFilter_h
 #define itkBinaryGeneratorImageFilter_h
 
+#include "itkBatchFunctor.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
 
@@ -186,6 +186,63 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  constexpr bool hasBatchOperator =
+    Functor::HasBinaryBatchOperator<TFunctor, Input1ImagePixelType, Input2ImagePixelType, OutputImagePixelType>::value;
+
+  if constexpr (ImageScanlineBatch::IsSupported<TInputImage1, TInputImage2, TOutputImage> &&
+                TInputImage1::ImageDimension == TOutputImage::ImageDimension &&
+                TInputImage2::ImageDimension == TOutputImage::ImageDimension && hasBatchOperator)
+  {
+    // The lines of the region are contiguous in the buffers: pass them to the
+    // batch overloads of the functor.
+    if (inputPtr1 && inputPtr2)
+    {
+      ImageScanlineBatch::ForEachScanline(
+        outputRegionForThread,
+        [&functor, &progress](const SizeValueType                lineLength,
+                              OutputImagePixelType * const       outputLine,
+                              const Input1ImagePixelType * const inputLine1,
+                              const Input2ImagePixelType * const inputLine2) {
+          functor(inputLine1, inputLine2, outputLine, lineLength);
+          progress.Completed(lineLength);
+        },
+        *outputPtr,
+        *inputPtr1,
+        *inputPtr2);
+      return;
+    }
+    if (inputPtr1)
+    {
+      const Input2ImagePixelType & input2Value = this->GetConstant2();
+      ImageScanlineBatch::ForEachScanline(
+        outputRegionForThread,
+        [&functor, &progress, &input2Value](const SizeValueType                lineLength,
+                                            OutputImagePixelType * const       outputLine,
+                                            const Input1ImagePixelType * const inputLine1) {
+          functor(inputLine1, input2Value, outputLine, lineLength);
+          progress.Completed(lineLength);
+        },
+        *outputPtr,
+        *inputPtr1);
+      return;
+    }
+    if (inputPtr2)
+    {
+      const Input1ImagePixelType & input1Value = this->GetConstant1();
+      ImageScanlineBatch::ForEachScanline(
+        outputRegionForThread,
+        [&functor, &progress, &input1Value](const SizeValueType                lineLength,
+                                            OutputImagePixelType * const       outputLine,
+                                            const Input2ImagePixelType * const inputLine2) {
+          functor(input1Value, inputLine2, outputLine, lineLength);
+          progress.Completed(lineLength);
+        },
+        *outputPtr,
+        *inputPtr2);
+      return;
+    }
+  }
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
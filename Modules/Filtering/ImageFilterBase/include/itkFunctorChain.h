@@ -0,0 +1,292 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFunctorChain_h
+#define itkFunctorChain_h
+
+#include "itkBatchFunctor.h"
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class FunctorChain
+ * \brief A pixel functor which applies a sequence of pixel functors, each one
+ * to the value of the previous one.
+ *
+ * The first functor takes the input pixels of the filter, so that it may be
+ * a unary, binary, ternary or n-ary functor, and the other functors are
+ * unary. A filter with a FunctorChain computes the pixels of a sequence of
+ * pixel-wise filters in a single pass over the images, without allocating
+ * the intermediate images. For instance, the z-score normalization and
+ * intensity windowing of an image
+   \code
+   auto filter = itk::UnaryGeneratorImageFilter<InputImageType, OutputImageType>::New();
+   filter->SetInput(image);
+   filter->SetFunctor(itk::Functor::MakeFunctorChain(
+     [mean, sigma](const InputPixelType x) { return (static_cast<float>(x) - mean) / sigma; },
+     clampFilter->GetFunctor(),
+     [](const float x) { return static_cast<OutputPixelType>(255.0f * x); }));
+   \endcode
+ * replaces a SubtractImageFilter, a DivideImageFilter, a ClampImageFilter and
+ * a CastImageFilter. The functors of UnaryFunctorImageFilter,
+ * BinaryFunctorImageFilter and NaryFunctorImageFilter instances can be
+ * chained with their GetFunctor() member function.
+ *
+ * FunctorChain also provides the batch overloads of itkBatchFunctor.h. They
+ * pass the pixels through the functors in batches of BatchSize pixels, which
+ * are held in arrays on the stack between the functors, with the batch
+ * overloads of the functors that have them.
+ *
+ * \sa MakeFunctorChain
+ * \sa UnaryGeneratorImageFilter BinaryGeneratorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFirstFunctor, typename... TFunctors>
+class FunctorChain
+{
+public:
+  /** The number of pixels that pass through the functors at once in the
+   * batch overloads. */
+  static constexpr SizeValueType BatchSize = 256;
+
+  static constexpr unsigned int NumberOfFunctors = 1 + sizeof...(TFunctors);
+
+  FunctorChain() = default;
+
+  explicit FunctorChain(const TFirstFunctor & firstFunctor, const TFunctors &... functors)
+    : m_Functors(firstFunctor, functors...)
+  {}
+
+  /** Get the functor with the index in the chain, for instance to set its
+   * parameters. */
+  template <unsigned int VIndex>
+  auto &
+  GetFunctor()
+  {
+    return std::get<VIndex>(m_Functors);
+  }
+  template <unsigned int VIndex>
+  const auto &
+  GetFunctor() const
+  {
+    return std::get<VIndex>(m_Functors);
+  }
+
+  bool
+  operator==(const FunctorChain & other) const
+  {
+    return m_Functors == other.m_Functors;
+  }
+
+  ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(FunctorChain);
+
+  /** Apply the functors to the input pixels. */
+  template <typename... TInputs,
+            typename = std::enable_if_t<std::is_invocable_v<const TFirstFunctor &, const TInputs &...>>>
+  auto
+  operator()(const TInputs &... inputs) const
+  {
+    return ApplyFunctors<1>(std::get<0>(m_Functors)(inputs...));
+  }
+
+  /** Batch overloads of a unary functor and of a binary functor. */
+  template <typename TInput,
+            typename TOutput,
+            typename = std::enable_if_t<std::is_invocable_v<const TFirstFunctor &, const TInput &>>>
+  void
+  operator()(const TInput * input, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    ApplyInBatches(output, numberOfPixels, ArrayArgument<TInput>{ input });
+  }
+  template <typename TInput1,
+            typename TInput2,
+            typename TOutput,
+            typename = std::enable_if_t<std::is_invocable_v<const TFirstFunctor &, const TInput1 &, const TInput2 &>>>
+  void
+  operator()(const TInput1 * input1, const TInput2 * input2, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    ApplyInBatches(output, numberOfPixels, ArrayArgument<TInput1>{ input1 }, ArrayArgument<TInput2>{ input2 });
+  }
+  template <typename TInput1,
+            typename TInput2,
+            typename TOutput,
+            typename = std::enable_if_t<std::is_invocable_v<const TFirstFunctor &, const TInput1 &, const TInput2 &>>>
+  void
+  operator()(const TInput1 * input1, const TInput2 & constant2, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    ApplyInBatches(output, numberOfPixels, ArrayArgument<TInput1>{ input1 }, ConstantArgument<TInput2>{ constant2 });
+  }
+  template <typename TInput1,
+            typename TInput2,
+            typename TOutput,
+            typename = std::enable_if_t<std::is_invocable_v<const TFirstFunctor &, const TInput1 &, const TInput2 &>>>
+  void
+  operator()(const TInput1 & constant1, const TInput2 * input2, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    ApplyInBatches(output, numberOfPixels, ConstantArgument<TInput1>{ constant1 }, ArrayArgument<TInput2>{ input2 });
+  }
+
+private:
+  using FunctorTupleType = std::tuple<TFirstFunctor, TFunctors...>;
+
+  /** An argument of the first functor in the batch overloads: an array of
+   * pixels, or a constant. */
+  template <typename TValue>
+  struct ArrayArgument
+  {
+    using ValueType = TValue;
+
+    const TValue * m_Pointer;
+
+    const TValue &
+    Get(const SizeValueType i) const
+    {
+      return m_Pointer[i];
+    }
+
+    const TValue *
+    GetBatch() const
+    {
+      return m_Pointer;
+    }
+
+    ArrayArgument
+    Shift(const SizeValueType offset) const
+    {
+      return { m_Pointer + offset };
+    }
+  };
+
+  template <typename TValue>
+  struct ConstantArgument
+  {
+    using ValueType = TValue;
+
+    TValue m_Value;
+
+    const TValue &
+    Get(SizeValueType) const
+    {
+      return m_Value;
+    }
+
+    const TValue &
+    GetBatch() const
+    {
+      return m_Value;
+    }
+
+    ConstantArgument
+    Shift(SizeValueType) const
+    {
+      return *this;
+    }
+  };
+
+  template <unsigned int VIndex, typename TValue>
+  auto
+  ApplyFunctors(const TValue & value) const
+  {
+    if constexpr (VIndex == NumberOfFunctors)
+    {
+      return value;
+    }
+    else
+    {
+      return ApplyFunctors<VIndex + 1>(std::get<VIndex>(m_Functors)(value));
+    }
+  }
+
+  template <typename TOutput, typename... TArguments>
+  void
+  ApplyInBatches(TOutput * output, const SizeValueType numberOfPixels, const TArguments &... arguments) const
+  {
+    for (SizeValueType offset = 0; offset < numberOfPixels; offset += BatchSize)
+    {
+      ApplyBatch<0>(output + offset, std::min(BatchSize, numberOfPixels - offset), arguments.Shift(offset)...);
+    }
+  }
+
+  /** Apply the functors from VIndex on to a batch of pixels, holding the
+   * values between the functors in arrays on the stack. */
+  template <unsigned int VIndex, typename TOutput, typename... TArguments>
+  void
+  ApplyBatch(TOutput * output, const SizeValueType count, const TArguments &... arguments) const
+  {
+    const auto & functor = std::get<VIndex>(m_Functors);
+
+    if constexpr (VIndex + 1 == NumberOfFunctors)
+    {
+      ApplyFunctor(functor, output, count, arguments...);
+    }
+    else
+    {
+      using FunctorType = std::tuple_element_t<VIndex, FunctorTupleType>;
+      using ValueType =
+        std::decay_t<std::invoke_result_t<const FunctorType &, const typename TArguments::ValueType &...>>;
+
+      ValueType values[BatchSize];
+      ApplyFunctor(functor, values, count, arguments...);
+      ApplyBatch<VIndex + 1>(output, count, ArrayArgument<ValueType>{ values });
+    }
+  }
+
+  /** Apply a functor to a batch of pixels, with its batch overload if it has
+   * one. */
+  template <typename TFunctor, typename TOutput, typename... TArguments>
+  static void
+  ApplyFunctor(const TFunctor & functor, TOutput * output, const SizeValueType count, const TArguments &... arguments)
+  {
+    if constexpr (std::is_invocable_v<const TFunctor &,
+                                      decltype(std::declval<const TArguments &>().GetBatch())...,
+                                      TOutput *,
+                                      SizeValueType>)
+    {
+      functor(arguments.GetBatch()..., output, count);
+    }
+    else
+    {
+      const TFunctor localFunctor = functor;
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        output[i] = localFunctor(arguments.Get(i)...);
+      }
+    }
+  }
+
+  FunctorTupleType m_Functors{};
+};
+
+
+/** Create a FunctorChain which applies the functors in the specified order.
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFirstFunctor, typename... TFunctors>
+FunctorChain<TFirstFunctor, TFunctors...>
+MakeFunctorChain(const TFirstFunctor & firstFunctor, const TFunctors &... functors)
+{
+  return FunctorChain<TFirstFunctor, TFunctors...>(firstFunctor, functors...);
+}
+} // end namespace Functor
+} // end namespace itk
+
+#endif
@@ -19,12 +19,17 @@
 #define itkNeighborhoodOperatorImageFilter_hxx
 
 
+#include "itkConstantBoundaryCondition.h"
+#include "itkConstantBoundaryImageNeighborhoodPixelAccessPolicy.h"
+#include "itkImageNeighborhoodAlgorithm.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionIterator.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkTotalProgressReporter.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage, typename TOperatorValueType>
@@ -78,15 +83,77 @@ void
 NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  // The zero-flux Neumann and constant boundary conditions have equivalent
+  // pixel access policies, with which ImageNeighborhoodAlgorithm reads the
+  // non-boundary region without bounds checks. Their subclasses may extend
+  // the image differently.
+  const std::type_info & boundaryConditionType = typeid(*m_BoundsCondition);
+  const auto * const     zeroFluxNeumannCondition =
+    boundaryConditionType == typeid(ZeroFluxNeumannBoundaryCondition<InputImageType>)
+      ? static_cast<const ZeroFluxNeumannBoundaryCondition<InputImageType> *>(m_BoundsCondition)
+      : nullptr;
+  const auto * const     constantCondition =
+    boundaryConditionType == typeid(ConstantBoundaryCondition<InputImageType>)
+      ? static_cast<const ConstantBoundaryCondition<InputImageType> *>(m_BoundsCondition)
+      : nullptr;
+
+  if (zeroFluxNeumannCondition || constantCondition)
+  {
+    using InputPixelRealType = typename NumericTraits<InputPixelType>::RealType;
+    using AccumulateRealType = typename NumericTraits<InputPixelRealType>::AccumulateType;
+    using ComputingPixelValueType = typename NumericTraits<ComputingPixelType>::ValueType;
+
+    // Same arithmetic as NeighborhoodInnerProduct.
+    const unsigned int                       neighborhoodSize = m_Operator.Size();
+    std::vector<Offset<InputImageDimension>> neighborhoodOffsets(neighborhoodSize);
+    std::vector<ComputingPixelValueType>     coefficients(neighborhoodSize);
+    for (unsigned int i = 0; i < neighborhoodSize; ++i)
+    {
+      neighborhoodOffsets[i] = m_Operator.GetOffset(i);
+      coefficients[i] = static_cast<ComputingPixelValueType>(m_Operator[i]);
+    }
+
+    const auto innerProduct = [&coefficients](const auto & neighborhood) {
+      AccumulateRealType sum{};
+      auto               coefficient = coefficients.cbegin();
+      for (const InputPixelType pixel : neighborhood)
+      {
+        sum += static_cast<AccumulateRealType>(*coefficient * static_cast<InputPixelRealType>(pixel));
+        ++coefficient;
+      }
+      return static_cast<OutputPixelType>(static_cast<ComputingPixelType>(sum));
+    };
+
+    if (zeroFluxNeumannCondition)
+    {
+      ImageNeighborhoodAlgorithm::Transform(
+        *input, *output, outputRegionForThread, neighborhoodOffsets, innerProduct, &progress);
+    }
+    else
+    {
+      ImageNeighborhoodAlgorithm::Transform<ConstantBoundaryImageNeighborhoodPixelAccessPolicy>(
+        *input,
+        *output,
+        outputRegionForThread,
+        neighborhoodOffsets,
+        innerProduct,
+        &progress,
+        constantCondition->GetConstant());
+    }
+    return;
+  }
+
   using BFC = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>;
   using FaceListType = typename BFC::FaceListType;
 
   NeighborhoodInnerProduct<InputImageType, OperatorValueType, ComputingPixelType> smartInnerProduct;
   BFC                                                                             faceCalculator;
 
-  OutputImageType *      output = this->GetOutput();
-  const InputImageType * input = this->GetInput();
-
   // Break the input into a series of regions.  The first region is free
   // of boundary conditions, the rest with boundary conditions. Note,
   // we pass in the input image and the OUTPUT requested region. We are
@@ -96,8 +163,6 @@ NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::
 
   ImageRegionIterator<OutputImageType> it;
 
-  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
-
   // Process non-boundary region and each of the boundary faces.
   // These are N-d regions which border the edge of the buffer.
   ConstNeighborhoodIterator<InputImageType> bit;
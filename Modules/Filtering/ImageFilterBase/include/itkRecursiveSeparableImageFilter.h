@@ -140,6 +140,22 @@ protected:
   void
   FilterDataArray(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
 
+  /** Apply the Recursive Filter to numberOfLines interleaved arrays of data:
+   * element i of line l is at index i * numberOfLines + l of the parameters
+   * "outs", "data" and "scratch". Each line is filtered as by
+   * FilterDataArray(), with the lines in the innermost loop so that they are
+   * processed together. */
+  void
+  FilterDataBlock(RealType *       outs,
+                  const RealType * data,
+                  RealType *       scratch,
+                  SizeValueType    ln,
+                  unsigned int     numberOfLines) const;
+
+  /** Number of lines filtered together along the directions other than the
+   * first one, where the lines are not contiguous in memory. */
+  static constexpr unsigned int NumberOfLinesPerBlock = 8;
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0{};
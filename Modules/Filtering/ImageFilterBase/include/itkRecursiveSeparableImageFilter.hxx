@@ -20,8 +20,12 @@
 
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 #include "itkMakeUniqueForOverwrite.h"
 
+#include <algorithm>
+#include <type_traits>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -165,6 +169,147 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to interleaved lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataBlock(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln,
+                                                                          const unsigned int     numberOfLines) const
+{
+  const SizeValueType n = numberOfLines;
+
+  RealType * const scratch1 = outs;
+  RealType * const scratch2 = scratch;
+
+  /**
+   * Causal direction pass, initializing the borders as FilterDataArray()
+   */
+  for (SizeValueType l = 0; l < n; ++l)
+  {
+    const RealType & outV1 = data[l];
+
+    MathEMAMAMAM(scratch1[l], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(scratch1[n + l], data[n + l], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(scratch1[2 * n + l], data[2 * n + l], m_N0, data[n + l], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(
+      scratch1[3 * n + l], data[3 * n + l], m_N0, data[2 * n + l], m_N1, data[n + l], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(scratch1[l], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[n + l], scratch1[l], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[2 * n + l], scratch1[n + l], m_D1, scratch1[l], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(
+      scratch1[3 * n + l], scratch1[2 * n + l], m_D1, scratch1[n + l], m_D2, scratch1[l], m_D3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    const SizeValueType k = i * n;
+    for (SizeValueType l = 0; l < n; ++l)
+    {
+      MathEMAMAMAM(scratch1[k + l],
+                   data[k + l],
+                   m_N0,
+                   data[k - n + l],
+                   m_N1,
+                   data[k - 2 * n + l],
+                   m_N2,
+                   data[k - 3 * n + l],
+                   m_N3);
+      MathSMAMAMAM(scratch1[k + l],
+                   scratch1[k - n + l],
+                   m_D1,
+                   scratch1[k - 2 * n + l],
+                   m_D2,
+                   scratch1[k - 3 * n + l],
+                   m_D3,
+                   scratch1[k - 4 * n + l],
+                   m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  const SizeValueType last = (ln - 1) * n;
+  for (SizeValueType l = 0; l < n; ++l)
+  {
+    const RealType & outV2 = data[last + l];
+
+    MathEMAMAMAM(scratch2[last + l], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch2[last - n + l], data[last + l], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(
+      scratch2[last - 2 * n + l], data[last - n + l], m_M1, data[last + l], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch2[last - 3 * n + l],
+                 data[last - 2 * n + l],
+                 m_M1,
+                 data[last - n + l],
+                 m_M2,
+                 data[last + l],
+                 m_M3,
+                 outV2,
+                 m_M4);
+
+    MathSMAMAMAM(scratch2[last + l], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch2[last - n + l], scratch2[last + l], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch2[last - 2 * n + l],
+                 scratch2[last - n + l],
+                 m_D1,
+                 scratch2[last + l],
+                 m_D2,
+                 outV2,
+                 m_BM3,
+                 outV2,
+                 m_BM4);
+    MathSMAMAMAM(scratch2[last - 3 * n + l],
+                 scratch2[last - 2 * n + l],
+                 m_D1,
+                 scratch2[last - n + l],
+                 m_D2,
+                 scratch2[last + l],
+                 m_D3,
+                 outV2,
+                 m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; --i)
+  {
+    const SizeValueType k = (i - 1) * n;
+    for (SizeValueType l = 0; l < n; ++l)
+    {
+      MathEMAMAMAM(scratch2[k + l],
+                   data[k + n + l],
+                   m_M1,
+                   data[k + 2 * n + l],
+                   m_M2,
+                   data[k + 3 * n + l],
+                   m_M3,
+                   data[k + 4 * n + l],
+                   m_M4);
+      MathSMAMAMAM(scratch2[k + l],
+                   scratch2[k + n + l],
+                   m_D1,
+                   scratch2[k + 2 * n + l],
+                   m_D2,
+                   scratch2[k + 3 * n + l],
+                   m_D3,
+                   scratch2[k + 4 * n + l],
+                   m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * n; ++i)
+  {
+    outs[i] += scratch2[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -281,6 +426,59 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
 
   const SizeValueType ln = region.GetSize(this->m_Direction);
 
+  if constexpr (std::is_arithmetic_v<RealType>)
+  {
+    if (this->m_Direction != 0 && region.GetSize(0) > 1)
+    {
+      // The lines along the other directions are not contiguous in memory:
+      // copy blocks of lines that are adjacent along the first direction
+      // into an interleaved buffer, so that the image is read and written a
+      // few contiguous pixels at a time, and filter them together.
+      const auto inps = make_unique_for_overwrite<RealType[]>(ln * NumberOfLinesPerBlock);
+      const auto outs = make_unique_for_overwrite<RealType[]>(ln * NumberOfLinesPerBlock);
+      const auto scratch = make_unique_for_overwrite<RealType[]>(ln * NumberOfLinesPerBlock);
+
+      // The first pixels of the lines along the first direction, in the
+      // region orthogonal to the filtering direction.
+      RegionType startRegion = region;
+      startRegion.SetSize(this->m_Direction, 1);
+      ImageLinearConstIteratorWithIndex<TInputImage> startIterator(inputImage, startRegion);
+      startIterator.SetDirection(0);
+
+      for (startIterator.GoToBegin(); !startIterator.IsAtEnd(); startIterator.NextLine())
+      {
+        const typename RegionType::IndexType lineStart = startIterator.GetIndex();
+        for (SizeValueType first = 0; first < region.GetSize(0); first += NumberOfLinesPerBlock)
+        {
+          const auto numberOfLines =
+            static_cast<unsigned int>(std::min<SizeValueType>(NumberOfLinesPerBlock, region.GetSize(0) - first));
+
+          // A region iterator walks the first direction fastest, which
+          // yields element i of line l at index i * numberOfLines + l.
+          RegionType blockRegion(lineStart, RegionType::SizeType::Filled(1));
+          blockRegion.SetIndex(0, lineStart[0] + static_cast<IndexValueType>(first));
+          blockRegion.SetSize(0, numberOfLines);
+          blockRegion.SetSize(this->m_Direction, ln);
+
+          SizeValueType i = 0;
+          for (ImageRegionConstIterator<TInputImage> it(inputImage, blockRegion); !it.IsAtEnd(); ++it)
+          {
+            inps[i++] = it.Get();
+          }
+
+          this->FilterDataBlock(outs.get(), inps.get(), scratch.get(), ln, numberOfLines);
+
+          i = 0;
+          for (ImageRegionIterator<TOutputImage> ot(outputImage, blockRegion); !ot.IsAtEnd(); ++ot)
+          {
+            ot.Set(static_cast<OutputPixelType>(outs[i++]));
+          }
+        }
+      }
+      return;
+    }
+  }
+
   const auto inps = make_unique_for_overwrite<RealType[]>(ln);
   const auto outs = make_unique_for_overwrite<RealType[]>(ln);
   const auto scratch = make_unique_for_overwrite<RealType[]>(ln);
@@ -18,6 +18,7 @@
 #ifndef itkUnaryGeneratorImageFilter_h
 #define itkUnaryGeneratorImageFilter_h
 
+#include "itkBatchFunctor.h"
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
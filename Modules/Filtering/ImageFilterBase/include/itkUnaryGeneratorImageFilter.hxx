@@ -92,6 +92,28 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
 
   this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
 
+  if constexpr (ImageScanlineBatch::IsSupported<TInputImage, TOutputImage> &&
+                TInputImage::ImageDimension == TOutputImage::ImageDimension &&
+                Functor::HasUnaryBatchOperator<TFunctor, InputImagePixelType, OutputImagePixelType>::value)
+  {
+    // The lines of the region are contiguous in both buffers: pass them to
+    // the batch overload of the functor.
+    if (inputRegionForThread == outputRegionForThread)
+    {
+      ImageScanlineBatch::ForEachScanline(
+        outputRegionForThread,
+        [&functor, &progress](const SizeValueType               lineLength,
+                              OutputImagePixelType * const      outputLine,
+                              const InputImagePixelType * const inputLine) {
+          functor(inputLine, outputLine, lineLength);
+          progress.Completed(lineLength);
+        },
+        *outputPtr,
+        *inputPtr);
+      return;
+    }
+  }
+
   // Define the iterators
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkFunctorChain.h"
+
+#include "itkAbsImageFilter.h"
+#include "itkArithmeticOpsFunctors.h"
+#include "itkBinaryGeneratorImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkDivideImageFilter.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+#include "itkSubtractImageFilter.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkUnaryGeneratorImageFilter.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ShortImageType = itk::Image<short, Dimension>;
+using FloatImageType = itk::Image<float, Dimension>;
+using CharImageType = itk::Image<unsigned char, Dimension>;
+using RegionType = FloatImageType::RegionType;
+
+// The lines of the region are longer than a batch of FunctorChain, and not a
+// multiple of it.
+const RegionType imageRegion(itk::Size<Dimension>{ { 600, 7 } });
+
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const int seed)
+{
+  const auto image = TImage::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+  int value = seed;
+  for (auto & pixel : itk::ImageRegionRange<TImage>(*image))
+  {
+    value = (value * 37 + 11) % 1001;
+    pixel = static_cast<typename TImage::PixelType>(value - 300);
+  }
+  return image;
+}
+
+template <typename TImage1, typename TImage2>
+void
+ExpectEqualPixels(const TImage1 & image1, const TImage2 & image2)
+{
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(imageRegion))
+  {
+    EXPECT_EQ(image1.GetPixel(index), image2.GetPixel(index)) << "index = " << index;
+  }
+}
+} // namespace
+
+
+// Tests that a FunctorChain applies its functors in order.
+TEST(FunctorChain, AppliesFunctorsInOrder)
+{
+  itk::Functor::Clamp<float, float> clamp;
+  clamp.SetBounds(-1.0f, 2.0f);
+
+  auto chain = itk::Functor::MakeFunctorChain(
+    [](const short x) { return static_cast<float>(x) / 4.0f; }, clamp, [](const float x) { return x * 10.0f; });
+  static_assert(decltype(chain)::NumberOfFunctors == 3);
+
+  EXPECT_EQ(chain(short{ 2 }), 5.0f);
+  EXPECT_EQ(chain(short{ 100 }), 20.0f);
+  EXPECT_EQ(chain(short{ -100 }), -10.0f);
+
+  chain.GetFunctor<1>().SetBounds(0.0f, 1.0f);
+  EXPECT_EQ(chain(short{ 2 }), 5.0f);
+  EXPECT_EQ(chain(short{ 100 }), 10.0f);
+
+  // The first functor of a chain may be binary.
+  const auto binaryChain =
+    itk::Functor::MakeFunctorChain(itk::Functor::Sub2<short, short, int>(), [](const int x) { return x * x; });
+  EXPECT_EQ(binaryChain(short{ 3 }, short{ 7 }), 16);
+
+  static_assert(itk::Functor::HasUnaryBatchOperator<decltype(chain), short, float>::value);
+  static_assert(itk::Functor::HasBinaryBatchOperator<decltype(binaryChain), short, short, int>::value);
+}
+
+
+// Tests that a UnaryGeneratorImageFilter with a FunctorChain computes the
+// same pixels as the sequence of filters that it replaces.
+TEST(FunctorChain, ReplacesSequenceOfUnaryFilters)
+{
+  const auto  image = CreateImage<ShortImageType>(1);
+  const float mean = 150.0f;
+  const float sigma = 175.0f;
+
+  const auto castToFloat = itk::CastImageFilter<ShortImageType, FloatImageType>::New();
+  castToFloat->SetInput(image);
+  const auto subtract = itk::SubtractImageFilter<FloatImageType, FloatImageType, FloatImageType>::New();
+  subtract->SetInput1(castToFloat->GetOutput());
+  subtract->SetConstant2(mean);
+  const auto divide = itk::DivideImageFilter<FloatImageType, FloatImageType, FloatImageType>::New();
+  divide->SetInput1(subtract->GetOutput());
+  divide->SetConstant2(sigma);
+  const auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(divide->GetOutput());
+  clamp->SetBounds(-1.0f, 1.0f);
+  const auto castToChar = itk::CastImageFilter<FloatImageType, CharImageType>::New();
+  castToChar->SetInput(clamp->GetOutput());
+  castToChar->Update();
+
+  const auto filter = itk::UnaryGeneratorImageFilter<ShortImageType, CharImageType>::New();
+  filter->SetInput(image);
+  filter->SetFunctor(itk::Functor::MakeFunctorChain([](const short x) { return static_cast<float>(x); },
+                                                    [mean](const float x) { return x - mean; },
+                                                    [sigma](const float x) { return x / sigma; },
+                                                    clamp->GetFunctor(),
+                                                    [](const float x) { return static_cast<unsigned char>(x); }));
+  filter->Update();
+
+  ExpectEqualPixels(*filter->GetOutput(), *castToChar->GetOutput());
+}
+
+
+// Tests that a UnaryFunctorImageFilter accepts a FunctorChain of functors.
+TEST(FunctorChain, UnaryFunctorImageFilter)
+{
+  using ChainType = itk::Functor::FunctorChain<itk::Functor::Abs<float, float>, itk::Functor::Clamp<float, float>>;
+  const auto image = CreateImage<FloatImageType>(2);
+
+  const auto abs = itk::AbsImageFilter<FloatImageType, FloatImageType>::New();
+  abs->SetInput(image);
+  const auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(abs->GetOutput());
+  clamp->SetBounds(10.0f, 500.0f);
+  clamp->Update();
+
+  const auto filter = itk::UnaryFunctorImageFilter<FloatImageType, FloatImageType, ChainType>::New();
+  filter->SetInput(image);
+  filter->SetFunctor(ChainType(itk::Functor::Abs<float, float>(), clamp->GetFunctor()));
+  filter->Update();
+
+  ExpectEqualPixels(*filter->GetOutput(), *clamp->GetOutput());
+}
+
+
+// Tests that a BinaryGeneratorImageFilter with a FunctorChain whose first
+// functor is binary computes the pixels of two images, and of an image and a
+// constant.
+TEST(FunctorChain, BinaryGeneratorImageFilter)
+{
+  const auto image1 = CreateImage<FloatImageType>(3);
+  const auto image2 = CreateImage<FloatImageType>(4);
+
+  const auto chain = itk::Functor::MakeFunctorChain(itk::Functor::Sub2<float, float, float>(),
+                                                    [](const float x) { return x * 0.5f; });
+  using FilterType = itk::BinaryGeneratorImageFilter<FloatImageType, FloatImageType, FloatImageType>;
+
+  const auto filter = FilterType::New();
+  filter->SetInput1(image1);
+  filter->SetInput2(image2);
+  filter->SetFunctor(chain);
+  filter->Update();
+
+  const auto constant2Filter = FilterType::New();
+  constant2Filter->SetInput1(image1);
+  constant2Filter->SetConstant2(12.0f);
+  constant2Filter->SetFunctor(chain);
+  constant2Filter->Update();
+
+  const auto constant1Filter = FilterType::New();
+  constant1Filter->SetConstant1(12.0f);
+  constant1Filter->SetInput2(image2);
+  constant1Filter->SetFunctor(chain);
+  constant1Filter->Update();
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(imageRegion))
+  {
+    const float pixel1 = image1->GetPixel(index);
+    const float pixel2 = image2->GetPixel(index);
+    EXPECT_EQ(filter->GetOutput()->GetPixel(index), (pixel1 - pixel2) * 0.5f);
+    EXPECT_EQ(constant2Filter->GetOutput()->GetPixel(index), (pixel1 - 12.0f) * 0.5f);
+    EXPECT_EQ(constant1Filter->GetOutput()->GetPixel(index), (12.0f - pixel2) * 0.5f);
+  }
+}
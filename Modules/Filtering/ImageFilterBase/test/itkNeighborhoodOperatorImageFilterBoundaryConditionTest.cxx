@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkDerivativeOperator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLaplacianOperator.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using InputImageType = itk::Image<short, 3>;
+using OutputImageType = itk::Image<float, 3>;
+using FilterType = itk::NeighborhoodOperatorImageFilter<InputImageType, OutputImageType, double>;
+
+// Subclasses of the boundary conditions, which the filter processes with
+// neighborhood iterators rather than with ImageNeighborhoodAlgorithm.
+class DerivedZeroFluxNeumannBoundaryCondition : public itk::ZeroFluxNeumannBoundaryCondition<InputImageType>
+{};
+
+class DerivedConstantBoundaryCondition : public itk::ConstantBoundaryCondition<InputImageType>
+{};
+
+// Filter the image with the operator and the boundary condition, and return
+// the time of the update.
+double
+FilterImage(InputImageType *                              image,
+            const FilterType::OutputNeighborhoodType &    op,
+            FilterType::ImageBoundaryConditionPointerType boundaryCondition,
+            OutputImageType::Pointer &                    output)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetOperator(op);
+  filter->OverrideBoundaryCondition(boundaryCondition);
+
+  itk::TimeProbe probe;
+  probe.Start();
+  filter->Update();
+  probe.Stop();
+  output = filter->GetOutput();
+  return probe.GetTotal();
+}
+
+// Check that the filter computes the same output with the boundary condition
+// and with its subclass, and print the time of both updates.
+bool
+CompareBoundaryConditions(const char *                                  name,
+                          InputImageType *                              image,
+                          const FilterType::OutputNeighborhoodType &    op,
+                          FilterType::ImageBoundaryConditionPointerType boundaryCondition,
+                          FilterType::ImageBoundaryConditionPointerType derivedBoundaryCondition)
+{
+  OutputImageType::Pointer output;
+  OutputImageType::Pointer iteratorOutput;
+  const double             time = FilterImage(image, op, boundaryCondition, output);
+  const double             iteratorTime = FilterImage(image, op, derivedBoundaryCondition, iteratorOutput);
+  std::cout << name << ": " << time << " s, with neighborhood iterators: " << iteratorTime << " s" << std::endl;
+
+  for (itk::ImageRegionIteratorWithIndex<OutputImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != iteratorOutput->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << name << ": pixel " << it.GetIndex() << " is " << it.Get() << ", with neighborhood iterators "
+                << iteratorOutput->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNeighborhoodOperatorImageFilterBoundaryConditionTest(int, char *[])
+{
+  auto image = InputImageType::New();
+  image->SetRegions(InputImageType::SizeType{ { 96, 80, 64 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<short>((index[0] * 7 + index[1] * index[1] - 3 * index[2]) % 101));
+  }
+
+  itk::LaplacianOperator<double, 3> laplacian;
+  laplacian.CreateOperator();
+  itk::DerivativeOperator<double, 3> derivative;
+  derivative.SetDirection(1);
+  derivative.SetOrder(2);
+  derivative.CreateDirectional();
+
+  itk::ZeroFluxNeumannBoundaryCondition<InputImageType> zeroFluxNeumannCondition;
+  DerivedZeroFluxNeumannBoundaryCondition               derivedZeroFluxNeumannCondition;
+  itk::ConstantBoundaryCondition<InputImageType>        constantCondition;
+  DerivedConstantBoundaryCondition                      derivedConstantCondition;
+  constantCondition.SetConstant(25);
+  derivedConstantCondition.SetConstant(25);
+
+  bool testPassed = true;
+  testPassed &= CompareBoundaryConditions(
+    "Laplacian, zero-flux Neumann", image, laplacian, &zeroFluxNeumannCondition, &derivedZeroFluxNeumannCondition);
+  testPassed &=
+    CompareBoundaryConditions("Laplacian, constant", image, laplacian, &constantCondition, &derivedConstantCondition);
+  testPassed &= CompareBoundaryConditions("Second derivative, zero-flux Neumann",
+                                          image,
+                                          derivative,
+                                          &zeroFluxNeumannCondition,
+                                          &derivedZeroFluxNeumannCondition);
+  testPassed &= CompareBoundaryConditions(
+    "Second derivative, constant", image, derivative, &constantCondition, &derivedConstantCondition);
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -18,14 +18,13 @@
 #ifndef itkGradientMagnitudeImageFilter_hxx
 #define itkGradientMagnitudeImageFilter_hxx
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
 #include "itkDerivativeOperator.h"
-#include "itkNeighborhoodAlgorithm.h"
+#include "itkImageNeighborhoodAlgorithm.h"
 #include "itkTotalProgressReporter.h"
 #include "itkMath.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -98,23 +97,13 @@ void
 GradientMagnitudeImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  unsigned int i;
-
-  ZeroFluxNeumannBoundaryCondition<TInputImage> nbc;
-
-  ConstNeighborhoodIterator<TInputImage> nit;
-  ConstNeighborhoodIterator<TInputImage> bit;
-  ImageRegionIterator<TOutputImage>      it;
-
-  NeighborhoodInnerProduct<TInputImage, RealType> SIP;
-
-  typename OutputImageType::Pointer     output = this->GetOutput();
-  typename InputImageType::ConstPointer input = this->GetInput();
+  OutputImageType * const      output = this->GetOutput();
+  const InputImageType * const input = this->GetInput();
 
   // Set up operators
   DerivativeOperator<RealType, ImageDimension> op[ImageDimension];
 
-  for (i = 0; i < ImageDimension; ++i)
+  for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     // The operator has default values for its direction (0) and its order (1).
     op[i].CreateDirectional();
@@ -132,53 +121,51 @@ GradientMagnitudeImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerate
     }
   }
 
-  // Set the iterator radius to one, which is the value of the first
-  // coordinate of the operator radius.
-  static constexpr auto radius = Size<ImageDimension>::Filled(1);
-
-  // Find the data-set boundary "faces"
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>                        bC;
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>::FaceListType faceList =
-    bC(input, outputRegionForThread, radius);
-
-
-  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+  // The neighborhood is made of the three pixels along each dimension, whose
+  // coefficients are those of the operator of the dimension. The derivatives
+  // are computed with the same arithmetic as NeighborhoodInnerProduct.
+  using InputPixelRealType = typename NumericTraits<InputPixelType>::RealType;
+  using AccumulateRealType = typename NumericTraits<InputPixelRealType>::AccumulateType;
+  using RealValueType = typename NumericTraits<RealType>::ValueType;
 
-  // Process non-boundary face
-  nit = ConstNeighborhoodIterator<TInputImage>(radius, input, faceList.front());
-
-  std::slice x_slice[ImageDimension];
-  for (i = 0; i < ImageDimension; ++i)
+  std::vector<Offset<ImageDimension>> neighborhoodOffsets;
+  std::vector<RealValueType>          coefficients;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    static constexpr SizeValueType neighborhoodSize = Math::UnsignedPower(3, ImageDimension);
-    static constexpr SizeValueType center = neighborhoodSize / 2;
-
-    x_slice[i] = std::slice(center - nit.GetStride(i), op[i].GetSize()[0], nit.GetStride(i));
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      Offset<ImageDimension> offset{};
+      offset[i] = static_cast<OffsetValueType>(j) - 1;
+      neighborhoodOffsets.push_back(offset);
+      coefficients.push_back(static_cast<RealValueType>(op[i][j]));
+    }
   }
 
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for (const auto & face : faceList)
-  {
-    bit = ConstNeighborhoodIterator<InputImageType>(radius, input, face);
-    it = ImageRegionIterator<OutputImageType>(output, face);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
-    while (!bit.IsAtEnd())
-    {
+  ImageNeighborhoodAlgorithm::Transform(
+    *input,
+    *output,
+    outputRegionForThread,
+    neighborhoodOffsets,
+    [&coefficients](const auto & neighborhood) {
       RealType a{};
-      for (i = 0; i < ImageDimension; ++i)
+      auto     pixelIterator = neighborhood.begin();
+      auto     coefficient = coefficients.cbegin();
+      for (unsigned int i = 0; i < ImageDimension; ++i)
       {
-        const RealType g = SIP(x_slice[i], bit, op[i]);
+        AccumulateRealType sum{};
+        for (unsigned int j = 0; j < 3; ++j, ++pixelIterator, ++coefficient)
+        {
+          const InputPixelType pixel = *pixelIterator;
+          sum += static_cast<AccumulateRealType>(*coefficient * static_cast<InputPixelRealType>(pixel));
+        }
+        const auto g = static_cast<RealType>(sum);
         a += g * g;
       }
-      it.Value() = static_cast<OutputPixelType>(std::sqrt(a));
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-    }
-  }
+      return static_cast<OutputPixelType>(std::sqrt(a));
+    },
+    &progress);
 }
 } // end namespace itk
 
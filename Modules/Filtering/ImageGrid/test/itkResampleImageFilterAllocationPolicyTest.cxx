@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAddImageFilter.h"
+#include "itkResampleImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+struct Timings
+{
+  double Add;
+  double Resample;
+};
+
+// Allocate the input images and the filter outputs with the global default
+// allocation policy, and time the filters, which stream through their input
+// and output buffers.
+Timings
+TimeFilters(const itk::ImageBufferAllocationPolicy & policy,
+            ImageType::Pointer &                     addOutput,
+            ImageType::Pointer &                     resampleOutput)
+{
+  itk::ImageBufferAllocationPolicy::SetGlobalDefault(policy);
+
+  const ImageType::RegionType region(ImageType::SizeType{ { 160, 160, 160 } });
+  auto                        image1 = ImageType::New();
+  auto                        image2 = ImageType::New();
+  for (const auto & image : { image1, image2 })
+  {
+    image->SetRegions(region);
+    image->Allocate();
+  }
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image1, region); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<float>(index[0] + 3 * index[1] - index[2]));
+    image2->SetPixel(index, static_cast<float>(index[2]));
+  }
+
+  Timings timings{};
+
+  auto add = itk::AddImageFilter<ImageType, ImageType, ImageType>::New();
+  add->SetInput1(image1);
+  add->SetInput2(image2);
+  itk::TimeProbe addProbe;
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    add->Modified();
+    addProbe.Start();
+    add->Update();
+    addProbe.Stop();
+  }
+  timings.Add = addProbe.GetMean();
+  addOutput = add->GetOutput();
+
+  auto resample = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  resample->SetInput(image1);
+  resample->SetSize(ImageType::SizeType{ { 200, 200, 200 } });
+  resample->SetOutputSpacing(0.75);
+  itk::TimeProbe resampleProbe;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    resample->Modified();
+    resampleProbe.Start();
+    resample->Update();
+    resampleProbe.Stop();
+  }
+  timings.Resample = resampleProbe.GetMean();
+  resampleOutput = resample->GetOutput();
+
+  itk::ImageBufferAllocationPolicy::SetGlobalDefault(itk::ImageBufferAllocationPolicy{});
+  return timings;
+}
+
+bool
+ImagesAreEqual(const ImageType * image, const ImageType * expectedImage)
+{
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expectedImage->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The output at " << it.GetIndex() << " is " << it.Get() << " instead of "
+                << expectedImage->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkResampleImageFilterAllocationPolicyTest(int, char *[])
+{
+  ImageType::Pointer expectedAddOutput;
+  ImageType::Pointer expectedResampleOutput;
+  const Timings      defaultTimings =
+    TimeFilters(itk::ImageBufferAllocationPolicy{}, expectedAddOutput, expectedResampleOutput);
+  std::cout << "Default policy: AddImageFilter " << defaultTimings.Add << " s, ResampleImageFilter "
+            << defaultTimings.Resample << " s" << std::endl;
+
+  itk::ImageBufferAllocationPolicy firstTouchPolicy;
+  firstTouchPolicy.Alignment = 64;
+  firstTouchPolicy.UseParallelFirstTouch = true;
+  itk::ImageBufferAllocationPolicy hugePagePolicy = firstTouchPolicy;
+  hugePagePolicy.UseHugePages = true;
+
+  bool testPassed = true;
+  for (const auto & policy : { firstTouchPolicy, hugePagePolicy })
+  {
+    ImageType::Pointer addOutput;
+    ImageType::Pointer resampleOutput;
+    const Timings      timings = TimeFilters(policy, addOutput, resampleOutput);
+    std::cout << "Policy (" << policy << "): AddImageFilter " << timings.Add << " s, ResampleImageFilter "
+              << timings.Resample << " s" << std::endl;
+
+    ITK_TEST_EXPECT_TRUE(addOutput->GetPixelContainer()->GetAllocationPolicy() == policy);
+    testPassed &= ImagesAreEqual(addOutput, expectedAddOutput);
+    testPassed &= ImagesAreEqual(resampleOutput, expectedResampleOutput);
+  }
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
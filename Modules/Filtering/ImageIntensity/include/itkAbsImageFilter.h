@@ -46,6 +46,8 @@ public:
   {
     return static_cast<TOutput>(itk::Math::abs(A));
   }
+
+  ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput, TOutput);
 };
 } // namespace Functor
 
@@ -18,6 +18,7 @@
 #ifndef itkArithmeticOpsFunctors_h
 #define itkArithmeticOpsFunctors_h
 
+#include "itkBatchFunctor.h"
 #include "itkMath.h"
 
 namespace itk
@@ -46,6 +47,8 @@ public:
   {
     return static_cast<TOutput>(A + B);
   }
+
+  ITK_BINARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput1, TInput2, TOutput);
 };
 
 
@@ -96,6 +99,8 @@ public:
   {
     return static_cast<TOutput>(A - B);
   }
+
+  ITK_BINARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput1, TInput2, TOutput);
 };
 
 
@@ -121,6 +126,8 @@ public:
   {
     return static_cast<TOutput>(A * B);
   }
+
+  ITK_BINARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput1, TInput2, TOutput);
 };
 
 
@@ -153,6 +160,8 @@ public:
       return NumericTraits<TOutput>::max(static_cast<TOutput>(A));
     }
   }
+
+  ITK_BINARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput1, TInput2, TOutput);
 };
 
 
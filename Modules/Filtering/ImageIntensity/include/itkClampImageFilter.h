@@ -75,6 +75,8 @@ public:
   OutputType
   operator()(const InputType & A) const;
 
+  ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION(InputType, OutputType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   itkConceptMacro(InputConvertibleToOutputCheck, (Concept::Convertible<InputType, OutputType>));
   itkConceptMacro(InputConvertibleToDoubleCheck, (Concept::Convertible<InputType, double>));
@@ -100,6 +100,8 @@ public:
     return result;
   }
 
+  ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput, TOutput);
+
 private:
   RealType m_Factor;
   RealType m_Offset;
@@ -83,6 +83,8 @@ public:
     return static_cast<TOutput>(v);
   }
 
+  ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput, TOutput);
+
   void
   SetAlpha(double alpha)
   {
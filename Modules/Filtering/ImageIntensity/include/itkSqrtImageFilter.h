@@ -47,6 +47,8 @@ public:
   {
     return static_cast<TOutput>(std::sqrt(static_cast<double>(A)));
   }
+
+  ITK_UNARY_BATCH_OPERATOR_MEMBER_FUNCTION(TInput, TOutput);
 };
 } // namespace Functor
 
@@ -20,6 +20,7 @@
 
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkSymmetricEigenAnalysis.h"
+#include "itkSymmetricEigenAnalysisClosedForm.h"
 #include "ITKImageIntensityExport.h"
 
 namespace itk
@@ -124,12 +125,20 @@ private:
   CalculatorType m_Calculator;
 };
 
+// The eigen values of 2x2 and 3x3 matrices are computed by
+// SymmetricEigenAnalysisClosedForm, which falls back to the iterative solver
+// of SymmetricEigenAnalysisFixedDimension for nearly repeated eigen values.
+// SymmetricEigenAnalysisFunction keeps the iterative solver, because its
+// dimension is only known at run time.
 template <unsigned int TMatrixDimension, typename TInput, typename TOutput>
 class SymmetricEigenAnalysisFixedDimensionFunction
 {
 public:
   using RealValueType = typename TInput::RealValueType;
-  using CalculatorType = SymmetricEigenAnalysisFixedDimension<TMatrixDimension, TInput, TOutput>;
+  using CalculatorType =
+    std::conditional_t<TMatrixDimension == 2 || TMatrixDimension == 3,
+                       SymmetricEigenAnalysisClosedForm<TMatrixDimension, TInput, TOutput>,
+                       SymmetricEigenAnalysisFixedDimension<TMatrixDimension, TInput, TOutput>>;
   bool
   operator==(const SymmetricEigenAnalysisFixedDimensionFunction &) const
   {
@@ -0,0 +1,211 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBatchFunctor.h"
+
+#include "itkAbsImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkDivideImageFilter.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+#include "itkIntensityWindowingImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+#include "itkSubtractImageFilter.h"
+#include "itkVectorImage.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<float, Dimension>;
+using ShortImageType = itk::Image<short, Dimension>;
+using RegionType = ImageType::RegionType;
+
+// Creates an image whose pixels are positive, negative and zero values.
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const RegionType & bufferedRegion, const int seed)
+{
+  const auto image = TImage::New();
+  image->SetRegions(bufferedRegion);
+  image->Allocate();
+  int value = seed;
+  for (auto & pixel : itk::ImageRegionRange<TImage>(*image))
+  {
+    value = (value * 37 + 11) % 101;
+    pixel = static_cast<typename TImage::PixelType>((value - 50) / 4);
+  }
+  return image;
+}
+
+// Expects each pixel of the region of the output image to be the value of the
+// function at its index.
+template <typename TImage, typename TFunction>
+void
+ExpectPixels(const TImage & outputImage, const RegionType & region, TFunction function)
+{
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    EXPECT_EQ(outputImage.GetPixel(index), function(index)) << "index = " << index;
+  }
+}
+
+const RegionType bufferedRegion({ { -3, 2, 1 } }, { { 37, 5, 4 } });
+} // namespace
+
+
+// Tests that the traits detect the batch overloads of the functors.
+TEST(BatchFunctor, DetectsBatchOperators)
+{
+  using itk::Functor::HasBinaryBatchOperator;
+  using itk::Functor::HasUnaryBatchOperator;
+
+  static_assert(HasUnaryBatchOperator<itk::Functor::Abs<float, float>, float, float>::value);
+  static_assert(HasUnaryBatchOperator<itk::Functor::Clamp<short, float>, short, float>::value);
+  static_assert(!HasUnaryBatchOperator<itk::Functor::Abs<float, float>, short, float>::value);
+  static_assert(!HasUnaryBatchOperator<float (*)(float), float, float>::value);
+  static_assert(HasBinaryBatchOperator<itk::Functor::Add2<float, float, float>, float, float, float>::value);
+  static_assert(HasBinaryBatchOperator<itk::Functor::Div<short, float, float>, short, float, float>::value);
+  static_assert(!HasBinaryBatchOperator<itk::Functor::Div<short, float, float>, float, float, float>::value);
+  static_assert(itk::ImageScanlineBatch::IsSupported<ImageType, const ShortImageType>);
+  static_assert(!itk::ImageScanlineBatch::IsSupported<ImageType, itk::VectorImage<float, Dimension>>);
+}
+
+
+// Tests that the binary filters compute with the batch overloads the same
+// pixels as with the functor for a pixel, for two images and for an image and
+// a constant.
+TEST(BatchFunctor, BinaryGeneratorImageFilter)
+{
+  const auto image1 = CreateImage<ImageType>(bufferedRegion, 1);
+  const auto image2 = CreateImage<ImageType>(bufferedRegion, 2);
+
+  const itk::Functor::Add2<float, float, float> add;
+  const auto addFilter = itk::AddImageFilter<ImageType>::New();
+  addFilter->SetInput1(image1);
+  addFilter->SetInput2(image2);
+  addFilter->Update();
+  ExpectPixels(*addFilter->GetOutput(), bufferedRegion, [&](const auto & index) {
+    return add(image1->GetPixel(index), image2->GetPixel(index));
+  });
+
+  const itk::Functor::Mult<float, float, float> multiply;
+  const auto multiplyFilter = itk::MultiplyImageFilter<ImageType>::New();
+  multiplyFilter->SetInput1(image1);
+  multiplyFilter->SetConstant2(-1.5f);
+  multiplyFilter->Update();
+  ExpectPixels(*multiplyFilter->GetOutput(), bufferedRegion, [&](const auto & index) {
+    return multiply(image1->GetPixel(index), -1.5f);
+  });
+
+  // The divisors include zero pixels.
+  const itk::Functor::Div<float, float, float> divide;
+  const auto divideFilter = itk::DivideImageFilter<ImageType, ImageType, ImageType>::New();
+  divideFilter->SetConstant1(3.0f);
+  divideFilter->SetInput2(image2);
+  divideFilter->Update();
+  ExpectPixels(*divideFilter->GetOutput(), bufferedRegion, [&](const auto & index) {
+    return divide(3.0f, image2->GetPixel(index));
+  });
+}
+
+
+// Tests that the batch overloads compute the pixels in place of the first
+// input, and compute only the requested region of the output.
+TEST(BatchFunctor, InPlaceAndRequestedRegion)
+{
+  const auto image1 = CreateImage<ImageType>(bufferedRegion, 3);
+  const auto image2 = CreateImage<ImageType>(bufferedRegion, 4);
+  const auto expectedImage = CreateImage<ImageType>(bufferedRegion, 3);
+
+  const itk::Functor::Sub2<float, float, float> subtract;
+  const auto subtractFilter = itk::SubtractImageFilter<ImageType>::New();
+  subtractFilter->SetInput1(image1);
+  subtractFilter->SetInput2(image2);
+  subtractFilter->InPlaceOn();
+  const float * const inputBuffer = image1->GetBufferPointer();
+  subtractFilter->Update();
+
+  EXPECT_EQ(subtractFilter->GetOutput()->GetBufferPointer(), inputBuffer);
+  ExpectPixels(*subtractFilter->GetOutput(), bufferedRegion, [&](const auto & index) {
+    return subtract(expectedImage->GetPixel(index), image2->GetPixel(index));
+  });
+
+  const RegionType requestedRegion({ { 2, 3, 2 } }, { { 19, 3, 2 } });
+  const auto       addFilter = itk::AddImageFilter<ImageType>::New();
+  addFilter->SetInput1(expectedImage);
+  addFilter->SetInput2(image2);
+  addFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  addFilter->Update();
+
+  EXPECT_EQ(addFilter->GetOutput()->GetBufferedRegion(), requestedRegion);
+  ExpectPixels(*addFilter->GetOutput(), requestedRegion, [&](const auto & index) {
+    return expectedImage->GetPixel(index) + image2->GetPixel(index);
+  });
+}
+
+
+// Tests that the unary filters compute with the batch overloads the same
+// pixels as with the functor for a pixel.
+TEST(BatchFunctor, UnaryFilters)
+{
+  const auto image = CreateImage<ImageType>(bufferedRegion, 5);
+  const auto shortImage = CreateImage<ShortImageType>(bufferedRegion, 6);
+
+  const itk::Functor::Abs<float, float> abs;
+  const auto absFilter = itk::AbsImageFilter<ImageType, ImageType>::New();
+  absFilter->SetInput(image);
+  absFilter->Update();
+  ExpectPixels(
+    *absFilter->GetOutput(), bufferedRegion, [&](const auto & index) { return abs(image->GetPixel(index)); });
+
+  const auto clampFilter = itk::ClampImageFilter<ShortImageType, ImageType>::New();
+  clampFilter->SetInput(shortImage);
+  clampFilter->SetBounds(-4.0f, 7.0f);
+  clampFilter->Update();
+  const auto & clamp = clampFilter->GetFunctor();
+  ExpectPixels(
+    *clampFilter->GetOutput(), bufferedRegion, [&](const auto & index) { return clamp(shortImage->GetPixel(index)); });
+
+  const auto sigmoidFilter = itk::SigmoidImageFilter<ImageType, ImageType>::New();
+  sigmoidFilter->SetInput(image);
+  sigmoidFilter->SetAlpha(2.0);
+  sigmoidFilter->SetBeta(1.0);
+  sigmoidFilter->SetOutputMinimum(-1.0f);
+  sigmoidFilter->SetOutputMaximum(1.0f);
+  sigmoidFilter->Update();
+  const auto & sigmoid = sigmoidFilter->GetFunctor();
+  ExpectPixels(
+    *sigmoidFilter->GetOutput(), bufferedRegion, [&](const auto & index) { return sigmoid(image->GetPixel(index)); });
+
+  const auto windowingFilter = itk::IntensityWindowingImageFilter<ShortImageType, ImageType>::New();
+  windowingFilter->SetInput(shortImage);
+  windowingFilter->SetWindowMinimum(-5);
+  windowingFilter->SetWindowMaximum(8);
+  windowingFilter->SetOutputMinimum(0.0f);
+  windowingFilter->SetOutputMaximum(1.0f);
+  windowingFilter->Update();
+  const auto & windowing = windowingFilter->GetFunctor();
+  ExpectPixels(*windowingFilter->GetOutput(), bufferedRegion, [&](const auto & index) {
+    return windowing(shortImage->GetPixel(index));
+  });
+}
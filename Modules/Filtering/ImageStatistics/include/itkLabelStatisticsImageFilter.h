@@ -23,7 +23,7 @@
 #include "itkSimpleDataObjectDecorator.h"
 #include "itkHistogram.h"
 #include "itkPrintHelper.h"
-#include <mutex>
+#include "itkImageReduction.h"
 #include <unordered_map>
 #include <vector>
 
@@ -50,7 +50,8 @@ namespace itk
  * This filter is automatically multi-threaded and can stream its
  * input when NumberOfStreamDivisions is set to more than
  * 1. Statistics are independently computed for each streamed and
- * threaded region then merged.
+ * threaded region then merged, in the order of the regions, so that the
+ * results do not depend on the scheduling of the threads.
  *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
@@ -395,6 +396,7 @@ protected:
   {
     this->AllocateOutputs();
     m_LabelStatistics.clear();
+    m_Partials.Clear();
   }
 
   /** Do final mean and variance computation from data accumulated in threads.
@@ -402,12 +404,34 @@ protected:
   void
   AfterStreamedGenerateData() override;
 
+  /** Merge the partial reductions of the piece after its threads run, so
+   * that only those of one piece are kept. */
+  void
+  StreamedGenerateData(unsigned int inputRequestedRegionNumber) override;
+
   void
   ThreadedStreamedGenerateData(const RegionType &) override;
 
 private:
+  /** The statistics of a label in the region of a thread. The pixels of a
+   * run of the label along a line are added at once. */
+  struct LabelAccumulator
+  {
+    using StatisticsAccumulatorType = Reduction::StatisticsAccumulator<PixelType, RealType>;
+
+    StatisticsAccumulatorType m_Statistics{};
+    IndexType                 m_MinimumIndex{ IndexType::Filled(NumericTraits<IndexValueType>::max()) };
+    IndexType                 m_MaximumIndex{ IndexType::Filled(NumericTraits<IndexValueType>::NonpositiveMin()) };
+    HistogramPointer          m_Histogram{};
+  };
+
+  using LabelAccumulatorMapType = std::unordered_map<LabelPixelType, LabelAccumulator>;
+
+  /** Merge the statistics of the labels of accumulators2 into accumulators1. */
   void
-  MergeMap(MapType &, MapType &) const;
+  MergeLabelAccumulators(LabelAccumulatorMapType & accumulators1, LabelAccumulatorMapType & accumulators2) const;
+
+  ImageReductionPartials<LabelAccumulatorMapType, ImageDimension> m_Partials{};
 
   MapType                       m_LabelStatistics{};
   ValidLabelValuesContainerType m_ValidLabelValues{};
@@ -418,9 +442,6 @@ private:
 
   RealType m_LowerBound{};
   RealType m_UpperBound{};
-
-  std::mutex m_Mutex{};
-
 }; // end of class
 } // end namespace itk
 
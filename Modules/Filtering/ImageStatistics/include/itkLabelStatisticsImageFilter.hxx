@@ -18,9 +18,6 @@
 #ifndef itkLabelStatisticsImageFilter_hxx
 #define itkLabelStatisticsImageFilter_hxx
 
-#include "itkImageLinearConstIteratorWithIndex.h"
-#include "itkImageScanlineConstIterator.h"
-#include "itkTotalProgressReporter.h"
 #include <algorithm> // For min and max.
 
 namespace itk
@@ -53,95 +50,105 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::SetHistogramParameters(con
 
 template <typename TInputImage, typename TLabelImage>
 void
-LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeMap(MapType & m1, MapType & m2) const
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeLabelAccumulators(
+  LabelAccumulatorMapType & accumulators1,
+  LabelAccumulatorMapType & accumulators2) const
 {
-
-  for (auto & m2_value : m2)
+  for (auto & value2 : accumulators2)
   {
     // does this label exist in the cumulative structure yet?
-    auto m1It = m1.find(m2_value.first);
-    if (m1It == m1.end())
+    auto it1 = accumulators1.find(value2.first);
+    if (it1 == accumulators1.end())
     {
-      // move m2 entry into m1, this reuses the histogram if needed.
-      m1.emplace(m2_value.first, std::move(m2_value.second));
+      // move the accumulator, this reuses the histogram if needed.
+      accumulators1.emplace(value2.first, std::move(value2.second));
     }
     else
     {
+      LabelAccumulator &       accumulator1 = it1->second;
+      const LabelAccumulator & accumulator2 = value2.second;
 
+      accumulator1.m_Statistics.Merge(accumulator2.m_Statistics);
 
-      typename MapType::mapped_type & labelStats = m1It->second;
-
-      // accumulate the information from this thread
-      labelStats.m_Count += m2_value.second.m_Count;
-      labelStats.m_Sum += m2_value.second.m_Sum;
-      labelStats.m_SumOfSquares += m2_value.second.m_SumOfSquares;
-
-      if (labelStats.m_Minimum > m2_value.second.m_Minimum)
-      {
-        labelStats.m_Minimum = m2_value.second.m_Minimum;
-      }
-      if (labelStats.m_Maximum < m2_value.second.m_Maximum)
-      {
-        labelStats.m_Maximum = m2_value.second.m_Maximum;
-      }
-
-      // bounding box is min,max pairs
-      for (unsigned int ii = 0; ii < (ImageDimension * 2); ii += 2)
+      for (unsigned int i = 0; i < ImageDimension; ++i)
       {
-        labelStats.m_BoundingBox[ii] = std::min(labelStats.m_BoundingBox[ii], m2_value.second.m_BoundingBox[ii]);
-        labelStats.m_BoundingBox[ii + 1] =
-          std::max(labelStats.m_BoundingBox[ii + 1], m2_value.second.m_BoundingBox[ii + 1]);
+        accumulator1.m_MinimumIndex[i] = std::min(accumulator1.m_MinimumIndex[i], accumulator2.m_MinimumIndex[i]);
+        accumulator1.m_MaximumIndex[i] = std::max(accumulator1.m_MaximumIndex[i], accumulator2.m_MaximumIndex[i]);
       }
 
       // if enabled, update the histogram for this label
       if (m_UseHistograms)
       {
-        typename HistogramType::IndexType index;
-        index.SetSize(1);
         for (unsigned int bin = 0; bin < m_NumBins[0]; ++bin)
         {
-          index[0] = bin;
-          labelStats.m_Histogram->IncreaseFrequency(bin, m2_value.second.m_Histogram->GetFrequency(bin));
+          accumulator1.m_Histogram->IncreaseFrequency(bin, accumulator2.m_Histogram->GetFrequency(bin));
         }
       }
     }
   }
 }
 
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::StreamedGenerateData(unsigned int inputRequestedRegionNumber)
+{
+  Superclass::StreamedGenerateData(inputRequestedRegionNumber);
+
+  m_Partials.MergePiece([this](LabelAccumulatorMapType & accumulators1, LabelAccumulatorMapType & accumulators2) {
+    this->MergeLabelAccumulators(accumulators1, accumulators2);
+  });
+}
+
 template <typename TInputImage, typename TLabelImage>
 void
 LabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterStreamedGenerateData()
 {
   Superclass::AfterStreamedGenerateData();
 
+  LabelAccumulatorMapType accumulators;
+  m_Partials.MergeInto(accumulators,
+                       [this](LabelAccumulatorMapType & accumulators1, LabelAccumulatorMapType & accumulators2) {
+                         this->MergeLabelAccumulators(accumulators1, accumulators2);
+                       });
+
   // compute the remainder of the statistics
-  for (auto & mapValue : m_LabelStatistics)
+  m_LabelStatistics.clear();
+  m_LabelStatistics.reserve(accumulators.size());
+  for (auto & value : accumulators)
   {
-    typename MapType::mapped_type & labelStats = mapValue.second;
+    const LabelAccumulator & accumulator = value.second;
+    const auto &             statistics = accumulator.m_Statistics;
 
-    labelStats.m_Mean = labelStats.m_Sum / static_cast<RealType>(labelStats.m_Count);
+    LabelStatistics labelStats;
+    labelStats.m_Count = statistics.GetCount();
+    labelStats.m_Minimum = static_cast<RealType>(statistics.GetMinimum());
+    labelStats.m_Maximum = static_cast<RealType>(statistics.GetMaximum());
+    labelStats.m_Sum = statistics.GetSum();
+    labelStats.m_SumOfSquares = statistics.GetSumOfSquares();
+    labelStats.m_Mean = statistics.GetMean();
 
     // variance
     if (labelStats.m_Count > 1)
     {
       // unbiased estimate of variance
-      LabelStatistics & ls = mapValue.second;
-      const RealType    sumSquared = ls.m_Sum * ls.m_Sum;
-      const auto        count = static_cast<RealType>(ls.m_Count);
-
-      ls.m_Variance = (ls.m_SumOfSquares - sumSquared / count) / (count - 1.0);
-    }
-    else
-    {
-      labelStats.m_Variance = RealType{};
+      labelStats.m_Variance = statistics.GetVariance();
     }
 
     // sigma
-    labelStats.m_Sigma = 0.0;
     if (labelStats.m_Variance >= 0.0)
     {
       labelStats.m_Sigma = std::sqrt(labelStats.m_Variance);
     }
+
+    // bounding box is min,max pairs
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      labelStats.m_BoundingBox[2 * i] = accumulator.m_MinimumIndex[i];
+      labelStats.m_BoundingBox[2 * i + 1] = accumulator.m_MaximumIndex[i];
+    }
+    labelStats.m_Histogram = accumulator.m_Histogram;
+
+    m_LabelStatistics.emplace(value.first, std::move(labelStats));
   }
 
   {
@@ -160,111 +167,71 @@ void
 LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateData(
   const RegionType & outputRegionForThread)
 {
-
-  MapType localStatistics;
+  LabelAccumulatorMapType localAccumulators;
 
   typename HistogramType::IndexType             histogramIndex(1);
   typename HistogramType::MeasurementVectorType histogramMeasurement(1);
 
-  const SizeValueType size0 = outputRegionForThread.GetSize(0);
-  if (size0 == 0)
-  {
-    return;
-  }
-
-  ImageLinearConstIteratorWithIndex<TInputImage> it(this->GetInput(), outputRegionForThread);
-
-  ImageScanlineConstIterator labelIt(this->GetLabelInput(), outputRegionForThread);
-
-  auto mapIt = localStatistics.end();
-
-  // do the work
-  while (!it.IsAtEnd())
-  {
-    while (!it.IsAtEndOfLine())
+  // Add the pixels of each run of a label along a line at once, after a
+  // single lookup of the label.
+  const auto addLine = [&](const IndexType &      lineIndex,
+                           const SizeValueType    lineLength,
+                           const PixelType *      pixels,
+                           const LabelPixelType * labels) {
+    SizeValueType runStart = 0;
+    while (runStart < lineLength)
     {
-      const RealType & value = static_cast<RealType>(it.Get());
-
-      const LabelPixelType & label = labelIt.Get();
+      const LabelPixelType label = labels[runStart];
+      SizeValueType        runEnd = runStart + 1;
+      while (runEnd < lineLength && labels[runEnd] == label)
+      {
+        ++runEnd;
+      }
 
-      // is the label already in this thread?
-      mapIt = localStatistics.find(label);
-      if (mapIt == localStatistics.end())
+      auto mapIt = localAccumulators.find(label);
+      if (mapIt == localAccumulators.end())
       {
-        // create a new statistics object
+        // create a new accumulator, with its histogram if enabled
+        LabelAccumulator accumulator;
         if (m_UseHistograms)
         {
-          mapIt = localStatistics.emplace(label, LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound)).first;
-        }
-        else
-        {
-          mapIt = localStatistics.emplace(label, LabelStatistics()).first;
+          accumulator.m_Histogram = LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound).m_Histogram;
         }
+        mapIt = localAccumulators.emplace(label, std::move(accumulator)).first;
       }
 
-      typename MapType::mapped_type & labelStats = mapIt->second;
-
-      // update the values for this label and this thread
-      if (value < labelStats.m_Minimum)
-      {
-        labelStats.m_Minimum = value;
-      }
-      if (value > labelStats.m_Maximum)
-      {
-        labelStats.m_Maximum = value;
-      }
+      LabelAccumulator & accumulator = mapIt->second;
+      accumulator.m_Statistics.AddPixels(pixels + runStart, runEnd - runStart);
 
-      // bounding box is min,max pairs
-      for (unsigned int i = 0; i < (2 * TInputImage::ImageDimension); i += 2)
+      // bounding box of the first and the last pixel of the run
+      for (unsigned int i = 1; i < ImageDimension; ++i)
       {
-        const IndexType & index = it.GetIndex();
-        labelStats.m_BoundingBox[i] = std::min(labelStats.m_BoundingBox[i], index[i / 2]);
-        labelStats.m_BoundingBox[i + 1] = std::max(labelStats.m_BoundingBox[i + 1], index[i / 2]);
+        accumulator.m_MinimumIndex[i] = std::min(accumulator.m_MinimumIndex[i], lineIndex[i]);
+        accumulator.m_MaximumIndex[i] = std::max(accumulator.m_MaximumIndex[i], lineIndex[i]);
       }
-
-      labelStats.m_Sum += value;
-      labelStats.m_SumOfSquares += (value * value);
-      labelStats.m_Count++;
+      accumulator.m_MinimumIndex[0] =
+        std::min(accumulator.m_MinimumIndex[0], lineIndex[0] + static_cast<IndexValueType>(runStart));
+      accumulator.m_MaximumIndex[0] =
+        std::max(accumulator.m_MaximumIndex[0], lineIndex[0] + static_cast<IndexValueType>(runEnd - 1));
 
       // if enabled, update the histogram for this label
       if (m_UseHistograms)
       {
-        histogramMeasurement[0] = value;
-        labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
-        labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        for (SizeValueType i = runStart; i < runEnd; ++i)
+        {
+          histogramMeasurement[0] = static_cast<RealType>(pixels[i]);
+          accumulator.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+          accumulator.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        }
       }
 
-
-      ++labelIt;
-      ++it;
+      runStart = runEnd;
     }
-    labelIt.NextLine();
-    it.NextLine();
-  }
-
-
-  // Merge localStatistics and m_LabelStatistics concurrently safe in a
-  // local copy, this thread may do multiple merges.
-  while (true)
-  {
-    MapType tomerge{};
-    {
-      const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  };
 
-      if (m_LabelStatistics.empty())
-      {
-        swap(m_LabelStatistics, localStatistics);
-        break;
-      }
+  ImageReduction::ForEachLine(outputRegionForThread, addLine, *this->GetInput(), *this->GetLabelInput());
 
-      // Move the data of the output map to the local `tomerge` and clear the output map.
-      swap(m_LabelStatistics, tomerge);
-
-    } // release lock, allow other threads to merge data
-
-    // Merge tomerge into localStatistics, locally
-    MergeMap(localStatistics, tomerge);
-  }
+  m_Partials.Add(outputRegionForThread, std::move(localAccumulators));
 }
 
 template <typename TInputImage, typename TLabelImage>
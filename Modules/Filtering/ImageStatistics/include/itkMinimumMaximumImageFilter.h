@@ -20,9 +20,7 @@
 
 #include "itkImageSink.h"
 #include "itkSimpleDataObjectDecorator.h"
-#include <mutex>
-
-#include <vector>
+#include "itkImageReduction.h"
 
 #include "itkNumericTraits.h"
 
@@ -132,6 +130,11 @@ protected:
   void
   AfterStreamedGenerateData() override;
 
+  /** Merge the partial reductions of the piece after its threads run, so
+   * that only those of one piece are kept. */
+  void
+  StreamedGenerateData(unsigned int inputRequestedRegionNumber) override;
+
   void
   ThreadedStreamedGenerateData(const RegionType &) override;
 
@@ -140,10 +143,10 @@ protected:
   itkSetDecoratedOutputMacro(Maximum, PixelType);
 
 private:
-  PixelType m_ThreadMin{};
-  PixelType m_ThreadMax{};
+  using AccumulatorType =
+    Reduction::CompositeAccumulator<Reduction::MinimumAccumulator<PixelType>, Reduction::MaximumAccumulator<PixelType>>;
 
-  std::mutex m_Mutex{};
+  ImageReductionPartials<AccumulatorType, InputImageDimension> m_Partials{};
 };
 } // end namespace itk
 
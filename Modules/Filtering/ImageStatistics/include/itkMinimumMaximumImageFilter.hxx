@@ -19,11 +19,6 @@
 #define itkMinimumMaximumImageFilter_hxx
 
 
-#include "itkImageScanlineIterator.h"
-#include <mutex>
-
-#include <vector>
-
 namespace itk
 {
 template <typename TInputImage>
@@ -50,8 +45,16 @@ MinimumMaximumImageFilter<TInputImage>::BeforeStreamedGenerateData()
 {
   Superclass::BeforeStreamedGenerateData();
 
-  m_ThreadMin = NumericTraits<PixelType>::max();
-  m_ThreadMax = NumericTraits<PixelType>::NonpositiveMin();
+  m_Partials.Clear();
+}
+
+template <typename TInputImage>
+void
+MinimumMaximumImageFilter<TInputImage>::StreamedGenerateData(unsigned int inputRequestedRegionNumber)
+{
+  Superclass::StreamedGenerateData(inputRequestedRegionNumber);
+
+  m_Partials.MergePiece();
 }
 
 template <typename TInputImage>
@@ -60,8 +63,11 @@ MinimumMaximumImageFilter<TInputImage>::AfterStreamedGenerateData()
 {
   Superclass::AfterStreamedGenerateData();
 
-  this->SetMinimum(m_ThreadMin);
-  this->SetMaximum(m_ThreadMax);
+  AccumulatorType accumulator;
+  m_Partials.MergeInto(accumulator);
+
+  this->SetMinimum(accumulator.GetMinimum());
+  this->SetMaximum(accumulator.GetMaximum());
 }
 
 template <typename TInputImage>
@@ -73,48 +79,9 @@ MinimumMaximumImageFilter<TInputImage>::ThreadedStreamedGenerateData(const Regio
     return;
   }
 
-  PixelType localMin = NumericTraits<PixelType>::max();
-  PixelType localMax = NumericTraits<PixelType>::NonpositiveMin();
-
-  ImageScanlineConstIterator it(this->GetInput(), regionForThread);
-
-
-  // do the work
-  while (!it.IsAtEnd())
-  {
-    // Handle the odd pixel separately
-    if (regionForThread.GetSize(0) % 2 == 1)
-    {
-      const PixelType value = it.Get();
-      localMin = std::min(value, localMin);
-      localMax = std::max(value, localMax);
-      ++it;
-    }
-
-    while (!it.IsAtEndOfLine())
-    {
-      const PixelType value1 = it.Get();
-      ++it;
-      const PixelType value2 = it.Get();
-      ++it;
-
-      if (value1 > value2)
-      {
-        localMax = std::max(value1, localMax);
-        localMin = std::min(value2, localMin);
-      }
-      else
-      {
-        localMax = std::max(value2, localMax);
-        localMin = std::min(value1, localMin);
-      }
-    }
-    it.NextLine();
-  }
-
-  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
-  m_ThreadMin = std::min(localMin, m_ThreadMin);
-  m_ThreadMax = std::max(localMax, m_ThreadMax);
+  AccumulatorType accumulator;
+  ImageReduction::Accumulate(*this->GetInput(), regionForThread, accumulator);
+  m_Partials.Add(regionForThread, std::move(accumulator));
 }
 
 template <typename TImage>
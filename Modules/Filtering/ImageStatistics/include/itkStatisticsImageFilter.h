@@ -22,8 +22,7 @@
 #include "itkNumericTraits.h"
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
-#include <mutex>
-#include "itkCompensatedSummation.h"
+#include "itkImageReduction.h"
 
 namespace itk
 {
@@ -39,11 +38,14 @@ namespace itk
  * This filter is automatically multi-threaded and can stream its
  * input when NumberOfStreamDivisions is set to more than
  * one. Statistics are independently computed for each streamed and
- * threaded region then merged.
+ * threaded region then merged, in the order of the regions, so that the
+ * results do not depend on the scheduling of the threads.
  *
  * Internally a compensated summation algorithm is used for the
  * accumulation of intensities to improve accuracy for large images.
  *
+ * \sa Reduction::StatisticsAccumulator
+ *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
  *
@@ -152,6 +154,11 @@ protected:
   void
   AfterStreamedGenerateData() override;
 
+  /** Merge the partial reductions of the piece after its threads run, so
+   * that only those of one piece are kept. */
+  void
+  StreamedGenerateData(unsigned int inputRequestedRegionNumber) override;
+
   void
   ThreadedStreamedGenerateData(const RegionType &) override;
 
@@ -164,14 +171,11 @@ protected:
   itkSetDecoratedOutputMacro(SumOfSquares, RealType);
 
 private:
-  CompensatedSummation<RealType> m_ThreadSum{ 1 };
-  CompensatedSummation<RealType> m_SumOfSquares{ 1 };
+  using AccumulatorType = Reduction::StatisticsAccumulator<PixelType, RealType>;
 
   SizeValueType m_Count{ 1 };
-  PixelType     m_ThreadMin{ 1 };
-  PixelType     m_ThreadMax{ 1 };
 
-  std::mutex m_Mutex{};
+  ImageReductionPartials<AccumulatorType, ImageDimension> m_Partials{};
 }; // end of class
 } // end namespace itk
 
@@ -19,9 +19,6 @@
 #define itkStatisticsImageFilter_hxx
 
 
-#include "itkImageScanlineIterator.h"
-#include <mutex>
-
 namespace itk
 {
 template <typename TInputImage>
@@ -59,12 +56,16 @@ StatisticsImageFilter<TInputImage>::BeforeStreamedGenerateData()
 {
   Superclass::BeforeStreamedGenerateData();
 
-  // Resize the thread temporaries
-  m_Count = SizeValueType{};
-  m_SumOfSquares = RealType{};
-  m_ThreadSum = RealType{};
-  m_ThreadMin = NumericTraits<PixelType>::max();
-  m_ThreadMax = NumericTraits<PixelType>::NonpositiveMin();
+  m_Partials.Clear();
+}
+
+template <typename TInputImage>
+void
+StatisticsImageFilter<TInputImage>::StreamedGenerateData(unsigned int inputRequestedRegionNumber)
+{
+  Superclass::StreamedGenerateData(inputRequestedRegionNumber);
+
+  m_Partials.MergePiece();
 }
 
 template <typename TInputImage>
@@ -73,64 +74,27 @@ StatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
 {
   Superclass::AfterStreamedGenerateData();
 
-  const SizeValueType count = m_Count;
-  const RealType      sumOfSquares(m_SumOfSquares);
-  const PixelType     minimum = m_ThreadMin;
-  const PixelType     maximum = m_ThreadMax;
-  const RealType      sum(m_ThreadSum);
-
-  const RealType mean = sum / static_cast<RealType>(count);
-  const RealType variance =
-    (sumOfSquares - (sum * sum / static_cast<RealType>(count))) / (static_cast<RealType>(count) - 1);
-  const RealType sigma = std::sqrt(variance);
+  AccumulatorType accumulator;
+  m_Partials.MergeInto(accumulator);
+  m_Count = accumulator.GetCount();
 
   // Set the outputs
-  this->SetMinimum(minimum);
-  this->SetMaximum(maximum);
-  this->SetMean(mean);
-  this->SetSigma(sigma);
-  this->SetVariance(variance);
-  this->SetSum(sum);
-  this->SetSumOfSquares(sumOfSquares);
+  this->SetMinimum(accumulator.GetMinimum());
+  this->SetMaximum(accumulator.GetMaximum());
+  this->SetMean(accumulator.GetMean());
+  this->SetSigma(accumulator.GetSigma());
+  this->SetVariance(accumulator.GetVariance());
+  this->SetSum(accumulator.GetSum());
+  this->SetSumOfSquares(accumulator.GetSumOfSquares());
 }
 
 template <typename TInputImage>
 void
 StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread)
 {
-
-  CompensatedSummation<RealType> sum = RealType{};
-  CompensatedSummation<RealType> sumOfSquares = RealType{};
-  SizeValueType                  count{};
-  PixelType                      min = NumericTraits<PixelType>::max();
-  PixelType                      max = NumericTraits<PixelType>::NonpositiveMin();
-
-  ImageScanlineConstIterator it(this->GetInput(), regionForThread);
-
-  // do the work
-  while (!it.IsAtEnd())
-  {
-    while (!it.IsAtEndOfLine())
-    {
-      const PixelType & value = it.Get();
-      const auto        realValue = static_cast<RealType>(value);
-      min = std::min(min, value);
-      max = std::max(max, value);
-
-      sum += realValue;
-      sumOfSquares += (realValue * realValue);
-      ++count;
-      ++it;
-    }
-    it.NextLine();
-  }
-
-  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
-  m_ThreadSum += sum;
-  m_SumOfSquares += sumOfSquares;
-  m_Count += count;
-  m_ThreadMin = std::min(min, m_ThreadMin);
-  m_ThreadMax = std::max(max, m_ThreadMax);
+  AccumulatorType accumulator;
+  ImageReduction::Accumulate(*this->GetInput(), regionForThread, accumulator);
+  m_Partials.Add(regionForThread, std::move(accumulator));
 }
 
 template <typename TImage>
@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkLabelStatisticsImageFilter.h"
+
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+#include <map>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<short, Dimension>;
+using LabelImageType = itk::Image<unsigned char, Dimension>;
+using FilterType = itk::LabelStatisticsImageFilter<ImageType, LabelImageType>;
+using RegionType = ImageType::RegionType;
+
+const RegionType imageRegion({ { 1, -2, 3 } }, { { 45, 11, 6 } });
+
+// The statistics of a label, computed pixel by pixel.
+struct ExpectedStatistics
+{
+  itk::SizeValueType          count{};
+  double                      minimum{ itk::NumericTraits<double>::max() };
+  double                      maximum{ itk::NumericTraits<double>::NonpositiveMin() };
+  double                      sum{};
+  double                      sumOfSquares{};
+  FilterType::BoundingBoxType boundingBox{};
+};
+
+template <typename TImage>
+typename TImage::Pointer
+CreateImage()
+{
+  const auto image = TImage::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+  return image;
+}
+
+// Creates an image and a label image whose labels have runs of various lengths
+// along the lines.
+std::pair<ImageType::Pointer, LabelImageType::Pointer>
+CreateImages()
+{
+  const auto image = CreateImage<ImageType>();
+  const auto labelImage = CreateImage<LabelImageType>();
+
+  int value = 1;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(imageRegion))
+  {
+    value = (value * 37 + 11) % 1001;
+    image->SetPixel(index, static_cast<short>(value - 500));
+    labelImage->SetPixel(index, static_cast<unsigned char>(((index[0] / (1 + std::abs(index[1]) % 4)) + index[2]) % 5));
+  }
+  return { image, labelImage };
+}
+
+std::map<unsigned char, ExpectedStatistics>
+ComputeExpectedStatistics(const ImageType & image, const LabelImageType & labelImage)
+{
+  std::map<unsigned char, ExpectedStatistics> expectedStatistics;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(imageRegion))
+  {
+    auto &       statistics = expectedStatistics[labelImage.GetPixel(index)];
+    const double value = image.GetPixel(index);
+    if (statistics.count == 0)
+    {
+      for (unsigned int i = 0; i < Dimension; ++i)
+      {
+        statistics.boundingBox.push_back(index[i]);
+        statistics.boundingBox.push_back(index[i]);
+      }
+    }
+    ++statistics.count;
+    statistics.minimum = std::min(statistics.minimum, value);
+    statistics.maximum = std::max(statistics.maximum, value);
+    statistics.sum += value;
+    statistics.sumOfSquares += value * value;
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      statistics.boundingBox[2 * i] = std::min(statistics.boundingBox[2 * i], index[i]);
+      statistics.boundingBox[2 * i + 1] = std::max(statistics.boundingBox[2 * i + 1], index[i]);
+    }
+  }
+  return expectedStatistics;
+}
+} // namespace
+
+
+// Tests that the filter computes the statistics, the bounding box and the
+// histogram of each label, with several threads and stream divisions.
+TEST(LabelStatisticsImageFilter, ComputesStatisticsOfLabels)
+{
+  const auto [image, labelImage] = CreateImages();
+  const auto expectedStatistics = ComputeExpectedStatistics(*image, *labelImage);
+
+  for (const unsigned int numberOfStreamDivisions : { 1, 3 })
+  {
+    const auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetLabelInput(labelImage);
+    filter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+    filter->SetNumberOfWorkUnits(4);
+    filter->SetHistogramParameters(10, -500.0, 500.0);
+    filter->Update();
+
+    ASSERT_EQ(filter->GetNumberOfLabels(), expectedStatistics.size());
+    for (const auto & [label, expected] : expectedStatistics)
+    {
+      ASSERT_TRUE(filter->HasLabel(label));
+      EXPECT_EQ(filter->GetCount(label), expected.count);
+      EXPECT_EQ(filter->GetMinimum(label), expected.minimum);
+      EXPECT_EQ(filter->GetMaximum(label), expected.maximum);
+      EXPECT_EQ(filter->GetSum(label), expected.sum);
+      EXPECT_DOUBLE_EQ(filter->GetMean(label), expected.sum / expected.count);
+      const double variance =
+        (expected.sumOfSquares - expected.sum * expected.sum / expected.count) / (expected.count - 1.0);
+      EXPECT_NEAR(filter->GetVariance(label), variance, 1e-9 * variance);
+      EXPECT_EQ(filter->GetBoundingBox(label), expected.boundingBox);
+
+      const auto histogram = filter->GetHistogram(label);
+      ASSERT_NE(histogram, nullptr);
+      EXPECT_EQ(histogram->GetTotalFrequency(), expected.count);
+    }
+  }
+}
+
+
+// Tests that the filter computes the same statistics when it runs again with
+// the same work units.
+TEST(LabelStatisticsImageFilter, IsDeterministic)
+{
+  const auto [image, labelImage] = CreateImages();
+
+  const auto filter1 = FilterType::New();
+  filter1->SetInput(image);
+  filter1->SetLabelInput(labelImage);
+  filter1->SetNumberOfWorkUnits(8);
+  filter1->Update();
+
+  for (int run = 0; run < 5; ++run)
+  {
+    const auto filter2 = FilterType::New();
+    filter2->SetInput(image);
+    filter2->SetLabelInput(labelImage);
+    filter2->SetNumberOfWorkUnits(8);
+    filter2->Update();
+
+    for (const auto label : filter1->GetValidLabelValues())
+    {
+      EXPECT_EQ(filter2->GetSum(label), filter1->GetSum(label));
+      EXPECT_EQ(filter2->GetVariance(label), filter1->GetVariance(label));
+    }
+  }
+}
@@ -34,6 +34,12 @@ namespace itk
  * https://doi.org/10.54294/igq8fn
  *
  *
+ * The sums over the boxes are computed separably, with running sums along
+ * the lines of each direction, so that the cost per pixel does not depend on
+ * the radius. The boxes are cropped at the border of the image.
+ *
+ * \sa BoxSumFunction
+ *
  * \author Richard Beare
  * \ingroup ITKSmoothing
  */
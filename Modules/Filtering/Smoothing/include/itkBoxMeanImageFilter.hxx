@@ -46,27 +46,22 @@ BoxMeanImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 {
   // Accumulate type is too small
   using AccPixType = typename NumericTraits<PixelType>::RealType;
-  using AccumImageType = Image<AccPixType, TInputImage::ImageDimension>;
-
-  typename TInputImage::SizeType internalRadius;
-  for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
-  {
-    internalRadius[i] = this->GetRadius()[i] + 1;
-  }
 
   const InputImageType * inputImage = this->GetInput();
   OutputImageType *      outputImage = this->GetOutput();
-  RegionType             accumRegion = outputRegionForThread;
-  accumRegion.PadByRadius(internalRadius);
-  accumRegion.Crop(inputImage->GetRequestedRegion());
-
-  auto accImage = AccumImageType::New();
-  accImage->SetRegions(accumRegion);
-  accImage->Allocate();
+  const RegionType       inputRegion = inputImage->GetRequestedRegion();
 
-  BoxAccumulateFunction<TInputImage, AccumImageType>(inputImage, accImage, accumRegion, accumRegion);
-  BoxMeanCalculatorFunction<AccumImageType, TOutputImage>(
-    accImage.GetPointer(), outputImage, accumRegion, outputRegionForThread, this->GetRadius());
+  const std::vector<AccPixType> sums = BoxSumFunction<AccPixType>(
+    inputImage, inputRegion, outputRegionForThread, this->GetRadius(), false, [](const PixelType & value) {
+      return value;
+    });
+  BoxCalculatorFunction(outputImage,
+                        inputRegion,
+                        outputRegionForThread,
+                        this->GetRadius(),
+                        [&sums](SizeValueType position, SizeValueType pixelCount) {
+                          return static_cast<OutputPixelType>(sums[position] / static_cast<AccPixType>(pixelCount));
+                        });
 }
 } // end namespace itk
 #endif
@@ -47,28 +47,29 @@ BoxSigmaImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 {
   // Accumulate type is too small
   using AccValueType = typename itk::NumericTraits<PixelType>::RealType;
-  using AccPixType = typename itk::Vector<AccValueType, 2>;
-  using AccumImageType = typename itk::Image<AccPixType, TInputImage::ImageDimension>;
-
-  typename TInputImage::SizeType internalRadius;
-  for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
-  {
-    internalRadius[i] = this->GetRadius()[i] + 1;
-  }
 
   const InputImageType * inputImage = this->GetInput();
   OutputImageType *      outputImage = this->GetOutput();
-  RegionType             accumRegion = outputRegionForThread;
-  accumRegion.PadByRadius(internalRadius);
-  accumRegion.Crop(inputImage->GetRequestedRegion());
-
-  auto accImage = AccumImageType::New();
-  accImage->SetRegions(accumRegion);
-  accImage->Allocate();
+  const RegionType       inputRegion = inputImage->GetRequestedRegion();
 
-  BoxSquareAccumulateFunction<TInputImage, AccumImageType>(inputImage, accImage, accumRegion, accumRegion);
-  BoxSigmaCalculatorFunction<AccumImageType, TOutputImage>(
-    accImage, outputImage, accumRegion, outputRegionForThread, this->GetRadius());
+  const std::vector<AccValueType> sums = BoxSumFunction<AccValueType>(
+    inputImage, inputRegion, outputRegionForThread, this->GetRadius(), false, [](const PixelType & value) {
+      return value;
+    });
+  const std::vector<AccValueType> squareSums = BoxSumFunction<AccValueType>(
+    inputImage, inputRegion, outputRegionForThread, this->GetRadius(), false, [](const PixelType & value) {
+      return static_cast<AccValueType>(value) * static_cast<AccValueType>(value);
+    });
+  BoxCalculatorFunction(outputImage,
+                        inputRegion,
+                        outputRegionForThread,
+                        this->GetRadius(),
+                        [&sums, &squareSums](SizeValueType position, SizeValueType pixelCount) {
+                          const AccValueType sum = sums[position];
+                          const auto         count = static_cast<AccValueType>(pixelCount);
+                          return static_cast<OutputPixelType>(
+                            std::sqrt((squareSums[position] - sum * sum / count) / (count - 1)));
+                        });
 }
 } // end namespace itk
 #endif
@@ -27,7 +27,9 @@
 #include "itkOffset.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkImageScanlineIterator.h"
 #include <algorithm> // For min.
+#include <vector>
 
 /*
  *
@@ -89,6 +91,104 @@ setConnectivityEarlyBox(TIterator * it, bool fullyConnected = false)
   return it;
 }
 
+// Sum, along the given direction of a buffer of the given size, the values
+// over the boxes of the given radius that are centered on the numberOfCenters
+// positions starting at firstCenter. The lines are processed together, one
+// position after the other, so that the memory is accessed contiguously, and
+// the sums are updated by adding the value that enters the box and
+// subtracting the value that leaves it, with Kahan compensation of the
+// rounding errors. The values outside the buffer are zero, or, when
+// replicateBorder is true, those of the nearest position of the buffer.
+template <typename TAccumulate, unsigned int VDimension>
+void
+BoxSumAlongDirection(const std::vector<TAccumulate> & input,
+                     const itk::Size<VDimension> &    inputSize,
+                     unsigned int                     direction,
+                     itk::OffsetValueType             firstCenter,
+                     itk::SizeValueType               numberOfCenters,
+                     itk::SizeValueType               radius,
+                     bool                             replicateBorder,
+                     std::vector<TAccumulate> &       output)
+{
+  itk::SizeValueType numberOfInnerValues = 1;
+  for (unsigned int d = 0; d < direction; ++d)
+  {
+    numberOfInnerValues *= inputSize[d];
+  }
+  itk::SizeValueType numberOfOuterValues = 1;
+  for (unsigned int d = direction + 1; d < VDimension; ++d)
+  {
+    numberOfOuterValues *= inputSize[d];
+  }
+  const auto lineLength = static_cast<itk::OffsetValueType>(inputSize[direction]);
+  const auto boxRadius = static_cast<itk::OffsetValueType>(radius);
+
+  output.resize(numberOfOuterValues * numberOfCenters * numberOfInnerValues);
+  std::vector<TAccumulate> compensation(numberOfInnerValues);
+
+  for (itk::SizeValueType outer = 0; outer < numberOfOuterValues; ++outer)
+  {
+    const TAccumulate * in = input.data() + outer * lineLength * numberOfInnerValues;
+    TAccumulate *       out = output.data() + outer * numberOfCenters * numberOfInnerValues;
+
+    // The values at a position along the direction, or nullptr when they are
+    // zero.
+    const auto valuesAt = [in, lineLength, numberOfInnerValues, replicateBorder](itk::OffsetValueType position) {
+      if (position < 0 || position >= lineLength)
+      {
+        if (!replicateBorder)
+        {
+          return static_cast<const TAccumulate *>(nullptr);
+        }
+        position = std::clamp(position, itk::OffsetValueType{ 0 }, lineLength - 1);
+      }
+      return in + position * numberOfInnerValues;
+    };
+    const auto addValues = [&compensation, numberOfInnerValues](TAccumulate * sums, const TAccumulate * values) {
+      for (itk::SizeValueType i = 0; i < numberOfInnerValues; ++i)
+      {
+        const TAccumulate compensatedValue = values[i] - compensation[i];
+        const TAccumulate sum = sums[i] + compensatedValue;
+        compensation[i] = (sum - sums[i]) - compensatedValue;
+        sums[i] = sum;
+      }
+    };
+    const auto subtractValues = [&compensation, numberOfInnerValues](TAccumulate * sums, const TAccumulate * values) {
+      for (itk::SizeValueType i = 0; i < numberOfInnerValues; ++i)
+      {
+        const TAccumulate compensatedValue = -values[i] - compensation[i];
+        const TAccumulate sum = sums[i] + compensatedValue;
+        compensation[i] = (sum - sums[i]) - compensatedValue;
+        sums[i] = sum;
+      }
+    };
+
+    std::fill_n(out, numberOfInnerValues, TAccumulate{});
+    std::fill(compensation.begin(), compensation.end(), TAccumulate{});
+    for (itk::OffsetValueType position = firstCenter - boxRadius; position <= firstCenter + boxRadius; ++position)
+    {
+      if (const TAccumulate * values = valuesAt(position))
+      {
+        addValues(out, values);
+      }
+    }
+    for (itk::SizeValueType center = 1; center < numberOfCenters; ++center)
+    {
+      TAccumulate * sums = out + center * numberOfInnerValues;
+      std::copy_n(sums - numberOfInnerValues, numberOfInnerValues, sums);
+      const auto centerPosition = firstCenter + static_cast<itk::OffsetValueType>(center);
+      if (const TAccumulate * values = valuesAt(centerPosition + boxRadius))
+      {
+        addValues(sums, values);
+      }
+      if (const TAccumulate * values = valuesAt(centerPosition - boxRadius - 1))
+      {
+        subtractValues(sums, values);
+      }
+    }
+  }
+}
+
 } // namespace itk_impl_details
 
 namespace itk
@@ -615,6 +715,110 @@ BoxSquareAccumulateFunction(const TInputImage *               inputImage,
     noutIt.SetCenterPixel(o);
   }
 }
+
+/** Sum the values that valueFunction returns for the pixels of inputImage
+ * over the boxes of the given radius that are centered on the pixels of
+ * outputRegion, which must be inside inputRegion. The boxes are cropped to
+ * inputRegion, or, when replicateBorder is true, the pixels outside
+ * inputRegion have the value of the nearest pixel of inputRegion, as with
+ * ZeroFluxNeumannBoundaryCondition. The sums are returned in the order of the
+ * pixels of outputRegion.
+ *
+ * Instead of a summed-area table, whose values grow with the size of the
+ * region, the sums are computed separably, one direction after the other, with
+ * running sums along the lines. The cost per pixel is therefore independent
+ * of the radius, and the rounding errors are of the order of those of the sums
+ * of a box. TAccumulate must be a floating point type. */
+template <typename TAccumulate, typename TInputImage, typename TValueFunction>
+std::vector<TAccumulate>
+BoxSumFunction(const TInputImage *                      inputImage,
+               const typename TInputImage::RegionType & inputRegion,
+               const typename TInputImage::RegionType & outputRegion,
+               const typename TInputImage::SizeType &   radius,
+               bool                                     replicateBorder,
+               TValueFunction                           valueFunction)
+{
+  static_assert(std::is_floating_point_v<TAccumulate>, "BoxSumFunction requires a floating point accumulate type.");
+
+  typename TInputImage::RegionType sumRegion = outputRegion;
+  sumRegion.PadByRadius(radius);
+  sumRegion.Crop(inputRegion);
+
+  std::vector<TAccumulate> values;
+  values.reserve(sumRegion.GetNumberOfPixels());
+  for (ImageScanlineConstIterator<TInputImage> it(inputImage, sumRegion); !it.IsAtEnd(); it.NextLine())
+  {
+    while (!it.IsAtEndOfLine())
+    {
+      values.push_back(static_cast<TAccumulate>(valueFunction(it.Get())));
+      ++it;
+    }
+  }
+
+  std::vector<TAccumulate> sums;
+  auto                     sumSize = sumRegion.GetSize();
+  for (unsigned int d = 0; d < TInputImage::ImageDimension; ++d)
+  {
+    itk_impl_details::BoxSumAlongDirection(values,
+                                           sumSize,
+                                           d,
+                                           outputRegion.GetIndex(d) - sumRegion.GetIndex(d),
+                                           outputRegion.GetSize(d),
+                                           radius[d],
+                                           replicateBorder,
+                                           sums);
+    sumSize[d] = outputRegion.GetSize(d);
+    std::swap(values, sums);
+  }
+  return values;
+}
+
+/** Set each pixel of outputRegion to the value that calculatorFunction returns
+ * for the position of the pixel in the order of outputRegion, and the number
+ * of pixels of the box of the given radius centered on the pixel, cropped to
+ * inputRegion. This computes, for instance, the means from the sums of
+ * BoxSumFunction. */
+template <typename TOutputImage, typename TCalculatorFunction>
+void
+BoxCalculatorFunction(TOutputImage *                            outputImage,
+                      const typename TOutputImage::RegionType & inputRegion,
+                      const typename TOutputImage::RegionType & outputRegion,
+                      const typename TOutputImage::SizeType &   radius,
+                      TCalculatorFunction                       calculatorFunction)
+{
+  // The number of pixels of a cropped box is the product of the numbers of
+  // pixels along each direction.
+  std::vector<SizeValueType> pixelCounts[TOutputImage::ImageDimension];
+  for (unsigned int d = 0; d < TOutputImage::ImageDimension; ++d)
+  {
+    const auto inputStart = inputRegion.GetIndex(d);
+    const auto inputEnd = inputStart + static_cast<OffsetValueType>(inputRegion.GetSize(d));
+    for (SizeValueType i = 0; i < outputRegion.GetSize(d); ++i)
+    {
+      const OffsetValueType center = outputRegion.GetIndex(d) + static_cast<OffsetValueType>(i);
+      const OffsetValueType boxRadius = static_cast<OffsetValueType>(radius[d]);
+      pixelCounts[d].push_back(static_cast<SizeValueType>(std::min(center + boxRadius + 1, inputEnd) -
+                                                          std::max(center - boxRadius, inputStart)));
+    }
+  }
+
+  SizeValueType position = 0;
+  for (ImageScanlineIterator<TOutputImage> it(outputImage, outputRegion); !it.IsAtEnd(); it.NextLine())
+  {
+    const auto    lineIndex = it.GetIndex();
+    SizeValueType linePixelCount = 1;
+    for (unsigned int d = 1; d < TOutputImage::ImageDimension; ++d)
+    {
+      linePixelCount *= pixelCounts[d][lineIndex[d] - outputRegion.GetIndex(d)];
+    }
+    for (const SizeValueType pixelCount : pixelCounts[0])
+    {
+      it.Set(calculatorFunction(position, linePixelCount * pixelCount));
+      ++position;
+      ++it;
+    }
+  }
+}
 } // namespace itk
 
 #endif
@@ -36,6 +36,12 @@ namespace itk
  *
  * A mean filter is one of the family of linear filters.
  *
+ * For scalar pixels, the sums over the neighborhoods are computed with
+ * running sums, as by BoxMeanImageFilter, so that the cost per pixel does not
+ * depend on the radius. Unlike BoxMeanImageFilter, the neighborhoods are not
+ * cropped at the border of the image: the pixels outside the image have the
+ * value of the nearest pixel of the image.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -108,21 +114,15 @@ protected:
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
-  template <typename TPixelAccessPolicy, typename TPixelType>
-  static void
-  GenerateDataInSubregion(const TInputImage &                              inputImage,
-                          TOutputImage &                                   outputImage,
-                          const ImageRegion<InputImageDimension> &         imageRegion,
-                          const std::vector<Offset<InputImageDimension>> & neighborhoodOffsets,
-                          const TPixelType *);
-
-  template <typename TPixelAccessPolicy, typename TValue>
-  static void
-  GenerateDataInSubregion(const TInputImage &                              inputImage,
-                          TOutputImage &                                   outputImage,
-                          const ImageRegion<InputImageDimension> &         imageRegion,
-                          const std::vector<Offset<InputImageDimension>> & neighborhoodOffsets,
-                          const VariableLengthVector<TValue> *);
+  /** Create the function which computes the mean of the pixels of a
+   * neighborhood of neighborhoodSize pixels. */
+  template <typename TPixelType>
+  static auto
+  CreateMeanFunction(double neighborhoodSize, unsigned int numberOfComponents, const TPixelType *);
+
+  template <typename TValue>
+  static auto
+  CreateMeanFunction(double neighborhoodSize, unsigned int numberOfComponents, const VariableLengthVector<TValue> *);
 };
 } // end namespace itk
 
@@ -18,13 +18,10 @@
 #ifndef itkMeanImageFilter_hxx
 #define itkMeanImageFilter_hxx
 
-#include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkBoxUtilities.h"
+#include "itkImageNeighborhoodAlgorithm.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
-#include "itkIndexRange.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
-#include "itkShapedImageNeighborhoodRange.h"
 #include "itkDefaultConvertPixelTraits.h"
 
 namespace itk
@@ -45,93 +42,79 @@ MeanImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 
   const auto radius = this->GetRadius();
 
-  // Find the data-set boundary "faces" and the center non-boundary subregion.
-  const auto calculatorResult =
-    NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(*input, outputRegionForThread, radius);
-
-  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
-
-  // Process the non-boundary subregion, using a faster pixel access policy without boundary extrapolation.
-  GenerateDataInSubregion<BufferedImageNeighborhoodPixelAccessPolicy<InputImageType>>(
-    *input,
-    *output,
-    calculatorResult.GetNonBoundaryRegion(),
-    neighborhoodOffsets,
-    static_cast<InputPixelType *>(nullptr));
+  if constexpr (std::is_arithmetic_v<InputPixelType>)
+  {
+    // Sum the scalar pixels with running sums, whose cost per pixel does not
+    // depend on the radius. Replicating the pixels of the buffered region
+    // matches ZeroFluxNeumannBoundaryCondition.
+    const std::vector<InputRealType> sums = BoxSumFunction<InputRealType>(
+      input.GetPointer(), input->GetBufferedRegion(), outputRegionForThread, radius, true, [](InputPixelType value) {
+        return value;
+      });
+    double neighborhoodSize = 1.0;
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      neighborhoodSize *= static_cast<double>(2 * radius[d] + 1);
+    }
 
-  // Process each of the boundary faces. These are N-d regions which border
-  // the edge of the buffer.
-  for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
+    auto sumIterator = sums.cbegin();
+    for (auto & outputPixel : ImageRegionRange<OutputImageType>(*output, outputRegionForThread))
+    {
+      outputPixel = static_cast<OutputPixelType>(*sumIterator / neighborhoodSize);
+      ++sumIterator;
+    }
+  }
+  else
   {
-    GenerateDataInSubregion<ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy<InputImageType>>(
-      *input, *output, boundaryFace, neighborhoodOffsets, static_cast<InputPixelType *>(nullptr));
+    const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
+
+    ImageNeighborhoodAlgorithm::Transform(*input,
+                                          *output,
+                                          outputRegionForThread,
+                                          neighborhoodOffsets,
+                                          CreateMeanFunction(static_cast<double>(neighborhoodOffsets.size()),
+                                                             input->GetNumberOfComponentsPerPixel(),
+                                                             static_cast<InputPixelType *>(nullptr)));
   }
 }
 
 
 template <typename TInputImage, typename TOutputImage>
-template <typename TPixelAccessPolicy, typename TPixelType>
-void
-MeanImageFilter<TInputImage, TOutputImage>::GenerateDataInSubregion(
-  const TInputImage &                              inputImage,
-  TOutputImage &                                   outputImage,
-  const ImageRegion<InputImageDimension> &         imageRegion,
-  const std::vector<Offset<InputImageDimension>> & neighborhoodOffsets,
-  const TPixelType *)
+template <typename TPixelType>
+auto
+MeanImageFilter<TInputImage, TOutputImage>::CreateMeanFunction(double neighborhoodSize,
+                                                               unsigned int,
+                                                               const TPixelType *)
 {
-  const auto neighborhoodSize = static_cast<double>(neighborhoodOffsets.size());
-
-  auto neighborhoodRange = ShapedImageNeighborhoodRange<const InputImageType, TPixelAccessPolicy>(
-    inputImage, Index<InputImageDimension>(), neighborhoodOffsets);
-  auto outputIterator = ImageRegionRange<OutputImageType>(outputImage, imageRegion).begin();
-
-  for (const auto & index : ImageRegionIndexRange<InputImageDimension>(imageRegion))
-  {
-    neighborhoodRange.SetLocation(index);
-
+  return [neighborhoodSize](const auto & neighborhood) {
     auto sum = InputRealType{};
 
-    for (const InputPixelType pixelValue : neighborhoodRange)
+    for (const InputPixelType pixelValue : neighborhood)
     {
       sum += static_cast<InputRealType>(pixelValue);
     }
 
     // get the mean value
-    *outputIterator = static_cast<typename OutputImageType::PixelType>(sum / neighborhoodSize);
-    ++outputIterator;
-  }
+    return static_cast<OutputPixelType>(sum / neighborhoodSize);
+  };
 }
 
 template <typename TInputImage, typename TOutputImage>
-template <typename TPixelAccessPolicy, typename TValueType>
-void
-MeanImageFilter<TInputImage, TOutputImage>::GenerateDataInSubregion(
-  const TInputImage &                              inputImage,
-  TOutputImage &                                   outputImage,
-  const ImageRegion<InputImageDimension> &         imageRegion,
-  const std::vector<Offset<InputImageDimension>> & neighborhoodOffsets,
+template <typename TValueType>
+auto
+MeanImageFilter<TInputImage, TOutputImage>::CreateMeanFunction(
+  double                                   neighborhoodSize,
+  unsigned int                             numberOfComponents,
   const VariableLengthVector<TValueType> *)
 {
-  const auto neighborhoodSize = static_cast<double>(neighborhoodOffsets.size());
-
-  auto neighborhoodRange = ShapedImageNeighborhoodRange<const InputImageType, TPixelAccessPolicy>(
-    inputImage, Index<InputImageDimension>(), neighborhoodOffsets);
-  auto outputIterator = ImageRegionRange<OutputImageType>(outputImage, imageRegion).begin();
-
-  // These temp variable are needed outside the loop for
-  // VariableLengthVectors to avoid memory allocations on a per-pixel
-  // basis.
-  InputRealType   sum(inputImage.GetNumberOfComponentsPerPixel());
-  OutputPixelType out(inputImage.GetNumberOfComponentsPerPixel());
-
-  for (const auto & index : ImageRegionIndexRange<InputImageDimension>(imageRegion))
-  {
-    neighborhoodRange.SetLocation(index);
-
+  // These temp variable are kept by the function for VariableLengthVectors
+  // to avoid memory allocations on a per-pixel basis.
+  return [neighborhoodSize, sum = InputRealType(numberOfComponents), out = OutputPixelType(numberOfComponents)](
+           const auto & neighborhood) mutable -> const OutputPixelType & {
     using PixelComponentType = typename NumericTraits<InputRealType>::ValueType;
     sum.Fill(NumericTraits<PixelComponentType>::Zero);
 
-    for (const InputPixelType pixelValue : neighborhoodRange)
+    for (const InputPixelType pixelValue : neighborhood)
     {
       sum += pixelValue;
     }
@@ -145,9 +128,8 @@ MeanImageFilter<TInputImage, TOutputImage>::GenerateDataInSubregion(
     // implicit assignment reuses the array allocated in the variable out.
     // *DO NOT USE static_cast*
     out = sum;
-    *outputIterator = out;
-    ++outputIterator;
-  }
+    return out;
+  };
 }
 
 
@@ -18,13 +18,8 @@
 #ifndef itkMedianImageFilter_hxx
 #define itkMedianImageFilter_hxx
 
-#include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkImageNeighborhoodAlgorithm.h"
 #include "itkImageNeighborhoodOffsets.h"
-#include "itkImageRegionRange.h"
-#include "itkIndexRange.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
-#include "itkShapedImageNeighborhoodRange.h"
 #include "itkTotalProgressReporter.h"
 
 #include <vector>
@@ -44,17 +39,10 @@ void
 MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  // Allocate output
   OutputImageType *      output = this->GetOutput();
   const InputImageType * input = this->GetInput();
 
-  const auto radius = this->GetRadius();
-
-  // Find the data-set boundary "faces" and the center non-boundary subregion.
-  const auto calculatorResult =
-    NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(*input, outputRegionForThread, radius);
-
-  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
+  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(this->GetRadius());
   const auto neighborhoodSize = neighborhoodOffsets.size();
 
   // All of our neighborhoods have an odd number of pixels, so there is
@@ -62,47 +50,19 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   std::vector<InputPixelType> pixels(neighborhoodSize);
   const auto                  medianIterator = pixels.begin() + (neighborhoodSize / 2);
 
-
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
-  const auto nonBoundaryRegion = calculatorResult.GetNonBoundaryRegion();
-  if (!nonBoundaryRegion.GetSize().empty())
-  {
-    // Process the non-boundary subregion, using a faster pixel access policy without boundary extrapolation.
-    auto neighborhoodRange =
-      ShapedImageNeighborhoodRange<const InputImageType, BufferedImageNeighborhoodPixelAccessPolicy<InputImageType>>(
-        *input, Index<InputImageDimension>(), neighborhoodOffsets);
-    auto outputIterator = ImageRegionRange<OutputImageType>(*output, nonBoundaryRegion).begin();
-
-    for (const auto & index : ImageRegionIndexRange<InputImageDimension>(nonBoundaryRegion))
-    {
-      neighborhoodRange.SetLocation(index);
-      std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
-      std::nth_element(pixels.begin(), medianIterator, pixels.end());
-      *outputIterator = *medianIterator;
-      ++outputIterator;
-      progress.CompletedPixel();
-    }
-  }
-
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
-  {
-    auto neighborhoodRange =
-      ShapedImageNeighborhoodRange<const InputImageType>(*input, Index<InputImageDimension>(), neighborhoodOffsets);
-    auto outputIterator = ImageRegionRange<OutputImageType>(*output, boundaryFace).begin();
-
-    for (const auto & index : ImageRegionIndexRange<InputImageDimension>(boundaryFace))
-    {
-      neighborhoodRange.SetLocation(index);
-      std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
+  ImageNeighborhoodAlgorithm::Transform(
+    *input,
+    *output,
+    outputRegionForThread,
+    neighborhoodOffsets,
+    [&pixels, medianIterator](const auto & neighborhood) {
+      std::copy(neighborhood.begin(), neighborhood.end(), pixels.begin());
       std::nth_element(pixels.begin(), medianIterator, pixels.end());
-      *outputIterator = *medianIterator;
-      ++outputIterator;
-      progress.CompletedPixel();
-    }
-  }
+      return *medianIterator;
+    },
+    &progress);
 }
 } // end namespace itk
 
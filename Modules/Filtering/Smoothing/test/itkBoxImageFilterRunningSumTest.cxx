@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBoxMeanImageFilter.h"
+#include "itkBoxSigmaImageFilter.h"
+#include "itkMeanImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+
+namespace
+{
+// Compute the mean, or the standard deviation, of the pixels of a box by
+// visiting them. The box is cropped to the image, or the pixels outside the
+// image have the value of the nearest pixel of the image.
+template <typename TImage>
+double
+BruteForceStatistic(const TImage *                     image,
+                    const typename TImage::IndexType & center,
+                    const typename TImage::SizeType &  radius,
+                    bool                               replicateBorder,
+                    bool                               sigma)
+{
+  const typename TImage::RegionType region = image->GetBufferedRegion();
+  typename TImage::IndexType        boxStart = center;
+  typename TImage::SizeType         boxSize;
+  for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+  {
+    boxStart[d] -= static_cast<itk::IndexValueType>(radius[d]);
+    boxSize[d] = 2 * radius[d] + 1;
+  }
+
+  double sum = 0.0;
+  double squareSum = 0.0;
+  double count = 0.0;
+  const typename TImage::RegionType box(boxStart, boxSize);
+  for (itk::SizeValueType n = 0; n < box.GetNumberOfPixels(); ++n)
+  {
+    typename TImage::IndexType index = boxStart;
+    itk::SizeValueType         rest = n;
+    bool                       inside = true;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      index[d] += static_cast<itk::IndexValueType>(rest % boxSize[d]);
+      rest /= boxSize[d];
+      const auto first = region.GetIndex(d);
+      const auto last = first + static_cast<itk::IndexValueType>(region.GetSize(d)) - 1;
+      inside = inside && index[d] >= first && index[d] <= last;
+      index[d] = std::clamp(index[d], first, last);
+    }
+    if (inside || replicateBorder)
+    {
+      const auto value = static_cast<double>(image->GetPixel(index));
+      sum += value;
+      squareSum += value * value;
+      count += 1.0;
+    }
+  }
+  return sigma ? std::sqrt((squareSum - sum * sum / count) / (count - 1.0)) : sum / count;
+}
+
+// Filter a random image with radii that are smaller and larger than the
+// image, with various numbers of work units, and compare the output with the
+// statistics of the boxes computed by visiting their pixels.
+template <typename TFilter>
+int
+TestRunningSums(const typename TFilter::InputImageType::SizeType & size,
+                bool                                               replicateBorder,
+                bool                                               sigma,
+                double                                             tolerance)
+{
+  using InputImageType = typename TFilter::InputImageType;
+  using OutputImageType = typename TFilter::OutputImageType;
+  constexpr unsigned int Dimension = InputImageType::ImageDimension;
+
+  typename InputImageType::IndexType start;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    start[d] = 5 - 3 * static_cast<itk::IndexValueType>(d);
+  }
+  const typename InputImageType::RegionType region(start, size);
+
+  auto image = InputImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename InputImageType::PixelType>(generator->GetUniformVariate(0.0, 255.0)));
+  }
+
+  typename InputImageType::SizeType radius;
+  for (const itk::SizeValueType radiusValue : { 1, 4, 12 })
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      radius[d] = radiusValue + d;
+    }
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+    {
+      auto filter = TFilter::New();
+      filter->SetInput(image);
+      filter->SetRadius(radius);
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(filter->GetOutput(), region); !it.IsAtEnd();
+           ++it)
+      {
+        const double expected = BruteForceStatistic(image.GetPointer(), it.GetIndex(), radius, replicateBorder, sigma);
+        const auto   expectedPixel = static_cast<typename OutputImageType::PixelType>(expected);
+        if (tolerance == 0.0 ? it.Get() != expectedPixel : std::abs(it.Get() - expected) > tolerance)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << filter->GetNameOfClass() << ", dimension " << Dimension << ", radius " << radius << ", "
+                    << numberOfWorkUnits << " work units: the output at " << it.GetIndex() << " is "
+                    << static_cast<double>(it.Get()) << " instead of " << expected << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkBoxImageFilterRunningSumTest(int, char *[])
+{
+  using FloatImageType2D = itk::Image<float, 2>;
+  using FloatImageType3D = itk::Image<float, 3>;
+  using CharImageType2D = itk::Image<unsigned char, 2>;
+
+  bool testPassed = true;
+  testPassed &= TestRunningSums<itk::BoxMeanImageFilter<FloatImageType2D, FloatImageType2D>>(
+                  { { 37, 21 } }, false, false, 1e-4) == EXIT_SUCCESS;
+  testPassed &= TestRunningSums<itk::BoxMeanImageFilter<FloatImageType3D, FloatImageType3D>>(
+                  { { 13, 9, 11 } }, false, false, 1e-4) == EXIT_SUCCESS;
+  testPassed &= TestRunningSums<itk::BoxSigmaImageFilter<FloatImageType2D, FloatImageType2D>>(
+                  { { 37, 21 } }, false, true, 1e-3) == EXIT_SUCCESS;
+  testPassed &= TestRunningSums<itk::BoxSigmaImageFilter<FloatImageType3D, FloatImageType3D>>(
+                  { { 13, 9, 11 } }, false, true, 1e-3) == EXIT_SUCCESS;
+  testPassed &= TestRunningSums<itk::MeanImageFilter<FloatImageType2D, FloatImageType2D>>(
+                  { { 37, 21 } }, true, false, 1e-4) == EXIT_SUCCESS;
+  testPassed &= TestRunningSums<itk::MeanImageFilter<FloatImageType3D, FloatImageType3D>>(
+                  { { 13, 9, 11 } }, true, false, 1e-4) == EXIT_SUCCESS;
+  // The sums of integers are exact, so that the truncated means are too.
+  testPassed &= TestRunningSums<itk::MeanImageFilter<CharImageType2D, CharImageType2D>>(
+                  { { 37, 21 } }, true, false, 0.0) == EXIT_SUCCESS;
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Filter a random image along each direction, and compare the result with
+// that of filtering, along the first direction, the image whose axes are
+// swapped. The lines along the first direction are filtered one at a time,
+// and those along the other directions by blocks of adjacent lines.
+template <unsigned int VDimension>
+int
+TestDirections(const itk::Size<VDimension> & size, itk::GaussianOrderEnum order)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using FilterType = itk::RecursiveGaussianImageFilter<ImageType, ImageType>;
+
+  typename ImageType::IndexType start;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    start[d] = 3 - static_cast<itk::IndexValueType>(d);
+  }
+  const typename ImageType::RegionType region(start, size);
+
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1234);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(generator->GetUniformVariate(-100.0, 100.0)));
+  }
+
+  for (unsigned int direction = 1; direction < VDimension; ++direction)
+  {
+    const auto swap = [direction](auto value) {
+      std::swap(value[0], value[direction]);
+      return value;
+    };
+
+    auto swappedImage = ImageType::New();
+    swappedImage->SetRegions(typename ImageType::RegionType(swap(start), swap(size)));
+    swappedImage->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      swappedImage->SetPixel(swap(it.GetIndex()), it.Get());
+    }
+
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetDirection(direction);
+    filter->SetOrder(order);
+    filter->SetSigma(1.5);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    auto swappedFilter = FilterType::New();
+    swappedFilter->SetInput(swappedImage);
+    swappedFilter->SetDirection(0);
+    swappedFilter->SetOrder(order);
+    swappedFilter->SetSigma(1.5);
+    ITK_TRY_EXPECT_NO_EXCEPTION(swappedFilter->Update());
+
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(filter->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      const float expected = swappedFilter->GetOutput()->GetPixel(swap(it.GetIndex()));
+      if (it.Get() != expected)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Dimension " << VDimension << ", order " << order << ", direction " << direction
+                  << ": the output at " << it.GetIndex() << " is " << it.Get() << " instead of " << expected
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkRecursiveGaussianImageFilterDirectionTest(int, char *[])
+{
+  bool testPassed = true;
+  for (const auto order :
+       { itk::GaussianOrderEnum::ZeroOrder, itk::GaussianOrderEnum::FirstOrder, itk::GaussianOrderEnum::SecondOrder })
+  {
+    // Sizes along the first direction that are smaller than, and not a
+    // multiple of, the number of lines filtered together.
+    testPassed &= TestDirections<2>(itk::Size<2>{ { 21, 17 } }, order) == EXIT_SUCCESS;
+    testPassed &= TestDirections<2>(itk::Size<2>{ { 5, 12 } }, order) == EXIT_SUCCESS;
+    testPassed &= TestDirections<3>(itk::Size<3>{ { 19, 6, 11 } }, order) == EXIT_SUCCESS;
+  }
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
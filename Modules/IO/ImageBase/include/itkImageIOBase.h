@@ -39,6 +39,7 @@
 
 #include <fstream>
 #include <string>
+#include <utility>
 
 namespace itk
 {
@@ -545,6 +546,20 @@ public:
   const ArrayOfExtensionsType &
   GetSupportedWriteExtensions() const;
 
+  /** Type for the list of file signatures: the bytes that a file contains at
+   * an offset from its beginning. */
+  using SignatureType = std::pair<SizeValueType, std::string>;
+  using ArrayOfSignaturesType = std::vector<SignatureType>;
+
+  /** This method returns an array with the list of signatures of the files
+   * supported for reading by this ImageIO class. An ImageIO class only has
+   * signatures if every file that it can read has one of them, so that
+   * ImageIOFactory does not need to probe it for the files that have none.
+   * It is empty for the ImageIO classes which do not declare any.
+   */
+  const ArrayOfSignaturesType &
+  GetSupportedReadSignatures() const;
+
   template <typename TPixel>
   void
   SetTypeInfo(const TPixel *);
@@ -874,6 +889,11 @@ protected:
   void
   SetSupportedWriteExtensions(const ArrayOfExtensionsType &);
 
+  /** Insert a signature to the list of supported signatures for reading: the
+   * bytes that the files contain at the given offset. */
+  void
+  AddSupportedReadSignature(const std::string & signature, SizeValueType offset = 0);
+
   /** an implementation of ImageRegionSplitter:GetNumberOfSplits
    */
   virtual unsigned int
@@ -893,6 +913,7 @@ private:
 
   ArrayOfExtensionsType m_SupportedReadExtensions{};
   ArrayOfExtensionsType m_SupportedWriteExtensions{};
+  ArrayOfSignaturesType m_SupportedReadSignatures{};
 };
 
 /** Utility function for writing RAW bytes */
@@ -21,11 +21,23 @@
 
 #include "itkObject.h"
 #include "itkImageIOBase.h"
+#include <map>
+#include <string>
 
 namespace itk
 {
 /** \class ImageIOFactory
  * \brief Create instances of ImageIO objects using an object factory.
+ *
+ * The ImageIO objects are constructed and asked whether they can read or
+ * write the file one at a time, in the order of the registered factories, and
+ * the first one that can is returned. To read a file, its first bytes are read
+ * once, and the ImageIO classes which declare signatures, see
+ * ImageIOBase::GetSupportedReadSignatures(), are skipped when the file has
+ * none of them. The ImageIO classes without signatures are always probed. The
+ * signatures of each ImageIO class are retrieved once, and again whenever the
+ * registered factories change.
+ *
  * \ingroup ITKIOImageBase
  */
 class ITKIOImageBase_EXPORT ImageIOFactory : public Object
@@ -61,6 +73,26 @@ public:
   static ImageIOBasePointer
   CreateImageIO(const char * path, IOFileModeEnum mode);
 
+  /** Statistics of the calls to CanReadFile() and CanWriteFile() made by
+   * CreateImageIO() for an ImageIO class. */
+  struct ProbeStatistics
+  {
+    /** Number of calls. */
+    SizeValueType NumberOfProbes{ 0 };
+    /** Number of calls that returned true. */
+    SizeValueType NumberOfMatches{ 0 };
+    /** Total duration of the calls, in seconds. */
+    double TotalTime{ 0.0 };
+  };
+
+  /** Get the probe statistics of each ImageIO class, by class name. */
+  static std::map<std::string, ProbeStatistics>
+  GetProbeStatistics();
+
+  /** Reset the probe statistics. */
+  static void
+  ResetProbeStatistics();
+
 protected:
   ImageIOFactory();
   ~ImageIOFactory() override;
@@ -65,6 +65,12 @@ ImageIOBase::GetSupportedReadExtensions() const
   return this->m_SupportedReadExtensions;
 }
 
+const ImageIOBase::ArrayOfSignaturesType &
+ImageIOBase::GetSupportedReadSignatures() const
+{
+  return this->m_SupportedReadSignatures;
+}
+
 void
 ImageIOBase::AddSupportedReadExtension(const char * extension)
 {
@@ -89,6 +95,12 @@ ImageIOBase::SetSupportedWriteExtensions(const ArrayOfExtensionsType & extension
   this->m_SupportedWriteExtensions = extensions;
 }
 
+void
+ImageIOBase::AddSupportedReadSignature(const std::string & signature, SizeValueType offset)
+{
+  this->m_SupportedReadSignatures.emplace_back(offset, signature);
+}
+
 void
 ImageIOBase::Resize(const unsigned int numDimensions, const unsigned int * dimensions)
 {
@@ -17,8 +17,12 @@
  *=========================================================================*/
 
 #include "itkImageIOFactory.h"
+#include "itkInternationalizationIOHelpers.h"
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
+#include <vector>
 
 
 namespace itk
@@ -27,45 +31,189 @@ namespace itk
 namespace
 {
 std::mutex createImageIOMutex;
+
+// Number of bytes read from the beginning of a file to match the signatures.
+constexpr SizeValueType probeSize = 4096;
+
+// An ImageIO class provided by the registered factories.
+struct ImageIOFormat
+{
+  std::string                        overrideWithName;
+  std::string                        className;
+  ImageIOBase::ArrayOfSignaturesType readSignatures;
+};
+
+struct ImageIOFactoryState
+{
+  // The enabled overrides of itkImageIOBase for which the formats were last
+  // retrieved, and their formats.
+  std::vector<std::string>   imageIOOverrides;
+  std::vector<ImageIOFormat> imageIOFormats;
+
+  std::map<std::string, ImageIOFactory::ProbeStatistics> probeStatistics;
+};
+
+ImageIOFactoryState &
+GetState()
+{
+  static ImageIOFactoryState state;
+  return state;
 }
 
-ImageIOBase::Pointer
-ImageIOFactory::CreateImageIO(const char * path, IOFileModeEnum mode)
+std::vector<std::string>
+GetImageIOOverrides()
 {
-  std::list<ImageIOBase::Pointer> possibleImageIO;
+  std::vector<std::string> overrides;
+  for (ObjectFactoryBase * factory : ObjectFactoryBase::GetRegisteredFactories())
+  {
+    const std::list<std::string> names = factory->GetClassOverrideNames();
+    const std::list<std::string> withNames = factory->GetClassOverrideWithNames();
+    const std::list<bool>        enableFlags = factory->GetEnableFlags();
 
-  const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
+    auto withName = withNames.cbegin();
+    auto enableFlag = enableFlags.cbegin();
+    for (const std::string & name : names)
+    {
+      if (name == "itkImageIOBase" && *enableFlag)
+      {
+        overrides.push_back(*withName);
+      }
+      ++withName;
+      ++enableFlag;
+    }
+  }
+  return overrides;
+}
+
+ImageIOBase::Pointer
+CreateImageIOOverride(const std::string & overrideWithName)
+{
+  const LightObject::Pointer object = ObjectFactoryBase::CreateInstance("itkImageIOBase", overrideWithName.c_str());
+  auto *                     io = dynamic_cast<ImageIOBase *>(object.GetPointer());
+  if (object && !io)
+  {
+    std::cerr << "Error ImageIO factory did not return an ImageIOBase: " << object->GetNameOfClass() << std::endl;
+  }
+  return io;
+}
 
-  for (auto & allobject : ObjectFactoryBase::CreateAllInstance("itkImageIOBase"))
+// Retrieve the formats of the registered ImageIO classes, unless the
+// registered factories did not change.
+void
+UpdateImageIOFormats()
+{
+  ImageIOFactoryState &    state = GetState();
+  std::vector<std::string> overrides = GetImageIOOverrides();
+  if (overrides == state.imageIOOverrides)
   {
-    auto * io = dynamic_cast<ImageIOBase *>(allobject.GetPointer());
-    if (io)
+    return;
+  }
+  state.imageIOFormats.clear();
+  for (const std::string & overrideWithName : overrides)
+  {
+    if (const ImageIOBase::Pointer io = CreateImageIOOverride(overrideWithName))
     {
-      possibleImageIO.emplace_back(io);
+      state.imageIOFormats.push_back({ overrideWithName, io->GetNameOfClass(), io->GetSupportedReadSignatures() });
     }
-    else
+  }
+  state.imageIOOverrides = std::move(overrides);
+}
+
+// Read the beginning of the file, and return whether it could be opened.
+bool
+ReadFileHeader(const char * path, std::string & header)
+{
+  if (path == nullptr || *path == '\0')
+  {
+    return false;
+  }
+  i18n::I18nIfstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  header.assign(probeSize, '\0');
+  file.read(&header[0], static_cast<std::streamsize>(probeSize));
+  header.resize(static_cast<size_t>(file.gcount()));
+  return true;
+}
+
+// Return whether the beginning of a file definitely has none of the
+// signatures. The signatures which end after the bytes read from a file that
+// is larger cannot be checked, and are assumed to match.
+bool
+HasNoneOfSignatures(const std::string & header, const ImageIOBase::ArrayOfSignaturesType & signatures)
+{
+  if (signatures.empty())
+  {
+    return false;
+  }
+  return std::none_of(signatures.cbegin(), signatures.cend(), [&header](const ImageIOBase::SignatureType & signature) {
+    const SizeValueType end = signature.first + signature.second.size();
+    if (end > probeSize)
     {
-      std::cerr << "Error ImageIO factory did not return an ImageIOBase: " << allobject->GetNameOfClass() << std::endl;
+      return true;
     }
+    return end <= header.size() && header.compare(signature.first, signature.second.size(), signature.second) == 0;
+  });
+}
+} // namespace
+
+ImageIOBase::Pointer
+ImageIOFactory::CreateImageIO(const char * path, IOFileModeEnum mode)
+{
+  if (mode != IOFileModeEnum::ReadMode && mode != IOFileModeEnum::WriteMode)
+  {
+    return nullptr;
   }
-  for (auto & k : possibleImageIO)
+
+  const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
+
+  UpdateImageIOFormats();
+
+  // The ImageIO classes are probed in the order of the registered factories,
+  // skipping those which declare signatures that the file does not have.
+  std::string header;
+  const bool  hasHeader = mode == IOFileModeEnum::ReadMode && ReadFileHeader(path, header);
+
+  for (const ImageIOFormat & format : GetState().imageIOFormats)
   {
-    if (mode == IOFileModeEnum::ReadMode)
+    if (hasHeader && HasNoneOfSignatures(header, format.readSignatures))
     {
-      if (k->CanReadFile(path))
-      {
-        return k;
-      }
+      continue;
     }
-    else if (mode == IOFileModeEnum::WriteMode)
+    const ImageIOBase::Pointer io = CreateImageIOOverride(format.overrideWithName);
+    if (!io)
     {
-      if (k->CanWriteFile(path))
-      {
-        return k;
-      }
+      continue;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const bool canUseFile = mode == IOFileModeEnum::ReadMode ? io->CanReadFile(path) : io->CanWriteFile(path);
+
+    ProbeStatistics & statistics = GetState().probeStatistics[format.className];
+    ++statistics.NumberOfProbes;
+    statistics.NumberOfMatches += canUseFile ? 1 : 0;
+    statistics.TotalTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (canUseFile)
+    {
+      return io;
     }
   }
   return nullptr;
 }
 
+std::map<std::string, ImageIOFactory::ProbeStatistics>
+ImageIOFactory::GetProbeStatistics()
+{
+  const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
+  return GetState().probeStatistics;
+}
+
+void
+ImageIOFactory::ResetProbeStatistics()
+{
+  const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
+  GetState().probeStatistics.clear();
+}
+
 } // end namespace itk
@@ -0,0 +1,257 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageIOFactory.h"
+#include "itkVersion.h"
+#include "itkTestingMacros.h"
+#include <fstream>
+
+namespace
+{
+// ImageIO that reads the files whose name has one of its extensions, and
+// counts its instances.
+class CountingImageIO : public itk::ImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingImageIO);
+
+  using Self = CountingImageIO;
+  using Superclass = itk::ImageIOBase;
+  using Pointer = itk::SmartPointer<Self>;
+
+  bool
+  CanReadFile(const char * fileName) override
+  {
+    return this->HasSupportedReadExtension(fileName);
+  }
+  void
+  ReadImageInformation() override
+  {}
+  void
+  Read(void *) override
+  {}
+  bool
+  CanWriteFile(const char * fileName) override
+  {
+    return this->HasSupportedWriteExtension(fileName);
+  }
+  void
+  WriteImageInformation() override
+  {}
+  void
+  Write(const void *) override
+  {}
+
+protected:
+  CountingImageIO(const char * extension, unsigned int & numberOfInstances)
+  {
+    this->AddSupportedReadExtension(extension);
+    this->AddSupportedWriteExtension(extension);
+    ++numberOfInstances;
+  }
+};
+
+class SignedImageIO : public CountingImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SignedImageIO);
+
+  using Self = SignedImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(SignedImageIO);
+
+  /** Reads the files that start with its signature, whatever their name. */
+  bool
+  CanReadFile(const char * fileName) override
+  {
+    std::ifstream file(fileName, std::ios::binary);
+    char          signature[4] = {};
+    file.read(signature, 4);
+    return file && std::string(signature, 4) == "SIGN";
+  }
+
+  static unsigned int NumberOfInstances;
+
+protected:
+  SignedImageIO()
+    : CountingImageIO(".sgn", NumberOfInstances)
+  {
+    this->AddSupportedReadSignature("SIGN");
+  }
+};
+unsigned int SignedImageIO::NumberOfInstances = 0;
+
+class UnsignedImageIO : public CountingImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(UnsignedImageIO);
+
+  using Self = UnsignedImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(UnsignedImageIO);
+
+  static unsigned int NumberOfInstances;
+
+protected:
+  UnsignedImageIO()
+    : CountingImageIO(".uns", NumberOfInstances)
+  {}
+};
+unsigned int UnsignedImageIO::NumberOfInstances = 0;
+
+template <typename TImageIO>
+class TestImageIOFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(TestImageIOFactory);
+
+  using Self = TestImageIOFactory;
+  using Pointer = itk::SmartPointer<Self>;
+
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "Test ImageIO factory";
+  }
+
+  itkFactorylessNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(TestImageIOFactory);
+
+protected:
+  TestImageIOFactory()
+  {
+    this->RegisterOverride("itkImageIOBase",
+                           (std::string("itk") + TImageIO::New()->GetNameOfClass()).c_str(),
+                           "Test ImageIO",
+                           true,
+                           itk::CreateObjectFunction<TImageIO>::New());
+  }
+};
+
+void
+WriteFile(const std::string & fileName, const char * contents)
+{
+  std::ofstream file(fileName, std::ios::binary);
+  file << contents;
+}
+
+// Create the ImageIO of a file, and check which ImageIO classes were
+// constructed.
+bool
+CheckCreatedImageIO(const std::string & fileName,
+                    itk::IOFileModeEnum mode,
+                    const std::string & expectedClassName,
+                    const unsigned int  expectedNumberOfSignedInstances,
+                    const unsigned int  expectedNumberOfUnsignedInstances)
+{
+  SignedImageIO::NumberOfInstances = 0;
+  UnsignedImageIO::NumberOfInstances = 0;
+  const itk::ImageIOBase::Pointer io = itk::ImageIOFactory::CreateImageIO(fileName.c_str(), mode);
+  const std::string               className = io ? io->GetNameOfClass() : "";
+  if (className != expectedClassName || SignedImageIO::NumberOfInstances != expectedNumberOfSignedInstances ||
+      UnsignedImageIO::NumberOfInstances != expectedNumberOfUnsignedInstances)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "For " << fileName << " in " << mode << ", created \"" << className << "\" instead of \""
+              << expectedClassName << "\", with " << SignedImageIO::NumberOfInstances << " and "
+              << UnsignedImageIO::NumberOfInstances << " instances instead of " << expectedNumberOfSignedInstances
+              << " and " << expectedNumberOfUnsignedInstances << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageIOFactorySignatureTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  // The factory of the ImageIO that has a signature is registered last, so
+  // that it is probed after the other one.
+  auto unsignedFactory = TestImageIOFactory<UnsignedImageIO>::New();
+  auto signedFactory = TestImageIOFactory<SignedImageIO>::New();
+  itk::ObjectFactoryBase::RegisterFactory(unsignedFactory);
+  itk::ObjectFactoryBase::RegisterFactory(signedFactory);
+
+  WriteFile(directory + "/itkImageIOFactorySignatureTest1.uns", "SIGN and more");
+  WriteFile(directory + "/itkImageIOFactorySignatureTest2.txt", "SIGN and more");
+  WriteFile(directory + "/itkImageIOFactorySignatureTest3.txt", "No signature");
+  WriteFile(directory + "/itkImageIOFactorySignatureTest4.sgn", "SIG");
+
+  bool testPassed = true;
+  // The first call retrieves the signatures of each ImageIO.
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest5.sgn", itk::IOFileModeEnum::WriteMode, "SignedImageIO", 2, 2);
+  itk::ImageIOFactory::ResetProbeStatistics();
+
+  // The order of the registered factories is kept, even when a file has the
+  // signature of an ImageIO registered later.
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest1.uns", itk::IOFileModeEnum::ReadMode, "UnsignedImageIO", 0, 1);
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest2.txt", itk::IOFileModeEnum::ReadMode, "SignedImageIO", 1, 1);
+  // The ImageIO with a signature is not constructed for the files without it,
+  // including the files shorter than the signature.
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest3.txt", itk::IOFileModeEnum::ReadMode, "", 0, 1);
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest4.sgn", itk::IOFileModeEnum::ReadMode, "", 0, 1);
+  // Every ImageIO is probed for the files which cannot be read, and for
+  // writing.
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTestMissing.txt", itk::IOFileModeEnum::ReadMode, "", 1, 1);
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest5.sgn", itk::IOFileModeEnum::WriteMode, "SignedImageIO", 1, 1);
+
+  const auto statistics = itk::ImageIOFactory::GetProbeStatistics();
+  ITK_TEST_EXPECT_EQUAL(statistics.at("SignedImageIO").NumberOfProbes, 3u);
+  ITK_TEST_EXPECT_EQUAL(statistics.at("SignedImageIO").NumberOfMatches, 2u);
+  ITK_TEST_EXPECT_EQUAL(statistics.at("UnsignedImageIO").NumberOfProbes, 6u);
+  ITK_TEST_EXPECT_EQUAL(statistics.at("UnsignedImageIO").NumberOfMatches, 1u);
+  ITK_TEST_EXPECT_TRUE(statistics.at("SignedImageIO").TotalTime >= 0.0);
+
+  // The signatures are retrieved again when the factories change.
+  itk::ObjectFactoryBase::UnRegisterFactory(unsignedFactory);
+  testPassed &= CheckCreatedImageIO(
+    directory + "/itkImageIOFactorySignatureTest1.uns", itk::IOFileModeEnum::ReadMode, "SignedImageIO", 2, 0);
+  itk::ObjectFactoryBase::UnRegisterFactory(signedFactory);
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -312,6 +312,8 @@ JPEGImageIO::JPEGImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+
+  this->AddSupportedReadSignature("\xff\xd8");
 }
 
 JPEGImageIO::~JPEGImageIO() = default;
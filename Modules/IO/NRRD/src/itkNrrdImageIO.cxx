@@ -41,6 +41,8 @@ NrrdImageIO::NrrdImageIO()
     this->AddSupportedReadExtension(ext);
   }
 
+  this->AddSupportedReadSignature("NRRD");
+
   this->Self::SetCompressor("");
   this->Self::SetMaximumCompressionLevel(9);
   this->Self::SetCompressionLevel(2);
@@ -287,6 +287,8 @@ PNGImageIO::PNGImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+
+  this->AddSupportedReadSignature(std::string("\x89PNG\r\n\x1a\n", 8));
 }
 
 PNGImageIO::~PNGImageIO() = default;
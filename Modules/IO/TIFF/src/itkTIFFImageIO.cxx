@@ -233,6 +233,15 @@ TIFFImageIO::TIFFImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+
+  // Classic and BigTIFF headers, in little and big endian.
+  const std::string signatures[] = {
+    std::string("II*\0", 4), std::string("MM\0*", 4), std::string("II+\0", 4), std::string("MM\0+", 4)
+  };
+  for (const auto & signature : signatures)
+  {
+    this->AddSupportedReadSignature(signature);
+  }
 }
 
 TIFFImageIO::~TIFFImageIO()
@@ -150,10 +150,11 @@ SpatialNeighborSubsampler<TSample, TRegion>::Search(const InstanceIdentifier & q
   // are ordered as if someone was iterating forward through the region
   // TODO Is this a safe assumption to make?
 
+  // The offset of the first position is needed even when it is the query, to
+  // step to the next positions
+  ImageHelperType::ComputeOffset(this->m_SampleRegion.GetIndex(), positionIndex, offsetTable, offset);
   if (this->m_CanSelectQuery || (positionIndex != queryIndex))
   {
-    offset = 0;
-    ImageHelperType::ComputeOffset(this->m_SampleRegion.GetIndex(), positionIndex, offsetTable, offset);
     results->AddInstance(static_cast<InstanceIdentifier>(offset));
   }
 
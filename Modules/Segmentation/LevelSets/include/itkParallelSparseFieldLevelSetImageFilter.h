@@ -24,7 +24,6 @@
 #include "itkObjectStore.h"
 #include "itkNeighborhoodIterator.h"
 #include "itkMultiThreaderBase.h"
-#include <condition_variable>
 #include <vector>
 
 namespace itk
@@ -237,6 +236,13 @@ private:
  * initializes, it will subtract the IsoSurfaceValue from all values, in the
  * input, shifting the isosurface of interest to zero in the output.
  *
+ * \par
+ * The work is divided among the work units of the multithreader into slabs
+ * along the dimension in which the initial active set is spread the most
+ * evenly.  Every LoadBalanceIterationFrequency iterations, the slabs are
+ * redrawn to follow the active set, so that each work unit keeps about the
+ * same number of active nodes to process.
+ *
  * \par IMPORTANT!
  *  Read the documentation for FiniteDifferenceImageFilter before attempting to
  *  use this filter.  The solver requires that you specify a
@@ -325,6 +331,14 @@ public:
   itkSetMacro(IsoSurfaceValue, ValueType);
   itkGetConstMacro(IsoSurfaceValue, ValueType);
 
+  /** Set/Get the number of iterations between two checks of the balance of
+   *  the load among the threads.  When the active layer nodes are no longer
+   *  evenly distributed, the slabs are redrawn so that every thread again
+   *  gets about the same number of nodes.  Zero disables load balancing.
+   *  Defaults to 30. */
+  itkSetMacro(LoadBalanceIterationFrequency, unsigned int);
+  itkGetConstMacro(LoadBalanceIterationFrequency, unsigned int);
+
   LayerPointerType
   GetActiveListForIndex(const IndexType index)
   {
@@ -504,13 +518,19 @@ protected:
   void
   ThreadedInitializeData(ThreadIdType ThreadId, const ThreadRegionType & ThreadRegion);
 
-  /** This performs the initial load distribution among the threads.  Every
-   *  thread gets a slab of the data to work on. The slabs created along a specific
-   *  dimension.  Load balancing is performed along the greatest numbered dimension
-   *  (i.e. the 3rd dimension in the 3D case and the 2nd dimension in the 2D case).
-   *  During the initializing of the sparse field layer an histogram is computed
+  /** Chooses the dimension along which the data is divided into slabs: the one
+   *  along which the nodes of the initial active set are spread the most evenly,
+   *  preferring the greatest numbered dimension (i.e. the 3rd dimension in the 3D
+   *  case and the 2nd dimension in the 2D case).  Also computes the histogram
    *  that stores the number of nodes in the active set for each index along the
-   *  chosen dimension.  This histogram is used to divide the work "equally" among
+   *  chosen dimension. */
+  void
+  ComputeSplitAxis();
+
+  /** This performs the initial load distribution among the threads.  Every
+   *  thread gets a slab of the data to work on. The slabs created along the
+   *  dimension chosen by ComputeSplitAxis().  The histogram of the active set
+   *  along this dimension is used to divide the work "equally" among
    *  threads so that each thread approximately get the same number of nodes to
    *  process. */
   void
@@ -530,9 +550,9 @@ protected:
   DeallocateData();
 
   /** This method calculates the change and does the update, i.e. one iteration
-   *  of this iterative solver.  A barrier class is used to synchronize
-   *  execution and keep the CalculateChange and ApplyUpdate sections from
-   *  executing simultaneously.  */
+   *  of this iterative solver.  The CalculateChange and ApplyUpdate sections
+   *  are run as separate parallel loops of the multithreader, so they never
+   *  execute simultaneously.  */
   void
   Iterate();
 
@@ -559,15 +579,25 @@ protected:
                                           const ValueType & itkNotUsed(value),
                                           ThreadIdType      itkNotUsed(ThreadId));
 
-  /** This method is not implemented or necessary for this solver */
-  void
-  ApplyUpdate(const TimeStepType &) override
-  {}
-
-  /** Does the actual work of updating the output from the UpdateContainer over
-   *  an output region supplied by the multithreading mechanism.  */
-  virtual void
-  ThreadedApplyUpdate(const TimeStepType & dt, ThreadIdType ThreadId);
+  /** Updates the active layer values and the sparse field layers of all the
+   *  threads.  Each of the steps that depend on the results of the neighboring
+   *  threads is run as a separate parallel loop, so that no thread ever waits
+   *  for another one and any threader may be used. */
+  void
+  ApplyUpdate(const TimeStepType & dt) override;
+
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+  /** Applies the update of all the threads, as ApplyUpdate() does.  The
+   *  threads no longer apply their part of the update in lockstep, so the
+   *  filter no longer calls this method, the thread identifier is ignored,
+   *  and the method must be called once per iteration instead of once per
+   *  thread. */
+  [[deprecated("Use ApplyUpdate(), which runs each step of the update as a parallel loop.")]] virtual void
+  ThreadedApplyUpdate(const TimeStepType & dt, ThreadIdType itkNotUsed(ThreadId))
+  {
+    this->ApplyUpdate(dt);
+  }
+#endif
 
   /** This method is not implemented or necessary for this solver */
   TimeStepType
@@ -683,8 +713,8 @@ protected:
    *  and it is correct to believe that during an iteration the movement is small enough that
    *  the small gain obtained by load balancing (if any) does not warrant the overhead for
    *  calling this method.
-   *  How often this is done is controlled by a parameter LOAD_BALANCE_ITERATION_FREQUENCY
-   *  which is defined in the IterateThreaderCallback() function.
+   *  How often this is done is controlled by the LoadBalanceIterationFrequency
+   *  parameter.
    *  A parameter that defines a degree of unbalancedness of the load among threads is
    *  MAX_PIXEL_DIFFERENCE_PERCENT which is defined in CheckLoadBalance(). */
   virtual void
@@ -697,14 +727,22 @@ protected:
   void
   ThreadedLoadBalance2(ThreadIdType ThreadId);
 
-  void
-  SignalNeighborsAndWait(ThreadIdType ThreadId);
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+  /** The threads no longer wait for each other: each step of the update that
+   *  depends on the neighboring threads is run as a separate parallel loop.
+   *  These methods do nothing. */
+  [[deprecated("The threads no longer wait for each other.")]] void
+  SignalNeighborsAndWait(ThreadIdType itkNotUsed(ThreadId))
+  {}
 
-  void
-  SignalNeighbor(unsigned int SemaphoreArrayNumber, ThreadIdType ThreadId);
+  [[deprecated("The threads no longer wait for each other.")]] void
+  SignalNeighbor(unsigned int itkNotUsed(SemaphoreArrayNumber), ThreadIdType itkNotUsed(ThreadId))
+  {}
 
-  void
-  WaitForNeighbor(unsigned int SemaphoreArrayNumber, ThreadIdType ThreadId);
+  [[deprecated("The threads no longer wait for each other.")]] void
+  WaitForNeighbor(unsigned int itkNotUsed(SemaphoreArrayNumber), ThreadIdType itkNotUsed(ThreadId))
+  {}
+#endif
 
   /** If child classes need an entry point to the start of every iteration step
    * they can override this method. This method is defined but empty in this class. */
@@ -719,6 +757,9 @@ protected:
   /** The number of work units to use. */
   ThreadIdType m_NumOfWorkUnits{ 0 };
 
+  /** The number of iterations between two checks of the load balance. */
+  unsigned int m_LoadBalanceIterationFrequency{ 30 };
+
   /** The dimension along which to distribute the load. */
   unsigned int m_SplitAxis{ 0 };
 
@@ -773,19 +814,6 @@ protected:
 
     /** Local histogram with each thread */
     int * m_ZHistogram;
-
-    /** pseudo-Semaphores used for signaling and waiting neighbor
-     *  threads. Strictly speaking the semaphores are NOT just
-     *  accessed by the thread that owns them
-     *  BUT also by the thread's neighbors. So they are NOT truly "local" data. */
-    int m_Semaphore[2];
-
-    std::mutex              m_Lock[2];
-    std::condition_variable m_Condition[2];
-
-    /** Indicates whether to use m_Semaphore[0] or m_Semaphore[1] for
-      signaling/waiting */
-    unsigned int m_SemaphoreArrayNumber;
   };
 
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT, ThreadDataUnaligned, ThreadDataPadded);
@@ -248,25 +248,6 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Initialize()
     m_Layers.push_back(LayerType::New());
   }
 
-  // always the "Z" dimension
-  m_SplitAxis = m_OutputImage->GetImageDimension() - 1;
-  if (m_OutputImage->GetImageDimension() < 1)
-  {
-    // cannot split
-    itkDebugMacro("Unable to choose an axis for workload distribution among threads");
-    return;
-  }
-
-  typename OutputImageType::SizeType requestedRegionSize = m_OutputImage->GetRequestedRegion().GetSize();
-  m_ZSize = requestedRegionSize[m_SplitAxis];
-
-  // Histogram of number of pixels in each Z plane for the entire 3D volume
-  m_GlobalZHistogram = new int[m_ZSize];
-  for (unsigned int i = 0; i < m_ZSize; ++i)
-  {
-    m_GlobalZHistogram[i] = 0;
-  }
-
   // Construct the active layer and initialize the first layers inside and
   // outside of the active layer
   this->ConstructActiveLayer();
@@ -290,8 +271,13 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Initialize()
   // filter.  See PostProcessOutput method for more information.
   this->InitializeBackgroundPixels();
 
-  m_NumOfWorkUnits = std::min(this->GetNumberOfWorkUnits(), this->GetMultiThreader()->GetMaximumNumberOfThreads());
-  this->SetNumberOfWorkUnits(m_NumOfWorkUnits);
+  // Choose the axis along which the volume is divided into slabs, and compute
+  // the histogram of the active layer along that axis.
+  this->ComputeSplitAxis();
+
+  // The work units never wait for each other, so there may be more of them
+  // than threads; there is no use for more of them than slabs, however.
+  m_NumOfWorkUnits = std::min(this->GetNumberOfWorkUnits(), static_cast<ThreadIdType>(m_ZSize));
 
   // Cumulative frequency of number of pixels in each Z plane for the entire 3D
   // volume
@@ -367,9 +353,6 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ConstructActi
       }
       if (bounds_status)
       {
-        // Here record the histogram information
-        m_GlobalZHistogram[center_index[m_SplitAxis]]++;
-
         // Borrow a node from the store and set its value.
         auto node = m_LayerNodeStore->Borrow();
         node->m_Index = center_index;
@@ -657,6 +640,57 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::InitializeBac
   m_ShiftedImage = nullptr;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ComputeSplitAxis()
+{
+  // Count the nodes of the active layer in the planes perpendicular to each
+  // axis.
+  const typename OutputImageType::SizeType regionSize = m_OutputImage->GetRequestedRegion().GetSize();
+
+  std::vector<int> histograms[ImageDimension];
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    histograms[d].assign(regionSize[d], 0);
+  }
+  for (typename LayerType::Iterator layerIt = m_Layers[0]->Begin(); layerIt != m_Layers[0]->End(); ++layerIt)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      ++histograms[d][layerIt->m_Index[d]];
+    }
+  }
+
+  // A plane is never shared by two work units, so along a given axis the
+  // busiest work unit gets at least the nodes of the fullest plane, and at
+  // least its share of all the nodes.  Split along the axis that minimizes
+  // this bound, preferring the last axes, whose slabs are contiguous in
+  // memory.
+  const auto   numberOfNodes = static_cast<SizeValueType>(m_Layers[0]->Size());
+  SizeValueType minimumLoad = NumericTraits<SizeValueType>::max();
+  for (int d = ImageDimension - 1; d >= 0; --d)
+  {
+    const auto    numberOfSlabs = std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), regionSize[d]);
+    SizeValueType load = (numberOfNodes + numberOfSlabs - 1) / numberOfSlabs;
+    for (const int count : histograms[d])
+    {
+      load = std::max(load, static_cast<SizeValueType>(count));
+    }
+    if (load < minimumLoad)
+    {
+      minimumLoad = load;
+      m_SplitAxis = d;
+    }
+  }
+
+  m_ZSize = regionSize[m_SplitAxis];
+
+  // Histogram of number of pixels in each plane along the split axis for the
+  // entire volume
+  m_GlobalZHistogram = new int[m_ZSize];
+  std::copy(histograms[m_SplitAxis].begin(), histograms[m_SplitAxis].end(), m_GlobalZHistogram);
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ComputeInitialThreadBoundaries()
@@ -741,9 +775,6 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedAlloc
 {
   static constexpr float SAFETY_FACTOR = 4.0;
 
-  m_Data[ThreadId].m_Semaphore[0] = 0;
-  m_Data[ThreadId].m_Semaphore[1] = 0;
-
   const std::size_t bufferLayerSize = 2 * m_NumberOfLayers + 1;
   // Allocate the layers for the sparse field.
   m_Data[ThreadId].m_Layers.reserve(bufferLayerSize);
@@ -789,7 +820,7 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedAlloc
   }
 
   // Used during the time when status lists are being processed (in
-  // ThreadedApplyUpdate() )
+  // ApplyUpdate() )
   // for the Uplists
   m_Data[ThreadId].m_InterNeighborNodeTransferBufferLayers[0] = new LayerPointerType *[m_NumberOfLayers + 1];
 
@@ -816,9 +847,6 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedAlloc
 
   // Every thread must have its own copy of the GlobalData struct.
   m_Data[ThreadId].globalData = this->GetDifferenceFunction()->GetGlobalDataPointer();
-
-  //
-  m_Data[ThreadId].m_SemaphoreArrayNumber = 0;
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -1049,10 +1077,6 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
 
   typename TOutputImage::RegionType reqRegion = m_OutputImage->GetRequestedRegion();
 
-  // Controls how often we check for balance of the load among the threads and
-  // perform load balancing (if needed) by redistributing the load.
-  constexpr unsigned int LOAD_BALANCE_ITERATION_FREQUENCY = 30;
-
   if (!this->m_IsInitialized)
   {
     this->ComputeInitialThreadBoundaries();
@@ -1145,27 +1169,26 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
         }
       }
 
-      // Should we stop iterating ? (in case there are too few pixels to
-      // process for every thread)
-      this->m_Stop = true;
+      // Should we stop iterating ? (in case there are too few pixels left to
+      // process).  The time steps of the work units whose slabs hold no
+      // pixels of the active layer are meaningless.
+      SizeValueType activeLayerSize = 0;
       for (unsigned int i = 0; i < this->m_NumOfWorkUnits; ++i)
       {
-        if (this->m_Data[i].m_Layers[0]->Size() > 10)
-        {
-          this->m_Stop = false;
-          break;
-        }
+        activeLayerSize += this->m_Data[i].m_Layers[0]->Size();
+        m_TimeStepList[i] = this->m_Data[i].TimeStep;
+        m_ValidTimeStepList[i] = !this->m_Data[i].m_Layers[0]->Empty();
       }
+      this->m_Stop = (activeLayerSize <= 10);
 
       this->InvokeEvent(IterationEvent());
       this->InvokeEvent(ProgressEvent());
       this->SetElapsedIterations(++iter);
 
-      for (unsigned int i = 0; i < this->m_NumOfWorkUnits; ++i)
+      if (!this->m_Stop)
       {
-        m_TimeStepList[i] = this->m_Data[i].TimeStep;
+        m_TimeStep = this->ResolveTimeStep(m_TimeStepList, m_ValidTimeStepList);
       }
-      m_TimeStep = this->ResolveTimeStep(m_TimeStepList, m_ValidTimeStepList);
     }
 
     // The active layer is too small => stop iterating
@@ -1174,19 +1197,9 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
       return;
     }
 
-    mt->ParallelizeArray(
-      0,
-      m_NumOfWorkUnits,
-      [this](SizeValueType threadId) {
-        this->ThreadedApplyUpdate(m_TimeStep, threadId);
-        // We only need to wait for neighbors because ThreadedCalculateChange
-        // requires information only from the neighbors.
-        this->SignalNeighborsAndWait(threadId);
-      },
-      nullptr);
+    this->ApplyUpdate(m_TimeStep);
 
-
-    if (this->GetElapsedIterations() % LOAD_BALANCE_ITERATION_FREQUENCY == 0)
+    if (m_LoadBalanceIterationFrequency > 0 && this->GetElapsedIterations() % m_LoadBalanceIterationFrequency == 0)
     {
       this->CheckLoadBalance();
 
@@ -1202,7 +1215,7 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::Iterate()
         // 1. Every thread checks for pixels with itself that should NOT be with
         //    itself anymore (because of the changed boundaries).
         //    These pixels are now put in extra "buckets" for other threads to grab
-        // 2. WaitForAll ().
+        // 2. Wait for all the threads.
         // 3. Every thread grabs those pixels, from every other thread, that come
         //    within its boundaries (from the extra buckets).
         mt->ParallelizeArray(
@@ -1340,31 +1353,36 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedCalcu
 
 template <typename TInputImage, typename TOutputImage>
 void
-ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedApplyUpdate(const TimeStepType & dt,
-                                                                                       ThreadIdType         ThreadId)
+ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ApplyUpdate(const TimeStepType & dt)
 {
-  this->ThreadedUpdateActiveLayerValues(dt, m_Data[ThreadId].UpList[0], m_Data[ThreadId].DownList[0], ThreadId);
+  // Every step of the update reads what the neighboring threads have written
+  // during the previous steps.  Each step is therefore run as a parallel loop
+  // of its own: the loops return only once all the threads are done, and no
+  // thread ever waits for another one inside of a loop.
+  MultiThreaderBase * mt = this->GetMultiThreader();
+  const auto          parallelizeStep = [this, mt](const MultiThreaderBase::ArrayThreadingFunctorType & step) {
+    mt->ParallelizeArray(0, m_NumOfWorkUnits, step, nullptr);
+  };
 
   // We need to update histogram information (because some pixels are LEAVING
   // layer-0 (the active layer)
-
-  this->SignalNeighborsAndWait(ThreadId);
+  parallelizeStep([this, &dt](SizeValueType threadId) {
+    this->ThreadedUpdateActiveLayerValues(dt, m_Data[threadId].UpList[0], m_Data[threadId].DownList[0], threadId);
+  });
 
   // Process status lists and update value for first inside/outside layers
-
-  this->ThreadedProcessStatusList(0, 1, 2, 1, 1, 0, ThreadId);
-  this->ThreadedProcessStatusList(0, 1, 1, 2, 0, 0, ThreadId);
-
-  this->SignalNeighborsAndWait(ThreadId);
+  parallelizeStep([this](SizeValueType threadId) {
+    this->ThreadedProcessStatusList(0, 1, 2, 1, 1, 0, threadId);
+    this->ThreadedProcessStatusList(0, 1, 1, 2, 0, 0, threadId);
+  });
 
   // Update first layer value, process first layer
-  this->ThreadedProcessFirstLayerStatusLists(1, 0, 3, 1, 1, ThreadId);
-  this->ThreadedProcessFirstLayerStatusLists(1, 0, 4, 0, 1, ThreadId);
-
   // We need to update histogram information (because some pixels are ENTERING
   // layer-0
-
-  this->SignalNeighborsAndWait(ThreadId);
+  parallelizeStep([this](SizeValueType threadId) {
+    this->ThreadedProcessFirstLayerStatusLists(1, 0, 3, 1, 1, threadId);
+    this->ThreadedProcessFirstLayerStatusLists(1, 0, 4, 0, 1, threadId);
+  });
 
   StatusType    up_to = 1;
   StatusType    up_search = 5;
@@ -1376,10 +1394,10 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedApply
   // The 3D case: this loop is executed at least once
   while (down_search < 2 * m_NumberOfLayers + 1)
   {
-    this->ThreadedProcessStatusList(j, k, up_to, up_search, 1, (up_search - 1) / 2, ThreadId);
-    this->ThreadedProcessStatusList(j, k, down_to, down_search, 0, (up_search - 1) / 2, ThreadId);
-
-    this->SignalNeighborsAndWait(ThreadId);
+    parallelizeStep([=](SizeValueType threadId) {
+      this->ThreadedProcessStatusList(j, k, up_to, up_search, 1, (up_search - 1) / 2, threadId);
+      this->ThreadedProcessStatusList(j, k, down_to, down_search, 0, (up_search - 1) / 2, threadId);
+    });
 
     up_to += 2;
     down_to += 2;
@@ -1394,40 +1412,46 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::ThreadedApply
   // now down_search = 2 * m_NumberOfLayers + 2 (= 8 if m_NumberOfLayers = 3)
 
   // Process the outermost inside/outside layers in the sparse field
-  this->ThreadedProcessStatusList(j, k, up_to, m_StatusNull, 1, (up_search - 1) / 2, ThreadId);
-  this->ThreadedProcessStatusList(j, k, down_to, m_StatusNull, 0, (up_search - 1) / 2, ThreadId);
-
-  this->SignalNeighborsAndWait(ThreadId);
-
-  this->ThreadedProcessOutsideList(k, (2 * m_NumberOfLayers + 1) - 2, 1, (up_search + 1) / 2, ThreadId);
-  this->ThreadedProcessOutsideList(k, (2 * m_NumberOfLayers + 1) - 1, 0, (up_search + 1) / 2, ThreadId);
-
-  if (m_OutputImage->GetImageDimension() < 3)
+  parallelizeStep([=](SizeValueType threadId) {
+    this->ThreadedProcessStatusList(j, k, up_to, m_StatusNull, 1, (up_search - 1) / 2, threadId);
+    this->ThreadedProcessStatusList(j, k, down_to, m_StatusNull, 0, (up_search - 1) / 2, threadId);
+  });
+
+  // A synchronization between the processing of the outside lists and the
+  // propagation of the first layer values is NOT required in the 3D case,
+  // because there are at least 7 layers, thus ThreadedProcessOutsideList()
+  // works on layers 5 & 6 while ThreadedPropagateLayerValues() works on 0, 1,
+  // 2, 3, 4 only. => There can NOT be any dependencies among different threads.
+  const bool synchronizeOutsideLists = (m_OutputImage->GetImageDimension() < 3);
+  parallelizeStep([=](SizeValueType threadId) {
+    this->ThreadedProcessOutsideList(k, (2 * m_NumberOfLayers + 1) - 2, 1, (up_search + 1) / 2, threadId);
+    this->ThreadedProcessOutsideList(k, (2 * m_NumberOfLayers + 1) - 1, 0, (up_search + 1) / 2, threadId);
+    if (!synchronizeOutsideLists)
+    {
+      // Finally, we update all of the layer VALUES (excluding the active
+      // layer, which has already been updated)
+      this->ThreadedPropagateLayerValues(0, 1, 3, 1, threadId); // first inside
+      this->ThreadedPropagateLayerValues(0, 2, 4, 0, threadId); // first outside
+    }
+  });
+  if (synchronizeOutsideLists)
   {
-    this->SignalNeighborsAndWait(ThreadId);
+    parallelizeStep([this](SizeValueType threadId) {
+      this->ThreadedPropagateLayerValues(0, 1, 3, 1, threadId); // first inside
+      this->ThreadedPropagateLayerValues(0, 2, 4, 0, threadId); // first outside
+    });
   }
 
-  // A synchronize is NOT required here because in 3D case we have at least 7
-  // layers, thus ThreadedProcessOutsideList() works on layers 5 & 6 while
-  // ThreadedPropagateLayerValues() works on 0, 1, 2, 3, 4 only. => There can
-  // NOT be any dependencies among different threads.
-
-  // Finally, we update all of the layer VALUES (excluding the active layer,
-  // which has already been updated)
-  this->ThreadedPropagateLayerValues(0, 1, 3, 1, ThreadId); // first inside
-  this->ThreadedPropagateLayerValues(0, 2, 4, 0, ThreadId); // first outside
-
-  this->SignalNeighborsAndWait(ThreadId);
-
   // Update the rest of the layer values
   unsigned int N = (2 * static_cast<unsigned int>(m_NumberOfLayers) + 1) - 2;
 
   for (unsigned int i = 1; i < N; i += 2)
   {
-    j = i + 1;
-    this->ThreadedPropagateLayerValues(i, i + 2, i + 4, 1, ThreadId);
-    this->ThreadedPropagateLayerValues(j, j + 2, j + 4, 0, ThreadId);
-    this->SignalNeighborsAndWait(ThreadId);
+    parallelizeStep([this, i](SizeValueType threadId) {
+      const unsigned int n = i + 1;
+      this->ThreadedPropagateLayerValues(i, i + 2, i + 4, 1, threadId);
+      this->ThreadedPropagateLayerValues(n, n + 2, n + 4, 0, threadId);
+    });
   }
 }
 
@@ -2392,83 +2416,6 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::GetThreadNumb
   return (m_MapZToThreadNumber[splitAxisValue]);
 }
 
-template <typename TInputImage, typename TOutputImage>
-void
-ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::SignalNeighborsAndWait(ThreadIdType ThreadId)
-{
-  // This is the case when a thread has no pixels to process
-  // This case is analogous to NOT using that thread at all
-  // Hence this thread does not need to signal / wait for any other neighbor
-  // thread during the iteration
-  if (ThreadId != 0)
-  {
-    if (m_Boundary[ThreadId - 1] == m_Boundary[ThreadId])
-    {
-      m_Data[ThreadId].m_SemaphoreArrayNumber = 1 - m_Data[ThreadId].m_SemaphoreArrayNumber;
-      return;
-    }
-  }
-
-  ThreadIdType lastThreadId = m_NumOfWorkUnits - 1;
-  if (lastThreadId == 0)
-  {
-    return; // only 1 thread => no need to wait
-  }
-
-  // signal neighbors that work is done
-  if (ThreadId != 0) // not the first thread
-  {
-    this->SignalNeighbor(m_Data[ThreadId].m_SemaphoreArrayNumber, this->GetThreadNumber(m_Boundary[ThreadId - 1]));
-  }
-  if (m_Boundary[ThreadId] != m_ZSize - 1) // not the last thread
-  {
-    this->SignalNeighbor(m_Data[ThreadId].m_SemaphoreArrayNumber, this->GetThreadNumber(m_Boundary[ThreadId] + 1));
-  }
-
-  // wait for signal from neighbors signifying that their work is done
-  if ((ThreadId == 0) || (m_Boundary[ThreadId] == m_ZSize - 1))
-  {
-    // do it just once for the first and the last threads because they share
-    // just 1 boundary (just 1 neighbor)
-    this->WaitForNeighbor(m_Data[ThreadId].m_SemaphoreArrayNumber, ThreadId);
-    m_Data[ThreadId].m_SemaphoreArrayNumber = 1 - m_Data[ThreadId].m_SemaphoreArrayNumber;
-  }
-  else
-  {
-    // do twice because share 2 boundaries with neighbors
-    this->WaitForNeighbor(m_Data[ThreadId].m_SemaphoreArrayNumber, ThreadId);
-    this->WaitForNeighbor(m_Data[ThreadId].m_SemaphoreArrayNumber, ThreadId);
-
-    m_Data[ThreadId].m_SemaphoreArrayNumber = 1 - m_Data[ThreadId].m_SemaphoreArrayNumber;
-  }
-}
-
-template <typename TInputImage, typename TOutputImage>
-void
-ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::SignalNeighbor(unsigned int SemaphoreArrayNumber,
-                                                                                  ThreadIdType ThreadId)
-{
-  ThreadData &                      td = m_Data[ThreadId];
-  const std::lock_guard<std::mutex> lockGuard(td.m_Lock[SemaphoreArrayNumber]);
-  ++td.m_Semaphore[SemaphoreArrayNumber];
-  td.m_Condition[SemaphoreArrayNumber].notify_one();
-}
-
-template <typename TInputImage, typename TOutputImage>
-void
-ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::WaitForNeighbor(unsigned int SemaphoreArrayNumber,
-                                                                                   ThreadIdType ThreadId)
-{
-  ThreadData &                 td = m_Data[ThreadId];
-  std::unique_lock<std::mutex> mutexHolder(td.m_Lock[SemaphoreArrayNumber]);
-  if (td.m_Semaphore[SemaphoreArrayNumber] == 0)
-  {
-    td.m_Condition[SemaphoreArrayNumber].wait(
-      mutexHolder, [&td, SemaphoreArrayNumber] { return (td.m_Semaphore[SemaphoreArrayNumber] != 0); });
-  }
-  --td.m_Semaphore[SemaphoreArrayNumber];
-}
-
 template <typename TInputImage, typename TOutputImage>
 void
 ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -2507,6 +2454,7 @@ ParallelSparseFieldLevelSetImageFilter<TInputImage, TOutputImage>::PrintSelf(std
   os << indent << "NumOfWorkUnits: " << static_cast<typename NumericTraits<ThreadIdType>::PrintType>(m_NumOfWorkUnits)
      << std::endl;
 
+  os << indent << "LoadBalanceIterationFrequency: " << m_LoadBalanceIterationFrequency << std::endl;
   os << indent << "SplitAxis: " << m_SplitAxis << std::endl;
   os << indent << "ZSize: " << m_ZSize << std::endl;
   itkPrintSelfBooleanMacro(BoundaryChanged);
@@ -314,8 +314,43 @@ itkParallelSparseFieldLevelSetImageFilterTest(int argc, char * argv[])
   mf->SetIsoSurfaceValue(isoSurfaceValue);
   ITK_TEST_SET_GET_VALUE(isoSurfaceValue, mf->GetIsoSurfaceValue());
 
+  constexpr unsigned int loadBalanceIterationFrequency = 10;
+  mf->SetLoadBalanceIterationFrequency(loadBalanceIterationFrequency);
+  ITK_TEST_SET_GET_VALUE(loadBalanceIterationFrequency, mf->GetLoadBalanceIterationFrequency());
+
   ITK_TRY_EXPECT_NO_EXCEPTION(mf->Update());
 
+  // The work units never wait for each other, so their number is not limited
+  // by the number of threads.
+  ITK_TEST_EXPECT_EQUAL(mf->GetNumberOfWorkUnits(), static_cast<itk::ThreadIdType>(numberOfWorkUnits));
+
+  // The output does not depend on the number of work units, although the slabs
+  // of the work units are redrawn as the load is balanced.
+  for (const itk::ThreadIdType otherNumberOfWorkUnits : { 1, 2, 5, 16 })
+  {
+    PSFLSIFT::MorphFilter::Pointer other = PSFLSIFT::MorphFilter::New();
+    other->SetDistanceTransform(im_target);
+    other->SetIterations(n);
+    other->SetInput(im_init);
+    other->SetNumberOfWorkUnits(otherNumberOfWorkUnits);
+    other->SetNumberOfLayers(numberOfLayers);
+    other->SetIsoSurfaceValue(isoSurfaceValue);
+    other->SetLoadBalanceIterationFrequency(loadBalanceIterationFrequency);
+    ITK_TRY_EXPECT_NO_EXCEPTION(other->Update());
+
+    itk::ImageRegionConstIterator<ImageType> expectedIt(mf->GetOutput(), r);
+    itk::ImageRegionConstIterator<ImageType> otherIt(other->GetOutput(), r);
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++otherIt)
+    {
+      if (otherIt.Get() != expectedIt.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The output with " << otherNumberOfWorkUnits << " work units differs from the output with "
+                  << numberOfWorkUnits << " work units at " << otherIt.GetIndex() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
 
   mf->GetOutput()->Print(std::cout);
 
@@ -323,6 +323,23 @@ template <typename TEquationContainer, typename TOutput, unsigned int VDimension
 void
 LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDimension>>::UpdateLevelSets()
 {
+  if (this->m_ConcurrentLevelSetUpdate)
+  {
+    this->template UpdateLevelSetsConcurrently<UpdateLevelSetFilterType>(
+      this->GetNumberOfWorkUnits(), [this](UpdateLevelSetFilterType * updateLevelSet, LevelSetIdentifierType id) {
+        updateLevelSet->SetUpdate(*this->m_UpdateBuffer[id]);
+        updateLevelSet->SetTimeStep(this->m_Dt);
+      });
+
+    typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+    while (it != this->m_LevelSetContainer->End())
+    {
+      this->m_UpdateBuffer[it->GetIdentifier()]->clear();
+      ++it;
+    }
+    return;
+  }
+
   typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
   while (it != this->m_LevelSetContainer->End())
   {
@@ -338,7 +355,7 @@ LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDime
 
     levelSet->Graft(updateLevelSet->GetOutputLevelSet());
 
-    this->m_RMSChangeAccumulator = updateLevelSet->GetRMSChangeAccumulator();
+    this->m_RMSChangeAccumulator += updateLevelSet->GetRMSChangeAccumulator();
 
     this->m_UpdateBuffer[it->GetIdentifier()]->clear();
     ++it;
@@ -358,6 +375,13 @@ template <typename TEquationContainer, unsigned int VDimension>
 void
 LevelSetEvolution<TEquationContainer, ShiSparseLevelSetImage<VDimension>>::UpdateLevelSets()
 {
+  if (this->m_ConcurrentLevelSetUpdate)
+  {
+    this->template UpdateLevelSetsConcurrently<UpdateLevelSetFilterType>(
+      MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), [](UpdateLevelSetFilterType *, LevelSetIdentifierType) {});
+    return;
+  }
+
   typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
 
   while (it != this->m_LevelSetContainer->End())
@@ -372,7 +396,7 @@ LevelSetEvolution<TEquationContainer, ShiSparseLevelSetImage<VDimension>>::Updat
 
     levelSet->Graft(updateLevelSet->GetOutputLevelSet());
 
-    this->m_RMSChangeAccumulator = updateLevelSet->GetRMSChangeAccumulator();
+    this->m_RMSChangeAccumulator += updateLevelSet->GetRMSChangeAccumulator();
 
     ++it;
   }
@@ -391,6 +415,13 @@ template <typename TEquationContainer, unsigned int VDimension>
 void
 LevelSetEvolution<TEquationContainer, MalcolmSparseLevelSetImage<VDimension>>::UpdateLevelSets()
 {
+  if (this->m_ConcurrentLevelSetUpdate)
+  {
+    this->template UpdateLevelSetsConcurrently<UpdateLevelSetFilterType>(
+      MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), [](UpdateLevelSetFilterType *, LevelSetIdentifierType) {});
+    return;
+  }
+
   typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
 
   while (it != this->m_LevelSetContainer->End())
@@ -406,7 +437,7 @@ LevelSetEvolution<TEquationContainer, MalcolmSparseLevelSetImage<VDimension>>::U
 
     levelSet->Graft(updateLevelSet->GetOutputLevelSet());
 
-    this->m_RMSChangeAccumulator = updateLevelSet->GetRMSChangeAccumulator();
+    this->m_RMSChangeAccumulator += updateLevelSet->GetRMSChangeAccumulator();
 
     ++it;
   }
@@ -112,6 +112,23 @@ public:
   /** Get the number of iterations that have occurred. */
   itkGetConstMacro(NumberOfIterations, IdentifierType);
 
+  /** Set/Get whether the layers of the different level sets are updated
+   * concurrently, one level set per work unit. The update of each level set
+   * then only sees the other level sets as they were at the beginning of the
+   * iteration, instead of the ones already updated within this iteration.
+   * Only used by the sparse level-set representations. Off by default.
+   *
+   * The term container of each level set is then evaluated and updated by
+   * its own work unit. This is thread safe as long as each term belongs to a
+   * single term container: the terms, such as the coupled Chan and Vese
+   * external term, only read the other level sets, the input image and the
+   * domain map, and the level sets are not modified until all of them are
+   * updated. The Whitaker evolution uses its number of work units, the Shi
+   * and Malcolm evolutions the global default number of threads. */
+  itkSetMacro(ConcurrentLevelSetUpdate, bool);
+  itkGetConstMacro(ConcurrentLevelSetUpdate, bool);
+  itkBooleanMacro(ConcurrentLevelSetUpdate);
+
   /** Update the filter by computing the output level function
    * by calling Evolve() once the instantiation of necessary variables
    * is verified */
@@ -157,6 +174,15 @@ protected:
   virtual void
   UpdateEquations() = 0;
 
+  /** Update all the level sets at once, one level set per work unit, and
+   * graft the results onto the level sets once all of them are updated.
+   * configureFilter(filter, levelSetId) sets the inputs of the update filter
+   * which are specific to the level-set representation. The internal filters
+   * of the update filters run on a single work unit. */
+  template <typename TUpdateFilter, typename TConfigureFunction>
+  void
+  UpdateLevelSetsConcurrently(ThreadIdType numberOfWorkUnits, TConfigureFunction && configureFilter);
+
   StoppingCriterionPointer m_StoppingCriterion{};
 
   EquationContainerPointer                m_EquationContainer{};
@@ -167,6 +193,7 @@ protected:
   LevelSetOutputRealType m_RMSChangeAccumulator{};
   bool                   m_UserGloballyDefinedTimeStep{};
   IdentifierType         m_NumberOfIterations{};
+  bool                   m_ConcurrentLevelSetUpdate{ false };
 
   /** Helper members for threading. */
   typename LevelSetContainerType::Iterator m_LevelSetContainerIteratorToProcessWhenThreading{};
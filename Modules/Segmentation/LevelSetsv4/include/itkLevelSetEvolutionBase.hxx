@@ -20,6 +20,9 @@
 #ifndef itkLevelSetEvolutionBase_hxx
 #define itkLevelSetEvolutionBase_hxx
 
+#include "itkMultiThreaderBase.h"
+#include <vector>
+
 
 namespace itk
 {
@@ -250,5 +253,48 @@ void
 LevelSetEvolutionBase<TEquationContainer, TLevelSet>::ComputeTimeStepForNextIteration()
 {}
 
+template <typename TEquationContainer, typename TLevelSet>
+template <typename TUpdateFilter, typename TConfigureFunction>
+void
+LevelSetEvolutionBase<TEquationContainer, TLevelSet>::UpdateLevelSetsConcurrently(ThreadIdType numberOfWorkUnits,
+                                                                                  TConfigureFunction && configureFilter)
+{
+  // Each level set is relabeled by its own update filter. The inputs are only
+  // modified when grafting, after all the filters have been run.
+  std::vector<typename LevelSetType::Pointer>  levelSets;
+  std::vector<typename TUpdateFilter::Pointer> updateLevelSets;
+
+  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+  while (it != this->m_LevelSetContainer->End())
+  {
+    auto updateLevelSet = TUpdateFilter::New();
+    updateLevelSet->SetInputLevelSet(it->GetLevelSet());
+    updateLevelSet->SetCurrentLevelSetId(it->GetIdentifier());
+    updateLevelSet->SetEquationContainer(this->m_EquationContainer);
+    updateLevelSet->SetNumberOfWorkUnits(1);
+    configureFilter(updateLevelSet.GetPointer(), it->GetIdentifier());
+
+    levelSets.push_back(it->GetLevelSet());
+    updateLevelSets.push_back(updateLevelSet);
+    ++it;
+  }
+
+  const auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  multiThreader->ParallelizeArray(
+    0,
+    updateLevelSets.size(),
+    [&updateLevelSets](SizeValueType ii) { updateLevelSets[ii]->Update(); },
+    nullptr);
+
+  // The changes of the level sets are summed in the order of the level sets,
+  // as in the serial update.
+  for (size_t ii = 0; ii < levelSets.size(); ++ii)
+  {
+    levelSets[ii]->Graft(updateLevelSets[ii]->GetOutputLevelSet());
+    this->m_RMSChangeAccumulator += updateLevelSets[ii]->GetRMSChangeAccumulator();
+  }
+}
+
 } // namespace itk
 #endif // itkLevelSetEvolutionBase_hxx
@@ -105,6 +105,12 @@ public:
   itkSetMacro(CurrentLevelSetId, IdentifierType);
   itkGetMacro(CurrentLevelSetId, IdentifierType);
 
+  /** Set/Get the number of work units of the internal label map filters, or 0
+   * for their default. Set to 1 when several level sets are updated
+   * concurrently, so that the filters do not nest into the thread pool. */
+  itkSetMacro(NumberOfWorkUnits, ThreadIdType);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
 protected:
   UpdateShiSparseLevelSet();
   ~UpdateShiSparseLevelSet() override = default;
@@ -113,6 +119,7 @@ protected:
   LevelSetPointer m_OutputLevelSet{};
 
   IdentifierType           m_CurrentLevelSetId{};
+  ThreadIdType             m_NumberOfWorkUnits{ 0 };
   LevelSetOutputRealType   m_RMSChangeAccumulator{};
   EquationContainerPointer m_EquationContainer{};
 
@@ -51,12 +51,18 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::Update()
   this->m_OutputLevelSet->SetLayer(LevelSetType::PlusOneLayer(),
                                    this->m_InputLevelSet->GetLayer(LevelSetType::PlusOneLayer()));
 
-  this->m_OutputLevelSet->SetLabelMap(this->m_InputLevelSet->GetModifiableLabelMap());
+  // The output gets its own label map so that the input level set is left
+  // untouched until the output is grafted onto it.
+  this->m_OutputLevelSet->SetLabelMap(LevelSetLabelMapType::New());
   this->m_OutputLevelSet->SetDomainOffset(this->m_Offset);
 
   using LabelMapToLabelImageFilterType = LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType>;
   auto labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
   labelMapToLabelImageFilter->SetInput(this->m_InputLevelSet->GetLabelMap());
+  if (this->m_NumberOfWorkUnits > 0)
+  {
+    labelMapToLabelImageFilter->SetNumberOfWorkUnits(this->m_NumberOfWorkUnits);
+  }
   labelMapToLabelImageFilter->Update();
 
   this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
@@ -167,6 +173,10 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::Update()
   auto labelImageToLabelMapFilter = LabelImageToLabelMapFilterType::New();
   labelImageToLabelMapFilter->SetInput(this->m_InternalImage);
   labelImageToLabelMapFilter->SetBackgroundValue(LevelSetType::PlusThreeLayer());
+  if (this->m_NumberOfWorkUnits > 0)
+  {
+    labelImageToLabelMapFilter->SetNumberOfWorkUnits(this->m_NumberOfWorkUnits);
+  }
   labelImageToLabelMapFilter->Update();
 
   LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap();
@@ -120,6 +120,12 @@ public:
   itkSetMacro(CurrentLevelSetId, IdentifierType);
   itkGetMacro(CurrentLevelSetId, IdentifierType);
 
+  /** Set/Get the number of work units of the internal label map filters, or 0
+   * for their default. Set to 1 when several level sets are updated
+   * concurrently, so that the filters do not nest into the thread pool. */
+  itkSetMacro(NumberOfWorkUnits, ThreadIdType);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
   /** Set the update map for all points in the zero layer */
   void
   SetUpdate(const LevelSetLayerType & update);
@@ -172,6 +178,7 @@ private:
   LevelSetOutputType m_TimeStep{};
   LevelSetOutputType m_RMSChangeAccumulator{};
   IdentifierType     m_CurrentLevelSetId{};
+  ThreadIdType       m_NumberOfWorkUnits{ 0 };
 
   EquationContainerPointer m_EquationContainer{};
 
@@ -75,10 +75,16 @@ UpdateWhitakerSparseLevelSet<VDimension, TLevelSetValueType, TEquationContainer>
   this->m_OutputLevelSet->SetDomainOffset(this->m_Offset);
   this->m_TempLevelSet->SetDomainOffset(this->m_Offset);
 
-  this->m_OutputLevelSet->SetLabelMap(this->m_InputLevelSet->GetModifiableLabelMap());
+  // The output gets its own label map so that the input level set is left
+  // untouched until the output is grafted onto it.
+  this->m_OutputLevelSet->SetLabelMap(LevelSetLabelMapType::New());
 
   auto labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
   labelMapToLabelImageFilter->SetInput(this->m_InputLevelSet->GetLabelMap());
+  if (this->m_NumberOfWorkUnits > 0)
+  {
+    labelMapToLabelImageFilter->SetNumberOfWorkUnits(this->m_NumberOfWorkUnits);
+  }
   labelMapToLabelImageFilter->Update();
 
   this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
@@ -168,6 +174,10 @@ UpdateWhitakerSparseLevelSet<VDimension, TLevelSetValueType, TEquationContainer>
   auto labelImageToLabelMapFilter = LabelImageToLabelMapFilterType::New();
   labelImageToLabelMapFilter->SetInput(this->m_InternalImage);
   labelImageToLabelMapFilter->SetBackgroundValue(LevelSetType::PlusThreeLayer());
+  if (this->m_NumberOfWorkUnits > 0)
+  {
+    labelImageToLabelMapFilter->SetNumberOfWorkUnits(this->m_NumberOfWorkUnits);
+  }
   labelImageToLabelMapFilter->Update();
 
   this->m_OutputLevelSet->GetModifiableLabelMap()->Graft(labelImageToLabelMapFilter->GetOutput());
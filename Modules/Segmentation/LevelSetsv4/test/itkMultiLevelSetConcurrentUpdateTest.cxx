@@ -0,0 +1,279 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkLevelSetEvolution.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkLevelSetDomainMapImageFilter.h"
+#include "itkAtanRegularizedHeavisideStepFunction.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+constexpr unsigned int NumberOfLevelSets = 3;
+
+using InputPixelType = unsigned short;
+using InputImageType = itk::Image<InputPixelType, Dimension>;
+
+// Evolve NumberOfLevelSets overlapping level sets, each one with its own
+// Chan and Vese internal term, and return their values over the whole image,
+// followed by the change of the last iteration. When coupled, each equation
+// also has a Chan and Vese external term, which reads the other level sets
+// through a domain map covering the whole image. The level sets are updated
+// on numberOfWorkUnits work units.
+template <typename TLevelSet>
+std::pair<std::vector<typename TLevelSet::OutputType>, double>
+EvolveLevelSets(InputImageType *  input,
+                bool              concurrentLevelSetUpdate,
+                itk::ThreadIdType numberOfWorkUnits,
+                bool              coupled)
+{
+  using LevelSetType = TLevelSet;
+  using LevelSetOutputRealType = typename LevelSetType::OutputRealType;
+  using LevelSetContainerType = itk::LevelSetContainer<itk::IdentifierType, LevelSetType>;
+  using ChanAndVeseInternalTermType =
+    itk::LevelSetEquationChanAndVeseInternalTerm<InputImageType, LevelSetContainerType>;
+  using ChanAndVeseExternalTermType =
+    itk::LevelSetEquationChanAndVeseExternalTerm<InputImageType, LevelSetContainerType>;
+  using TermContainerType = itk::LevelSetEquationTermContainer<InputImageType, LevelSetContainerType>;
+  using EquationContainerType = itk::LevelSetEquationContainer<TermContainerType>;
+  using LevelSetEvolutionType = itk::LevelSetEvolution<EquationContainerType, LevelSetType>;
+  using StoppingCriterionType = itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion<LevelSetContainerType>;
+  using HeavisideFunctionType =
+    itk::AtanRegularizedHeavisideStepFunction<LevelSetOutputRealType, LevelSetOutputRealType>;
+  using BinaryImageToLevelSetType = itk::BinaryImageToLevelSetImageAdaptor<InputImageType, LevelSetType>;
+  using IdListType = std::list<itk::IdentifierType>;
+  using IdListImageType = itk::Image<IdListType, Dimension>;
+  using CacheImageType = itk::Image<short, Dimension>;
+  using DomainMapImageFilterType = itk::LevelSetDomainMapImageFilter<IdListImageType, CacheImageType>;
+
+  auto heaviside = HeavisideFunctionType::New();
+  heaviside->SetEpsilon(1.0);
+
+  auto lscontainer = LevelSetContainerType::New();
+  lscontainer->SetHeaviside(heaviside);
+
+  if (coupled)
+  {
+    // The identifiers of the domain map start at 1.
+    IdListType listIds;
+    for (unsigned int ii = 0; ii < NumberOfLevelSets; ++ii)
+    {
+      listIds.push_back(ii + 1);
+    }
+
+    auto idImage = IdListImageType::New();
+    idImage->SetRegions(input->GetLargestPossibleRegion());
+    idImage->Allocate();
+    idImage->FillBuffer(listIds);
+
+    auto domainMapFilter = DomainMapImageFilterType::New();
+    domainMapFilter->SetInput(idImage);
+    domainMapFilter->Update();
+
+    lscontainer->SetDomainMapFilter(domainMapFilter);
+  }
+
+  auto equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer(lscontainer);
+
+  for (unsigned int ii = 0; ii < NumberOfLevelSets; ++ii)
+  {
+    // Each level set starts from a different square.
+    auto binary = InputImageType::New();
+    binary->SetRegions(input->GetLargestPossibleRegion());
+    binary->Allocate(true);
+
+    InputImageType::IndexType index;
+    index.Fill(8 + 4 * ii);
+    const InputImageType::RegionType seedRegion{ index, InputImageType::SizeType::Filled(28) };
+
+    itk::ImageRegionIterator<InputImageType> bIt(binary, seedRegion);
+    for (bIt.GoToBegin(); !bIt.IsAtEnd(); ++bIt)
+    {
+      bIt.Set(itk::NumericTraits<InputPixelType>::OneValue());
+    }
+
+    auto adaptor = BinaryImageToLevelSetType::New();
+    adaptor->SetInputImage(binary);
+    adaptor->Initialize();
+
+    lscontainer->AddLevelSet(ii, adaptor->GetModifiableLevelSet(), false);
+
+    auto cvInternalTerm = ChanAndVeseInternalTermType::New();
+    cvInternalTerm->SetInput(input);
+    cvInternalTerm->SetCoefficient(1.0);
+
+    auto termContainer = TermContainerType::New();
+    termContainer->SetInput(input);
+    termContainer->SetCurrentLevelSetId(ii);
+    termContainer->SetLevelSetContainer(lscontainer);
+    termContainer->AddTerm(0, cvInternalTerm);
+
+    if (coupled)
+    {
+      auto cvExternalTerm = ChanAndVeseExternalTermType::New();
+      cvExternalTerm->SetInput(input);
+      cvExternalTerm->SetCoefficient(1.0);
+      termContainer->AddTerm(1, cvExternalTerm);
+    }
+
+    equationContainer->AddEquation(ii, termContainer);
+  }
+
+  auto criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations(5);
+
+  const itk::ThreadIdType globalDefaultNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfWorkUnits);
+
+  auto evolution = LevelSetEvolutionType::New();
+  evolution->SetEquationContainer(equationContainer);
+  evolution->SetStoppingCriterion(criterion);
+  evolution->SetLevelSetContainer(lscontainer);
+  evolution->SetConcurrentLevelSetUpdate(concurrentLevelSetUpdate);
+  evolution->Update();
+
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(globalDefaultNumberOfThreads);
+
+  std::vector<typename LevelSetType::OutputType> values;
+  for (unsigned int ii = 0; ii < NumberOfLevelSets; ++ii)
+  {
+    const LevelSetType * levelSet = lscontainer->GetLevelSet(ii);
+
+    itk::ImageRegionConstIteratorWithIndex<InputImageType> it(input, input->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      values.push_back(levelSet->Evaluate(it.GetIndex()));
+    }
+  }
+  return { values, criterion->GetRMSChangeAccumulator() };
+}
+
+template <typename TLevelSet>
+bool
+CompareSerialAndConcurrentUpdates(InputImageType * input, const char * name)
+{
+  const auto serialValues = EvolveLevelSets<TLevelSet>(input, false, 4, false);
+  const auto concurrentValues = EvolveLevelSets<TLevelSet>(input, true, 4, false);
+
+  if (serialValues != concurrentValues)
+  {
+    std::cerr << "Test failed for uncoupled " << name << " level sets!" << std::endl;
+    std::cerr << "The concurrent update, or its change, differs from the serial one." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Coupled level sets updated concurrently only see the others as they were at
+// the beginning of the iteration, so their result must not depend on the
+// number of work units: running the update filters one after the other on a
+// single work unit must give the same values and the same change as running
+// them concurrently, although the external terms of the different level sets
+// read the same level sets at the same time. The fronts must also stay close
+// to the ones of the serial evolution.
+template <typename TLevelSet>
+bool
+CompareSerialAndConcurrentCoupledUpdates(InputImageType * input, const char * name)
+{
+  const auto serialValues = EvolveLevelSets<TLevelSet>(input, false, 4, true);
+  const auto singleWorkUnitValues = EvolveLevelSets<TLevelSet>(input, true, 1, true);
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2, 4 })
+  {
+    if (EvolveLevelSets<TLevelSet>(input, true, numberOfWorkUnits, true) != singleWorkUnitValues)
+    {
+      std::cerr << "Test failed for coupled " << name << " level sets!" << std::endl;
+      std::cerr << "The concurrent update on " << numberOfWorkUnits
+                << " work units differs from the one on a single work unit." << std::endl;
+      return false;
+    }
+  }
+  const auto & serial = serialValues.first;
+  const auto & concurrent = singleWorkUnitValues.first;
+
+  size_t numberOfDifferentPixels = 0;
+  for (size_t ii = 0; ii < serial.size(); ++ii)
+  {
+    if ((serial[ii] <= 0) != (concurrent[ii] <= 0))
+    {
+      ++numberOfDifferentPixels;
+    }
+  }
+  if (100 * numberOfDifferentPixels > serial.size())
+  {
+    std::cerr << "Test failed for coupled " << name << " level sets!" << std::endl;
+    std::cerr << "The interiors of the concurrent update differ from the serial ones on " << numberOfDifferentPixels
+              << " pixels." << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkMultiLevelSetConcurrentUpdateTest(int, char *[])
+{
+  auto input = InputImageType::New();
+  input->SetRegions(InputImageType::SizeType::Filled(64));
+  input->Allocate(true);
+
+  InputImageType::IndexType index;
+  index.Fill(16);
+  const InputImageType::RegionType objectRegion{ index, InputImageType::SizeType::Filled(32) };
+
+  itk::ImageRegionIterator<InputImageType> iIt(input, objectRegion);
+  for (iIt.GoToBegin(); !iIt.IsAtEnd(); ++iIt)
+  {
+    iIt.Set(100);
+  }
+
+  using ShiLevelSetType = itk::ShiSparseLevelSetImage<Dimension>;
+  using ShiLevelSetContainerType = itk::LevelSetContainer<itk::IdentifierType, ShiLevelSetType>;
+  using ShiTermContainerType = itk::LevelSetEquationTermContainer<InputImageType, ShiLevelSetContainerType>;
+  using ShiEquationContainerType = itk::LevelSetEquationContainer<ShiTermContainerType>;
+  using ShiLevelSetEvolutionType = itk::LevelSetEvolution<ShiEquationContainerType, ShiLevelSetType>;
+
+  auto evolution = ShiLevelSetEvolutionType::New();
+  ITK_TEST_SET_GET_BOOLEAN(evolution, ConcurrentLevelSetUpdate, true);
+
+  using WhitakerLevelSetType = itk::WhitakerSparseLevelSetImage<float, Dimension>;
+  using MalcolmLevelSetType = itk::MalcolmSparseLevelSetImage<Dimension>;
+
+  bool testPassed = true;
+  testPassed &= CompareSerialAndConcurrentUpdates<WhitakerLevelSetType>(input, "Whitaker");
+  testPassed &= CompareSerialAndConcurrentUpdates<ShiLevelSetType>(input, "Shi");
+  testPassed &= CompareSerialAndConcurrentUpdates<MalcolmLevelSetType>(input, "Malcolm");
+  testPassed &= CompareSerialAndConcurrentCoupledUpdates<WhitakerLevelSetType>(input, "Whitaker");
+  testPassed &= CompareSerialAndConcurrentCoupledUpdates<ShiLevelSetType>(input, "Shi");
+  testPassed &= CompareSerialAndConcurrentCoupledUpdates<MalcolmLevelSetType>(input, "Malcolm");
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
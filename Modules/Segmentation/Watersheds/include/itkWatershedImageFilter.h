@@ -23,6 +23,8 @@
 #include "itkWatershedSegmentTreeGenerator.h"
 #include "itkWatershedRelabeler.h"
 #include "itkWatershedMiniPipelineProgressCommand.h"
+#include "itkWatershedBoundaryResolver.h"
+#include <functional>
 
 namespace itk
 {
@@ -32,8 +34,8 @@ namespace itk
  *
  * \par Overview and terminology
  * \par
- * This filter implements a non-streaming version of an image segmentation
- * algorithm commonly known as "watershed segmentation".   Watershed
+ * This filter implements an image segmentation algorithm commonly known as
+ * "watershed segmentation".   Watershed
  * segmentation gets its name from the manner in which the algorithm  segments
  * regions into catchment basins. If a function \f$ f \f$ is a continuous
  * height function defined over an image domain, then a catchment basin is
@@ -75,9 +77,32 @@ namespace itk
  * algorithm components in the namespace "watershed").  For a more complete
  * picture of the implementation, refer to the documentation of those components.
  * The component classes were designed to operate in either a data-streaming or
- * a non-data-streaming mode.  The pipeline constructed in this class'
- * GenerateData() method does not support streaming, but is the common use case
- * for the components.
+ * a non-data-streaming mode.  By default, the pipeline constructed in this
+ * class' GenerateData() method does not support streaming, but is the common
+ * use case for the components.
+ *
+ * \par
+ * When NumberOfTiles is greater than one, the image is instead split into a
+ * grid of tiles that are segmented concurrently by independent Segmenter
+ * objects, at most one tile per work unit at a time.  The labels flowing across
+ * the tile faces are joined with BoundaryResolver, the segment tables of the
+ * tiles are merged with the adjacencies across the faces, and the merge tree
+ * is computed once for the whole image.  The plateaus that cross a tile face
+ * flow to their lowest outlet over all the tiles.  The output labels the same
+ * regions as the single tile pipeline, up to the label values, except where a
+ * plateau has several outlets of the same height, which may be chosen
+ * differently.
+ *
+ * \par
+ * The tiled mode streams: the input is requested one padded tile at a time,
+ * and only the requested region of the output is produced, so that a
+ * streaming consumer such as StreamingImageFilter or ImageFileWriter keeps the
+ * memory bounded for very large images.  The input is read twice, once to
+ * find its dynamic range and once to segment the tiles.  The equivalencies of
+ * the labels over the whole image are kept between updates, and the tiles
+ * covering each further requested region of the output are segmented again
+ * to produce it.  The basic segmentation is not kept, so that changing the
+ * Level re-executes the whole segmentation.
  *
  * \par Description of the input to this filter
  * The input to this filter is a scalar itk::Image of any dimensionality.  This
@@ -184,7 +209,8 @@ public:
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
-  /** Standard process object method.  This filter is not multithreaded. */
+  /** Standard process object method.  This filter is only multithreaded
+   * when NumberOfTiles is greater than one. */
   void
   GenerateData() override;
 
@@ -233,6 +259,14 @@ public:
 
   itkGetConstMacro(Level, double);
 
+  /** Set/Get the number of tiles the image is split into.  The default value
+   * is 1, which segments the whole image at once.  GetBasicSegmentation() and
+   * GetSegmentTree() refer to the single tile pipeline only. */
+  void
+  SetNumberOfTiles(unsigned int);
+
+  itkGetConstMacro(NumberOfTiles, unsigned int);
+
   /** Get the basic segmentation from the Segmenter member filter. */
   typename watershed::Segmenter<InputImageType>::OutputImageType *
   GetBasicSegmentation()
@@ -248,10 +282,14 @@ public:
     return m_TreeGenerator->GetOutputSegmentTree();
   }
 
-  // Override since the filter produces all of its output
+  // Override since the filter produces all of its output, unless it is tiled
   void
   EnlargeOutputRequestedRegion(DataObject * data) override;
 
+  // Override since the tiled mode requests the input tile by tile
+  void
+  GenerateInputRequestedRegion() override;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(InputEqualityComparableCheck, (Concept::EqualityComparable<ScalarType>));
@@ -272,7 +310,42 @@ protected:
   void
   PrepareOutputs() override;
 
+  /** Segment the image tile by tile.  Called by GenerateData() when
+   * NumberOfTiles is greater than one. */
+  void
+  GenerateTiledData();
+
 private:
+  using SegmenterType = watershed::Segmenter<InputImageType>;
+
+  /** Split the largest possible region of the input into the tiles, and
+   * compute the range of labels of each tile. */
+  void
+  SplitIntoTiles();
+
+  /** Get the index of the tile containing an index of the image.  Throws an
+   * exception if the index is outside the image. */
+  unsigned int
+  FindTile(const IndexType & index) const;
+
+  /** Segment the tiles of the list, each with its own Segmenter.  The input
+   * of each tile is streamed in turn, then up to one tile per work unit is
+   * segmented concurrently, and the function is called with the index and
+   * the Segmenter of each segmented tile. */
+  void
+  SegmentTiles(const std::vector<unsigned int> &                     tileIndices,
+               const std::function<void(unsigned int, SegmenterType *)> & tileFunction);
+
+  /** Segment all the tiles, join the labels across their faces, and compute
+   * the equivalencies of the labels over the whole image, up to the flood
+   * level.  The function is called with each segmented tile. */
+  void
+  ComputeTiledEquivalencies(const std::function<void(unsigned int, SegmenterType *)> & tileFunction);
+
+  /** Update the input over a region of it. */
+  void
+  StreamInput(const RegionType & region);
+
   /** A Percentage of the maximum depth (max - min pixel value) in the input
    *  image.  This percentage will be used to threshold the minimum values in
    *  the image. */
@@ -284,6 +357,19 @@ private:
    *  level. */
   double m_Level{ 0.0 };
 
+  /** The number of tiles segmented concurrently. */
+  unsigned int m_NumberOfTiles{ 1 };
+
+  /** The tiled segmentation, kept between the updates of different output
+   * requested regions.  Each tile is also segmented with a one pixel overlap
+   * along the faces it shares with other tiles. */
+  std::vector<RegionType>     m_Tiles{};
+  std::vector<RegionType>     m_PaddedTiles{};
+  std::vector<IdentifierType> m_TileFirstLabels{};
+  ScalarType                  m_TileMinimum{};
+  ScalarType                  m_TileMaximum{};
+  EquivalencyTable::Pointer   m_TileEquivalencies{};
+
   /** The component parts of the segmentation algorithm.  These objects
    * must save state between calls to GenerateData() so that the
    * computationally expensive execution of segment tree generation is
@@ -18,6 +18,14 @@
 #ifndef itkWatershedImageFilter_hxx
 #define itkWatershedImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkMultiThreaderBase.h"
+#include <mutex>
+#include <numeric>
+#include <unordered_set>
+
 namespace itk
 {
 template <typename TInputImage>
@@ -73,6 +81,25 @@ WatershedImageFilter<TInputImage>::SetLevel(double val)
   ITK_GCC_PRAGMA_POP
 }
 
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::SetNumberOfTiles(unsigned int val)
+{
+  if (val < 1)
+  {
+    val = 1;
+  }
+
+  if (val != m_NumberOfTiles)
+  {
+    m_NumberOfTiles = val;
+
+    // The mini-pipeline does not know about the updates done by tiles.
+    m_InputChanged = true;
+    this->Modified();
+  }
+}
+
 template <typename TInputImage>
 WatershedImageFilter<TInputImage>::WatershedImageFilter()
 {
@@ -111,7 +138,10 @@ void
 WatershedImageFilter<TInputImage>::EnlargeOutputRequestedRegion(DataObject * data)
 {
   Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
+  if (m_NumberOfTiles == 1)
+  {
+    data->SetRequestedRegionToLargestPossibleRegion();
+  }
 }
 
 template <typename TInputImage>
@@ -168,6 +198,12 @@ template <typename TInputImage>
 void
 WatershedImageFilter<TInputImage>::GenerateData()
 {
+  if (m_NumberOfTiles > 1)
+  {
+    this->GenerateTiledData();
+    return;
+  }
+
   // Set the largest possible region in the segmenter
   m_Segmenter->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
   m_Segmenter->GetOutputImage()->SetRequestedRegion(this->GetInput()->GetLargestPossibleRegion());
@@ -196,6 +232,537 @@ WatershedImageFilter<TInputImage>::GenerateData()
   m_ThresholdChanged = false;
 }
 
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (m_NumberOfTiles == 1)
+  {
+    return;
+  }
+
+  // GenerateTiledData() streams the input tile by tile, so only the first
+  // tile it reads is requested here.
+  this->SplitIntoTiles();
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  input->SetRequestedRegion(m_PaddedTiles[this->FindTile(this->GetOutput()->GetRequestedRegion().GetIndex())]);
+}
+
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::SplitIntoTiles()
+{
+  //
+  // Split the image into a grid of tiles, so that each face of a tile
+  // matches exactly the face of its neighbor.
+  //
+  const RegionType largestPossibleRegion = this->GetInput()->GetLargestPossibleRegion();
+  auto             splitter = ImageRegionSplitterMultidimensional::New();
+  const unsigned int numberOfTiles = splitter->GetNumberOfSplits(largestPossibleRegion, m_NumberOfTiles);
+
+  //
+  // Each tile is processed with the one pixel overlap the Segmenter expects
+  // along the faces shared with other tiles.  Every tile labels its segments
+  // from its own range, which is larger than the number of labels the
+  // Segmenter can create.
+  //
+  m_Tiles.assign(numberOfTiles, largestPossibleRegion);
+  m_PaddedTiles.resize(numberOfTiles);
+  m_TileFirstLabels.resize(numberOfTiles + 1);
+  m_TileFirstLabels[0] = 1;
+  for (unsigned int i = 0; i < numberOfTiles; ++i)
+  {
+    splitter->GetSplit(i, numberOfTiles, m_Tiles[i]);
+    m_PaddedTiles[i] = m_Tiles[i];
+    m_PaddedTiles[i].PadByRadius(1);
+    m_PaddedTiles[i].Crop(largestPossibleRegion);
+    m_TileFirstLabels[i + 1] = m_TileFirstLabels[i] + (2 * ImageDimension + 1) * m_PaddedTiles[i].GetNumberOfPixels();
+  }
+}
+
+template <typename TInputImage>
+unsigned int
+WatershedImageFilter<TInputImage>::FindTile(const IndexType & index) const
+{
+  for (unsigned int i = 0; i < m_Tiles.size(); ++i)
+  {
+    if (m_Tiles[i].IsInside(index))
+    {
+      return i;
+    }
+  }
+  itkExceptionMacro("The index " << index << " is outside the largest possible region of the input.");
+}
+
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::StreamInput(const RegionType & region)
+{
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  input->SetRequestedRegion(region);
+  input->PropagateRequestedRegion();
+  input->UpdateOutputData();
+
+  if (!input->GetBufferedRegion().IsInside(region))
+  {
+    itkExceptionMacro("The input does not provide the region " << region);
+  }
+}
+
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::SegmentTiles(
+  const std::vector<unsigned int> &                           tileIndices,
+  const std::function<void(unsigned int, SegmenterType *)> & tileFunction)
+{
+  const InputImageType * input = this->GetInput();
+  MultiThreaderBase *    multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  const size_t batchSize = std::max(multiThreader->GetNumberOfWorkUnits(), 1u);
+
+  std::vector<typename InputImageType::Pointer> tileInputs(batchSize);
+  for (size_t first = 0; first < tileIndices.size(); first += batchSize)
+  {
+    const size_t last = std::min(first + batchSize, tileIndices.size());
+
+    // The pipeline upstream cannot execute concurrently, so the input of each
+    // tile of the batch is streamed in turn, and copied to an image that is
+    // disconnected from the pipeline.
+    for (size_t k = first; k < last; ++k)
+    {
+      const RegionType & paddedTile = m_PaddedTiles[tileIndices[k]];
+      this->StreamInput(paddedTile);
+
+      auto tileInput = InputImageType::New();
+      tileInput->CopyInformation(input);
+      tileInput->SetBufferedRegion(paddedTile);
+      tileInput->SetRequestedRegion(paddedTile);
+      tileInput->Allocate();
+      ImageAlgorithm::Copy(input, tileInput.GetPointer(), paddedTile, paddedTile);
+      tileInputs[k - first] = tileInput;
+    }
+
+    const double threshold = m_Threshold;
+    multiThreader->ParallelizeArray(
+      first,
+      last,
+      [&, threshold](SizeValueType k) {
+        const unsigned int i = tileIndices[k];
+
+        auto segmenter = SegmenterType::New();
+        segmenter->SetInputImage(tileInputs[k - first]);
+        segmenter->SetLargestPossibleRegion(input->GetLargestPossibleRegion());
+        segmenter->SetThreshold(threshold);
+        segmenter->SetDoBoundaryAnalysis(true);
+        segmenter->SetSortEdgeLists(false);
+        segmenter->SetCurrentLabel(m_TileFirstLabels[i]);
+        segmenter->AutoMinimumMaximumOff();
+        segmenter->SetMinimum(m_TileMinimum);
+        segmenter->SetMaximum(m_TileMaximum);
+        segmenter->GetOutputImage()->SetRequestedRegion(m_PaddedTiles[i]);
+        segmenter->Update();
+        tileInputs[k - first] = nullptr;
+
+        if (segmenter->GetCurrentLabel() > m_TileFirstLabels[i + 1])
+        {
+          itkExceptionMacro("The labels of tile " << i << " overflow their range.");
+        }
+
+        tileFunction(i, segmenter);
+      },
+      nullptr);
+  }
+}
+
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::GenerateTiledData()
+{
+  this->UpdateProgress(0.0);
+
+  OutputImageType * output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+  const RegionType outputRegion = output->GetRequestedRegion();
+
+  this->SplitIntoTiles();
+
+  // Copy the labels of a segmented tile where the output is requested.
+  const auto copyLabels = [output, &outputRegion, this](unsigned int i, SegmenterType * segmenter) {
+    RegionType region = m_Tiles[i];
+    if (region.Crop(outputRegion))
+    {
+      ImageAlgorithm::Copy(segmenter->GetOutputImage(), output, region, region);
+    }
+  };
+
+  if (m_TileEquivalencies.IsNull() || m_InputChanged || m_ThresholdChanged || m_LevelChanged ||
+      this->GetInput()->GetPipelineMTime() > m_GenerateDataMTime)
+  {
+    this->ComputeTiledEquivalencies(copyLabels);
+  }
+  else
+  {
+    // The equivalencies are up to date, so only the tiles covering the
+    // requested region of the output are segmented again.
+    std::vector<unsigned int> tileIndices;
+    for (unsigned int i = 0; i < m_Tiles.size(); ++i)
+    {
+      RegionType region = m_Tiles[i];
+      if (region.Crop(outputRegion))
+      {
+        tileIndices.push_back(i);
+      }
+    }
+    this->SegmentTiles(tileIndices, copyLabels);
+  }
+
+  this->UpdateProgress(0.9);
+
+  //
+  // Relabel the output with the equivalencies and the merges up to the flood
+  // level, as the Relabeler does.
+  //
+  const EquivalencyTable * equivalencies = m_TileEquivalencies;
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    outputRegion,
+    [output, equivalencies](const RegionType & region) {
+      for (ImageRegionIterator<OutputImageType> it(output, region); !it.IsAtEnd(); ++it)
+      {
+        it.Set(equivalencies->Lookup(it.Get()));
+      }
+    },
+    nullptr);
+
+  this->UpdateProgress(1.0);
+
+  // Keep track of when we last executed
+  m_GenerateDataMTime.Modified();
+
+  // Clear flags
+  m_InputChanged = false;
+  m_LevelChanged = false;
+  m_ThresholdChanged = false;
+}
+
+template <typename TInputImage>
+void
+WatershedImageFilter<TInputImage>::ComputeTiledEquivalencies(
+  const std::function<void(unsigned int, SegmenterType *)> & tileFunction)
+{
+  using BoundaryType = typename SegmenterType::BoundaryType;
+  using SegmentTableType = typename SegmenterType::SegmentTableType;
+  using BoundaryResolverType = watershed::BoundaryResolver<ScalarType, ImageDimension>;
+  using TreeGeneratorType = watershed::SegmentTreeGenerator<ScalarType>;
+  using FaceType = typename BoundaryType::face_t;
+
+  const InputImageType * input = this->GetInput();
+  const auto             numberOfTiles = static_cast<unsigned int>(m_Tiles.size());
+  MultiThreaderBase *    multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  //
+  // All the tiles must be thresholded at the same level, so the dynamic range
+  // is computed over the whole image first.  The tiles are read starting with
+  // the one requested by GenerateInputRequestedRegion().
+  //
+  const unsigned int firstTile = this->FindTile(this->GetOutput()->GetRequestedRegion().GetIndex());
+  bool               hasMinimumMaximum = false;
+  std::mutex         mutex;
+  for (unsigned int t = 0; t < numberOfTiles; ++t)
+  {
+    const unsigned int i = (firstTile + t) % numberOfTiles;
+    this->StreamInput(m_Tiles[i]);
+    multiThreader->template ParallelizeImageRegion<ImageDimension>(
+      m_Tiles[i],
+      [&](const RegionType & region) {
+        ImageRegionConstIterator<InputImageType> it(input, region);
+        ScalarType                               minimum = it.Get();
+        ScalarType                               maximum = it.Get();
+        for (; !it.IsAtEnd(); ++it)
+        {
+          if (it.Get() < minimum)
+          {
+            minimum = it.Get();
+          }
+          if (it.Get() > maximum)
+          {
+            maximum = it.Get();
+          }
+        }
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (!hasMinimumMaximum || minimum < m_TileMinimum)
+        {
+          m_TileMinimum = minimum;
+        }
+        if (!hasMinimumMaximum || maximum > m_TileMaximum)
+        {
+          m_TileMaximum = maximum;
+        }
+        hasMinimumMaximum = true;
+      },
+      nullptr);
+  }
+
+  this->UpdateProgress(0.1);
+
+  // Apply the same threshold as the Segmenter to the pixels of the faces.
+  ScalarType cappedMaximum = m_TileMaximum;
+  ITK_GCC_PRAGMA_PUSH
+  ITK_GCC_SUPPRESS_Wfloat_equal
+  if (std::is_integral_v<ScalarType> && cappedMaximum == NumericTraits<ScalarType>::max())
+  {
+    cappedMaximum -= NumericTraits<ScalarType>::OneValue();
+  }
+  ITK_GCC_PRAGMA_POP
+  const auto thresholdValue = static_cast<ScalarType>((m_Threshold * (cappedMaximum - m_TileMinimum)) + m_TileMinimum);
+  const auto thresholdedValue = [thresholdValue](ScalarType value) -> ScalarType {
+    if (value < thresholdValue)
+    {
+      return thresholdValue;
+    }
+    ITK_GCC_PRAGMA_PUSH
+    ITK_GCC_SUPPRESS_Wfloat_equal
+    if (std::is_integral_v<ScalarType> && value == NumericTraits<ScalarType>::max())
+    {
+      return value - NumericTraits<ScalarType>::OneValue();
+    }
+    ITK_GCC_PRAGMA_POP
+    return value;
+  };
+
+  //
+  // Segment the tiles.  Only their boundary, their segment table and the input
+  // values along their faces are kept.
+  //
+  std::vector<typename BoundaryType::Pointer>                boundaries(numberOfTiles);
+  std::vector<typename SegmentTableType::Pointer>            segmentTables(numberOfTiles);
+  std::vector<typename InputImageType::Pointer>              faceValues(numberOfTiles * 2 * ImageDimension);
+  std::vector<unsigned int>                                  tileIndices(numberOfTiles);
+  std::iota(tileIndices.begin(), tileIndices.end(), 0u);
+  this->SegmentTiles(tileIndices, [&](unsigned int i, SegmenterType * segmenter) {
+    tileFunction(i, segmenter);
+
+    boundaries[i] = segmenter->GetBoundary();
+    segmentTables[i] = segmenter->GetSegmentTable();
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      for (unsigned int highlow = 0; highlow < 2; ++highlow)
+      {
+        if (!boundaries[i]->GetValid(d, highlow))
+        {
+          continue;
+        }
+        const RegionType faceRegion = boundaries[i]->GetFace(d, highlow)->GetRequestedRegion();
+        auto             values = InputImageType::New();
+        values->SetRegions(faceRegion);
+        values->Allocate();
+        ImageAlgorithm::Copy(segmenter->GetInputImage(), values.GetPointer(), faceRegion, faceRegion);
+        faceValues[(i * ImageDimension + d) * 2 + highlow] = values;
+      }
+    }
+  });
+
+  this->UpdateProgress(0.6);
+
+  //
+  // Merge the segment tables of the tiles.  The labels of the tiles do not
+  // overlap.
+  //
+  auto segmentTable = SegmentTableType::New();
+  for (unsigned int i = 0; i < numberOfTiles; ++i)
+  {
+    for (auto it = segmentTables[i]->Begin(); it != segmentTables[i]->End(); ++it)
+    {
+      typename SegmentTableType::segment_t segment;
+      segment.min = it->second.min;
+      segmentTable->Add(it->first, segment);
+      segmentTable->Lookup(it->first)->edge_list.swap(it->second.edge_list);
+    }
+    segmentTables[i] = nullptr;
+  }
+
+  //
+  // The plateaus that reach a face shared with another tile are not descended
+  // by the Segmenter, since their lowest neighbor may lie in another tile.
+  // The outlets of their pieces are gathered from all the tiles instead.
+  //
+  using OutletType = std::pair<ScalarType, IdentifierType>;
+  const auto addOutlet = [](auto & outlets, IdentifierType label, const OutletType & outlet) {
+    auto result = outlets.insert(std::make_pair(label, outlet));
+    if (!result.second && outlet < result.first->second)
+    {
+      result.first->second = outlet;
+    }
+  };
+
+  std::unordered_set<IdentifierType>             plateaus;
+  std::unordered_map<IdentifierType, OutletType> outlets;
+  for (unsigned int i = 0; i < numberOfTiles; ++i)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      for (unsigned int highlow = 0; highlow < 2; ++highlow)
+      {
+        if (!boundaries[i]->GetValid(d, highlow))
+        {
+          continue;
+        }
+        for (const auto & flat : *boundaries[i]->GetFlatHash(d, highlow))
+        {
+          plateaus.insert(flat.first);
+          if (flat.second.bounds_min < flat.second.value)
+          {
+            addOutlet(outlets, flat.first, OutletType(flat.second.bounds_min, flat.second.min_label));
+          }
+        }
+      }
+    }
+  }
+
+  //
+  // Resolve the labels that flow across each face shared by two tiles, and
+  // add the adjacencies across that face, which the Segmenter of either tile
+  // cannot see.
+  //
+  auto equivalencies = EquivalencyTable::New();
+  for (unsigned int a = 0; a < numberOfTiles; ++a)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      IndexType neighborIndex = m_Tiles[a].GetIndex();
+      neighborIndex[d] += static_cast<IndexValueType>(m_Tiles[a].GetSize()[d]);
+      unsigned int b = 0;
+      while (b < numberOfTiles && m_Tiles[b].GetIndex() != neighborIndex)
+      {
+        ++b;
+      }
+      if (b == numberOfTiles)
+      {
+        continue;
+      }
+
+      const typename FaceType::Pointer faceA = boundaries[a]->GetFace(d, 1);
+      const typename FaceType::Pointer faceB = boundaries[b]->GetFace(d, 0);
+      const InputImageType *           faceValuesA = faceValues[(a * ImageDimension + d) * 2 + 1];
+      const InputImageType *           faceValuesB = faceValues[(b * ImageDimension + d) * 2];
+
+      std::unordered_map<IdentifierType, std::map<IdentifierType, ScalarType>> edges;
+
+      ImageRegionIteratorWithIndex<FaceType> itA(faceA, faceA->GetRequestedRegion());
+      ImageRegionIteratorWithIndex<FaceType> itB(faceB, faceB->GetRequestedRegion());
+      for (; !itA.IsAtEnd(); ++itA, ++itB)
+      {
+        typename BoundaryType::face_pixel_t pixelA = itA.Get();
+        typename BoundaryType::face_pixel_t pixelB = itB.Get();
+        const ScalarType                    valueA = thresholdedValue(faceValuesA->GetPixel(itA.GetIndex()));
+        const ScalarType                    valueB = thresholdedValue(faceValuesB->GetPixel(itB.GetIndex()));
+
+        // A plateau that flows down across the face is not joined to the
+        // segment below, which is only one of the outlets of the plateau.
+        if (pixelA.flow != SegmenterType::NULL_FLOW && !Math::AlmostEquals(valueA, valueB) &&
+            plateaus.count(pixelA.label) != 0)
+        {
+          addOutlet(outlets, pixelA.label, OutletType(valueB, pixelB.label));
+          pixelA.flow = SegmenterType::NULL_FLOW;
+          itA.Set(pixelA);
+        }
+        if (pixelB.flow != SegmenterType::NULL_FLOW && !Math::AlmostEquals(valueA, valueB) &&
+            plateaus.count(pixelB.label) != 0)
+        {
+          addOutlet(outlets, pixelB.label, OutletType(valueA, pixelA.label));
+          pixelB.flow = SegmenterType::NULL_FLOW;
+          itB.Set(pixelB);
+        }
+
+        const ScalarType height = std::max(valueA, valueB);
+        for (const auto & edge :
+             { std::make_pair(pixelA.label, pixelB.label), std::make_pair(pixelB.label, pixelA.label) })
+        {
+          auto result = edges[edge.first].insert(std::make_pair(edge.second, height));
+          if (!result.second && height < result.first->second)
+          {
+            result.first->second = height;
+          }
+        }
+      }
+
+      for (const auto & edgeTable : edges)
+      {
+        typename SegmentTableType::segment_t * segment = segmentTable->Lookup(edgeTable.first);
+        if (segment == nullptr)
+        {
+          itkExceptionMacro("Label " << edgeTable.first << " of a tile face is missing from the segment table.");
+        }
+        for (const auto & edge : edgeTable.second)
+        {
+          segment->edge_list.push_back(typename SegmentTableType::edge_pair_t(edge.first, edge.second));
+        }
+      }
+
+      auto resolver = BoundaryResolverType::New();
+      resolver->SetBoundaryA(boundaries[a]);
+      resolver->SetBoundaryB(boundaries[b]);
+      resolver->SetFace(d);
+      resolver->Update();
+
+      for (auto it = resolver->GetEquivalencyTable()->Begin(); it != resolver->GetEquivalencyTable()->End(); ++it)
+      {
+        equivalencies->Add(it->first, it->second);
+      }
+    }
+  }
+
+  // Once its pieces are joined, each plateau flows to its lowest outlet.  The
+  // ties between outlets of the same height are broken by their label.
+  std::unordered_map<IdentifierType, OutletType> plateauOutlets;
+  for (const auto & outlet : outlets)
+  {
+    addOutlet(plateauOutlets, equivalencies->RecursiveLookup(outlet.first), outlet.second);
+  }
+  for (const auto & outlet : plateauOutlets)
+  {
+    equivalencies->Add(outlet.first, outlet.second.second);
+  }
+  boundaries.clear();
+  faceValues.clear();
+
+  segmentTable->SortEdgeLists();
+  segmentTable->SetMaximumDepth(cappedMaximum - m_TileMinimum);
+
+  this->UpdateProgress(0.7);
+
+  //
+  // Merge the segments joined across the faces, then compute the merge tree
+  // of the whole image.
+  //
+  auto treeGenerator = TreeGeneratorType::New();
+  treeGenerator->SetInputSegmentTable(segmentTable);
+  treeGenerator->SetInputEquivalencyTable(equivalencies);
+  treeGenerator->SetMerge(true);
+  treeGenerator->SetConsumeInput(true);
+  treeGenerator->SetFloodLevel(m_Level);
+  treeGenerator->Update();
+
+  //
+  // Add the merges up to the flood level to the equivalencies, as the
+  // Relabeler does.
+  //
+  typename TreeGeneratorType::SegmentTreeType::Pointer tree = treeGenerator->GetOutputSegmentTree();
+  if (!tree->Empty())
+  {
+    const auto mergeLimit = static_cast<ScalarType>(m_Level * tree->Back().saliency);
+    for (auto it = tree->Begin(); it != tree->End() && it->saliency <= mergeLimit; ++it)
+    {
+      equivalencies->Add(it->from, it->to);
+    }
+  }
+  equivalencies->Flatten();
+  m_TileEquivalencies = equivalencies;
+}
+
 template <typename TInputImage>
 void
 WatershedImageFilter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -203,6 +770,7 @@ WatershedImageFilter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) c
   Superclass::PrintSelf(os, indent);
   os << indent << "Threshold: " << m_Threshold << std::endl;
   os << indent << "Level: " << m_Level << std::endl;
+  os << indent << "NumberOfTiles: " << m_NumberOfTiles << std::endl;
 }
 } // end namespace itk
 
@@ -248,6 +248,22 @@ public:
   itkGetConstMacro(SortEdgeLists, bool);
   itkSetMacro(SortEdgeLists, bool);
 
+  /** Determines whether the minimum and maximum values used to compute the
+   * threshold and the maximum depth are computed from the region being
+   * processed.  Default is true.  Streaming applications must turn this off
+   * and set the minimum and maximum values of the whole data set, so that all
+   * the chunks are thresholded at the same level. */
+  itkSetMacro(AutoMinimumMaximum, bool);
+  itkGetConstMacro(AutoMinimumMaximum, bool);
+  itkBooleanMacro(AutoMinimumMaximum);
+
+  /** Gets/Sets the minimum and maximum values of the data set.  Only used
+   * when AutoMinimumMaximum is off. */
+  itkSetMacro(Minimum, InputPixelType);
+  itkGetConstMacro(Minimum, InputPixelType);
+  itkSetMacro(Maximum, InputPixelType);
+  itkGetConstMacro(Maximum, InputPixelType);
+
 protected:
   /** Structure storing information about image flat regions.
    * Flat regions are connected pixels of the same value.  */
@@ -392,6 +408,9 @@ private:
 
   bool           m_SortEdgeLists{};
   bool           m_DoBoundaryAnalysis{};
+  bool           m_AutoMinimumMaximum{ true };
+  InputPixelType m_Minimum{};
+  InputPixelType m_Maximum{};
   double         m_Threshold{};
   double         m_MaximumFloodLevel{};
   IdentifierType m_CurrentLabel{};
@@ -167,9 +167,12 @@ Segmenter<TInputImage>::GenerateData()
   // for local minima without requiring expensive boundary conditions.
   //
   //
-  InputPixelType minimum;
-  InputPixelType maximum;
-  Self::MinMax(input, regionToProcess, minimum, maximum);
+  InputPixelType minimum = m_Minimum;
+  InputPixelType maximum = m_Maximum;
+  if (m_AutoMinimumMaximum)
+  {
+    Self::MinMax(input, regionToProcess, minimum, maximum);
+  }
   // cap the maximum in the image so that we can always define a pixel
   // value that is one greater than the maximum value in the image.
   ITK_GCC_PRAGMA_PUSH
@@ -179,6 +182,16 @@ Segmenter<TInputImage>::GenerateData()
     maximum -= NumericTraits<InputPixelType>::OneValue();
   }
   ITK_GCC_PRAGMA_POP
+
+  // The boundary flow analysis looks at the padding along the true data set
+  // boundaries before the retaining wall is built below, so build it there
+  // first.  The overlaps with other chunks are filled by the threshold.
+  if (m_DoBoundaryAnalysis)
+  {
+    this->BuildRetainingWall(
+      thresholdImage, thresholdImage->GetBufferedRegion(), maximum + NumericTraits<InputPixelType>::OneValue());
+  }
+
   // threshold the image.
   Self::Threshold(thresholdImage,
                   input,
@@ -481,15 +494,17 @@ Segmenter<TInputImage>::AnalyzeBoundaryFlow(InputImageTypePointer thresholdImage
       searchIt.GoToBegin();
       labelIt.GoToBegin();
 
+      // The connectivity lists the low neighbors from the highest dimension
+      // down, then the high neighbors from the lowest dimension up.
       if ((idx).second == 0)
       {
         // Low face
-        cPos = m_Connectivity.index[(idx).first];
+        cPos = m_Connectivity.index[(ImageDimension - 1) - (idx).first];
       }
       else
       {
         // High face
-        cPos = m_Connectivity.index[(ImageDimension - 1) + (ImageDimension - (idx).first)];
+        cPos = m_Connectivity.index[ImageDimension + (idx).first];
       }
 
       while (!searchIt.IsAtEnd())
@@ -542,11 +557,14 @@ Segmenter<TInputImage>::AnalyzeBoundaryFlow(InputImageTypePointer thresholdImage
         {
           if (searchIt.GetPixel(cPos) < searchIt.GetPixel(nCenter))
           {
+            // Gradient descent follows the first of the lowest neighbors
+            // in connectivity order, which is also the neighborhood order.
             isSteepest = true;
             for (i = 0; i < m_Connectivity.size; ++i)
             {
               nPos = m_Connectivity.index[i];
-              if (searchIt.GetPixel(nPos) < searchIt.GetPixel(cPos))
+              if (searchIt.GetPixel(nPos) < searchIt.GetPixel(cPos) ||
+                  (nPos < cPos && !(searchIt.GetPixel(cPos) < searchIt.GetPixel(nPos))))
               {
                 isSteepest = false;
                 break;
@@ -572,7 +590,9 @@ Segmenter<TInputImage>::AnalyzeBoundaryFlow(InputImageTypePointer thresholdImage
             // Since we've labeled this pixel, we need to check to
             // make sure this is not also a flat region.  If it is,
             // then it must be entered into the flat region table
-            // or we could have problems later on.
+            // or we could have problems later on. The lowest neighbor of
+            // the flat region may lie across the boundary, so the region
+            // is not descended here.
             for (i = 0; i < m_Connectivity.size; ++i)
             {
               nPos = m_Connectivity.index[i];
@@ -581,7 +601,7 @@ Segmenter<TInputImage>::AnalyzeBoundaryFlow(InputImageTypePointer thresholdImage
                 tempFlatRegion.bounds_min = max;
                 tempFlatRegion.min_label_ptr = output->GetBufferPointer() + output->ComputeOffset(labelIt.GetIndex());
                 tempFlatRegion.value = searchIt.GetPixel(nCenter);
-                tempFlatRegion.is_on_boundary = false;
+                tempFlatRegion.is_on_boundary = true;
                 flatRegions[m_CurrentLabel] = tempFlatRegion;
                 break;
               }
@@ -1384,6 +1404,9 @@ Segmenter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   os << indent << "SortEdgeLists: " << m_SortEdgeLists << std::endl;
   os << indent << "DoBoundaryAnalysis: " << m_DoBoundaryAnalysis << std::endl;
+  os << indent << "AutoMinimumMaximum: " << m_AutoMinimumMaximum << std::endl;
+  os << indent << "Minimum: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_Minimum) << std::endl;
+  os << indent << "Maximum: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_Maximum) << std::endl;
   os << indent << "Threshold: " << m_Threshold << std::endl;
   os << indent << "MaximumFloodLevel: " << m_MaximumFloodLevel << std::endl;
   os << indent << "CurrentLabel: " << m_CurrentLabel << std::endl;
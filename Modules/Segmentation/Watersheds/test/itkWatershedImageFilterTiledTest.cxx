@@ -0,0 +1,253 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWatershedImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+// Check that two label images define the same regions, up to the label
+// values.
+template <typename TLabelImage>
+bool
+SameRegions(const TLabelImage * expected, const TLabelImage * labels)
+{
+  std::unordered_map<itk::IdentifierType, itk::IdentifierType> expectedToLabels;
+  std::unordered_map<itk::IdentifierType, itk::IdentifierType> labelsToExpected;
+
+  itk::ImageRegionConstIterator<TLabelImage> expectedIt(expected, expected->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TLabelImage> labelIt(labels, labels->GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++labelIt)
+  {
+    const auto a = expectedToLabels.insert(std::make_pair(expectedIt.Get(), labelIt.Get()));
+    const auto b = labelsToExpected.insert(std::make_pair(labelIt.Get(), expectedIt.Get()));
+    if (a.first->second != labelIt.Get() || b.first->second != expectedIt.Get())
+    {
+      return false;
+    }
+  }
+  std::cout << "  " << expectedToLabels.size() << " regions" << std::endl;
+  return true;
+}
+
+// Count the regions of a label image.
+template <typename TLabelImage>
+size_t
+NumberOfRegions(const TLabelImage * labels)
+{
+  std::unordered_set<itk::IdentifierType> regions;
+  for (itk::ImageRegionConstIterator<TLabelImage> it(labels, labels->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    regions.insert(it.Get());
+  }
+  return regions.size();
+}
+
+// Segment a smooth height function with many local minima, at once and tile
+// by tile.  When the height function is quantized, its plateaus may have
+// several outlets of the same height, which the tiles do not necessarily
+// choose as the whole image does, so only the number of catchment basins is
+// compared.
+template <unsigned int VDimension>
+int
+TestTiles(const itk::Size<VDimension> & size,
+          double                        threshold,
+          double                        level,
+          unsigned int                  numberOfTiles,
+          double                        quantization = 0.0)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using FilterType = itk::WatershedImageFilter<ImageType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    double value = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      value += std::sin(0.23 * (d + 1) * it.GetIndex()[d]) + 0.003 * (d + 1) * it.GetIndex()[d];
+    }
+    if (quantization > 0.0)
+    {
+      value = std::floor(value * quantization);
+    }
+    it.Set(static_cast<float>(value));
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetThreshold(threshold);
+  filter->SetLevel(level);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  const typename FilterType::OutputImageType::Pointer expected = filter->GetOutput();
+  expected->DisconnectPipeline();
+
+  auto tiledFilter = FilterType::New();
+  tiledFilter->SetInput(image);
+  tiledFilter->SetThreshold(threshold);
+  tiledFilter->SetLevel(level);
+  tiledFilter->SetNumberOfTiles(numberOfTiles);
+  ITK_TEST_SET_GET_VALUE(numberOfTiles, tiledFilter->GetNumberOfTiles());
+  ITK_TRY_EXPECT_NO_EXCEPTION(tiledFilter->Update());
+
+  std::cout << "Dimension " << VDimension << ", threshold " << threshold << ", level " << level << ", "
+            << numberOfTiles << " tiles, quantization " << quantization << std::endl;
+  if (quantization > 0.0)
+  {
+    const size_t expectedNumberOfRegions = NumberOfRegions<typename FilterType::OutputImageType>(expected);
+    const size_t numberOfRegions = NumberOfRegions<typename FilterType::OutputImageType>(tiledFilter->GetOutput());
+    std::cout << "  " << numberOfRegions << " regions" << std::endl;
+    if (numberOfRegions != expectedNumberOfRegions)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The tiled segmentation has " << numberOfRegions << " regions instead of "
+                << expectedNumberOfRegions << std::endl;
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+  if (!SameRegions<typename FilterType::OutputImageType>(expected, tiledFilter->GetOutput()))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The tiled segmentation differs from the segmentation of the whole image." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Segment tile by tile an image produced by a filter, and stream the output
+// in pieces.  The input is requested one tile at a time, and the streamed
+// output matches the output produced at once.
+int
+TestStreaming(unsigned int numberOfTiles, unsigned int numberOfStreamDivisions)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::WatershedImageFilter<ImageType>;
+  using OutputImageType = FilterType::OutputImageType;
+
+  auto image = itk::Image<double, 2>::New();
+  image->SetRegions(itk::Size<2>{ { 97, 83 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<itk::Image<double, 2>> it(image, image->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    it.Set(std::sin(0.23 * it.GetIndex()[0]) + std::sin(0.46 * it.GetIndex()[1]) + 0.001 * it.GetIndex()[0]);
+  }
+
+  auto caster = itk::CastImageFilter<itk::Image<double, 2>, ImageType>::New();
+  caster->SetInput(image);
+  itk::SizeValueType largestInputRequest = 0;
+  unsigned int       numberOfInputUpdates = 0;
+  caster->AddObserver(itk::StartEvent(), [&](const itk::EventObject &) {
+    largestInputRequest =
+      std::max(largestInputRequest, caster->GetOutput()->GetRequestedRegion().GetNumberOfPixels());
+    ++numberOfInputUpdates;
+  });
+
+  auto filter = FilterType::New();
+  filter->SetInput(caster->GetOutput());
+  filter->SetLevel(0.1);
+  filter->SetNumberOfTiles(numberOfTiles);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const OutputImageType::Pointer expected = filter->GetOutput();
+  expected->DisconnectPipeline();
+
+  auto streamedFilter = FilterType::New();
+  streamedFilter->SetInput(caster->GetOutput());
+  streamedFilter->SetLevel(0.1);
+  streamedFilter->SetNumberOfTiles(numberOfTiles);
+  auto streamer = itk::StreamingImageFilter<OutputImageType, OutputImageType>::New();
+  streamer->SetInput(streamedFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  largestInputRequest = 0;
+  numberOfInputUpdates = 0;
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  std::cout << numberOfTiles << " tiles, " << numberOfStreamDivisions << " stream divisions: " << numberOfInputUpdates
+            << " input updates of at most " << largestInputRequest << " pixels" << std::endl;
+  ITK_TEST_EXPECT_TRUE(largestInputRequest < image->GetBufferedRegion().GetNumberOfPixels() / 2);
+  ITK_TEST_EXPECT_TRUE(numberOfInputUpdates >= 2 * numberOfTiles);
+
+  itk::ImageRegionConstIterator<OutputImageType> expectedIt(expected, expected->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> streamedIt(streamer->GetOutput(), expected->GetBufferedRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++streamedIt)
+  {
+    if (expectedIt.Get() != streamedIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The streamed output differs from the output produced at once." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkWatershedImageFilterTiledTest(int, char *[])
+{
+  bool testPassed = true;
+
+  const itk::Size<2> size2D{ { 97, 83 } };
+  testPassed &= TestTiles<2>(size2D, 0.0, 0.0, 4) == EXIT_SUCCESS;
+  testPassed &= TestTiles<2>(size2D, 0.05, 0.0, 9) == EXIT_SUCCESS;
+  testPassed &= TestTiles<2>(size2D, 0.0, 0.2, 7) == EXIT_SUCCESS;
+  testPassed &= TestTiles<2>(size2D, 0.1, 0.5, 16) == EXIT_SUCCESS;
+  testPassed &= TestTiles<2>(size2D, 0.0, 0.0, 9, 3.0) == EXIT_SUCCESS;
+
+  const itk::Size<3> size3D{ { 31, 27, 23 } };
+  testPassed &= TestTiles<3>(size3D, 0.0, 0.0, 8) == EXIT_SUCCESS;
+  testPassed &= TestTiles<3>(size3D, 0.0, 0.3, 12) == EXIT_SUCCESS;
+  testPassed &= TestTiles<3>(size3D, 0.0, 0.0, 8, 4.0) == EXIT_SUCCESS;
+
+  testPassed &= TestStreaming(9, 4) == EXIT_SUCCESS;
+  testPassed &= TestStreaming(6, 5) == EXIT_SUCCESS;
+
+  // The number of tiles is at least one.
+  auto filter = itk::WatershedImageFilter<itk::Image<float, 2>>::New();
+  filter->SetNumberOfTiles(0);
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfTiles(), 1u);
+
+  // A requested region outside the image does not fall in any tile.
+  auto image = itk::Image<float, 2>::New();
+  image->SetRegions(size2D);
+  image->AllocateInitialized();
+  filter->SetInput(image);
+  filter->SetNumberOfTiles(4);
+  filter->GetOutput()->SetRequestedRegion(itk::ImageRegion<2>({ { 200, 0 } }, { { 4, 4 } }));
+  ITK_TRY_EXPECT_EXCEPTION(filter->GetOutput()->PropagateRequestedRegion());
+
+  if (!testPassed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWatershedSegmenter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Check the boundary analysis that the Segmenter does when it processes one
+// chunk of a streamed data set.
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using SegmenterType = itk::watershed::Segmenter<ImageType>;
+
+// The positions of the face neighbors in a 3x3 neighborhood.
+constexpr short LowX = 3;
+constexpr short HighX = 5;
+
+ImageType::Pointer
+CreateImage(const ImageType::SizeType & size, float (*function)(ImageType::IndexValueType, ImageType::IndexValueType))
+{
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(function(it.GetIndex()[0], it.GetIndex()[1]));
+  }
+  return image;
+}
+
+// Segment the chunk of the columns [firstColumn, lastColumn] of the image,
+// which includes the one pixel overlap with the neighboring chunks.
+SegmenterType::Pointer
+SegmentChunk(ImageType * image, ImageType::IndexValueType firstColumn, ImageType::IndexValueType lastColumn)
+{
+  ImageType::RegionType chunk = image->GetLargestPossibleRegion();
+  chunk.SetIndex(0, firstColumn);
+  chunk.SetSize(0, lastColumn - firstColumn + 1);
+
+  auto segmenter = SegmenterType::New();
+  segmenter->SetInputImage(image);
+  segmenter->SetLargestPossibleRegion(image->GetLargestPossibleRegion());
+  segmenter->SetDoBoundaryAnalysis(true);
+  segmenter->SetThreshold(0.0);
+  segmenter->GetOutputImage()->SetRequestedRegion(chunk);
+  segmenter->Update();
+  return segmenter;
+}
+
+// Check the flow of every pixel of a face of the chunk.
+int
+CheckFaceFlow(SegmenterType * segmenter, unsigned int highlow, short expectedFlow)
+{
+  using FaceType = SegmenterType::BoundaryType::face_t;
+
+  const FaceType * face = segmenter->GetBoundary()->GetFace(0, highlow);
+  for (itk::ImageRegionConstIteratorWithIndex<FaceType> it(face, face->GetRequestedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get().flow != expectedFlow)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The flow of the face pixel " << it.GetIndex() << " is " << it.Get().flow << ", expected "
+                << expectedFlow << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkWatershedSegmenterBoundaryAnalysisTest(int, char *[])
+{
+  const ImageType::SizeType size = { { 8, 7 } };
+
+  // Every pixel of a face flows across it when the steepest descent crosses the
+  // face.  The corners of the faces are next to the retaining wall built along
+  // the data set boundary, so they check that the wall is in place before the
+  // flow is analyzed.
+  auto descending = CreateImage(size, [](ImageType::IndexValueType x, ImageType::IndexValueType y) {
+    return static_cast<float>(100 - 10 * x + y);
+  });
+  ITK_TEST_EXPECT_EQUAL(CheckFaceFlow(SegmentChunk(descending, 0, 4), 1, HighX), EXIT_SUCCESS);
+
+  auto ascending = CreateImage(size, [](ImageType::IndexValueType x, ImageType::IndexValueType y) {
+    return static_cast<float>(1 + 10 * x + y);
+  });
+  ITK_TEST_EXPECT_EQUAL(CheckFaceFlow(SegmentChunk(ascending, 3, 7), 0, LowX), EXIT_SUCCESS);
+
+  // When several neighbors are the lowest, the flow follows the first of them
+  // in connectivity order, as the gradient descent within the chunk does.
+  // The neighbor above comes before the neighbor across the high face, and the
+  // neighbor below comes after it.
+  auto ties = CreateImage(size, [](ImageType::IndexValueType x, ImageType::IndexValueType y) {
+    if ((x == 3 && (y == 2 || y == 5)) || (x == 4 && (y == 2 || y == 5)))
+    {
+      return x == 3 ? 50.0f : 10.0f;
+    }
+    if (x == 3 && (y == 1 || y == 6))
+    {
+      return 10.0f;
+    }
+    return 100.0f + static_cast<float>(x);
+  });
+  SegmenterType::Pointer tiesSegmenter = SegmentChunk(ties, 0, 4);
+  const auto             tiesFace = tiesSegmenter->GetBoundary()->GetFace(0, 1);
+  ITK_TEST_EXPECT_EQUAL(tiesFace->GetPixel({ { 3, 2 } }).flow, SegmenterType::NULL_FLOW);
+  ITK_TEST_EXPECT_EQUAL(tiesFace->GetPixel({ { 3, 5 } }).flow, HighX);
+
+  // A plateau that reaches a face is not descended within the chunk, even when
+  // it is merged with the parts of the plateau that do not reach the face,
+  // because its lowest neighbor may lie across the face.
+  auto plateau = CreateImage(size, [](ImageType::IndexValueType x, ImageType::IndexValueType) {
+    if (x == 0)
+    {
+      return 20.0f;
+    }
+    if (x <= 3)
+    {
+      return 30.0f;
+    }
+    return x == 4 ? 10.0f : 40.0f;
+  });
+  SegmenterType::Pointer plateauSegmenter = SegmentChunk(plateau, 0, 4);
+  const auto *           labels = plateauSegmenter->GetOutputImage();
+  for (ImageType::IndexValueType y = 0; y < static_cast<ImageType::IndexValueType>(size[1]); ++y)
+  {
+    ITK_TEST_EXPECT_TRUE(labels->GetPixel({ { 1, y } }) != labels->GetPixel({ { 0, y } }));
+    ITK_TEST_EXPECT_EQUAL(labels->GetPixel({ { 1, y } }), labels->GetPixel({ { 3, 0 } }));
+    ITK_TEST_EXPECT_EQUAL(labels->GetPixel({ { 3, y } }), labels->GetPixel({ { 3, 0 } }));
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkHarness.h"
+
+#include <iostream>
+
+int
+main(int argc, char * argv[])
+{
+  try
+  {
+    return itk::Benchmark::RunBenchmarks(argc, argv);
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    std::cerr << exception << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (const std::exception & exception)
+  {
+    std::cerr << exception.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
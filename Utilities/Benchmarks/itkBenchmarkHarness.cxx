@@ -0,0 +1,346 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkHarness.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTimeProbesCollectorBase.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace itk
+{
+namespace Benchmark
+{
+namespace
+{
+std::map<std::string, SetUpFunctionType> &
+GetRegistry()
+{
+  static std::map<std::string, SetUpFunctionType> benchmarks;
+  return benchmarks;
+}
+
+void
+PrintUsage(const char * program)
+{
+  std::cout << "Usage: " << program << " [options]\n"
+            << "  --list                      List the benchmarks and exit.\n"
+            << "  --filter <text>             Run the benchmarks whose name contains the text.\n"
+            << "  --size <n>                  Size of the synthetic images along each dimension (128).\n"
+            << "  --iterations <n>            Number of timed iterations of each benchmark (5).\n"
+            << "  --warm-up <n>               Number of untimed iterations of each benchmark (1).\n"
+            << "  --threads <n>               Number of threads, 0 for the default (0).\n"
+            << "  --temporary-directory <dir> Directory of the files of the IO benchmarks (.).\n"
+            << "  --output <file.json>        Write the times in JSON.\n"
+            << "  --baseline <file.json>      Compare the times with a previous JSON output.\n"
+            << "  --tolerance <ratio>         Relative slowdown reported as a regression (0.1).\n";
+}
+
+// Reads the minimum time of each probe of a report of
+// TimeProbesCollectorBase::JSONReport().
+std::map<std::string, double>
+ReadBaseline(const std::string & fileName)
+{
+  std::ifstream file(fileName);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot open the baseline " << fileName);
+  }
+  const std::string text{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+  const std::string             nameKey = "\"Name\": \"";
+  const std::string             minimumKey = "\"Minimum\": ";
+  std::map<std::string, double> times;
+  size_t                        position = text.find("\"Probes\"");
+  while (position != std::string::npos && (position = text.find(nameKey, position)) != std::string::npos)
+  {
+    const size_t nameBegin = position + nameKey.size();
+    const size_t nameEnd = text.find('"', nameBegin);
+    position = text.find(minimumKey, nameEnd);
+    if (position != std::string::npos)
+    {
+      times[text.substr(nameBegin, nameEnd - nameBegin)] =
+        std::strtod(text.c_str() + position + minimumKey.size(), nullptr);
+    }
+  }
+  return times;
+}
+
+// Prints the ratio of the minimum time of each probe to its baseline, and
+// returns whether any ratio exceeds 1 + tolerance.
+bool
+CompareWithBaseline(const TimeProbesCollectorBase &       collector,
+                    const std::vector<std::string> &      names,
+                    const std::map<std::string, double> & baseline,
+                    double                                tolerance)
+{
+  bool hasRegression = false;
+  std::cout << '\n'
+            << std::left << std::setw(50) << "Benchmark" << std::right << std::setw(14) << "Baseline (s)"
+            << std::setw(14) << "Current (s)" << std::setw(10) << "Ratio" << '\n';
+  for (const std::string & name : names)
+  {
+    const double time = collector.GetProbe(name.c_str()).GetMinimum();
+    std::cout << std::left << std::setw(50) << name << std::right;
+
+    const auto baselineTime = baseline.find(name);
+    if (baselineTime == baseline.end() || !(baselineTime->second > 0.0))
+    {
+      std::cout << std::setw(14) << "-" << std::setw(14) << time << std::setw(10) << "-" << "  not in baseline\n";
+      continue;
+    }
+    const double ratio = time / baselineTime->second;
+    std::cout << std::setw(14) << baselineTime->second << std::setw(14) << time << std::setw(10) << std::fixed
+              << std::setprecision(3) << ratio << std::defaultfloat << std::setprecision(6);
+    if (ratio > 1.0 + tolerance)
+    {
+      std::cout << "  REGRESSION";
+      hasRegression = true;
+    }
+    else if (ratio < 1.0 - tolerance)
+    {
+      std::cout << "  improvement";
+    }
+    std::cout << '\n';
+  }
+  return hasRegression;
+}
+} // namespace
+
+
+const std::map<std::string, SetUpFunctionType> &
+GetBenchmarks()
+{
+  return GetRegistry();
+}
+
+
+Registrar::Registrar(const std::string & name, SetUpFunctionType setUpFunction)
+{
+  GetRegistry()[name] = std::move(setUpFunction);
+}
+
+
+ImageType::Pointer
+CreateSyntheticImage(const Settings & settings, unsigned int seed)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(settings.ImageSize));
+  image->Allocate();
+
+  // Blobs at fixed positions relative to the size of the image.
+  const double size = settings.ImageSize;
+  const double centers[][3] = {
+    { 0.3, 0.3, 0.3 }, { 0.7, 0.4, 0.5 }, { 0.5, 0.7, 0.6 }, { 0.25, 0.75, 0.4 }, { 0.7, 0.7, 0.25 }
+  };
+  const double radius = 0.15 * size;
+
+  const auto generator = Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(seed);
+
+  for (ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    double                     value = 0.0;
+    for (const auto & center : centers)
+    {
+      double squaredDistance = 0.0;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        const double difference = index[i] - center[i] * size;
+        squaredDistance += difference * difference;
+      }
+      value += 800.0 * std::exp(-squaredDistance / (2.0 * radius * radius));
+    }
+    value += generator->GetUniformVariate(0.0, 200.0);
+    it.Set(static_cast<float>(std::min(value, 1000.0)));
+  }
+  return image;
+}
+
+
+BinaryImageType::Pointer
+CreateSyntheticBinaryImage(const Settings & settings)
+{
+  const auto image = CreateSyntheticImage(settings);
+
+  const auto binaryImage = BinaryImageType::New();
+  binaryImage->SetRegions(image->GetBufferedRegion());
+  binaryImage->Allocate();
+
+  const float * const   pixels = image->GetBufferPointer();
+  unsigned char * const binaryPixels = binaryImage->GetBufferPointer();
+  const SizeValueType   numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    binaryPixels[i] = pixels[i] > 500.0f ? 1 : 0;
+  }
+  return binaryImage;
+}
+
+
+int
+RunBenchmarks(int argc, char * argv[])
+{
+  Settings    settings;
+  std::string filter;
+  std::string outputFileName;
+  std::string baselineFileName;
+  double      tolerance = 0.1;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string argument = argv[i];
+    if (argument == "--list")
+    {
+      for (const auto & benchmark : GetBenchmarks())
+      {
+        std::cout << benchmark.first << '\n';
+      }
+      return EXIT_SUCCESS;
+    }
+    if (argument == "--help" || i + 1 == argc)
+    {
+      PrintUsage(argv[0]);
+      return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    const std::string value = argv[++i];
+    try
+    {
+      if (argument == "--filter")
+      {
+        filter = value;
+      }
+      else if (argument == "--size")
+      {
+        settings.ImageSize = std::stoul(value);
+      }
+      else if (argument == "--iterations")
+      {
+        settings.NumberOfIterations = std::stoul(value);
+      }
+      else if (argument == "--warm-up")
+      {
+        settings.NumberOfWarmUpIterations = std::stoul(value);
+      }
+      else if (argument == "--threads")
+      {
+        settings.NumberOfThreads = std::stoul(value);
+      }
+      else if (argument == "--temporary-directory")
+      {
+        settings.TemporaryDirectory = value;
+      }
+      else if (argument == "--output")
+      {
+        outputFileName = value;
+      }
+      else if (argument == "--baseline")
+      {
+        baselineFileName = value;
+      }
+      else if (argument == "--tolerance")
+      {
+        tolerance = std::stod(value);
+      }
+      else
+      {
+        std::cerr << "Unknown option: " << argument << '\n';
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    catch (const std::logic_error &)
+    {
+      std::cerr << "Invalid value of " << argument << ": " << value << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+  if (settings.ImageSize < 8 || settings.NumberOfIterations == 0)
+  {
+    std::cerr << "The size must be at least 8, and the number of iterations at least 1.\n";
+    return EXIT_FAILURE;
+  }
+  if (settings.NumberOfThreads > 0)
+  {
+    MultiThreaderBase::SetGlobalDefaultNumberOfThreads(settings.NumberOfThreads);
+  }
+
+  // The name of a probe includes the size of the images, so that a baseline
+  // is only compared with the times of the same size.
+  TimeProbesCollectorBase  collector;
+  std::vector<std::string> names;
+  for (const auto & benchmark : GetBenchmarks())
+  {
+    if (benchmark.first.find(filter) == std::string::npos)
+    {
+      continue;
+    }
+    const std::string name = benchmark.first + '/' + std::to_string(settings.ImageSize);
+    std::cout << "Running " << name << std::endl;
+
+    const KernelType kernel = benchmark.second(settings);
+    for (unsigned int iteration = 0; iteration < settings.NumberOfWarmUpIterations; ++iteration)
+    {
+      kernel();
+    }
+    for (unsigned int iteration = 0; iteration < settings.NumberOfIterations; ++iteration)
+    {
+      collector.Start(name.c_str());
+      kernel();
+      collector.Stop(name.c_str());
+    }
+    names.push_back(name);
+  }
+  if (names.empty())
+  {
+    std::cerr << "No benchmark matches the filter " << filter << '\n';
+    return EXIT_FAILURE;
+  }
+
+  collector.Report(std::cout, true, true, true);
+
+  if (!outputFileName.empty())
+  {
+    std::ofstream outputFile(outputFileName);
+    if (!outputFile)
+    {
+      std::cerr << "Cannot open the output " << outputFileName << '\n';
+      return EXIT_FAILURE;
+    }
+    collector.JSONReport(outputFile);
+  }
+
+  if (!baselineFileName.empty() &&
+      CompareWithBaseline(collector, names, ReadBaseline(baselineFileName), tolerance))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace Benchmark
+} // namespace itk
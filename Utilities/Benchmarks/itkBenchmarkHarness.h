@@ -0,0 +1,86 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkHarness_h
+#define itkBenchmarkHarness_h
+
+#include "itkImage.h"
+
+#include <functional>
+#include <map>
+#include <string>
+
+namespace itk
+{
+namespace Benchmark
+{
+/** The settings of a run of the benchmarks, given on the command line. */
+struct Settings
+{
+  /** Size of the synthetic images along each dimension. */
+  unsigned int ImageSize{ 128 };
+  unsigned int NumberOfIterations{ 5 };
+  unsigned int NumberOfWarmUpIterations{ 1 };
+  /** Number of threads of the global thread pool, 0 for the default. */
+  unsigned int NumberOfThreads{ 0 };
+  /** Directory of the files written by the benchmarks of the readers and
+   * writers. */
+  std::string TemporaryDirectory{ "." };
+};
+
+/** The timed part of a benchmark, executed once per iteration. */
+using KernelType = std::function<void()>;
+
+/** Creates the inputs of a benchmark, which are not timed, and returns its
+ * kernel. */
+using SetUpFunctionType = std::function<KernelType(const Settings &)>;
+
+/** The benchmarks, by name. */
+const std::map<std::string, SetUpFunctionType> &
+GetBenchmarks();
+
+/** Registers a benchmark when the executable is loaded:
+ * \code
+ * const Registrar medianRegistrar("MedianImageFilter", SetUpMedianImageFilter);
+ * \endcode */
+class Registrar
+{
+public:
+  Registrar(const std::string & name, SetUpFunctionType setUpFunction);
+};
+
+using ImageType = Image<float, 3>;
+using BinaryImageType = Image<unsigned char, 3>;
+
+/** Create a synthetic image of smooth blobs and deterministic noise, whose
+ * values are within [0, 1000]. A different seed gives different noise. */
+ImageType::Pointer
+CreateSyntheticImage(const Settings & settings, unsigned int seed = 1);
+
+/** Create a synthetic binary image of the blobs of CreateSyntheticImage(),
+ * with many small components due to the noise. */
+BinaryImageType::Pointer
+CreateSyntheticBinaryImage(const Settings & settings);
+
+/** Run the benchmarks selected by the command line, write their times, and
+ * compare them with a baseline. Returns EXIT_FAILURE on a regression. */
+int
+RunBenchmarks(int argc, char * argv[]);
+} // namespace Benchmark
+} // namespace itk
+
+#endif
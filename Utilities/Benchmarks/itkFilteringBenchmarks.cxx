@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkHarness.h"
+
+#include "itkConnectedComponentImageFilter.h"
+#include "itkEuler3DTransform.h"
+#include "itkMedianImageFilter.h"
+#include "itkResampleImageFilter.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+namespace
+{
+using itk::Benchmark::BinaryImageType;
+using itk::Benchmark::ImageType;
+using itk::Benchmark::KernelType;
+using itk::Benchmark::Settings;
+
+// Returns a kernel which executes the filter again at each iteration.
+template <typename TFilterPointer>
+KernelType
+UpdateFilter(const TFilterPointer & filter)
+{
+  return [filter] {
+    filter->Modified();
+    filter->Update();
+  };
+}
+
+// Resamples an image through a rotation around its center, with linear
+// interpolation.
+KernelType
+SetUpResampleImageFilter(const Settings & settings)
+{
+  const auto image = itk::Benchmark::CreateSyntheticImage(settings);
+
+  using TransformType = itk::Euler3DTransform<double>;
+  const auto                    transform = TransformType::New();
+  TransformType::InputPointType center;
+  center.Fill(0.5 * (settings.ImageSize - 1));
+  transform->SetCenter(center);
+  transform->SetRotation(0.1, 0.2, 0.3);
+
+  const auto filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetOutputParametersFromImage(image);
+  return UpdateFilter(filter);
+}
+
+KernelType
+SetUpSmoothingRecursiveGaussianImageFilter(const Settings & settings)
+{
+  const auto filter = itk::SmoothingRecursiveGaussianImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticImage(settings));
+  filter->SetSigma(2.0);
+  return UpdateFilter(filter);
+}
+
+KernelType
+SetUpMedianImageFilter(const Settings & settings)
+{
+  const auto filter = itk::MedianImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticImage(settings));
+  filter->SetRadius(1);
+  return UpdateFilter(filter);
+}
+
+KernelType
+SetUpSignedMaurerDistanceMapImageFilter(const Settings & settings)
+{
+  const auto filter = itk::SignedMaurerDistanceMapImageFilter<BinaryImageType, ImageType>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticBinaryImage(settings));
+  filter->SetUseImageSpacing(true);
+  filter->SetSquaredDistance(false);
+  return UpdateFilter(filter);
+}
+
+KernelType
+SetUpConnectedComponentImageFilter(const Settings & settings)
+{
+  const auto filter =
+    itk::ConnectedComponentImageFilter<BinaryImageType, itk::Image<unsigned int, ImageType::ImageDimension>>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticBinaryImage(settings));
+  filter->SetFullyConnected(true);
+  return UpdateFilter(filter);
+}
+
+const itk::Benchmark::Registrar resampleRegistrar("ResampleImageFilter", SetUpResampleImageFilter);
+const itk::Benchmark::Registrar gaussianRegistrar("SmoothingRecursiveGaussianImageFilter",
+                                                  SetUpSmoothingRecursiveGaussianImageFilter);
+const itk::Benchmark::Registrar medianRegistrar("MedianImageFilter", SetUpMedianImageFilter);
+const itk::Benchmark::Registrar distanceMapRegistrar("SignedMaurerDistanceMapImageFilter",
+                                                     SetUpSignedMaurerDistanceMapImageFilter);
+const itk::Benchmark::Registrar connectedComponentRegistrar("ConnectedComponentImageFilter",
+                                                            SetUpConnectedComponentImageFilter);
+} // namespace
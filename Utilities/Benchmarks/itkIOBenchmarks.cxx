@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkHarness.h"
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaImageIO.h"
+#include "itkNiftiImageIO.h"
+#include "itksys/SystemTools.hxx"
+
+#include <memory>
+
+namespace
+{
+using itk::Benchmark::ImageType;
+using itk::Benchmark::KernelType;
+using itk::Benchmark::Settings;
+
+// A file of the temporary directory, removed with the last kernel which
+// refers to it.
+class TemporaryFile
+{
+public:
+  TemporaryFile(const Settings & settings, const std::string & fileName)
+    : m_FileName(settings.TemporaryDirectory + '/' + fileName)
+  {}
+
+  ~TemporaryFile() { itksys::SystemTools::RemoveFile(m_FileName); }
+
+  TemporaryFile(const TemporaryFile &) = delete;
+  TemporaryFile &
+  operator=(const TemporaryFile &) = delete;
+
+  const std::string &
+  GetFileName() const
+  {
+    return m_FileName;
+  }
+
+private:
+  const std::string m_FileName;
+};
+
+// Returns a writer of the synthetic image, without compression.
+template <typename TImageIO>
+itk::ImageFileWriter<ImageType>::Pointer
+CreateWriter(const Settings & settings, const std::string & fileName)
+{
+  const auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(itk::Benchmark::CreateSyntheticImage(settings));
+  writer->SetImageIO(TImageIO::New());
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(false);
+  return writer;
+}
+
+template <typename TImageIO>
+KernelType
+SetUpWrite(const Settings & settings, const char * fileName)
+{
+  const auto file = std::make_shared<TemporaryFile>(settings, fileName);
+  const auto writer = CreateWriter<TImageIO>(settings, file->GetFileName());
+  return [file, writer] {
+    writer->Modified();
+    writer->Update();
+  };
+}
+
+template <typename TImageIO>
+KernelType
+SetUpRead(const Settings & settings, const char * fileName)
+{
+  const auto file = std::make_shared<TemporaryFile>(settings, fileName);
+  CreateWriter<TImageIO>(settings, file->GetFileName())->Update();
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(TImageIO::New());
+  reader->SetFileName(file->GetFileName());
+  return [file, reader] {
+    reader->Modified();
+    reader->Update();
+  };
+}
+
+const itk::Benchmark::Registrar metaImageWriteRegistrar("MetaImageIO/Write", [](const Settings & settings) {
+  return SetUpWrite<itk::MetaImageIO>(settings, "ITKBenchmarkWrite.mha");
+});
+const itk::Benchmark::Registrar metaImageReadRegistrar("MetaImageIO/Read", [](const Settings & settings) {
+  return SetUpRead<itk::MetaImageIO>(settings, "ITKBenchmarkRead.mha");
+});
+const itk::Benchmark::Registrar niftiWriteRegistrar("NiftiImageIO/Write", [](const Settings & settings) {
+  return SetUpWrite<itk::NiftiImageIO>(settings, "ITKBenchmarkWrite.nii");
+});
+const itk::Benchmark::Registrar niftiReadRegistrar("NiftiImageIO/Read", [](const Settings & settings) {
+  return SetUpRead<itk::NiftiImageIO>(settings, "ITKBenchmarkRead.nii");
+});
+} // namespace
@@ -0,0 +1,263 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkHarness.h"
+
+#include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
+#include "itkGradientMagnitudeImageFilter.h"
+#include "itkImageNeighborhoodAlgorithm.h"
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+#include "itkLaplacianImageFilter.h"
+#include "itkLaplacianOperator.h"
+#include "itkMedianImageFilter.h"
+#include "itkNeighborhoodAlgorithm.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkShapedImageNeighborhoodRange.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// The neighborhood filters, with the neighborhood engine,
+// ImageNeighborhoodAlgorithm, and without it. Without the engine, the region
+// is split with ImageBoundaryFacesCalculator and the neighborhoods are read
+// through ShapedImageNeighborhoodRange, as the filters did before, or through
+// the neighborhood iterators of NeighborhoodOperatorImageFilter.
+
+namespace
+{
+using itk::Benchmark::ImageType;
+using itk::Benchmark::KernelType;
+using itk::Benchmark::Settings;
+
+constexpr unsigned int Dimension = ImageType::ImageDimension;
+
+using OffsetsType = std::vector<itk::Offset<Dimension>>;
+
+// Returns a kernel which executes the filter again at each iteration.
+template <typename TFilterPointer>
+KernelType
+UpdateFilter(const TFilterPointer & filter)
+{
+  return [filter] {
+    filter->Modified();
+    filter->Update();
+  };
+}
+
+ImageType::Pointer
+CreateOutputImage(const ImageType & input)
+{
+  const auto output = ImageType::New();
+  output->CopyInformation(&input);
+  output->SetRegions(input.GetBufferedRegion());
+  output->Allocate();
+  return output;
+}
+
+// Assigns neighborhoodKernel(neighborhood) to each pixel of the region, with
+// the neighborhoods read through ShapedImageNeighborhoodRange.
+template <typename TPixelAccessPolicy, typename TNeighborhoodKernel>
+void
+TransformRegionWithRange(const ImageType &             input,
+                         ImageType &                   output,
+                         const ImageType::RegionType & region,
+                         const OffsetsType &           offsets,
+                         TNeighborhoodKernel &         neighborhoodKernel)
+{
+  auto neighborhoodRange =
+    itk::ShapedImageNeighborhoodRange<const ImageType, TPixelAccessPolicy>(input, itk::Index<Dimension>(), offsets);
+  auto outputIterator = itk::ImageRegionRange<ImageType>(output, region).begin();
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    neighborhoodRange.SetLocation(index);
+    *outputIterator = neighborhoodKernel(neighborhoodRange);
+    ++outputIterator;
+  }
+}
+
+// Returns a kernel which assigns neighborhoodKernel(neighborhood) to each
+// pixel of the output, either with the neighborhood engine, or by splitting
+// the region into the non-boundary region and the boundary faces and reading
+// the neighborhoods through ShapedImageNeighborhoodRange. The boundaries are
+// zero-flux Neumann in both cases.
+template <typename TNeighborhoodKernel>
+KernelType
+TransformImage(const Settings &            settings,
+               bool                        useEngine,
+               const OffsetsType &         offsets,
+               const TNeighborhoodKernel & neighborhoodKernel)
+{
+  const ImageType::Pointer input = itk::Benchmark::CreateSyntheticImage(settings);
+  const ImageType::Pointer output = CreateOutputImage(*input);
+  const auto               multiThreader = itk::MultiThreaderBase::New();
+
+  if (useEngine)
+  {
+    return [input, output, offsets, neighborhoodKernel, multiThreader] {
+      itk::ImageNeighborhoodAlgorithm::ParallelTransform(
+        multiThreader, *input, *output, output->GetBufferedRegion(), offsets, neighborhoodKernel);
+    };
+  }
+
+  ImageType::SizeType radius{};
+  for (const auto & offset : offsets)
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      radius[d] = std::max(radius[d], static_cast<itk::SizeValueType>(std::abs(offset[d])));
+    }
+  }
+
+  return [input, output, offsets, neighborhoodKernel, multiThreader, radius] {
+    multiThreader->ParallelizeImageRegion<Dimension>(
+      output->GetBufferedRegion(),
+      [&](const ImageType::RegionType & piece) {
+        TNeighborhoodKernel pieceKernel(neighborhoodKernel);
+        const auto          calculatorResult =
+          itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<ImageType>::Compute(*input, piece, radius);
+
+        TransformRegionWithRange<itk::BufferedImageNeighborhoodPixelAccessPolicy<ImageType>>(
+          *input, *output, calculatorResult.GetNonBoundaryRegion(), offsets, pieceKernel);
+        for (const auto & boundaryFace : calculatorResult.GetBoundaryFaces())
+        {
+          TransformRegionWithRange<itk::ZeroFluxNeumannImageNeighborhoodPixelAccessPolicy<ImageType>>(
+            *input, *output, boundaryFace, offsets, pieceKernel);
+        }
+      },
+      nullptr);
+  };
+}
+
+// The mean of the neighborhood of radius 1. MeanImageFilter computes the mean
+// of scalar pixels with running sums, so the neighborhood kernel of its other
+// pixel types is timed on its own.
+KernelType
+SetUpMean(const Settings & settings, bool useEngine)
+{
+  return TransformImage(settings,
+                        useEngine,
+                        itk::GenerateRectangularImageNeighborhoodOffsets<Dimension>(ImageType::SizeType::Filled(1)),
+                        [](const auto & neighborhood) {
+                          double sum = 0.0;
+                          for (const float pixel : neighborhood)
+                          {
+                            sum += pixel;
+                          }
+                          return static_cast<float>(sum / neighborhood.size());
+                        });
+}
+
+KernelType
+SetUpMedianNeighborhoodRange(const Settings & settings)
+{
+  const OffsetsType offsets =
+    itk::GenerateRectangularImageNeighborhoodOffsets<Dimension>(ImageType::SizeType::Filled(1));
+  return TransformImage(settings,
+                        false,
+                        offsets,
+                        [pixels = std::vector<float>(offsets.size())](const auto & neighborhood) mutable {
+                          std::copy(neighborhood.begin(), neighborhood.end(), pixels.begin());
+                          const auto medianIterator = pixels.begin() + pixels.size() / 2;
+                          std::nth_element(pixels.begin(), medianIterator, pixels.end());
+                          return *medianIterator;
+                        });
+}
+
+// The gradient magnitude with central differences, as computed by
+// GradientMagnitudeImageFilter for the unit spacing of the synthetic image.
+KernelType
+SetUpGradientMagnitudeNeighborhoodRange(const Settings & settings)
+{
+  OffsetsType offsets;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    for (const itk::OffsetValueType step : { -1, 1 })
+    {
+      itk::Offset<Dimension> offset{};
+      offset[d] = step;
+      offsets.push_back(offset);
+    }
+  }
+  return TransformImage(settings, false, offsets, [](const auto & neighborhood) {
+    double sumOfSquares = 0.0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double derivative =
+        0.5 * (static_cast<double>(neighborhood[2 * d + 1]) - static_cast<double>(neighborhood[2 * d]));
+      sumOfSquares += derivative * derivative;
+    }
+    return static_cast<float>(std::sqrt(sumOfSquares));
+  });
+}
+
+KernelType
+SetUpGradientMagnitudeImageFilter(const Settings & settings)
+{
+  const auto filter = itk::GradientMagnitudeImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticImage(settings));
+  return UpdateFilter(filter);
+}
+
+KernelType
+SetUpLaplacianImageFilter(const Settings & settings)
+{
+  const auto filter = itk::LaplacianImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticImage(settings));
+  return UpdateFilter(filter);
+}
+
+// NeighborhoodOperatorImageFilter only uses the neighborhood engine when the
+// boundary condition is exactly ZeroFluxNeumannBoundaryCondition or
+// ConstantBoundaryCondition. A subclass of the first one gives the same
+// output through the neighborhood iterators.
+class IteratorZeroFluxNeumannBoundaryCondition : public itk::ZeroFluxNeumannBoundaryCondition<ImageType>
+{};
+
+KernelType
+SetUpLaplacianNeighborhoodIterator(const Settings & settings)
+{
+  itk::LaplacianOperator<float, Dimension> laplacian;
+  laplacian.CreateOperator();
+
+  const auto boundaryCondition = std::make_shared<IteratorZeroFluxNeumannBoundaryCondition>();
+  const auto filter = itk::NeighborhoodOperatorImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(itk::Benchmark::CreateSyntheticImage(settings));
+  filter->SetOperator(laplacian);
+  filter->OverrideBoundaryCondition(boundaryCondition.get());
+  return [filter, boundaryCondition] {
+    filter->Modified();
+    filter->Update();
+  };
+}
+
+const itk::Benchmark::Registrar meanEngineRegistrar("MeanNeighborhoodEngine",
+                                                    [](const Settings & settings) { return SetUpMean(settings, true); });
+const itk::Benchmark::Registrar meanRangeRegistrar("MeanNeighborhoodRange",
+                                                   [](const Settings & settings) { return SetUpMean(settings, false); });
+const itk::Benchmark::Registrar medianRangeRegistrar("MedianNeighborhoodRange", SetUpMedianNeighborhoodRange);
+const itk::Benchmark::Registrar gradientMagnitudeRegistrar("GradientMagnitudeImageFilter",
+                                                           SetUpGradientMagnitudeImageFilter);
+const itk::Benchmark::Registrar gradientMagnitudeRangeRegistrar("GradientMagnitudeNeighborhoodRange",
+                                                                SetUpGradientMagnitudeNeighborhoodRange);
+const itk::Benchmark::Registrar laplacianRegistrar("LaplacianImageFilter", SetUpLaplacianImageFilter);
+const itk::Benchmark::Registrar laplacianIteratorRegistrar("LaplacianNeighborhoodIterator",
+                                                           SetUpLaplacianNeighborhoodIterator);
+} // namespace
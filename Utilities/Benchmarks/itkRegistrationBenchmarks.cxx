@@ -0,0 +1,61 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkHarness.h"
+
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkTranslationTransform.h"
+
+namespace
+{
+using itk::Benchmark::ImageType;
+using itk::Benchmark::KernelType;
+using itk::Benchmark::Settings;
+
+// Evaluates the value and the derivative of the metric, as each iteration of
+// a registration does, between two images of different noise with a small
+// translation.
+KernelType
+SetUpMattesMutualInformationImageToImageMetricv4(const Settings & settings)
+{
+  using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+  using TransformType = itk::TranslationTransform<double, 3>;
+  const auto                      transform = TransformType::New();
+  TransformType::OutputVectorType translation;
+  translation.Fill(1.5);
+  transform->SetOffset(translation);
+
+  const auto metric = MetricType::New();
+  metric->SetFixedImage(itk::Benchmark::CreateSyntheticImage(settings, 1));
+  metric->SetMovingImage(itk::Benchmark::CreateSyntheticImage(settings, 2));
+  metric->SetMovingTransform(transform);
+  metric->SetNumberOfHistogramBins(50);
+  metric->SetUseFixedImageGradientFilter(false);
+  metric->SetUseMovingImageGradientFilter(false);
+  metric->Initialize();
+
+  return [metric] {
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    metric->GetValueAndDerivative(value, derivative);
+  };
+}
+
+const itk::Benchmark::Registrar mattesRegistrar("MattesMutualInformationImageToImageMetricv4",
+                                                SetUpMattesMutualInformationImageToImageMetricv4);
+} // namespace